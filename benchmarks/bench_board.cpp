@@ -0,0 +1,262 @@
+/**
+ * @file bench_board.cpp
+ * @brief The board's core paths, from the 16 cards of EASY up to 100k
+ *
+ * Boards are headless (cards load no textures) and square: 4x4, 8x8,
+ * 32x32, 100x100 and 316x316 = 99856 cards, so anything that is not
+ * linear in the card count shows long before a player would see it. Each
+ * benchmark measures the call the game makes, with the board set up for
+ * its worst realistic case: clicks that scan every card, hints on a fresh
+ * deal, allMatched() on a board one card from cleared.
+ *
+ * "ScoreManager persistence" is the Leaderboard: ScoreManager only counts
+ * the current game, finished games are recorded and reloaded there.
+ *
+ * Results go to JSON with the bench_json target, or by hand:
+ *   memory_bench --benchmark_out=results.json --benchmark_out_format=json
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "../include/GameBoard.h"
+#include "../include/Leaderboard.h"
+#include "../include/SimulationClock.h"
+#include "../include/Utils.h"
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t SEED = 7;
+constexpr Vector2 CARD_SIZE = {10.0f, 14.0f};
+constexpr float PADDING = 2.0f;
+constexpr Rectangle BOUNDS = {0.0f, 0.0f, 1920.0f, 1080.0f};
+
+/// Square boards with an even card count, as Arg = number of cards
+void boardSizes(benchmark::internal::Benchmark* bench) {
+    for (int side : {4, 8, 32, 100, 316}) {
+        bench->Arg(side * side);
+    }
+}
+
+std::unique_ptr<GameBoard> makeBoard(int cards) {
+    const int side = static_cast<int>(std::lround(std::sqrt(cards)));
+    return std::make_unique<GameBoard>(side, side, CARD_SIZE, PADDING, BOUNDS, SEED, true);
+}
+
+void countCards(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["cards"] = static_cast<double>(state.range(0));
+}
+
+// === Dealing ===
+
+void BM_CreateCardPairs(benchmark::State& state) {
+    const int pairs = static_cast<int>(state.range(0)) / 2;
+    for (auto _ : state) {
+        std::vector<int> deck = Utils::createCardPairs(pairs);
+        benchmark::DoNotOptimize(deck.data());
+    }
+    countCards(state);
+}
+BENCHMARK(BM_CreateCardPairs)->Apply(boardSizes);
+
+void BM_SeededShuffle(benchmark::State& state) {
+    std::vector<int> deck(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t i = 0; i < deck.size(); ++i) {
+        deck[i] = static_cast<int>(i / 2);
+    }
+    std::mt19937 rng(SEED);
+    for (auto _ : state) {
+        Utils::shuffle(deck, rng);
+        benchmark::DoNotOptimize(deck.data());
+    }
+    countCards(state);
+}
+BENCHMARK(BM_SeededShuffle)->Apply(boardSizes);
+
+// The constructor is createCards(): the seeded deal and one Card per slot
+void BM_CreateBoard(benchmark::State& state) {
+    const int cards = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::unique_ptr<GameBoard> board = makeBoard(cards);
+        benchmark::DoNotOptimize(board.get());
+    }
+    countCards(state);
+}
+BENCHMARK(BM_CreateBoard)->Apply(boardSizes)->Unit(benchmark::kMicrosecond);
+
+// === Input ===
+
+// A click in the gap after the last card looks at every card and flips none
+void BM_HandleClick(benchmark::State& state) {
+    const int cards = static_cast<int>(state.range(0));
+    std::unique_ptr<GameBoard> board = makeBoard(cards);
+    Vector2 miss = board->getSlotCenter(cards - 1);
+    miss.x += CARD_SIZE.x / 2.0f + PADDING / 2.0f;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(board->handleClick(miss));
+    }
+    countCards(state);
+}
+BENCHMARK(BM_HandleClick)->Apply(boardSizes);
+
+// showHint() is findHintPair() plus two flips; the fresh deal is put back between hints
+void BM_FindHintPair(benchmark::State& state) {
+    const int cards = static_cast<int>(state.range(0));
+    std::unique_ptr<GameBoard> board = makeBoard(cards);
+    GameBoard::LogicState fresh;
+    board->saveState(fresh);
+    for (auto _ : state) {
+        board->showHint();
+        state.PauseTiming();
+        if (!board->isHintActive()) {
+            state.SkipWithError("no hint was shown");
+            break;
+        }
+        board->restoreState(fresh);
+        state.ResumeTiming();
+    }
+    countCards(state);
+}
+BENCHMARK(BM_FindHintPair)->Apply(boardSizes);
+
+// === Per-step work ===
+
+// Every card but the last one matched: the whole board is looked at
+void BM_AllMatched(benchmark::State& state) {
+    const int cards = static_cast<int>(state.range(0));
+    std::unique_ptr<GameBoard> board = makeBoard(cards);
+    GameBoard::LogicState nearlyCleared;
+    board->saveState(nearlyCleared);
+    for (int i = 0; i + 1 < cards; ++i) {
+        nearlyCleared.cards[i].state = CardState::MATCHED;
+    }
+    board->restoreState(nearlyCleared);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(board->allMatched());
+    }
+    countCards(state);
+}
+BENCHMARK(BM_AllMatched)->Apply(boardSizes);
+
+/// Each board size with no card, a flipped pair's worth, and every card moving
+void animatingSizes(benchmark::internal::Benchmark* bench) {
+    for (int side : {4, 8, 32, 100, 316}) {
+        const int cards = side * side;
+        for (int animating : {0, 2, cards}) {
+            bench->Args({cards, animating});
+        }
+    }
+}
+
+// One update() step with range(1) cards on a move that does not end during the run
+void BM_UpdateAnimating(benchmark::State& state) {
+    const int cards = static_cast<int>(state.range(0));
+    const int animating = static_cast<int>(state.range(1));
+    std::unique_ptr<GameBoard> board = makeBoard(cards);
+    GameBoard::LogicState moving;
+    board->saveState(moving);
+    for (int i = 0; i < animating; ++i) {
+        Card::LogicState& card = moving.cards[i];
+        card.isMoving = true;
+        card.moveStart = card.position;
+        card.moveTarget = {card.position.x + CARD_SIZE.x, card.position.y};
+        card.moveTimer = 0.0f;
+        card.moveDuration = 1.0e9f;
+    }
+    board->restoreState(moving);
+    for (auto _ : state) {
+        board->update(SimulationClock::DEFAULT_STEP);
+    }
+    countCards(state);
+}
+BENCHMARK(BM_UpdateAnimating)->Apply(animatingSizes);
+
+// Picking new places for every unmatched card; the moves themselves run in update()
+void BM_StartShuffle(benchmark::State& state) {
+    const int cards = static_cast<int>(state.range(0));
+    std::unique_ptr<GameBoard> board = makeBoard(cards);
+    for (auto _ : state) {
+        board->startShuffle(1.0f);
+        benchmark::DoNotOptimize(board->isShuffling());
+    }
+    countCards(state);
+}
+BENCHMARK(BM_StartShuffle)->Apply(boardSizes);
+
+// === Layout ===
+
+// Grid, card size and card positions for a board filling the window
+void BM_CalculateLayout(benchmark::State& state) {
+    const int cards = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        const Vector2 grid = Utils::calculateGridDimensions(cards);
+        const int cols = static_cast<int>(grid.x);
+        const int rows = static_cast<int>(grid.y);
+        const Vector2 cardSize = Utils::calculateOptimalCardSize(cols, rows, BOUNDS, PADDING);
+        std::vector<Vector2> positions = Utils::calculateCardPositions(cols, rows, cardSize, PADDING, BOUNDS);
+        benchmark::DoNotOptimize(positions.data());
+    }
+    countCards(state);
+}
+BENCHMARK(BM_CalculateLayout)->Apply(boardSizes);
+
+// === Scores ===
+
+LeaderboardEntry randomGame(std::mt19937& random) {
+    static constexpr std::int32_t DIFFICULTIES[] = {16, 36, 64};
+    LeaderboardEntry entry;
+    entry.timestamp = 1760400000 + random() % 1000000;
+    entry.difficulty = DIFFICULTIES[random() % 3];
+    entry.score = static_cast<std::int32_t>(random() % 5000);
+    entry.milliseconds = 20000 + random() % 300000;
+    entry.moves = static_cast<std::int32_t>(8 + random() % 100);
+    return entry;
+}
+
+// Ranking one more finished game among range(0) (in memory; the append is the worker's)
+void BM_LeaderboardRecord(benchmark::State& state) {
+    Leaderboard leaderboard("");
+    std::mt19937 random(SEED);
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        leaderboard.record(randomGame(random));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(leaderboard.record(randomGame(random)).sequence);
+    }
+}
+BENCHMARK(BM_LeaderboardRecord)->Arg(1000)->Arg(100000);
+
+// Reading and ranking a log of range(0) games, as at start-up
+void BM_LeaderboardLoad(benchmark::State& state) {
+    const std::string path = (std::filesystem::temp_directory_path() / "mc_bench_leaderboard.bin").string();
+    std::filesystem::remove(path);
+    {
+        Leaderboard leaderboard(path);
+        std::mt19937 random(SEED);
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            leaderboard.record(randomGame(random));
+        }
+        leaderboard.flush();
+    }
+
+    Leaderboard leaderboard(path);
+    for (auto _ : state) {
+        if (!leaderboard.load()) {
+            state.SkipWithError("leaderboard log did not load");
+            break;
+        }
+        benchmark::DoNotOptimize(leaderboard.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+    std::filesystem::remove(leaderboard.getBackupPath());
+}
+BENCHMARK(BM_LeaderboardLoad)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+} // namespace
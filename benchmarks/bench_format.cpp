@@ -0,0 +1,187 @@
+/**
+ * @file bench_format.cpp
+ * @brief Format against the std::ostringstream formatting it replaced
+ *
+ * Each pair formats the same rotating values the old way (a stream per
+ * call, as Utils::toString(float, int) and formatTime() did) and the new
+ * way, into a stack buffer. The Utils wrappers are measured too: they
+ * still return a std::string, which for these lengths stays in the
+ * string's own buffer. HUD_Line builds a whole HUD line per iteration.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "../include/Format.h"
+#include "../include/Utils.h"
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace {
+
+constexpr int VALUES = 1024;    // Rotated through so no result can be reused
+
+float valueAt(int i) {
+    return static_cast<float>(i % VALUES) * 3.7137f - 150.0f;
+}
+
+float secondsAt(int i) {
+    return static_cast<float>(i % VALUES) * 7.31f;
+}
+
+// === The stream versions ===
+
+std::string streamDecimal(float value, int precision) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(precision) << value;
+    return oss.str();
+}
+
+std::string streamClock(float seconds) {
+    int mins = static_cast<int>(seconds) / 60;
+    int secs = static_cast<int>(seconds) % 60;
+    std::ostringstream oss;
+    oss << (mins < 10 ? "0" : "") << mins << ":" << (secs < 10 ? "0" : "") << secs;
+    return oss.str();
+}
+
+// === Decimals ===
+
+void BM_Decimal_Stream(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(streamDecimal(valueAt(i++), 2));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Decimal_Stream);
+
+void BM_Decimal_Format(benchmark::State& state) {
+    char text[Format::DECIMAL_CHARS];
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Format::decimal(text, sizeof(text), valueAt(i++), 2));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Decimal_Format);
+
+// Past the integer fast path: std::to_chars does the rounding
+void BM_Decimal_FormatToChars(benchmark::State& state) {
+    char text[Format::DECIMAL_CHARS];
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Format::decimal(text, sizeof(text), valueAt(i++), 8));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Decimal_FormatToChars);
+
+void BM_Decimal_UtilsToString(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Utils::toString(valueAt(i++), 2));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Decimal_UtilsToString);
+
+// === Integers ===
+
+void BM_Integer_Stream(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        std::ostringstream oss;
+        oss << (i++ * 7919);
+        benchmark::DoNotOptimize(oss.str());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Integer_Stream);
+
+void BM_Integer_Format(benchmark::State& state) {
+    char text[Format::INTEGER_CHARS];
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Format::integer(text, sizeof(text), static_cast<long long>(i++ * 7919)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Integer_Format);
+
+// === MM:SS ===
+
+void BM_Clock_Stream(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(streamClock(secondsAt(i++)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Clock_Stream);
+
+void BM_Clock_Format(benchmark::State& state) {
+    char text[Format::CLOCK_CHARS];
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Format::clock(text, sizeof(text), secondsAt(i++)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Clock_Format);
+
+void BM_Clock_UtilsFormatTime(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Utils::formatTime(secondsAt(i++)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Clock_UtilsFormatTime);
+
+// The HUD timer: called every frame, a new second once in 60 calls
+void BM_Clock_CachedText(benchmark::State& state) {
+    ClockText clock;
+    float seconds = 0.0f;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clock.update(seconds).data());
+        seconds += 1.0f / 60.0f;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Clock_CachedText);
+
+// === A HUD line ===
+
+void BM_HudLine_Strings(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        std::string line = "Frame: " + streamDecimal(valueAt(i), 2) + " ms avg (" + std::to_string(i % 144) +
+                           " FPS), " + streamClock(secondsAt(i));
+        benchmark::DoNotOptimize(line);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HudLine_Strings);
+
+void BM_HudLine_FormatBuffer(benchmark::State& state) {
+    FormatBuffer<96> line;
+    int i = 0;
+    for (auto _ : state) {
+        line.clear().append("Frame: ").appendDecimal(valueAt(i), 2).append(" ms avg (").append(i % 144)
+            .append(" FPS), ").appendClock(secondsAt(i));
+        benchmark::DoNotOptimize(line.c_str());
+        benchmark::ClobberMemory();
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HudLine_FormatBuffer);
+
+} // namespace
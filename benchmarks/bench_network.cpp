@@ -0,0 +1,288 @@
+/**
+ * @file bench_network.cpp
+ * @brief Turn hand-over and reconnect latency over simulated network conditions
+ *
+ * Two NetworkSessions play a scripted match over a NetworkSimulator link.
+ * The "turn_latency_ms" counter is simulated time from one player passing
+ * the turn to the other player seeing it, which is what a player feels;
+ * the wall-clock time is the CPU cost of running the sessions.
+ * "reconnect_ms" is the simulated time from a dropped link until the
+ * guest has resumed its session. BM_LossyTurnDelivery compares how long a
+ * TURN line takes to cross a lossy link over the TCP-like stream and over
+ * the UDP ReliableChannel.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "../include/NetworkSession.h"
+#include "../include/NetworkSimulator.h"
+#include "../include/ReliableChannel.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+constexpr int MOVES_PER_MATCH = 20;
+
+NetworkConditions conditionsFor(int preset) {
+    NetworkConditions conditions;
+    switch (preset) {
+    case 1: // Home broadband
+        conditions.latency = 0.03f;
+        conditions.jitter = 0.005f;
+        conditions.bandwidth = 1000000.0f;
+        break;
+    case 2: // Congested Wi-Fi
+        conditions.latency = 0.08f;
+        conditions.jitter = 0.04f;
+        conditions.lossRate = 0.05f;
+        conditions.bandwidth = 50000.0f;
+        conditions.maxSegmentSize = 64;
+        conditions.coalesceWindow = 0.01f;
+        break;
+    case 3: // Poor mobile link
+        conditions.latency = 0.2f;
+        conditions.jitter = 0.1f;
+        conditions.lossRate = 0.15f;
+        conditions.retransmitDelay = 0.3f;
+        conditions.bandwidth = 4000.0f;
+        conditions.maxSegmentSize = 16;
+        conditions.coalesceWindow = 0.05f;
+        break;
+    default: // Loopback
+        break;
+    }
+    return conditions;
+}
+
+const char* presetName(int preset) {
+    switch (preset) {
+    case 1: return "broadband";
+    case 2: return "wifi";
+    case 3: return "mobile";
+    default: return "loopback";
+    }
+}
+
+// Minimal datagram wire for ReliableChannel: fixed latency, random loss
+struct DatagramWire {
+    struct Datagram {
+        float arrival;
+        int to;
+        std::string bytes;
+    };
+
+    ReliableChannel channels[2];
+    std::vector<Datagram> inFlight;
+    std::mt19937 rng;
+    float now = 0.0f;
+    float latency;
+    float lossRate;
+
+    DatagramWire(float latencySeconds, float loss, unsigned int seed)
+        : rng(seed), latency(latencySeconds), lossRate(loss) {
+    }
+
+    void put(int from, std::vector<std::string>& packets) {
+        for (std::string& packet : packets) {
+            if (static_cast<float>(rng() >> 8) * (1.0f / 16777216.0f) >= lossRate) {
+                inFlight.push_back(Datagram{now + latency, 1 - from, std::move(packet)});
+            }
+        }
+        packets.clear();
+    }
+
+    void advance(float dt) {
+        now += dt;
+        size_t delivered = 0;
+        while (delivered < inFlight.size() && inFlight[delivered].arrival <= now) {
+            channels[inFlight[delivered].to].receivePacket(inFlight[delivered].bytes.data(),
+                                                            inFlight[delivered].bytes.size());
+            ++delivered;
+        }
+        inFlight.erase(inFlight.begin(), inFlight.begin() + delivered);
+
+        std::vector<std::string> packets;
+        for (int side = 0; side < 2; ++side) {
+            channels[side].update(dt, packets);
+            put(side, packets);
+        }
+    }
+};
+
+} // namespace
+
+static void BM_TurnLatency(benchmark::State& state) {
+    const int preset = static_cast<int>(state.range(0));
+    double totalLatency = 0.0;
+    long long handovers = 0;
+    unsigned int seed = 1;
+
+    for (auto _ : state) {
+        NetworkSimulator simulator(conditionsFor(preset), seed++);
+        NetworkSession host;
+        NetworkSession guest;
+        host.attach(NetworkMode::SERVER, simulator.takeEndpoint(0));
+        guest.attach(NetworkMode::CLIENT, simulator.takeEndpoint(1));
+
+        int moves = 0;
+        float passedAt = -1.0f;
+        while (moves < MOVES_PER_MATCH && simulator.getTime() < 600.0f) {
+            simulator.advance(TICK);
+            host.update(TICK);
+            guest.update(TICK);
+            if (!host.isConnected() || !guest.isConnected()) {
+                continue;
+            }
+
+            NetworkSession* mover = nullptr;
+            if (host.getCurrentTurn() == 0 && host.isMyTurn()) {
+                mover = &host;
+            } else if (guest.getCurrentTurn() == 1 && guest.isMyTurn()) {
+                mover = &guest;
+            }
+            if (!mover) {
+                continue;
+            }
+
+            if (passedAt >= 0.0f) {
+                totalLatency += simulator.getTime() - passedAt;
+                ++handovers;
+            }
+            mover->sendFlip(moves % 16);
+            mover->sendFlip((moves + 5) % 16);
+            mover->nextTurn();
+            passedAt = simulator.getTime();
+            ++moves;
+        }
+    }
+
+    state.SetLabel(presetName(preset));
+    state.SetItemsProcessed(handovers);
+    state.counters["turn_latency_ms"] = handovers > 0 ? 1000.0 * totalLatency / handovers : 0.0;
+}
+BENCHMARK(BM_TurnLatency)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+static void BM_ReconnectTime(benchmark::State& state) {
+    const int preset = static_cast<int>(state.range(0));
+    double totalReconnect = 0.0;
+    long long reconnects = 0;
+    unsigned int seed = 1;
+
+    for (auto _ : state) {
+        NetworkSimulator simulator(conditionsFor(preset), seed++);
+        NetworkSession host;
+        NetworkSession guest;
+        host.attach(NetworkMode::SERVER, nullptr);
+        guest.startClient(NetworkMode::CLIENT, [&simulator]() { return simulator.connect(); });
+
+        auto tick = [&]() {
+            simulator.advance(TICK);
+            while (auto incoming = simulator.accept()) {
+                host.acceptTransport(std::move(incoming));
+            }
+            host.update(TICK);
+            guest.update(TICK);
+        };
+
+        while (!guest.isHandshakeComplete() && simulator.getTime() < 60.0f) {
+            tick();
+        }
+        host.sendFlip(1);
+        tick();
+
+        // Drop the link mid-game and time how long the guest takes to resume
+        simulator.disconnect();
+        const float cutAt = simulator.getTime();
+        while (guest.getResumeCount() == 0 && simulator.getTime() < cutAt + 60.0f) {
+            tick();
+        }
+        if (guest.getResumeCount() > 0) {
+            totalReconnect += simulator.getTime() - cutAt;
+            ++reconnects;
+        }
+    }
+
+    state.SetLabel(presetName(preset));
+    state.SetItemsProcessed(reconnects);
+    state.counters["reconnect_ms"] = reconnects > 0 ? 1000.0 * totalReconnect / reconnects : 0.0;
+}
+BENCHMARK(BM_ReconnectTime)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+// Args: loss percent, transport (0 = TCP-like stream, 1 = UDP ReliableChannel)
+static void BM_LossyTurnDelivery(benchmark::State& state) {
+    const float lossRate = static_cast<float>(state.range(0)) / 100.0f;
+    const bool udp = state.range(1) != 0;
+    constexpr float LATENCY = 0.04f;
+    constexpr int TURNS = 40;
+    constexpr float TURN_INTERVAL = 0.25f;
+    const std::string line = "TURN 1\n";
+
+    double totalDelay = 0.0;
+    double worstDelay = 0.0;
+    long long delivered = 0;
+    unsigned int seed = 1;
+    char buffer[256];
+
+    for (auto _ : state) {
+        NetworkConditions conditions;
+        conditions.latency = LATENCY;
+        conditions.lossRate = lossRate;
+        conditions.retransmitDelay = 0.2f; // Common minimum TCP retransmit timeout
+        NetworkSimulator simulator(conditions, seed);
+        auto streamSender = simulator.takeEndpoint(0);
+        auto streamReceiver = simulator.takeEndpoint(1);
+        DatagramWire wire(LATENCY, lossRate, seed);
+        ++seed;
+
+        for (int turn = 0; turn < TURNS; ++turn) {
+            const float sentAt = udp ? wire.now : simulator.getTime();
+            if (udp) {
+                wire.channels[0].send(line.data(), line.size());
+                std::vector<std::string> packets;
+                wire.channels[0].flush(packets);
+                wire.put(0, packets);
+            } else {
+                streamSender->send(line.data(), line.size());
+            }
+
+            // Each TURN waits for the previous one, so the delay is all head-of-line and resend
+            size_t received = 0;
+            float elapsed = 0.0f;
+            while (received < line.size() && elapsed < 10.0f) {
+                if (udp) {
+                    wire.advance(TICK);
+                    received += wire.channels[1].read(buffer, sizeof(buffer));
+                } else {
+                    simulator.advance(TICK);
+                    long count = streamReceiver->receive(buffer, sizeof(buffer));
+                    received += count > 0 ? static_cast<size_t>(count) : 0;
+                }
+                elapsed = (udp ? wire.now : simulator.getTime()) - sentAt;
+            }
+            totalDelay += elapsed;
+            worstDelay = std::max(worstDelay, static_cast<double>(elapsed));
+            ++delivered;
+
+            for (float idle = elapsed; idle < TURN_INTERVAL; idle += TICK) {
+                if (udp) {
+                    wire.advance(TICK);
+                } else {
+                    simulator.advance(TICK);
+                }
+            }
+        }
+    }
+
+    state.SetLabel(udp ? "udp" : "tcp");
+    state.SetItemsProcessed(delivered);
+    state.counters["turn_delivery_ms"] = delivered > 0 ? 1000.0 * totalDelay / delivered : 0.0;
+    state.counters["worst_ms"] = 1000.0 * worstDelay;
+}
+BENCHMARK(BM_LossyTurnDelivery)
+    ->ArgsProduct({{0, 5, 15}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
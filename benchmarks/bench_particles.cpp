@@ -0,0 +1,59 @@
+/**
+ * @file bench_particles.cpp
+ * @brief Particle update cost: the old per-particle trigonometry vs the SoA pool
+ *
+ * BM_ParticlesPerParticleTrig reproduces what the background and victory
+ * screen did before: recompute every particle from the clock with
+ * fmod/sin/cos. BM_ParticleSystemUpdate runs ParticleSystem::update over
+ * a pool of the same size (gravity, motion, fade and dead-particle
+ * removal). Drawing is not measured here since it needs a GL context.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "../include/ParticleSystem.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+void BM_ParticlesPerParticleTrig(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::vector<Vector2> positions(count);
+    float time = 0.0f;
+    for (auto _ : state) {
+        time += TICK;
+        for (int i = 0; i < count; ++i) {
+            float angle = (i * 12.0f + time * 50) * DEG2RAD;
+            float dist = 150 + std::sin(time * 2 + i) * 30;
+            positions[i] = {512.0f + std::cos(angle) * dist, 284.0f + std::sin(angle) * dist};
+        }
+        benchmark::DoNotOptimize(positions.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParticlesPerParticleTrig)->Arg(1000)->Arg(100000);
+
+void BM_ParticleSystemUpdate(benchmark::State& state) {
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    ParticleSystem particles(count);
+    particles.setGravity({0.0f, 120.0f});
+
+    ParticleEmitter burst;
+    burst.position = {512.0f, 284.0f};
+    burst.maxSpeed = 320.0f;
+    burst.lifetime = 0.0f; // keep the pool full so every iteration does the same work
+    particles.emit(burst, count);
+
+    for (auto _ : state) {
+        particles.update(TICK);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_ParticleSystemUpdate)->Arg(1000)->Arg(100000);
+
+} // namespace
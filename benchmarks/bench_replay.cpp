@@ -0,0 +1,100 @@
+/**
+ * @file bench_replay.cpp
+ * @brief Replay verification throughput, and seeking with keyframes
+ *
+ * Replays come from a bot that plays like a decent human: a card every
+ * 20-60 steps (a third to a whole second), a wrong guess one pair in
+ * three. BM_ReplayVerify is ReplayPlayer::verify() over such games, i.e.
+ * how many leaderboard submissions one core checks per second.
+ * BM_ReplaySeek jumps to random steps of one HARD game.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "../include/Game.h"
+#include "../include/ReplayPlayer.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<unsigned char> playGame(std::uint32_t seed, int cards) {
+    const int grid = static_cast<int>(std::sqrt(cards));
+    GameBoard board(grid, grid, {100.0f, 100.0f}, 10.0f, {0.0f, 0.0f, 880.0f, 880.0f}, seed, true);
+    ScoreManager score;
+    board.setScoreManager(&score);
+    board.startShuffle(Game::OPENING_SHUFFLE_SECONDS);
+
+    ReplayRecorder recorder;
+    recorder.begin(seed, cards);
+    std::mt19937 bot(seed);
+    BoardSnapshot snapshot;
+    std::uint64_t step = 0;
+    std::uint64_t nextInput = 0;
+    int moves = 0;
+    int upId = -1;
+
+    while (!board.allMatched()) {
+        if (step >= nextInput && !board.isShuffling()) {
+            nextInput = step + 20 + bot() % 40;
+            board.fillSnapshot(snapshot);
+            int pick = -1;
+            for (int i = 0; i < static_cast<int>(snapshot.cards.size()); ++i) {
+                const CardSnapshot& card = snapshot.cards[i];
+                if (card.state != CardState::FACE_DOWN) continue;
+                if (pick < 0 || (upId >= 0 && card.id == upId && bot() % 3 != 0)) pick = i;
+            }
+            if (pick >= 0) {
+                Vector2 center = board.getSlotCenter(board.slotAt(snapshot.cards[pick].position));
+                if (board.handleClick(center)) {
+                    recorder.click(step, board.slotAt(center));
+                    upId = upId < 0 ? snapshot.cards[pick].id : -1;
+                }
+                ++moves;
+            }
+        }
+        ++step;
+        board.update(SimulationClock::DEFAULT_STEP);
+    }
+    recorder.finish(step, score.getScore(), moves);
+    return std::vector<unsigned char>(recorder.data(), recorder.data() + recorder.size());
+}
+
+void BM_ReplayVerify(benchmark::State& state) {
+    const int cards = static_cast<int>(state.range(0));
+    std::vector<std::vector<unsigned char>> replays;
+    for (std::uint32_t seed = 1; seed <= 16; ++seed) {
+        replays.push_back(playGame(seed, cards));
+    }
+
+    std::size_t next = 0;
+    for (auto _ : state) {
+        const std::vector<unsigned char>& replay = replays[next++ % replays.size()];
+        ReplayCheck check = ReplayPlayer::verify(replay.data(), replay.size());
+        if (!check.isValid()) {
+            state.SkipWithError("replay did not verify");
+            break;
+        }
+        benchmark::DoNotOptimize(check);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReplayVerify)->Arg(16)->Arg(36)->Arg(64);
+
+void BM_ReplaySeek(benchmark::State& state) {
+    const std::vector<unsigned char> replay = playGame(7, 64);
+    ReplayPlayer player(static_cast<std::uint64_t>(state.range(0)));
+    player.load(replay.data(), replay.size());
+    player.finish(); // every keyframe taken
+
+    std::mt19937 random(1);
+    for (auto _ : state) {
+        player.seek(random() % (player.getEndStep() + 1));
+        benchmark::DoNotOptimize(player.getScore());
+    }
+}
+BENCHMARK(BM_ReplaySeek)->Arg(60)->Arg(ReplayPlayer::KEYFRAME_INTERVAL);
+
+} // namespace
@@ -0,0 +1,104 @@
+/**
+ * @file bench_savegame.cpp
+ * @brief Saving a HARD game in progress, and continuing it
+ *
+ * The game is saved part way: 3000 steps (50 seconds) of a bot's play,
+ * so some pairs are matched and the replay has a few dozen inputs.
+ * BM_SaveGame is what Game::saveUnfinishedGame() does on the game thread
+ * before the bytes go to the PersistenceWorker; BM_ContinueGame is what
+ * Game::continueSavedGame() does: decode, deal the board again (its cards
+ * load no textures), restore and resume the replay. Both should stay well
+ * under a millisecond.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "../include/Game.h"
+#include "../include/SavedGame.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t SEED = 7;
+constexpr int CARDS = 64;
+constexpr Vector2 CARD_SIZE = {100.0f, 100.0f};
+constexpr float PADDING = 10.0f;
+constexpr Rectangle BOUNDS = {0.0f, 0.0f, 880.0f, 880.0f};
+
+struct SavedSetup {
+    std::unique_ptr<GameBoard> board;
+    ScoreManager score;
+    ReplayRecorder recorder;
+};
+
+void playPartWay(SavedSetup& game) {
+    game.board = std::make_unique<GameBoard>(8, 8, CARD_SIZE, PADDING, BOUNDS, SEED);
+    game.board->setScoreManager(&game.score);
+    game.board->startShuffle(Game::OPENING_SHUFFLE_SECONDS);
+    game.recorder.begin(SEED, CARDS);
+
+    std::mt19937 bot(SEED);
+    BoardSnapshot snapshot;
+    for (std::uint64_t step = 0; step < 3000; ++step) {
+        if (step % 30 == 0 && !game.board->isShuffling()) {
+            game.board->fillSnapshot(snapshot);
+            const int slot = static_cast<int>(bot() % CARDS);
+            if (game.board->handleClick(game.board->getSlotCenter(slot))) {
+                game.recorder.click(step, slot);
+            }
+        }
+        game.board->update(SimulationClock::DEFAULT_STEP);
+    }
+}
+
+void BM_SaveGame(benchmark::State& state) {
+    SavedSetup game;
+    playPartWay(game);
+    SavedGame saved;
+    std::vector<unsigned char> bytes;
+    for (auto _ : state) {
+        saved.difficulty = CARDS;
+        saved.seed = SEED;
+        saved.scoreMoves = game.score.getMoves();
+        saved.scoreMatches = game.score.getMatches();
+        saved.score = game.score.getScore();
+        game.board->saveGridState(saved.board);
+        saved.replay.assign(game.recorder.data(), game.recorder.data() + game.recorder.size());
+        saved.encode(bytes);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.counters["bytes"] = static_cast<double>(bytes.size());
+}
+BENCHMARK(BM_SaveGame)->Unit(benchmark::kMicrosecond);
+
+void BM_ContinueGame(benchmark::State& state) {
+    SavedSetup game;
+    playPartWay(game);
+    SavedGame saved;
+    saved.difficulty = CARDS;
+    saved.seed = SEED;
+    game.board->saveGridState(saved.board);
+    saved.replay.assign(game.recorder.data(), game.recorder.data() + game.recorder.size());
+    std::vector<unsigned char> bytes;
+    saved.encode(bytes);
+
+    ScoreManager score;
+    ReplayRecorder recorder;
+    for (auto _ : state) {
+        if (!saved.decode(bytes.data(), bytes.size())) {
+            state.SkipWithError("saved game did not decode");
+            break;
+        }
+        GameBoard board(8, 8, CARD_SIZE, PADDING, BOUNDS, saved.seed);
+        board.setScoreManager(&score);
+        board.restoreGridState(saved.board);
+        score.restore(saved.scoreMoves, saved.scoreMatches, saved.score);
+        recorder.resume(saved.replay.data(), saved.replay.size());
+        benchmark::DoNotOptimize(board.getMatchesFound());
+    }
+}
+BENCHMARK(BM_ContinueGame)->Unit(benchmark::kMicrosecond);
+
+} // namespace
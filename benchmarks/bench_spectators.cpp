@@ -0,0 +1,114 @@
+/**
+ * @file bench_spectators.cpp
+ * @brief Per-event cost of fanning game updates out to spectators
+ *
+ * Each spectator is one end of a local socket pair, so the numbers include
+ * the real system calls. A background thread drains the other ends to keep
+ * the kernel buffers from filling up. Compare BM_SpectatorFanout (shared
+ * buffer + gather write) with BM_SpectatorFanoutCopy (one copy and one
+ * send per viewer) to see what sharing saves as the audience grows.
+ */
+
+#include <benchmark/benchmark.h>
+
+#ifndef _WIN32
+
+#include "../include/SpectatorHub.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+// A typical tick: a flip plus the score/turn it caused
+const std::string kDelta = "FLIP 12\nMATCH 12 27\nSCORE 0 40\nTURN 1\n";
+
+struct SocketPairs {
+    std::vector<int> writers;
+    std::vector<int> readers;
+    std::atomic<bool> running{true};
+    std::thread drainer;
+
+    explicit SocketPairs(int count) {
+        for (int i = 0; i < count; ++i) {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+                break;
+            }
+            setSocketNonBlocking(fds[0]);
+            setSocketNonBlocking(fds[1]);
+            writers.push_back(fds[0]);
+            readers.push_back(fds[1]);
+        }
+        drainer = std::thread([this]() {
+            char buffer[65536];
+            while (running.load(std::memory_order_relaxed)) {
+                for (int fd : readers) {
+                    while (read(fd, buffer, sizeof(buffer)) > 0) {
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    ~SocketPairs() {
+        running = false;
+        drainer.join();
+        for (int fd : readers) {
+            close(fd);
+        }
+    }
+};
+
+} // namespace
+
+static void BM_SpectatorFanout(benchmark::State& state) {
+    const int spectatorCount = static_cast<int>(state.range(0));
+    SocketPairs pairs(spectatorCount);
+    SpectatorHub hub;
+    for (int fd : pairs.writers) {
+        hub.addSpectator(fd, nullptr); // hub closes the writer ends
+    }
+
+    for (auto _ : state) {
+        // Encoded once, referenced by every spectator queue
+        hub.broadcast(makeBroadcastBuffer(kDelta));
+        hub.pump(1.0f / 60.0f);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kDelta.size()) * spectatorCount);
+    state.counters["spectators"] = spectatorCount;
+    state.counters["resyncs"] = static_cast<double>(hub.getDroppedBacklogs());
+}
+BENCHMARK(BM_SpectatorFanout)->Arg(0)->RangeMultiplier(4)->Range(1, 256);
+
+static void BM_SpectatorFanoutCopy(benchmark::State& state) {
+    const int spectatorCount = static_cast<int>(state.range(0));
+    SocketPairs pairs(spectatorCount);
+
+    for (auto _ : state) {
+        // Baseline: format a private copy and send it to each viewer separately
+        for (int fd : pairs.writers) {
+            std::string copy = kDelta;
+            benchmark::DoNotOptimize(send(fd, copy.data(), copy.size(), MSG_NOSIGNAL));
+        }
+    }
+
+    for (int fd : pairs.writers) {
+        close(fd);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kDelta.size()) * spectatorCount);
+    state.counters["spectators"] = spectatorCount;
+}
+BENCHMARK(BM_SpectatorFanoutCopy)->Arg(0)->RangeMultiplier(4)->Range(1, 256);
+
+#endif // _WIN32
@@ -0,0 +1,270 @@
+/**
+ * @file memory_perf.cpp
+ * @brief Frame-time regression harness: the real game, a scripted player, a baseline
+ *
+ * Opens the game in a hidden window and lets a ScriptedSession play it:
+ * menu -> HARD -> perfect solve -> victory -> restart, --games times.
+ * Its decisions are fed to raylib as automation events, so Game reads
+ * them through IsKeyPressed(), GetMousePosition() and the rest exactly as
+ * it reads a player. Every frame's update and draw CPU time and
+ * allocations are recorded; the p50/p99/max of each are printed and held
+ * to a baseline.
+ *
+ *   memory_perf [--games=N] [--baseline=PATH] [--tolerance=0.25] [--write-baseline]
+ *               [--require-zero-allocations]
+ *
+ * --require-zero-allocations holds PLAYING to the AllocationTracker
+ * budget: past the warm-up, no frame of a game may allocate.
+ *
+ * Exit status: 0 within the baseline (or none asked for), 1 on a
+ * regression, a frame over the allocation budget or a --baseline file
+ * that does not exist, 2 when the session could not be played, 77
+ * (ctest's SKIP_RETURN_CODE) when there is no display to open a window
+ * on. Frames run uncapped; no GPU is needed (Xvfb and Mesa's llvmpipe
+ * will do):
+ *
+ *   xvfb-run -a env LIBGL_ALWAYS_SOFTWARE=1 ./memory_perf --baseline=...
+ *
+ * Run it from a scratch directory: the games it wins go to the
+ * leaderboard and replays under ./assets like any other.
+ */
+
+#include <raylib.h>
+
+#include "../include/AllocationTracker.h"
+#include "../include/FrameProfile.h"
+#include "../include/Game.h"
+#include "../include/ScriptedSession.h"
+#include "../include/TextRenderer.h"
+#include "../include/Utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int WINDOW_WIDTH = 1024;
+constexpr int WINDOW_HEIGHT = 768;
+constexpr int DEFAULT_GAMES = 3;
+constexpr double DEFAULT_TOLERANCE = 0.25;
+constexpr double SESSION_TIMEOUT_SECONDS = 300.0;   ///< A stuck script fails instead of hanging CI
+constexpr int EXIT_NO_DISPLAY = 77;                 ///< Headless machine: the test is skipped, not failed
+
+// raylib 5.0's AutomationEventType (rcore.c, not in raylib.h): the input events used here
+constexpr unsigned int INPUT_KEY_UP = 1;
+constexpr unsigned int INPUT_KEY_DOWN = 2;
+constexpr unsigned int INPUT_MOUSE_BUTTON_UP = 5;
+constexpr unsigned int INPUT_MOUSE_BUTTON_DOWN = 6;
+constexpr unsigned int INPUT_MOUSE_POSITION = 7;
+
+void play(unsigned int type, int param0, int param1 = 0) {
+    AutomationEvent event{};
+    event.type = type;
+    event.params[0] = param0;
+    event.params[1] = param1;
+    PlayAutomationEvent(event);
+}
+
+/**
+ * Presses what the script decided, after releasing what it pressed the
+ * frame before: PollInputEvents() in EndDrawing() has copied the current
+ * input state to the previous one by now, so a press shows up as
+ * IsKeyPressed()/IsMouseButtonPressed() for exactly this frame.
+ */
+class InputInjector {
+public:
+    void apply(const ScriptedInput& input) {
+        if (m_heldKey != 0) {
+            play(INPUT_KEY_UP, m_heldKey);
+            m_heldKey = 0;
+        }
+        if (m_buttonHeld) {
+            play(INPUT_MOUSE_BUTTON_UP, MOUSE_BUTTON_LEFT);
+            m_buttonHeld = false;
+        }
+        switch (input.type) {
+            case ScriptedInput::Type::CLICK:
+                play(INPUT_MOUSE_POSITION, static_cast<int>(input.position.x), static_cast<int>(input.position.y));
+                play(INPUT_MOUSE_BUTTON_DOWN, MOUSE_BUTTON_LEFT);
+                m_buttonHeld = true;
+                break;
+            case ScriptedInput::Type::KEY:
+                play(INPUT_KEY_DOWN, input.key);
+                m_heldKey = input.key;
+                break;
+            case ScriptedInput::Type::NONE:
+                break;
+        }
+    }
+
+private:
+    int m_heldKey = 0;
+    bool m_buttonHeld = false;
+};
+
+struct Options {
+    int games = DEFAULT_GAMES;
+    std::string baseline;
+    double tolerance = DEFAULT_TOLERANCE;
+    bool writeBaseline = false;
+    bool requireZeroAllocations = false;
+};
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--games=", 0) == 0) {
+            options.games = std::atoi(arg.c_str() + 8);
+        } else if (arg.rfind("--baseline=", 0) == 0) {
+            options.baseline = arg.substr(11);
+        } else if (arg.rfind("--tolerance=", 0) == 0) {
+            options.tolerance = std::atof(arg.c_str() + 12);
+        } else if (arg == "--write-baseline") {
+            options.writeBaseline = true;
+        } else if (arg == "--require-zero-allocations") {
+            options.requireZeroAllocations = true;
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (options.games < 1 || options.tolerance < 0.0 || (options.writeBaseline && options.baseline.empty())) {
+        std::fprintf(stderr, "usage: memory_perf [--games=N] [--baseline=PATH] [--tolerance=0.25] [--write-baseline] "
+                             "[--require-zero-allocations]\n");
+        return false;
+    }
+    return true;
+}
+
+// An X11/Wayland session is needed before a window can be opened at all
+bool hasDisplay() {
+#if defined(__linux__) || defined(__FreeBSD__)
+    return std::getenv("DISPLAY") != nullptr || std::getenv("WAYLAND_DISPLAY") != nullptr;
+#else
+    return true;
+#endif
+}
+
+// Injected input must reach the game; otherwise the session would just time out
+bool injectionWorks() {
+    play(INPUT_KEY_DOWN, KEY_F12);
+    const bool down = IsKeyDown(KEY_F12);
+    play(INPUT_KEY_UP, KEY_F12);
+    return down && !IsKeyDown(KEY_F12);
+}
+
+/// Plays the session; false if it did not finish
+bool playSession(int games, FrameProfile& profile, AllocationTracker& allocations) {
+    Game game(GetScreenWidth(), GetScreenHeight());
+    ScriptedSession session(games);
+    InputInjector injector;
+    BoardSnapshot board;
+    const double start = GetTime();
+
+    while (!session.isFinished() && !WindowShouldClose()) {
+        if (GetTime() - start > SESSION_TIMEOUT_SECONDS) {
+            Utils::logError("memory_perf: session timed out after " + Utils::toString(session.getGamesWon()) + " games");
+            return false;
+        }
+
+        // What the last frame showed decides this frame's input
+        const GameState state = game.getCurrentState();
+        if (state == GameState::PLAYING && game.getBoard()) {
+            game.getBoard()->fillSnapshot(board);
+        }
+        injector.apply(session.next(state, game.getWidgets(), board, GetFrameTime()));
+
+        FrameSample sample;
+        allocations.beginFrame();
+        const double frameStart = GetTime();
+        allocations.beginPhase(AllocationPhase::UPDATE);
+        game.update();
+        const double updated = GetTime();
+        allocations.beginPhase(AllocationPhase::DRAW);
+        BeginDrawing();
+        ClearBackground(DARKBLUE);
+        game.draw();
+        const double drawn = GetTime();
+        allocations.endFrame(state == GameState::PLAYING && game.getCurrentState() == GameState::PLAYING);
+        sample.updateMs = static_cast<float>((updated - frameStart) * 1000.0);
+        sample.drawMs = static_cast<float>((drawn - updated) * 1000.0);
+        sample.allocations = static_cast<std::uint32_t>(allocations.getLastFrame().total.allocations);
+        sample.allocatedBytes = allocations.getLastFrame().total.bytes;
+        EndDrawing();
+        profile.add(sample);
+    }
+    return session.isFinished();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    // Checked first: a gate without its baseline must fail, not pass after a full session
+    std::vector<PerfMetric> baseline;
+    if (!options.writeBaseline && !options.baseline.empty() && !FrameProfile::readBaseline(options.baseline, baseline)) {
+        std::printf("MISSING BASELINE %s; --write-baseline records one\n", options.baseline.c_str());
+        return 1;
+    }
+    if (!hasDisplay()) {
+        std::printf("SKIPPED no display (run under xvfb-run)\n");
+        return EXIT_NO_DISPLAY;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "memory_perf");
+    if (!IsWindowReady()) {
+        std::printf("SKIPPED no window could be opened\n");
+        return EXIT_NO_DISPLAY;
+    }
+    SetExitKey(KEY_NULL);
+    SetTargetFPS(0);
+
+    int status = 2;
+    if (!injectionWorks()) {
+        Utils::logError("memory_perf: this raylib build does not play automation events (SUPPORT_AUTOMATION_EVENTS)");
+    } else {
+        FrameProfile profile;
+        profile.reserve(1 << 16);
+        AllocationTracker allocations;
+        if (playSession(options.games, profile, allocations)) {
+            status = 0;
+            const std::vector<PerfMetric> metrics = profile.summarize();
+            std::printf("%zu frames, %d games\n", profile.size(), options.games);
+            for (const PerfMetric& metric : metrics) {
+                std::printf("  %-18s %10.3f\n", metric.name.c_str(), metric.value);
+            }
+
+            if (options.writeBaseline) {
+                if (!FrameProfile::writeBaseline(options.baseline, metrics)) {
+                    Utils::logError("memory_perf: cannot write " + options.baseline);
+                    status = 2;
+                }
+            } else if (options.baseline.empty()) {
+                // Nothing to compare with
+            } else {
+                for (const std::string& line : FrameProfile::findRegressions(baseline, metrics, options.tolerance)) {
+                    std::printf("REGRESSION %s\n", line.c_str());
+                    status = 1;
+                }
+            }
+
+            allocations.logSummary();
+            if (options.requireZeroAllocations && allocations.getViolations() > 0) {
+                std::printf("ALLOCATIONS %llu PLAYING frames allocated past the warm-up\n",
+                            static_cast<unsigned long long>(allocations.getViolations()));
+                status = 1;
+            }
+        }
+    }
+
+    TextRenderer::unload();
+    CloseWindow();
+    return status;
+}
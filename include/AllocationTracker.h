@@ -0,0 +1,142 @@
+/**
+ * @file AllocationTracker.h
+ * @brief Heap allocations per frame and per phase, and a zero-allocation budget
+ *
+ * Counting needs the global operator new replacement in
+ * AllocationHook.cpp, which is opt-in: the game links it when configured
+ * with -DTRACK_ALLOCATIONS=ON, the tests and memory_perf always do.
+ * Without it isInstalled() is false and every count stays zero.
+ *
+ * The hook only bumps two process-wide counters. An AllocationTracker
+ * reads them at frame and phase boundaries, so a frame's numbers are
+ * everything allocated between beginFrame() and endFrame(), on any
+ * thread, and each phase's are what was allocated inside its scope.
+ * Whatever is outside every phase (overlays, the network) only shows in
+ * the frame total.
+ *
+ * The budget: frames the caller marks as budgeted (PLAYING) must not
+ * allocate at all once BUDGET_WARMUP_FRAMES of them have run in a row
+ * (the first frames of a game build its board and caches). Each frame
+ * over it is a violation, and the first few are logged with their phases.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Allocation count and requested bytes
+ */
+struct AllocationCounts {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+};
+
+/**
+ * @brief The parts of a frame counted on their own
+ */
+enum class AllocationPhase {
+    UPDATE,
+    DRAW,
+    COUNT
+};
+
+/**
+ * @brief One frame's allocations
+ */
+struct FrameAllocations {
+    AllocationCounts total;
+    AllocationCounts phases[static_cast<int>(AllocationPhase::COUNT)];
+
+    const AllocationCounts& phase(AllocationPhase which) const { return phases[static_cast<int>(which)]; }
+};
+
+/**
+ * @brief Splits the allocation counters into frames and phases
+ */
+class AllocationTracker {
+public:
+    AllocationTracker();
+
+    // === The hook's side ===
+
+    /**
+     * @brief Counts one allocation; called by the operator new replacement only
+     */
+    static void recordAllocation(std::size_t bytes);
+
+    /**
+     * @brief Called once by the hook, so callers can tell counting is on
+     */
+    static void markInstalled();
+    static bool isInstalled();
+
+    /**
+     * @brief Everything counted since the process started
+     */
+    static AllocationCounts current();
+
+    // === Frames and phases ===
+
+    void beginFrame();
+
+    /**
+     * @brief Closes the frame
+     * @param budgeted True when the frame is held to the zero-allocation budget
+     */
+    void endFrame(bool budgeted);
+
+    /**
+     * @brief Counts what follows as phase, until endPhase(); phases do not nest
+     */
+    void beginPhase(AllocationPhase phase);
+    void endPhase();
+
+    /**
+     * @brief beginPhase() until the end of the scope
+     */
+    class Scope {
+    public:
+        Scope(AllocationTracker& tracker, AllocationPhase phase) : m_tracker(tracker) { tracker.beginPhase(phase); }
+        ~Scope() { m_tracker.endPhase(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        AllocationTracker& m_tracker;
+    };
+
+    const FrameAllocations& getLastFrame() const { return m_lastFrame; }
+    const FrameAllocations& getWorstFrame() const { return m_worstFrame; }   ///< Most allocations in one frame
+    std::uint64_t getFrames() const { return m_frames; }
+    std::uint64_t getViolations() const { return m_violations; }
+
+    /**
+     * @brief Draws the last and worst frame per phase in a small panel
+     */
+    void drawOverlay(int x, int y) const;
+
+    /**
+     * @brief Writes the worst frame and the budget result to the log
+     */
+    void logSummary() const;
+
+    static constexpr int BUDGET_WARMUP_FRAMES = 30;
+    static constexpr int MAX_REPORTED_VIOLATIONS = 5;
+
+private:
+    FrameAllocations m_frame;       ///< The frame being counted
+    FrameAllocations m_lastFrame;
+    FrameAllocations m_worstFrame;
+    AllocationCounts m_frameStart;
+    AllocationCounts m_phaseStart;
+    int m_phase;                    ///< Current phase, -1 outside any
+    std::uint64_t m_frames;
+    std::uint64_t m_violations;
+    int m_budgetedFrames;           ///< Budgeted frames in a row
+};
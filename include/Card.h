@@ -16,6 +16,8 @@
 #include <string>
 #include <memory>
 
+struct CardSnapshot;
+
 /**
  * @brief Enumeration of card states
  */
@@ -41,7 +43,9 @@ public:
     /**
      * @brief Constructor for Card class
      * @param id Unique identifier for this card (used for matching)
-     * @param texturePath Path to the card's texture file
+     * @param texturePath Path to the card's texture file, loaded by
+     *                    loadTextures(); empty for a logic-only card that
+     *                    never loads any (headless boards)
      * @param position Position of the card on screen
      * @param size Size of the card
      */
@@ -86,8 +90,34 @@ public:
     
     /**
      * @brief Draws the card to the screen
+     * @param alpha Interpolation between the previous and the current update (1 = current)
+     */
+    void draw(float alpha = 1.0f) const;
+    
+    /**
+     * @brief Draws this card's textures in a state captured earlier
+     * 
+     * Reads nothing but the (immutable) textures and id from the card
+     * itself, so the render thread may call it while the simulation
+     * thread updates the card.
+     * 
+     * @param state Snapshot taken by fillSnapshot()
+     * @param alpha Interpolation between the snapshot's previous and current state
+     */
+    void draw(const CardSnapshot& state, float alpha) const;
+    
+    /**
+     * @brief Loads the textures draw() uses, once; does nothing for a logic-only card
+     * 
+     * Cards are created without them: the board normally draws through
+     * CardRenderer's atlas, so only its per-card fallback needs them.
+     */
+    void loadTextures();
+    
+    /**
+     * @brief Copies the drawable state into a snapshot
      */
-    void draw() const;
+    void fillSnapshot(CardSnapshot& snapshot) const;
     
     /**
      * @brief Starts the flip animation to reveal the card
@@ -96,6 +126,8 @@ public:
     
     /**
      * @brief Starts the flip animation to hide the card
+     *
+     * A card still turning up turns back from where it got to.
      */
     void flipDown();
     
@@ -160,7 +192,7 @@ public:
     Rectangle getBounds() const;
     
     /**
-     * @brief Sets the card's position
+     * @brief Sets the card's position, ending any move in progress
      * @param position New position
      */
     void setPosition(Vector2 position);
@@ -175,6 +207,75 @@ public:
     void moveTo(Vector2 target, float duration);
     bool isMoving() const;
 
+    /**
+     * @brief Whether update() would change nothing: no move or flip under way,
+     *        and the previous-update state has caught up for drawing
+     */
+    bool isSettled() const;
+    Vector2 getDestination() const { return m_isMoving ? m_moveTarget : m_position; }
+
+    /**
+     * @brief Everything update() and the board rules read, without textures
+     */
+    struct LogicState {
+        CardState state = CardState::FACE_DOWN;
+        Vector2 position{};
+        Vector2 previousPosition{};
+        float previousFlip = 0.0f;
+        float animationProgress = 0.0f;
+        float scaleX = 1.0f;
+        bool isMoving = false;
+        Vector2 moveStart{};
+        Vector2 moveTarget{};
+        float moveTimer = 0.0f;
+        float moveDuration = 0.0f;
+    };
+
+    /**
+     * @brief Copies the logic state out, e.g. into a replay keyframe
+     */
+    void saveState(LogicState& state) const;
+
+    /**
+     * @brief Puts the card back into a state saved from this same card
+     */
+    void restoreState(const LogicState& state);
+
+    /**
+     * @brief How far the card has turned towards its face
+     * @param alpha Interpolation between the previous and the current update (1 = current)
+     * @return 0 when face down, 1 when face up, eased in between while flipping
+     */
+    float getFlipAmount(float alpha = 1.0f) const;
+    
+    /**
+     * @brief Position to draw at, blended between the previous and the current update
+     * @param alpha Interpolation factor, 0 = previous update, 1 = current
+     */
+    Vector2 getRenderPosition(float alpha) const;
+    
+    /**
+     * @brief Gets the path the front texture was requested from
+     * @return Texture path (may not exist on disk)
+     */
+    const std::string& getTexturePath() const { return m_texturePath; }
+    
+    /**
+     * @brief Builds the complete front face image, id number included
+     * @param id Card ID
+     * @param texturePath Front texture path, used when it exists
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @return Image owned by the caller (UnloadImage)
+     */
+    static Image createFaceImage(int id, const std::string& texturePath, int width, int height);
+    
+    /**
+     * @brief Builds the card back image, from the first back texture found or generated
+     * @return Image owned by the caller (UnloadImage)
+     */
+    static Image createBackImage();
+
 private:
     // Card properties
     int m_id;                    ///< Unique identifier for matching
@@ -183,8 +284,8 @@ private:
     CardState m_state;           ///< Current card state
     
     // Textures
-    Texture2D m_frontTexture;    ///< Texture when card is face up
-    Texture2D m_backTexture;     ///< Texture when card is face down
+    Texture2D m_frontTexture{};  ///< Texture when card is face up
+    Texture2D m_backTexture{};   ///< Texture when card is face down
     std::string m_texturePath;   ///< Path to the front texture
     
     // Animation properties
@@ -203,12 +304,15 @@ private:
     float m_rotation;            ///< Card rotation angle
     bool m_isHovered;            ///< Whether mouse is over the card
     
+    // State at the start of the last update(), for interpolated drawing
+    Vector2 m_previousPosition{};
+    float m_previousFlip = 0.0f;
+    
     // Static textures (shared by all cards)
     static Texture2D s_defaultBackTexture;
     static bool s_defaultTexturesLoaded;
     
     // Helper methods
-    void loadTextures();
     void unloadTextures();
     void updateAnimation(float deltaTime);
     void drawCardFront() const;
@@ -217,6 +321,9 @@ private:
     void drawHoverEffect() const;
     void drawMatchedEffect() const;
     
+    float currentFlipAmount() const;
+    static Image generateFrontImage(int id, int width, int height);
+    
     // Static methods for managing shared resources
     static void loadDefaultTextures();
     static void unloadDefaultTextures();
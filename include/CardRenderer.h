@@ -0,0 +1,112 @@
+/**
+ * @file CardRenderer.h
+ * @brief Draws the whole board in one instanced call with a GPU card flip
+ *
+ * Card::draw() fakes the flip on the CPU: it narrows the destination
+ * rectangle, picks the front or back texture at the midpoint and prints
+ * the id with DrawText, one texture switch and several draw calls per
+ * card. CardRenderer instead bakes the back and every card face (id
+ * number included) into one atlas and renders all cards as instances of
+ * a single quad. The vertex shader rotates each card about its vertical
+ * axis with perspective, the fragment shader samples the back or the
+ * (mirrored) front depending on which side faces the viewer, and adds the
+ * border and matched outline.
+ *
+ * Per frame the CPU uploads one float for each card whose flip amount
+ * changed; the layout buffer (rectangle, face slot, matched flag) is only
+ * re-sent when a card moves or gets matched. Cards are drawn from
+ * CardSnapshots, so the live Card objects may be busy on another thread.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <map>
+#include <string>
+#include <vector>
+
+struct CardSnapshot;
+
+/**
+ * @brief Instanced renderer for a board of cards
+ *
+ * GPU resources are created on the first draw() and need a window.
+ * Without OpenGL 3.3, draw() returns false and the caller draws the
+ * cards itself with Card::draw().
+ */
+class CardRenderer {
+public:
+    CardRenderer() = default;
+    ~CardRenderer();
+
+    CardRenderer(const CardRenderer&) = delete;
+    CardRenderer& operator=(const CardRenderer&) = delete;
+
+    /**
+     * @brief Sets the front texture the faces are built from (generated faces when missing)
+     */
+    void setFaceTexturePath(const std::string& path) { m_faceTexturePath = path; }
+
+    /**
+     * @brief Draws every card in one instanced call
+     * @param cards The board's cards; must keep the same ids while the renderer lives
+     * @param alpha Interpolation between the last two simulation steps (1 = current)
+     * @return False when instanced drawing is unavailable (nothing was drawn)
+     */
+    bool draw(const std::vector<CardSnapshot>& cards, float alpha = 1.0f);
+
+    /**
+     * @brief Releases the atlas, shader and buffers
+     */
+    void unload();
+
+    /**
+     * @brief Flip values uploaded so far (one float each)
+     */
+    unsigned long long getFlipUploads() const { return m_flipUploads; }
+
+    /**
+     * @brief Times the layout buffer has been re-sent
+     */
+    unsigned long long getLayoutUploads() const { return m_layoutUploads; }
+
+private:
+    /**
+     * @brief Per-card data that changes rarely
+     */
+    struct CardLayout {
+        float x, y, width, height;
+        float faceSlot;      ///< Atlas slot of the front face (the back is slot 0)
+        float matched;       ///< 1 draws the green matched outline
+    };
+
+    bool m_loaded = false;
+    bool m_available = false;
+    std::string m_faceTexturePath;
+
+    Shader m_shader{};
+    int m_mvpLoc = -1;
+    Texture2D m_atlas{};
+    int m_atlasColumns = 1;
+    int m_atlasRows = 1;
+    std::map<int, int> m_faceSlots;  ///< Card id -> atlas slot
+
+    unsigned int m_vao = 0;
+    unsigned int m_cornerVbo = 0;
+    unsigned int m_layoutVbo = 0;
+    unsigned int m_flipVbo = 0;
+
+    std::vector<CardLayout> m_layout; ///< What the GPU currently holds
+    std::vector<float> m_flip;
+    unsigned long long m_flipUploads = 0;
+    unsigned long long m_layoutUploads = 0;
+
+    void load(const std::vector<CardSnapshot>& cards);
+    bool buildAtlas(const std::vector<CardSnapshot>& cards);
+    bool buildBuffers();
+    CardLayout layoutFor(const CardSnapshot& card, float alpha) const;
+};
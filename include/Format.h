@@ -0,0 +1,155 @@
+/**
+ * @file Format.h
+ * @brief Number and clock formatting into fixed-size buffers, without the heap
+ *
+ * Utils::toString() and formatTime() used to build a std::ostringstream
+ * per call, and the HUD called formatTime() every frame. Format writes
+ * the same text straight into a caller's buffer instead:
+ * - integer(): std::to_chars
+ * - decimal(): fixed notation with a given number of decimals, like
+ *   printf("%.*f"). Up to 6 decimals and for magnitudes below 2^53 it
+ *   scales the float to an exact integer (a float times 10^6 fits in a
+ *   double's mantissa) and prints that with integer code; the rounding
+ *   is the same round-half-to-even of the exact value printf does.
+ *   Anything else goes to std::to_chars.
+ * - clock(): MM:SS from a table of the two-digit strings 00..99
+ *
+ * FormatBuffer strings those pieces together on the stack, and ClockText
+ * keeps an MM:SS string that is only rewritten when the whole second
+ * changes. Utils::toString() and formatTime() are thin wrappers over this.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Formatting into caller-provided buffers
+ *
+ * Each function writes at most capacity characters (no terminating NUL)
+ * and returns how many it wrote: 0 when the text would not fit, in which
+ * case nothing useful is in the buffer.
+ */
+class Format {
+public:
+    Format() = delete; // Static class, no constructor
+
+    static std::size_t integer(char* out, std::size_t capacity, long long value);
+    static std::size_t integer(char* out, std::size_t capacity, unsigned long long value);
+
+    /**
+     * @brief value with exactly precision decimals (0 to 9), like printf("%.*f")
+     */
+    static std::size_t decimal(char* out, std::size_t capacity, float value, int precision);
+
+    /**
+     * @brief Whole minutes and seconds as MM:SS (minutes widen past 99); negative times read 00:00
+     */
+    static std::size_t clock(char* out, std::size_t capacity, float seconds);
+
+    static constexpr std::size_t INTEGER_CHARS = 20;    ///< Longest long long, sign included
+    static constexpr std::size_t DECIMAL_CHARS = 64;    ///< Enough for any float with up to 9 decimals
+    static constexpr std::size_t CLOCK_CHARS = 24;      ///< MM:SS up to MAX_CLOCK_SECONDS (14 minute digits)
+    static constexpr int MAX_PRECISION = 9;
+    static constexpr float MAX_CLOCK_SECONDS = 1.0e15f;   ///< Longer times read as this (whole seconds stay exact)
+};
+
+/**
+ * @brief Text built from pieces in a fixed array
+ *
+ * Pieces that do not fit are dropped whole (numbers) or cut (text), and
+ * the buffer remembers it in truncated(). The text is NUL-terminated.
+ */
+template <std::size_t Capacity>
+class FormatBuffer {
+public:
+    FormatBuffer() { clear(); }
+
+    FormatBuffer& clear() {
+        m_size = 0;
+        m_truncated = false;
+        m_data[0] = '\0';
+        return *this;
+    }
+
+    FormatBuffer& append(std::string_view text) {
+        std::size_t count = text.size();
+        if (count > Capacity - m_size) {
+            count = Capacity - m_size;
+            m_truncated = true;
+        }
+        std::memcpy(m_data + m_size, text.data(), count);
+        return grow(count);
+    }
+
+    FormatBuffer& append(const char* text) { return append(std::string_view(text)); }
+    FormatBuffer& append(char c) { return append(std::string_view(&c, 1)); }
+
+    template <typename Integer,
+              typename = std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, bool> &&
+                                          !std::is_same_v<Integer, char>>>
+    FormatBuffer& append(Integer value) {
+        if constexpr (std::is_signed_v<Integer>) {
+            return appendWritten(Format::integer(m_data + m_size, Capacity - m_size, static_cast<long long>(value)));
+        } else {
+            return appendWritten(Format::integer(m_data + m_size, Capacity - m_size, static_cast<unsigned long long>(value)));
+        }
+    }
+
+    FormatBuffer& appendDecimal(float value, int precision) {
+        return appendWritten(Format::decimal(m_data + m_size, Capacity - m_size, value, precision));
+    }
+
+    FormatBuffer& appendClock(float seconds) {
+        return appendWritten(Format::clock(m_data + m_size, Capacity - m_size, seconds));
+    }
+
+    std::string_view view() const { return std::string_view(m_data, m_size); }
+    operator std::string_view() const { return view(); }
+    const char* c_str() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool truncated() const { return m_truncated; }
+
+private:
+    char m_data[Capacity + 1];
+    std::size_t m_size;
+    bool m_truncated;
+
+    FormatBuffer& grow(std::size_t count) {
+        m_size += count;
+        m_data[m_size] = '\0';
+        return *this;
+    }
+
+    FormatBuffer& appendWritten(std::size_t count) {
+        if (count == 0) {
+            m_truncated = true;
+        }
+        return grow(count);
+    }
+};
+
+/**
+ * @brief An MM:SS string rewritten only when the whole second changes
+ */
+class ClockText {
+public:
+    /**
+     * @brief The text for seconds; formats only on a new whole second
+     */
+    std::string_view update(float seconds);
+
+    std::string_view view() const { return m_text.view(); }
+
+private:
+    FormatBuffer<Format::CLOCK_CHARS> m_text;
+    long long m_second = -1;    ///< Whole second of m_text, -1 before the first update
+};
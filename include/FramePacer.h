@@ -0,0 +1,136 @@
+/**
+ * @file FramePacer.h
+ * @brief Frame rate policy (fixed, vsync, uncapped, adaptive) and latency stats
+ *
+ * The main loop used to run at a hardcoded 60 FPS. FramePacer decides the
+ * cap instead and the loop applies it with SetTargetFPS and the vsync
+ * window flag:
+ * - FIXED: capped at a given rate, no vsync (the old behaviour)
+ * - VSYNC: the buffer swap waits for the display
+ * - UNCAPPED: no cap and no vsync, lowest latency, may tear
+ * - ADAPTIVE: capped at the monitor's refresh rate; when frames keep
+ *   taking longer than that allows, the cap drops to half the refresh
+ *   rate (even pacing beats missed frames) and returns once there is
+ *   headroom again
+ *
+ * It also keeps frame time and click-to-flip latency statistics for the
+ * F3 overlay and the exit log.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How the frame rate is chosen
+ */
+enum class PacingMode {
+    FIXED,      ///< Capped at the fixed rate
+    VSYNC,      ///< Synced to the display
+    UNCAPPED,   ///< As fast as possible
+    ADAPTIVE    ///< Monitor refresh rate, halved while frames cannot keep up
+};
+
+/**
+ * @brief Running statistics of a duration, in seconds
+ */
+struct LatencyStats {
+    unsigned long long count = 0;
+    double total = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double last = 0.0;
+
+    void add(double seconds);
+    double average() const { return count > 0 ? total / count : 0.0; }
+};
+
+/**
+ * @brief Picks the frame rate cap and tracks frame timing
+ */
+class FramePacer {
+public:
+    /**
+     * @param mode Pacing mode
+     * @param fixedFps Cap used in FIXED mode, and when the refresh rate is unknown
+     */
+    explicit FramePacer(PacingMode mode = PacingMode::FIXED, int fixedFps = DEFAULT_FPS);
+
+    /**
+     * @brief Parses "fixed", "vsync", "uncapped" or "adaptive"
+     * @return False (mode unchanged) for anything else
+     */
+    static bool parseMode(const std::string& name, PacingMode& mode);
+    static const char* getModeName(PacingMode mode);
+
+    PacingMode getMode() const { return m_mode; }
+    bool wantsVsync() const { return m_mode == PacingMode::VSYNC; }
+
+    /**
+     * @brief Sets the monitor refresh rate (0 = unknown); resets the adaptive cap
+     */
+    void setRefreshRate(int hz);
+    int getRefreshRate() const { return m_refreshRate; }
+
+    /**
+     * @brief The frame rate cap to pass to SetTargetFPS (0 = none)
+     */
+    int getTargetFps() const;
+
+    /**
+     * @brief Records one frame
+     * @param frameTime Whole frame, waiting included (GetFrameTime)
+     * @param workTime Update and draw only, from the start of the frame to before EndDrawing
+     * @return True when the adaptive cap changed
+     */
+    bool frameFinished(float frameTime, float workTime);
+
+    /**
+     * @brief Adds one click-to-flip-visible measurement
+     */
+    void addFlipLatency(double seconds) { m_flipLatency.add(seconds); }
+    const LatencyStats& getFlipLatency() const { return m_flipLatency; }
+
+    /**
+     * @brief Average and worst frame time over the last FRAME_HISTORY frames (seconds)
+     */
+    float getAverageFrameTime() const;
+    float getWorstFrameTime() const;
+
+    /**
+     * @brief Draws mode, frame times and latency in a small panel
+     */
+    void drawOverlay(int x, int y) const;
+
+    /**
+     * @brief Writes the same numbers to the log
+     */
+    void logSummary() const;
+
+    static constexpr int DEFAULT_FPS = 60;
+    static constexpr int MIN_ADAPTIVE_FPS = 30;
+    static constexpr int FRAME_HISTORY = 120;
+    static constexpr float SLOW_WORK_RATIO = 0.9f;    ///< Work above this share of the budget counts as slow
+    static constexpr float FAST_WORK_RATIO = 0.5f;    ///< Work below this share of the full-rate budget is headroom
+    static constexpr int ADAPT_FRAMES = 30;           ///< Consecutive frames before the cap changes
+
+private:
+    PacingMode m_mode;
+    int m_fixedFps;
+    int m_refreshRate;
+    int m_adaptiveFps;
+    int m_slowFrames;
+    int m_fastFrames;
+
+    std::vector<float> m_frameTimes;    ///< Ring buffer of the last frame times
+    std::size_t m_nextFrame;
+    LatencyStats m_flipLatency;
+
+    int fullRateFps() const;
+};
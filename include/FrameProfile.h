@@ -0,0 +1,87 @@
+/**
+ * @file FrameProfile.h
+ * @brief Per-frame timings of a scripted session, and the baseline they are held to
+ *
+ * memory_perf plays the real game through synthetic input and records one
+ * FrameSample per frame: CPU time of Game::update() and of drawing (up to,
+ * not including, EndDrawing's buffer swap), and the allocations made
+ * meanwhile. FrameProfile reduces them to p50/p99/max metrics, which are
+ * compared with a baseline file of "name value" lines. A metric regresses
+ * when it exceeds its baseline by more than the tolerance ratio plus the
+ * metric's own slack; the slack keeps sub-0.1 ms timings from failing on
+ * scheduler noise.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One frame of a session
+ */
+struct FrameSample {
+    float updateMs = 0.0f;
+    float drawMs = 0.0f;
+    std::uint32_t allocations = 0;      ///< operator new calls during update and draw
+    std::uint64_t allocatedBytes = 0;
+};
+
+/**
+ * @brief One named number of a run, e.g. "frame_p99_ms"
+ */
+struct PerfMetric {
+    std::string name;
+    double value = 0.0;
+    double slack = 0.0;     ///< Absolute margin on top of the tolerance ratio
+};
+
+/**
+ * @brief The samples of a run and their summary
+ */
+class FrameProfile {
+public:
+    void reserve(std::size_t frames) { m_samples.reserve(frames); }
+    void add(const FrameSample& sample) { m_samples.push_back(sample); }
+    void clear() { m_samples.clear(); }
+    std::size_t size() const { return m_samples.size(); }
+
+    /**
+     * @brief p50, p99 and max of update, draw and whole-frame time, and of allocations per frame
+     * @return Nothing when there are no samples
+     */
+    std::vector<PerfMetric> summarize() const;
+
+    /**
+     * @brief Nearest-rank percentile; reorders values
+     * @param fraction 0.5 for the median, 1 for the maximum
+     */
+    static double percentile(std::vector<double>& values, double fraction);
+
+    /**
+     * @brief Reads a baseline written by writeBaseline()
+     * @return False if the file cannot be read or a line is not "name value"
+     */
+    static bool readBaseline(const std::string& path, std::vector<PerfMetric>& metrics);
+    static bool writeBaseline(const std::string& path, const std::vector<PerfMetric>& metrics);
+
+    /**
+     * @brief Metrics of run worse than their baseline
+     * @param tolerance Allowed ratio over the baseline, 0.25 for 25%
+     * @return One line per regression, e.g. "frame_p99_ms 4.1 > 3.2 allowed (baseline 2.5)"
+     */
+    static std::vector<std::string> findRegressions(const std::vector<PerfMetric>& baseline,
+                                                    const std::vector<PerfMetric>& run, double tolerance);
+
+    static constexpr double TIME_SLACK_MS = 0.1;
+    static constexpr double ALLOCATION_SLACK = 2.0;
+
+private:
+    std::vector<FrameSample> m_samples;
+};
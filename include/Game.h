@@ -14,12 +14,25 @@
 
 #include <raylib.h>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
 #include "GameBoard.h"
 #include "AudioManager.h"
 #include "ScoreManager.h"
+#include "HudRenderer.h"
+#include "LayoutTree.h"
+#include "Leaderboard.h"
+#include "ParticleSystem.h"
+#include "PersistenceWorker.h"
+#include "Replay.h"
+#include "SavedGame.h"
+#include "SimulationClock.h"
+#include "SimulationThread.h"
+#include "TripleBuffer.h"
+#include "RenderSnapshot.h"
+#include "WidgetLayer.h"
 #include "Utils.h"
 
 /**
@@ -44,6 +57,19 @@ enum class Difficulty {
     HARD = 64       ///< 8x8 grid (64 cards, 32 pairs)
 };
 
+/**
+ * @brief A move this player made on the board, for the multiplayer session to send
+ */
+struct BoardMove {
+    enum class Type {
+        FLIP,       ///< A card was turned up: first is its grid slot
+        MATCH       ///< The pair first and second was matched
+    };
+    Type type = Type::FLIP;
+    int first = -1;
+    int second = -1;
+};
+
 /**
  * @brief Main Game class that manages the entire game
  * 
@@ -101,6 +127,84 @@ public:
      */
     Difficulty getDifficulty() const { return m_difficulty; }
     
+    /**
+     * @brief Whether the current screen changes on its own (timer, card or victory animations)
+     * 
+     * Menus, settings, high scores and the pause screen only change on
+     * input, apart from the background, which freezes while idle.
+     */
+    bool isAnimating() const;
+    
+    /**
+     * @brief Enters or leaves idle mode; the background animation stops while idle
+     */
+    void setIdle(bool idle) { m_idle = idle; }
+    
+    /**
+     * @brief Runs the board logic on a SimulationThread during play
+     * 
+     * The main thread then only samples input and draws the latest
+     * published BoardSnapshot. Set before the first game starts.
+     */
+    void setThreadedSimulation(bool threaded) { m_threadedSimulation = threaded; }
+    
+    /**
+     * @brief Click-to-flip latency of the frame just drawn
+     * 
+     * Call once per frame, after draw() and right before EndDrawing().
+     * When this frame is the first to show a card flipped by a click,
+     * reports the time from IsMouseButtonPressed() seeing that click to
+     * now. Buffer swap and scan-out come on top and are the same in
+     * every mode.
+     * 
+     * @param seconds Receives the latency
+     * @return False when the frame shows no new flip
+     */
+    bool takeFlipLatency(double& seconds);
+    
+    /**
+     * @brief Adapts the game to a new window size
+     * 
+     * Lays the screens out again (nothing happens if the size did not
+     * change), rescales the HUD and moves the cards of a running game to
+     * the same grid slots on the resized board.
+     */
+    void resize(int screenWidth, int screenHeight);
+    
+    /**
+     * @brief Screen pixels per design pixel, for overlays drawn outside the game
+     */
+    float getUiScale() const { return m_layout.getScale(); }
+
+    /**
+     * @brief What is on screen, for a scripted player (memory_perf) to aim its input at
+     *
+     * The buttons are those the last draw() declared. The board is null
+     * outside a game, and owned by the worker with threaded simulation.
+     */
+    const WidgetLayer& getWidgets() const { return m_widgets; }
+    const GameBoard* getBoard() const { return m_gameBoard.get(); }
+
+    /**
+     * @brief Starts (or stops) collecting this player's moves for takeBoardMoves()
+     *
+     * Off by default: a single-player game has nobody to send them to.
+     */
+    void setMoveReporting(bool enabled);
+
+    /**
+     * @brief Appends the moves made since the last call to out, oldest first
+     *
+     * Safe to call while the simulation thread plays.
+     */
+    void takeBoardMoves(std::vector<BoardMove>& out);
+
+    // Shuffle rules, shared with ReplayPlayer, which re-runs recorded games by them
+    static constexpr float OPENING_SHUFFLE_SECONDS = 1.8f;     ///< Every new board starts with a quick shuffle
+    static constexpr float RESHUFFLE_SECONDS = 1.35f;          ///< Reshuffle bought with the R key
+    static constexpr float SHUFFLE_COOLDOWN_SECONDS = 25.0f;
+    static constexpr float SHUFFLE_INITIAL_DELAY_SECONDS = 3.0f;
+    
 private:
     // Screen dimensions
     int m_screenWidth;
@@ -115,20 +219,61 @@ private:
     std::unique_ptr<GameBoard> m_gameBoard;
     std::unique_ptr<AudioManager> m_audioManager;
     std::unique_ptr<ScoreManager> m_scoreManager;
+    Leaderboard m_leaderboard;          ///< Every finished game, loaded once
+    std::size_t m_lastRank;             ///< Place of the game just won among its difficulty
+    Difficulty m_scoresDifficulty;      ///< Tab shown on the high score screen
+    std::vector<LeaderboardEntry> m_scoresTable;    ///< Reused by drawHighScores()
     
     // Game timing
     float m_gameStartTime;
     float m_currentTime;
     float m_pausedTime;
+    SimulationClock m_simulationClock;  ///< Fixed-step clock for board logic
     
     // UI elements
     Font m_titleFont;
     Font m_uiFont;
     Texture2D m_backgroundTexture;
-    
-    // Menu selection
-    int m_selectedMenuItem;
-    int m_selectedDifficulty;
+    HudRenderer m_hud;          ///< Cached in-game HUD layers
+    
+    // Screen layout: described once in design pixels, laid out per window
+    // size and read by both the draw* and the handle*Input methods
+    LayoutTree m_layout{DESIGN_WIDTH, DESIGN_HEIGHT};
+    struct LayoutIds {
+        int frame = -1;             ///< The design area, centred in the window
+        int backHint = -1;          ///< Bottom-left "< ESC" line
+        int menuTitle = -1;
+        int menuButtons = -1;       ///< First of MAIN_MENU_ITEMS + 1
+        int difficultyTitle = -1;
+        int difficultyButtons = -1; ///< First of DIFFICULTY_OPTIONS
+        int pausePanel = -1;
+        int pauseTitle = -1;
+        int pauseLines = -1;        ///< Resume, then main menu
+        int victoryPanel = -1;
+        int victoryTitle = -1;
+        int timeBox = -1;
+        int movesBox = -1;
+        int victoryRank = -1;
+        int restartButton = -1;
+        int menuButton = -1;
+        int settingsTitle = -1;
+        int settingsPanel = -1;
+        int settingsLabel = -1;
+        int soundToggle = -1;
+        int settingsHelp = -1;
+        int scoresTitle = -1;
+        int scoresPanel = -1;
+        int scoresLine = -1;        ///< "No games yet"
+        int scoresTab = -1;
+        int scoresHeader = -1;
+        int scoresRows = -1;        ///< First of SCORES_ROWS
+        int boardArea = -1;         ///< Cards are sized to fit in here
+        int boardBounds = -1;       ///< Cards are placed from its top-left corner
+    } m_ui;
+    
+    // Buttons of the current menu screen, declared by its draw method and
+    // tested against the following frame's input (also tracks focus)
+    WidgetLayer m_widgets;
     
     // Game statistics
     int m_totalMoves;
@@ -138,8 +283,54 @@ private:
     bool m_soundEnabled;
     int m_shufflesUsed;
     float m_shuffleCooldownTimer;
-    static constexpr float SHUFFLE_COOLDOWN_SECONDS = 25.0f;
-    static constexpr float SHUFFLE_INITIAL_DELAY_SECONDS = 3.0f;
+    
+    // Idle mode
+    float m_backgroundTime;     ///< Background animation clock, stopped while idle
+    bool m_idle;
+    
+    // Particle effects
+    ParticleSystem m_backgroundParticles;
+    ParticleSystem m_celebration;
+    float m_fireworkTimer;
+    static constexpr std::size_t BACKGROUND_PARTICLES = 20;
+    static constexpr std::size_t CELEBRATION_CAPACITY = 100000;
+    static constexpr std::size_t CELEBRATION_BURST = 30000;   ///< Launched on victory
+    static constexpr std::size_t FIREWORK_PARTICLES = 6000;   ///< Each follow-up firework
+    static constexpr float FIREWORK_INTERVAL = 0.5f;
+    
+    // Threaded simulation: while the worker runs, it owns the board, the
+    // score, the move and shuffle counters and the replay recording
+    bool m_threadedSimulation;
+    SimulationThread m_simThread;
+    TripleBuffer<BoardSnapshot> m_snapshots;
+    unsigned long long m_appliedInput;      ///< Worker: newest click that flipped a card
+    double m_appliedInputTime;
+    
+    // Click-to-flip latency (main thread)
+    unsigned long long m_inputSequence;     ///< Single-threaded mode's own click counter
+    double m_inputTime;
+    unsigned long long m_drawnInput;        ///< Newest flipping click the last drawn frame shows
+    double m_drawnInputTime;
+    unsigned long long m_presentedInput;
+    
+    // Moves for the multiplayer session, made on whichever thread runs the board
+    std::mutex m_movesMutex;
+    std::vector<BoardMove> m_moves;         ///< Guarded by m_movesMutex
+    bool m_reportMoves;                     ///< Guarded by m_movesMutex
+    int m_openFlipSlot;                     ///< Slot of a card flipped up and waiting for its pair, or -1
+    static constexpr std::size_t RESERVED_MOVES = 16;
+    
+    // Replay of the current game
+    ReplayRecorder m_replay;
+    std::uint32_t m_deckSeed;           ///< Seed the current board was dealt with
+    std::uint64_t m_stepsPlayed;        ///< Simulation steps since the game started
+    PersistenceWorker m_writer;         ///< Saves finished games' replays and games left unfinished
+    static constexpr const char* REPLAY_DIRECTORY = "assets/replays";
+    
+    // Game left unfinished, to continue from the main menu
+    SavedGame m_savedGame;                          ///< Reused for saving and continuing
+    std::vector<unsigned char> m_savedGameBytes;    ///< Newest save, on disk too; empty when there is none
+    static constexpr const char* SAVED_GAME_PATH = "assets/savegame.bin";
     
     // Private methods for different game states
     void updateMainMenu();
@@ -148,6 +339,13 @@ private:
     void updatePaused();
     void updateGameOver();
     void updateSettings();
+    void stepPlaying(float deltaTime);
+    void updatePlayingThreaded();
+    void startSimulationThread();
+    void stopSimulationThread();
+    void applyInput(const InputEvent& event);
+    void reportFlip(int slot, int matchesBefore);
+    void publishSnapshot(unsigned long long step);
     
     void drawMainMenu();
     void drawDifficultySelection();
@@ -160,6 +358,9 @@ private:
     // State transition methods
     void changeState(GameState newState);
     void startNewGame(Difficulty difficulty);
+    void dealBoard(Difficulty difficulty, std::uint32_t seed);
+    void saveUnfinishedGame();
+    bool continueSavedGame();
     void pauseGame();
     void resumeGame();
     void restartGame();
@@ -173,6 +374,11 @@ private:
     void drawTimer();
     void drawGradientBackground();
     void drawEnhancedHUD();
+    HudState buildHudState() const;
+    void launchFirework(Vector2 position, std::size_t count);
+    void buildLayout();
+    Vector2 getCardSize(int gridSize) const;
+    float getBoardPadding() const { return BOARD_PADDING * m_layout.getScale(); }
     
     // Input handling
     void handleMainMenuInput();
@@ -187,16 +393,23 @@ private:
     void loadResources();
     void unloadResources();
     void checkWinCondition();
+    void recordFinishedGame();
     float getElapsedTime() const;
     bool canTriggerShuffle() const;
     void triggerShuffle();
+    void showHint();
     
     // Menu configuration
-    static constexpr int MAIN_MENU_ITEMS = 4;
+    static constexpr int MAIN_MENU_ITEMS = 4;          ///< Continue, when there is a saved game, comes on top
+    static constexpr int CONTINUE_ITEM = MAIN_MENU_ITEMS;
     static constexpr int DIFFICULTY_OPTIONS = 3;
+    static constexpr int SCORES_ROWS = 10;             ///< Games listed per high score tab
     static constexpr float BUTTON_HEIGHT = 60.0f;
     static constexpr float BUTTON_WIDTH = 300.0f;
     static constexpr float BUTTON_SPACING = 20.0f;
+    static constexpr float DESIGN_WIDTH = 1024.0f;     ///< Window size the layout's design pixels were chosen for
+    static constexpr float DESIGN_HEIGHT = 768.0f;
+    static constexpr float BOARD_PADDING = 15.0f;
     
     // Menu item names
     const std::vector<std::string> m_mainMenuItems = {
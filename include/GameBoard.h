@@ -1,7 +1,11 @@
 #pragma once
+#include <cstdint>
+#include <random>
 #include <vector>
 #include <memory>
 #include "Card.h"
+#include "CardRenderer.h"
+#include "RenderSnapshot.h"
 #include "Utils.h"
 
 // Forward declaration
@@ -9,10 +13,18 @@ class AudioManager;
 
 class GameBoard {
 public:
-    GameBoard(int rows, int cols, Vector2 cardSize, float padding, Rectangle screenBounds);
+    // seed: deals the deck and drives every reshuffle, so a seed and the same inputs replay the same game
+    // headless: cards load no textures, for boards that are only simulated (replay checks); never draw one
+    GameBoard(int rows, int cols, Vector2 cardSize, float padding, Rectangle screenBounds, std::uint32_t seed = 0,
+              bool headless = false);
     void update(float deltaTime);
-    void draw() const;
-    void handleClick(Vector2 mousePos);
+    void draw(float alpha = 1.0f) const; // alpha: interpolation between the last two updates
+    void fillSnapshot(BoardSnapshot& snapshot) const;
+    void drawSnapshot(const BoardSnapshot& snapshot, float alpha) const; // safe while another thread updates the board
+    bool handleClick(Vector2 mousePos); // true when the click flipped a card up
+    int slotAt(Vector2 point) const; // grid slot (row * cols + col) whose card area contains point, or -1
+    Vector2 getSlotCenter(int slot) const;
+    void setLayout(Vector2 cardSize, float padding, Rectangle screenBounds); // window resized: cards keep their grid slots
     bool allMatched() const;
     int getMatchesFound() const { return m_matchesFound; }
     int getComboCount() const { return m_comboCount; }
@@ -30,8 +42,43 @@ public:
     void showHint();
     bool canUseHint() const { return m_hintsRemaining > 0 && m_hintCooldown <= 0.0f; }
     int getHintsRemaining() const { return m_hintsRemaining; }
+    int getHintsUsed() const { return MAX_HINTS - m_hintsRemaining; }
     float getHintCooldown() const { return m_hintCooldown; }
 
+    // Everything the board logic runs on, for replay keyframes; restore only into the board it came from
+    struct LogicState {
+        std::vector<Card::LogicState> cards;
+        int firstFlipped = -1; // card indices, -1 for none
+        int secondFlipped = -1;
+        int hintCard1 = -1;
+        int hintCard2 = -1;
+        float flipBackTimer = 0.0f;
+        bool isProcessingMatch = false;
+        int matchesFound = 0;
+        int comboCount = 0;
+        float comboDisplayTime = 0.0f;
+        int hintsRemaining = 0;
+        float hintCooldown = 0.0f;
+        float hintDisplayTime = 0.0f;
+        bool hintAutoFlipBack = false;
+        std::mt19937 rng;
+        std::uint64_t rngDraws = 0; // values drawn from rng since the seed
+        bool isShuffling = false;
+        float shuffleDuration = 0.0f;
+        float shuffleTimer = 0.0f;
+        std::vector<int> shuffleOrder;
+        std::vector<Vector2> shuffleTargets;
+        int nextShuffleStartIndex = 0;
+    };
+    void saveState(LogicState& state) const; // reuses the state's vectors, so saving into the same one does not allocate
+    void restoreState(const LogicState& state);
+
+    // The same with positions in grid units (the slot in row r, column c is at (c, r)), for saved
+    // games: restores into any board dealt from the same seed, whatever its layout. restoreGridState()
+    // rebuilds the rng from the board's seed and rngDraws, so a decoded state need not carry one.
+    void saveGridState(LogicState& state) const;
+    void restoreGridState(LogicState state);
+
 private:
     int m_rows;
     int m_cols;
@@ -39,6 +86,8 @@ private:
     float m_padding;
     Rectangle m_screenBounds;
     std::vector<std::unique_ptr<Card>> m_cards;
+    mutable CardRenderer m_cardRenderer; // GPU-side cache, refreshed by draw()
+    mutable BoardSnapshot m_drawSnapshot; // reused by draw() so the card vector keeps its capacity
     
     Card* m_firstFlippedCard;
     Card* m_secondFlippedCard;
@@ -60,6 +109,13 @@ private:
     float m_hintDisplayTime;
     bool m_hintAutoFlipBack;
     
+    std::mt19937 m_rng; // seeded per board; the only randomness the board uses
+    std::uint32_t m_seed;
+    std::uint64_t m_rngDraws = 0; // values drawn from m_rng, all through nextRandom()
+    bool m_headless;
+    bool m_cardsSettled = false; // every card settled as of the last update(); anything that changes a card clears it
+    
+    static constexpr const char* CARD_TEXTURE_PATH = "assets/textures/card.png";
     static constexpr float FLIP_BACK_DELAY = 1.0f;
     static constexpr int MAX_HINTS = 3;
     static constexpr float HINT_COOLDOWN = 15.0f; // seconds
@@ -70,6 +126,11 @@ private:
     void checkMatch();
     void resetFlippedCards();
     void findHintPair();
+    int indexOf(const Card* card) const;
+    Card* cardAt(int index) const;
+    std::uint32_t nextRandom();
+    Vector2 toGrid(Vector2 position) const;
+    Vector2 fromGrid(Vector2 cell) const;
     
     // Shuffle animation state
     bool m_isShuffling = false;
@@ -78,6 +139,7 @@ private:
     // Movement-based shuffle scheduling
     std::vector<int> m_shuffleOrder; // final order: for each slot index, which original card index will land there
     std::vector<Vector2> m_shuffleTargets; // target positions per original card index
+    std::vector<Vector2> m_shufflePositions; // scratch for startShuffle: the movable cards' slots
     int m_nextShuffleStartIndex = 0; // next index in m_shuffleOrder to begin moving
     float m_shuffleStartInterval = 0.02f; // stagger between starting each card move
     float m_shuffleMoveDuration = 0.45f; // duration for each card move
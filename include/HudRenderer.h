@@ -0,0 +1,119 @@
+/**
+ * @file HudRenderer.h
+ * @brief Layered, cached rendering of the in-game HUD
+ *
+ * The HUD used to redraw a dozen rounded panels and rebuild its strings
+ * every frame although almost nothing in it changes between clicks. It is
+ * now split into two render-texture layers: the chrome (bar, panels,
+ * labels) is baked once, and the text layer is rebaked only when one of
+ * the values in HudState changes, which is at most once per second from
+ * the timer plus once per click. A frame then costs two textured quads.
+ * The animated combo banner is the only part still drawn every frame.
+ *
+ * Positions are in the 1024x768 design pixels of the rest of the UI and
+ * scaled by setScale() to the window, edges staying on the window edges.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include "Format.h"
+
+/**
+ * @brief Every value the HUD displays, reduced to what changes its pixels
+ */
+struct HudState {
+    int moves = 0;
+    int matches = 0;
+    int totalPairs = 0;
+    int score = 0;
+    int elapsedSeconds = 0;
+    bool hasBoard = false;
+    int hintsRemaining = 0;
+    bool canUseHint = false;
+    int hintCooldownSeconds = 0;
+    bool canShuffle = false;
+    int shuffleCooldownSeconds = 0;
+    int shufflesUsed = 0;
+
+    bool operator==(const HudState& other) const;
+    bool operator!=(const HudState& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Draws the HUD from cached layers
+ *
+ * Must be used (and unloaded) while the window exists. Without render
+ * texture support it falls back to drawing the layers directly.
+ */
+class HudRenderer {
+public:
+    HudRenderer() = default;
+    ~HudRenderer();
+
+    HudRenderer(const HudRenderer&) = delete;
+    HudRenderer& operator=(const HudRenderer&) = delete;
+
+    /**
+     * @brief Draws chrome and text, rebaking only what is out of date
+     */
+    void draw(const HudState& state, int screenWidth, int screenHeight);
+
+    /**
+     * @brief Draws the animated combo banner (not cached, it changes every frame)
+     */
+    void drawCombo(int comboCount, float comboTimer, int screenWidth);
+
+    /**
+     * @brief Screen pixels per design pixel (LayoutTree::getScale()); rebakes when it changes
+     */
+    void setScale(float scale);
+
+    /**
+     * @brief Forces both layers to be rebaked on the next draw
+     */
+    void invalidate();
+
+    /**
+     * @brief Releases the render textures
+     */
+    void unload();
+
+    /**
+     * @brief How many times the text layer has been rebuilt (formatting its strings)
+     */
+    unsigned long long getTextRebuilds() const { return m_textRebuilds; }
+
+private:
+    RenderTexture2D m_chrome{};
+    RenderTexture2D m_text{};
+    int m_width = 0;
+    int m_height = 0;
+    float m_scale = 1.0f;
+    bool m_useTextures = false;
+    bool m_chromeValid = false;
+    bool m_textValid = false;
+    HudState m_lastState;
+    unsigned long long m_textRebuilds = 0;
+
+    ClockText m_clock;                  ///< The timer, reformatted once a second
+
+    // Combo banner strings, rebuilt when the multiplier changes
+    int m_comboMultiplier = 0;
+    FormatBuffer<32> m_comboText;
+    FormatBuffer<32> m_comboHint;
+    static constexpr int COMBO_FONT_SIZE = 32;     ///< Laid out at this size only, the pulse is a scale
+
+    void ensureTargets(int width, int height);
+    void drawChrome() const;
+    void drawText(const HudState& state);
+    void beginScaled(int& width, int& height) const;
+    static void endScaled();
+    static void beginBake(const RenderTexture2D& target);
+    static void endBake();
+    static void drawLayer(const RenderTexture2D& layer);
+};
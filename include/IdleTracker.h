@@ -0,0 +1,57 @@
+/**
+ * @file IdleTracker.h
+ * @brief Detects when nothing on screen can change, so the loop can idle
+ *
+ * The main loop reports every frame whether anything happened: input, a
+ * running animation or network traffic. After IDLE_DELAY seconds of
+ * quiet the tracker reports idle; the loop then drops to IDLE_FPS and
+ * re-presents the last frame instead of redrawing the scene. The first
+ * active frame wakes it up again.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+/**
+ * @brief Quiet-time counter deciding between the active and the idle frame rate
+ */
+class IdleTracker {
+public:
+    /**
+     * @param idleDelay Seconds without activity before going idle
+     */
+    explicit IdleTracker(float idleDelay = IDLE_DELAY);
+
+    /**
+     * @brief Advances by one frame
+     * @param deltaTime Frame time in seconds
+     * @param active Whether input, animation or network activity happened this frame
+     */
+    void update(float deltaTime, bool active);
+
+    /**
+     * @brief Whether the scene has been still for long enough to stop redrawing it
+     */
+    bool isIdle() const { return m_quietTime >= m_idleDelay; }
+
+    /**
+     * @brief Frame rate the loop should run at right now
+     */
+    int getTargetFps(int activeFps) const { return isIdle() ? IDLE_FPS : activeFps; }
+
+    /**
+     * @brief Frames presented from the cache since the tracker was created
+     */
+    unsigned long long getIdleFrames() const { return m_idleFrames; }
+
+    static constexpr float IDLE_DELAY = 3.0f; // seconds of quiet before idling
+    static constexpr int IDLE_FPS = 10;       // still polls input and network at this rate
+
+private:
+    float m_idleDelay;
+    float m_quietTime;
+    unsigned long long m_idleFrames;
+};
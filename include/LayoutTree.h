@@ -0,0 +1,113 @@
+/**
+ * @file LayoutTree.h
+ * @brief Retained, resolution-independent UI layout
+ *
+ * Screens are described once as a tree of nodes in design pixels (the
+ * 1024x768 the game was drawn for): each node hangs from a point of its
+ * parent, or of the window, and may stretch with it. resize() turns the
+ * tree into screen rectangles, scaling design pixels uniformly so that
+ * the design area fits the window, and does so only when the window size
+ * changes. Drawing and hit-testing read the same rectangles, so a button
+ * is clickable exactly where it is drawn, at any resolution.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <vector>
+
+/**
+ * @brief One rectangle of the layout, in design pixels
+ *
+ * Its screen rectangle is sized size * scale + stretch * parent size and
+ * placed so that its pivot point sits on the parent's anchor point,
+ * moved by offset * scale. Anchor and pivot are fractions: (0, 0) is the
+ * top-left corner, (0.5, 0.5) the centre, (1, 1) the bottom-right.
+ */
+struct LayoutNode {
+    static constexpr int WINDOW = -1;
+
+    int parent = WINDOW;            ///< Node id, or WINDOW
+    Vector2 anchor{0.0f, 0.0f};
+    Vector2 pivot{0.0f, 0.0f};
+    Vector2 offset{0.0f, 0.0f};
+    Vector2 size{0.0f, 0.0f};
+    Vector2 stretch{0.0f, 0.0f};    ///< Share of the parent's size added to size (1 fills it)
+};
+
+/**
+ * @brief Layout nodes and their screen rectangles for the current window size
+ */
+class LayoutTree {
+public:
+    /**
+     * @param designWidth Width the design pixels were chosen for
+     * @param designHeight Height the design pixels were chosen for
+     */
+    LayoutTree(float designWidth, float designHeight);
+
+    /**
+     * @brief Adds a node; its parent must already be in the tree
+     * @return Node id for get()
+     */
+    int add(const LayoutNode& node);
+
+    /**
+     * @brief Adds count nodes like node, each one step further down (or right, if step.x is set)
+     * @return Id of the first; the others follow it
+     */
+    int addStack(const LayoutNode& node, int count, Vector2 step);
+
+    /**
+     * @brief Lays the tree out for a window size
+     * @return True when the size changed and the rectangles were recomputed
+     */
+    bool resize(int width, int height);
+
+    /**
+     * @brief Screen rectangle of a node (empty for an unknown id)
+     */
+    Rectangle get(int id) const;
+
+    /**
+     * @brief Centre of a node's screen rectangle
+     */
+    Vector2 getCenter(int id) const;
+
+    /**
+     * @brief First of count consecutive nodes that contains point
+     * @return Index within the range, or -1
+     */
+    int hitTest(Vector2 point, int first, int count) const;
+
+    /**
+     * @brief Screen pixels per design pixel
+     */
+    float getScale() const { return m_scale; }
+
+    /**
+     * @brief A design length in whole screen pixels (at least 1 for positive lengths)
+     */
+    int pixels(float designPixels) const;
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    int getNodeCount() const { return static_cast<int>(m_nodes.size()); }
+    unsigned long long getLayoutPasses() const { return m_layoutPasses; }
+
+private:
+    float m_designWidth;
+    float m_designHeight;
+    int m_width = 0;
+    int m_height = 0;
+    float m_scale = 1.0f;
+    std::vector<LayoutNode> m_nodes;
+    std::vector<Rectangle> m_rects;     ///< Parallel to m_nodes
+    unsigned long long m_layoutPasses = 0;
+
+    Rectangle computeNode(const LayoutNode& node) const;
+};
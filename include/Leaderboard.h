@@ -0,0 +1,181 @@
+/**
+ * @file Leaderboard.h
+ * @brief Every finished game, stored in an append-only log and ranked per difficulty
+ *
+ * Each won game becomes one fixed-size, checksummed record appended to a
+ * binary log (assets/leaderboard.bin); nothing already written is ever
+ * rewritten. The append and its fsync run on a PersistenceWorker, so
+ * recording a game never waits for the disk. On load the log is read
+ * front to back and a torn record at the end, left by a crash mid-write,
+ * is cut off.
+ *
+ * After a clean load the verified log is copied, atomically, to
+ * leaderboard.bin.bak. If the log later turns out damaged (or gone) and
+ * that last good copy holds more games, the copy is loaded and put back
+ * in the log's place.
+ *
+ * In memory every difficulty has its own ranking: an order-statistic
+ * treap over the records, best first (higher score, then faster, then
+ * fewer moves, then earlier). Inserting a game and asking where a score
+ * ranks are O(log n), and the top K come out in O(log n + K), so the
+ * history can grow to millions of games without the game-over and high
+ * score screens slowing down.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "PersistenceWorker.h"
+
+/**
+ * @brief One finished game
+ */
+struct LeaderboardEntry {
+    std::uint64_t sequence = 0;     ///< Order of recording, assigned by the leaderboard
+    std::int64_t timestamp = 0;     ///< Unix time the game finished
+    std::int32_t difficulty = 0;    ///< Number of cards (16, 36, 64)
+    std::int32_t score = 0;
+    std::uint32_t milliseconds = 0; ///< Time to finish
+    std::int32_t moves = 0;
+    std::int32_t hintsUsed = 0;
+    std::int32_t shufflesUsed = 0;
+};
+
+/**
+ * @brief Ranking of one difficulty's games, as indices into the leaderboard's records
+ */
+class LeaderboardIndex {
+public:
+    /**
+     * @brief Adds records[entry]; O(log n) expected
+     */
+    void insert(std::uint32_t entry, const std::vector<LeaderboardEntry>& records);
+
+    /**
+     * @brief How many indexed games rank ahead of probe; O(log n) expected
+     */
+    std::size_t countAhead(const LeaderboardEntry& probe, const std::vector<LeaderboardEntry>& records) const;
+
+    /**
+     * @brief Appends the best k games to out, best first
+     */
+    void top(std::size_t k, const std::vector<LeaderboardEntry>& records, std::vector<LeaderboardEntry>& out) const;
+
+    std::size_t size() const { return m_nodes.size(); }
+
+    /**
+     * @brief Whether a ranks ahead of b
+     */
+    static bool ahead(const LeaderboardEntry& a, const LeaderboardEntry& b);
+
+private:
+    static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Node {
+        std::uint32_t entry;
+        std::uint32_t priority;
+        std::uint32_t size;         ///< Nodes in this subtree
+        std::uint32_t left = NIL;   ///< Better games
+        std::uint32_t right = NIL;  ///< Worse games
+    };
+
+    std::vector<Node> m_nodes;      ///< Pool; links are indices into it
+    std::uint32_t m_root = NIL;
+    std::uint32_t m_seed = 0x9E3779B9u;
+    mutable std::vector<std::uint32_t> m_walk;  ///< top()'s stack, kept to reuse its storage
+
+    std::uint32_t sizeOf(std::uint32_t node) const { return node == NIL ? 0 : m_nodes[node].size; }
+    void refresh(std::uint32_t node);
+    std::uint32_t insertAt(std::uint32_t node, std::uint32_t fresh, const std::vector<LeaderboardEntry>& records);
+    void split(std::uint32_t node, const LeaderboardEntry& key, const std::vector<LeaderboardEntry>& records,
+               std::uint32_t& better, std::uint32_t& rest);
+};
+
+/**
+ * @brief The leaderboard log and its per-difficulty rankings
+ */
+class Leaderboard {
+public:
+    /**
+     * @param path The log; empty keeps the leaderboard in memory only
+     */
+    explicit Leaderboard(std::string path = DEFAULT_PATH);
+
+    /**
+     * @brief Reads the log, replacing whatever is in memory
+     *
+     * Waits for pending writes first. A missing log is an empty
+     * leaderboard. A torn record at the end is cut off the file. A file
+     * that is not a leaderboard log is left alone and nothing will be
+     * appended to it - unless a last good copy exists, in which case that
+     * copy replaces it.
+     *
+     * @return False when the log exists but could not be used
+     */
+    bool load();
+
+    /**
+     * @brief Records a finished game: ranks it and queues its append to the log
+     * @param entry The game; its sequence number is assigned here
+     * @return The recorded entry; it stays ranked in memory even if the append fails
+     */
+    const LeaderboardEntry& record(LeaderboardEntry entry);
+
+    /**
+     * @brief Waits until every recorded game is on disk
+     */
+    void flush() { m_writer.flush(); }
+
+    std::size_t getWriteFailures() const { return m_writer.getFailures(); }
+
+    /**
+     * @brief The best k games of a difficulty, best first (out is cleared first)
+     */
+    void top(std::int32_t difficulty, std::size_t k, std::vector<LeaderboardEntry>& out) const;
+
+    /**
+     * @brief 0-based place entry has (or would have) among its difficulty's games
+     */
+    std::size_t rankOf(const LeaderboardEntry& entry) const;
+
+    std::size_t count(std::int32_t difficulty) const;
+    std::size_t size() const { return m_records.size(); }
+    bool isWritable() const { return m_writable; }
+    const std::string& getPath() const { return m_path; }
+    std::string getBackupPath() const { return m_path + ".bak"; }
+
+    /**
+     * @brief Encodes one record as it is stored in the log (RECORD_SIZE bytes, little-endian)
+     */
+    static void encode(const LeaderboardEntry& entry, unsigned char* bytes);
+
+    /**
+     * @brief Decodes a stored record
+     * @return False if its checksum does not match
+     */
+    static bool decode(const unsigned char* bytes, LeaderboardEntry& entry);
+
+    static constexpr const char* DEFAULT_PATH = "assets/leaderboard.bin";
+    static constexpr std::size_t HEADER_SIZE = 8;       ///< "MCLB" + format version
+    static constexpr std::size_t RECORD_SIZE = 44;      ///< Fields + 32-bit checksum
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+private:
+    std::string m_path;
+    std::vector<LeaderboardEntry> m_records;            ///< In log order
+    std::map<std::int32_t, LeaderboardIndex> m_indexes; ///< By difficulty
+    std::uint64_t m_durableBytes = 0;                   ///< Log length; the writer's jobs own it between loads
+    bool m_writable = true;
+    PersistenceWorker m_writer;                         ///< Last, so pending appends finish before the rest goes
+
+    void index(std::uint32_t entry);
+};
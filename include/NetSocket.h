@@ -0,0 +1,65 @@
+/**
+ * @file NetSocket.h
+ * @brief Portable socket definitions and small helpers shared by the
+ *        networking code
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+
+// Platform-specific socket includes
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+    typedef int socklen_t;
+    #define SOCKET_ERROR_CODE WSAGetLastError()
+    #define CLOSE_SOCKET closesocket
+    #define SHUTDOWN_SOCKET(s) shutdown(s, SD_BOTH)
+#else
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <cerrno>
+    typedef int SOCKET;
+    #define INVALID_SOCKET -1
+    #define SOCKET_ERROR -1
+    #define SOCKET_ERROR_CODE errno
+    #define CLOSE_SOCKET ::close
+    #define SHUTDOWN_SOCKET(s) shutdown(s, SHUT_RDWR)
+#endif
+
+/**
+ * @brief A read-only view of bytes to be written as part of a gather write
+ */
+struct ConstBuffer {
+    const char* data;
+    size_t size;
+};
+
+/**
+ * @brief Switches a socket to non-blocking mode
+ */
+void setSocketNonBlocking(SOCKET sock);
+
+/**
+ * @brief Checks whether the last socket error only means "try again later"
+ */
+bool socketWouldBlock();
+
+/**
+ * @brief Writes several buffers with a single system call (writev/WSASend)
+ * @param sock Destination socket
+ * @param buffers Buffers to write, in order
+ * @param count Number of buffers
+ * @return Bytes written, 0 if the socket would block, -1 on error
+ */
+long sendBuffers(SOCKET sock, const ConstBuffer* buffers, int count);
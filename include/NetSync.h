@@ -0,0 +1,182 @@
+/**
+ * @file NetSync.h
+ * @brief Change-driven state synchronisation for networked games
+ *
+ * NetSync turns game state changes (turns, flips, matches, scores) into
+ * newline-delimited protocol messages, batches everything produced during
+ * one network tick into a single write and only falls back to a full
+ * STATE snapshot as a low-rate heartbeat when the game is idle.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Traffic counters for one network session
+ *
+ * Totals grow for the lifetime of the session, the per-second values are
+ * recomputed once per STATS_WINDOW from the traffic seen in that window.
+ */
+struct NetStats {
+    unsigned long long bytesSent = 0;       ///< Total bytes written to the socket
+    unsigned long long bytesReceived = 0;   ///< Total bytes read from the socket
+    unsigned long long messagesSent = 0;    ///< Total protocol messages sent
+    unsigned long long messagesReceived = 0;///< Total protocol messages received
+    float bytesSentPerSecond = 0.0f;        ///< Outgoing bandwidth over the last window
+    float bytesReceivedPerSecond = 0.0f;    ///< Incoming bandwidth over the last window
+    float messagesSentPerSecond = 0.0f;     ///< Outgoing message rate over the last window
+    float messagesReceivedPerSecond = 0.0f; ///< Incoming message rate over the last window
+};
+
+/**
+ * @brief Encoder/decoder for the line-based multiplayer protocol
+ *
+ * Outgoing: callers report state through setTurn()/setScore(), and a
+ * TURN or SCORE line goes out when one differs from what the peer last
+ * saw. Board moves are events, queued as they happen through
+ * queueFlip()/queueMatch(); anything else (END) through queueMessage().
+ * flush() is called once per network tick and returns everything that
+ * changed since the last tick as one buffer, or nothing at all when the
+ * game is quiet.
+ *
+ * Incoming: feed() accepts raw socket bytes, which may contain several
+ * messages or only part of one, and returns complete lines.
+ */
+class NetSync {
+public:
+    NetSync();
+
+    /**
+     * @brief Clears all pending output, framing and statistics
+     */
+    void reset();
+
+    // === OUTGOING STATE ===
+    void setTurn(int turn);
+    void setScore(int player, int score);
+
+    /**
+     * @brief Records state received from the peer so it is not echoed back
+     */
+    void noteRemoteTurn(int turn);
+    void noteRemoteScore(int player, int score);
+
+    // === OUTGOING EVENTS ===
+    void queueFlip(int slot);
+    void queueMatch(int slot1, int slot2);
+    void queueMessage(const std::string& message);
+
+    /**
+     * @brief Forces a full STATE snapshot into the next flush
+     */
+    void requestSnapshot();
+
+    /**
+     * @brief Enables or disables idle STATE heartbeats (read-only peers send none)
+     */
+    void setHeartbeatEnabled(bool enabled) { m_heartbeatEnabled = enabled; }
+
+    /**
+     * @brief Collects everything pending into a single outgoing buffer
+     * @param deltaTime Time elapsed since the previous tick
+     * @param out Receives the batch (cleared first)
+     * @return True if there is something to send this tick
+     */
+    bool flush(float deltaTime, std::string& out);
+
+    /**
+     * @brief Appends a full STATE snapshot of the current values
+     */
+    void appendSnapshot(std::string& out) const;
+
+    // === INCOMING ===
+    /**
+     * @brief Splits received bytes into complete protocol lines
+     * @param data Raw bytes read from the socket
+     * @param size Number of bytes
+     * @param lines Receives every complete line (without the newline)
+     */
+    void feed(const char* data, size_t size, std::vector<std::string>& lines);
+
+    // === SESSION RESUME ===
+    /**
+     * @brief Number of lines flushed so far (the sequence number of the last one)
+     */
+    unsigned int getSentSeq() const { return m_sentSeq; }
+
+    /**
+     * @brief Number of game lines received from the peer so far
+     */
+    unsigned int getReceivedSeq() const { return m_receivedSeq; }
+    void markReceived() { ++m_receivedSeq; }
+    void setReceivedSeq(unsigned int seq) { m_receivedSeq = seq; }
+
+    /**
+     * @brief Appends every flushed line with a sequence number above afterSeq
+     * @return False if some of those lines already fell out of the history
+     */
+    bool appendReplay(unsigned int afterSeq, std::string& out) const;
+
+    /**
+     * @brief Starts numbering from zero again (new opponent)
+     */
+    void resetSequence();
+
+    /**
+     * @brief Keeps only the lines flushed after afterSeq, renumbered from 1
+     *
+     * Used when a resume is refused and a fresh session starts: lines the
+     * old opponent already had are dropped, newer ones are still delivered.
+     */
+    void restartSequenceAfter(unsigned int afterSeq);
+
+    /**
+     * @brief Drops a partial line left over from a connection that died
+     */
+    void resetFraming() { m_recvBuffer.clear(); }
+
+    // === STATISTICS ===
+    void recordSent(size_t bytes, int messages);
+    void recordReceived(size_t bytes, int messages);
+    void updateStats(float deltaTime);
+    const NetStats& getStats() const { return m_stats; }
+
+    static constexpr float HEARTBEAT_INTERVAL = 2.0f; // seconds of silence before a STATE heartbeat
+    static constexpr float STATS_WINDOW = 1.0f;       // seconds per rate sample
+    static constexpr size_t RESUME_HISTORY = 512;     // flushed lines kept for replay after a reconnect
+
+private:
+    // Values as last announced to (or received from) the peer
+    int m_turn;
+    int m_scores[2];
+    int m_sentTurn;
+    int m_sentScores[2];
+
+    std::string m_events;       ///< Flip/match/raw messages queued this tick
+    bool m_snapshotRequested;
+    bool m_heartbeatEnabled;
+    float m_idleTimer;          ///< Time since anything was last sent
+
+    std::string m_recvBuffer;   ///< Partial line carried over between reads
+
+    unsigned int m_sentSeq;     ///< Lines flushed so far
+    unsigned int m_receivedSeq; ///< Game lines received so far
+    std::deque<std::string> m_history; ///< Most recent flushed lines, the last one is m_sentSeq
+
+    NetStats m_stats;
+    float m_statsTimer;
+    unsigned long long m_windowBytesSent;
+    unsigned long long m_windowBytesReceived;
+    unsigned long long m_windowMessagesSent;
+    unsigned long long m_windowMessagesReceived;
+
+    static void appendInt(std::string& out, int value);
+};
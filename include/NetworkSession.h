@@ -0,0 +1,251 @@
+/**
+ * @file NetworkSession.h
+ * @brief Two-player multiplayer session (host, join or spectate)
+ *
+ * The session owns the connection to the opponent, the turn/score state
+ * shared with them and, when hosting, the listening socket and spectators.
+ * All traffic goes through a Transport, so a session can be driven over TCP
+ * by the game or over a NetworkSimulator link by tests and benchmarks.
+ *
+ * Clients reconnect on their own: a connect attempt that does not complete
+ * within CONNECT_TIMEOUT, or a connection that drops, is retried with
+ * exponential backoff. The server hands out a resume token in its WELCOME
+ * message; a client that comes back with it gets the lines it missed
+ * replayed (both directions) followed by a fresh STATE snapshot, so a
+ * dropped connection no longer ends the match.
+ *
+ * Servers accept players over TCP and UDP on the same port number. A
+ * client started with preferUdp tries UDP first and falls back to TCP for
+ * every later attempt if the server never answers. Cursor presence goes
+ * over the transport's unreliable channel when it has one and as a
+ * PRESENCE line in the stream otherwise.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "NetSocket.h"
+#include "NetSync.h"
+#include "SpectatorHub.h"
+#include "Transport.h"
+#include "UdpTransport.h"
+
+/**
+ * @brief Role of this instance in a multiplayer game
+ */
+enum class NetworkMode {
+    NONE,
+    SERVER,
+    CLIENT,
+    SPECTATOR   // Read-only client watching a hosted game
+};
+
+/**
+ * @brief Progress of a client's connection to the server
+ */
+enum class ConnectionState {
+    OFFLINE,          // Not a client, or stopped
+    CONNECTING,       // Waiting for the transport to come up
+    CONNECTED,
+    WAITING_TO_RETRY, // Backing off before the next attempt
+    FAILED            // Gave up after MAX_CONNECT_ATTEMPTS
+};
+
+/**
+ * @brief Creates a new connection attempt to the server (nullptr on immediate failure)
+ */
+using TransportFactory = std::function<std::unique_ptr<Transport>()>;
+
+/**
+ * @brief State and protocol handling for one multiplayer game
+ */
+class NetworkSession {
+public:
+    NetworkSession() = default;
+    ~NetworkSession();
+
+    NetworkSession(const NetworkSession&) = delete;
+    NetworkSession& operator=(const NetworkSession&) = delete;
+
+    // === SESSION CONTROL ===
+
+    /**
+     * @brief Hosts a game on a TCP port (and the same UDP port); the session becomes player 0
+     * @return true if the server is listening
+     */
+    bool startServer(unsigned short port);
+
+    /**
+     * @brief Joins (or watches) a game hosted at ip:port
+     * @param preferUdp Players try UDP first and fall back to TCP; spectators always use TCP
+     * @return true if the connection attempt was started
+     */
+    bool startClient(const std::string& ip, unsigned short port, bool spectate = false, bool preferUdp = false);
+
+    /**
+     * @brief Joins (or watches) a game through any kind of transport
+     * @param mode CLIENT or SPECTATOR
+     * @param factory Called for the first attempt and for every reconnect
+     */
+    bool startClient(NetworkMode mode, TransportFactory factory);
+
+    /**
+     * @brief Runs the session over an already created transport
+     * @param mode SERVER, CLIENT or SPECTATOR; a SERVER treats the transport as its opponent
+     * @param transport Connection to the other side (e.g. a NetworkSimulator endpoint);
+     *                  a SERVER may pass nullptr and wait for acceptTransport()
+     *
+     * A client attached this way cannot reconnect, there is nothing to reconnect with.
+     */
+    void attach(NetworkMode mode, std::unique_ptr<Transport> transport);
+
+    /**
+     * @brief Server only: hands over an incoming connection, classified like an accepted socket
+     */
+    void acceptTransport(std::unique_ptr<Transport> transport);
+
+    /**
+     * @brief Closes every connection and returns to single player
+     */
+    void stop();
+
+    /**
+     * @brief One network tick: accept, receive, apply, then send everything that changed
+     */
+    void update(float deltaTime);
+
+    // === GAMEPLAY ===
+    void sendMessage(const std::string& message);
+
+    /**
+     * @brief Sends this player's board moves (grid slots), batched with the tick's other output
+     */
+    void sendFlip(int slot);
+    void sendMatch(int slot1, int slot2);
+    void nextTurn();
+    bool isMyTurn() const;
+    void updateScore(int player, int delta);
+
+    /**
+     * @brief Sets this player's cursor position, sent to the opponent at most every PRESENCE_INTERVAL
+     */
+    void setPresence(int x, int y);
+
+    /**
+     * @brief The opponent's latest cursor position
+     * @return false if none has been received
+     */
+    bool getRemotePresence(int& x, int& y) const;
+
+    /**
+     * @brief Moves the opponent's FLIP/MATCH/END messages received so far into out
+     */
+    void takeRemoteEvents(std::vector<std::string>& out);
+
+    /**
+     * @brief Writes the current turn and scores as a single STATE message (no terminator)
+     */
+    void serializeState(std::string& output) const;
+
+    /**
+     * @brief Applies one protocol message as if it had been received
+     */
+    void deserializeState(const std::string& input);
+
+    // === GETTERS ===
+    NetworkMode getMode() const { return m_mode; }
+    bool isConnected() const { return m_connected; }
+    bool isHandshakeComplete() const { return m_connected && !m_awaitingWelcome; }
+    const std::string& getRemoteIP() const { return m_remoteIP; }
+    unsigned short getPort() const { return m_port; }
+    int getMyPlayerID() const { return m_myPlayerID; }
+    int getCurrentTurn() const { return m_currentTurn; }
+    int getPlayerScore(int player) const;
+    size_t getSpectatorCount() const { return m_spectators.getSpectatorCount(); }
+    const NetStats& getStats() const { return m_sync.getStats(); }
+    ConnectionState getConnectionState() const { return m_connectionState; }
+    int getConnectAttempts() const { return m_connectAttempts; }
+    float getRetryDelay() const { return m_retryDelay; }
+    float getRetryRemaining() const { return m_retryDelay - m_stateTimer; }
+    int getResumeCount() const { return m_resumeCount; }
+
+    /**
+     * @brief Whether anything visible happened since the last call (messages, connection changes)
+     */
+    bool takeActivity();
+    const char* getTransportName() const { return m_transport ? m_transport->getName() : ""; }
+
+    static constexpr float CONNECT_TIMEOUT = 5.0f;     // seconds before a connect attempt is abandoned
+    static constexpr float INITIAL_RETRY_DELAY = 0.5f; // first backoff, doubled after every failure
+    static constexpr float MAX_RETRY_DELAY = 8.0f;     // backoff ceiling
+    static constexpr int MAX_CONNECT_ATTEMPTS = 10;    // consecutive failures before giving up
+    static constexpr float PRESENCE_INTERVAL = 0.05f;  // seconds between cursor updates
+
+private:
+    // A connection the server accepted but has not classified yet
+    struct PendingConnection {
+        std::unique_ptr<Transport> transport;
+        float age = 0.0f;
+        std::string received;
+    };
+
+    NetworkMode m_mode = NetworkMode::NONE;
+    std::unique_ptr<Transport> m_transport;  // Connection to the opponent (or host)
+    TransportFactory m_factory;              // Client only: opens reconnect attempts
+    ConnectionState m_connectionState = ConnectionState::OFFLINE;
+    float m_stateTimer = 0.0f;               // Time spent in the current connection state
+    float m_retryDelay = 0.0f;
+    int m_connectAttempts = 0;               // Consecutive failed attempts
+    std::string m_sessionToken;              // Resume token issued by the server
+    unsigned int m_helloSeq = 0;             // Client: lines flushed before the current HELLO
+    bool m_awaitingWelcome = false;          // Client: output is held until the server answers
+    int m_resumeCount = 0;
+    SOCKET m_serverSocket = INVALID_SOCKET;
+    UdpListener m_udpListener;               // Server only: players connecting over UDP
+    bool m_socketsInitialized = false;
+    bool m_connected = false;
+    std::vector<std::string> m_incomingMessages;
+    std::vector<std::string> m_remoteEvents;
+    NetSync m_sync;                // Change tracking, batching and traffic stats
+    std::string m_sendBuffer;      // Bytes the transport has not accepted yet
+    SpectatorHub m_spectators;     // Server only: read-only viewers of this room
+    std::vector<PendingConnection> m_pending;  // Server only: awaiting HELLO
+    std::string m_spectatorBatch;  // Server only: this tick's updates for viewers
+    std::string m_remoteIP = "127.0.0.1";
+    unsigned short m_port = 0;
+    int m_myPlayerID = 0;  // 0 = server, 1 = client, -1 = spectator
+    int m_currentTurn = 0; // Whose turn it is
+    int m_playerScores[2] = {0, 0};
+    bool m_isMyTurn = true;
+    int m_localPresence[2] = {0, 0};
+    bool m_presenceDirty = false;
+    float m_presenceTimer = 0.0f;
+    int m_remotePresence[2] = {0, 0};
+    bool m_hasRemotePresence = false;
+    bool m_activity = false;  // Something the UI shows changed since takeActivity()
+
+    void initSockets();
+    void cleanupSockets();
+    void enterMode(NetworkMode mode);
+    void beginConnect();
+    void scheduleRetry();
+    void updateClientConnection(float deltaTime);
+    void onClientConnected();
+    void onWelcome(const std::string& token, unsigned int peerReceived, unsigned int resumeFrom);
+    void joinPlayer(std::unique_ptr<Transport> transport, bool resume, unsigned int peerReceived,
+                    const std::string& gameBytes);
+    void flushSendBuffer();
+    void sendPresence(float deltaTime);
+    void receiveGameState();
+    void handleIncomingMessage(const std::string& msg);
+    void acceptConnections();
+    void classifyPendingConnections(float deltaTime);
+};
@@ -0,0 +1,150 @@
+/**
+ * @file ParticleSystem.h
+ * @brief Structure-of-arrays particle system drawn in a single instanced call
+ *
+ * The background and victory screen used to compute every particle from
+ * scratch with fmod/sin and draw it with its own DrawCircle (20 + 30
+ * circles, each a tessellated fan). Particles now live in contiguous
+ * per-field arrays that update() walks in simple, branch-free loops the
+ * compiler vectorises, and draw() uploads them as one instance buffer
+ * rendered with a point-sprite shader: a unit quad expanded per instance
+ * in the vertex shader and rounded off in the fragment shader. 100k
+ * particles cost one upload and one draw call.
+ *
+ * Without OpenGL 3.3 (or if the shader fails to build) the same data is
+ * fed through rlgl's batch as textured quads, which is still a handful of
+ * draw calls rather than one per particle.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/**
+ * @brief How new particles look and move
+ */
+struct ParticleEmitter {
+    Vector2 position = {0.0f, 0.0f};   ///< Spawn point
+    Vector2 spread = {0.0f, 0.0f};     ///< Random offset from the spawn point, +/- per axis
+    float minSpeed = 0.0f;
+    float maxSpeed = 0.0f;
+    float minAngle = 0.0f;             ///< Launch direction range in degrees (0 = right, 90 = down)
+    float maxAngle = 360.0f;
+    float minSize = 2.0f;              ///< Radius in pixels
+    float maxSize = 4.0f;
+    float lifetime = 1.0f;             ///< Seconds until fully faded; 0 = never fades
+    Color color = WHITE;
+    float hueJitter = 0.0f;            ///< Random hue shift in degrees, +/- (0 keeps the colour)
+};
+
+/**
+ * @brief Fixed-capacity particle pool with SoA storage
+ *
+ * Dead particles are swap-removed, so the live ones always occupy
+ * [0, getCount()). Drawing needs a window; updating does not.
+ */
+class ParticleSystem {
+public:
+    /**
+     * @param capacity Maximum live particles; emit() drops what does not fit
+     * @param seed RNG seed for emission (spawn jitter only, not gameplay)
+     */
+    explicit ParticleSystem(std::size_t capacity = DEFAULT_CAPACITY, unsigned int seed = 0x5EED);
+    ~ParticleSystem();
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    /**
+     * @brief Spawns particles
+     * @return How many were actually spawned (less than count when full)
+     */
+    std::size_t emit(const ParticleEmitter& emitter, std::size_t count);
+
+    /**
+     * @brief Advances every particle and removes the ones that have faded out
+     */
+    void update(float deltaTime);
+
+    /**
+     * @brief Draws all live particles in one instanced call (or one batch)
+     */
+    void draw();
+
+    /**
+     * @brief Removes all particles
+     */
+    void clear() { m_count = 0; }
+
+    /**
+     * @brief Acceleration applied to every particle, in pixels/s^2
+     */
+    void setGravity(Vector2 gravity) { m_gravity = gravity; }
+
+    /**
+     * @brief Makes particles wrap around a width x height area instead of leaving it (0 disables)
+     */
+    void setWrap(float width, float height);
+
+    /**
+     * @brief Releases GPU resources; draw() reloads them on demand
+     */
+    void unload();
+
+    std::size_t getCount() const { return m_count; }
+    std::size_t getCapacity() const { return m_capacity; }
+    Vector2 getPosition(std::size_t index) const { return {m_x[index], m_y[index]}; }
+    float getAlpha(std::size_t index) const { return m_life[index]; }
+
+    /**
+     * @brief Whether the last draw() used the instanced shader path
+     */
+    bool isInstanced() const { return m_instanced; }
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+private:
+    // === Particle state, one array per field ===
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_vx;
+    std::vector<float> m_vy;
+    std::vector<float> m_size;
+    std::vector<float> m_life;         ///< 1 at spawn, fades to 0
+    std::vector<float> m_fade;         ///< Life lost per second (0 = immortal)
+    std::vector<Color> m_color;        ///< Colour at full life
+    std::size_t m_count = 0;
+    std::size_t m_capacity;
+
+    Vector2 m_gravity = {0.0f, 0.0f};
+    float m_wrapWidth = 0.0f;
+    float m_wrapHeight = 0.0f;
+    std::mt19937 m_rng;
+
+    // === GPU resources ===
+    struct Instance {
+        float x, y, size;
+        Color color;
+    };
+    std::vector<Instance> m_instances; ///< Staging buffer for the upload
+    bool m_gpuLoaded = false;
+    bool m_instanced = false;
+    Shader m_shader{};
+    int m_mvpLoc = -1;
+    unsigned int m_vao = 0;
+    unsigned int m_quadVbo = 0;
+    unsigned int m_instanceVbo = 0;
+    Texture2D m_sprite{};              ///< Soft dot for the batched fallback
+
+    void loadGpu();
+    void removeDead();
+    void drawInstanced();
+    void drawBatched();
+};
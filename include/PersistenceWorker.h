@@ -0,0 +1,93 @@
+/**
+ * @file PersistenceWorker.h
+ * @brief Background thread for durable file writes
+ *
+ * Saving must never hold up a frame: the game thread posts write jobs
+ * here and carries on, and this thread runs them one at a time, in the
+ * order they were posted. The file helpers it offers make each write
+ * durable before reporting success: appends are flushed to disk with
+ * fsync, and whole-file writes go to a temporary file that is synced and
+ * then renamed over the target, so a crash leaves either the old file or
+ * the new one, never a mix.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Runs posted write jobs, in order, on its own thread
+ *
+ * Jobs still queued when the worker is destroyed are run before it joins,
+ * so nothing posted is lost on a normal exit.
+ */
+class PersistenceWorker {
+public:
+    /// A write job; returns false if it failed
+    using Job = std::function<bool()>;
+
+    PersistenceWorker();
+    ~PersistenceWorker();
+
+    PersistenceWorker(const PersistenceWorker&) = delete;
+    PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+    /**
+     * @brief Queues a job and returns at once
+     */
+    void post(Job job);
+
+    /**
+     * @brief Blocks until every job posted so far has run
+     */
+    void flush();
+
+    std::size_t getCompleted() const { return m_completed.load(); }
+    std::size_t getFailures() const { return m_failures.load(); }
+
+    // === Durable file helpers (run them from jobs) ===
+
+    /**
+     * @brief Appends data to a file and syncs it to disk
+     *
+     * The file must be expectedSize bytes long beforehand; anything past
+     * that (left by a write that failed part way) is cut off first. If the
+     * append fails, the file is cut back to expectedSize.
+     */
+    static bool appendDurably(const std::string& path, const void* data, std::size_t size, std::uint64_t expectedSize);
+
+    /**
+     * @brief Replaces a file with data: temporary file, sync, rename
+     */
+    static bool writeAtomically(const std::string& path, const void* data, std::size_t size);
+
+    /**
+     * @brief Atomically replaces destination with the first length bytes of source
+     */
+    static bool copyAtomically(const std::string& source, const std::string& destination, std::uint64_t length);
+
+private:
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;     ///< Work arrived, or stopping
+    std::condition_variable m_idle;     ///< The queue ran dry
+    std::deque<Job> m_jobs;             ///< Guarded by m_mutex
+    bool m_busy = false;                ///< A job is running (guarded by m_mutex)
+    bool m_stopping = false;
+    std::atomic<std::size_t> m_completed{0};
+    std::atomic<std::size_t> m_failures{0};
+
+    void run();
+};
@@ -0,0 +1,162 @@
+/**
+ * @file ReliableChannel.h
+ * @brief Reliable-ordered and unreliable message channels over datagrams
+ *
+ * ReliableChannel is the packet logic behind UdpTransport, kept free of
+ * sockets so it can be tested against a simulated lossy wire. Every packet
+ * carries the sender's sequence number plus an ack of the newest packet
+ * received and a 32-bit bitfield acking the 32 before it, so a single
+ * surviving packet confirms many. Reliable data is cut into numbered
+ * chunks that are resent until acked and released to the reader strictly
+ * in order. Presence packets (cursor, hover) are never resent: only the
+ * newest one matters, so a lost one costs nothing and they never wait
+ * behind a lost chunk.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief First byte after the protocol id in every datagram
+ */
+enum class PacketType : uint8_t {
+    CONNECT = 1,    // Client asks for a connection (resent until ACCEPT)
+    ACCEPT = 2,     // Server confirms the connection
+    DISCONNECT = 3, // Either side is closing
+    DATA = 4,       // Acks, optionally with one reliable chunk
+    PRESENCE = 5    // Acks plus an unreliable, latest-wins payload
+};
+
+/**
+ * @brief Datagram-level reliability for one peer
+ *
+ * Outgoing packets are appended to a caller-supplied vector; the caller
+ * puts them on the wire. Incoming datagrams are handed to receivePacket().
+ */
+class ReliableChannel {
+public:
+    ReliableChannel();
+
+    // === OUTGOING ===
+    /**
+     * @brief Queues bytes on the reliable-ordered channel
+     * @return Bytes accepted (less than size when the send window is full)
+     */
+    size_t send(const char* data, size_t size);
+
+    /**
+     * @brief Replaces the pending presence payload; only the newest is sent
+     */
+    void sendPresence(const std::string& payload);
+
+    /**
+     * @brief Builds packets for newly queued chunks and presence
+     */
+    void flush(std::vector<std::string>& packets);
+
+    /**
+     * @brief Advances timers: resends overdue chunks, sends acks and keepalives
+     */
+    void update(float deltaTime, std::vector<std::string>& packets);
+
+    // === INCOMING ===
+    /**
+     * @brief Processes one datagram
+     * @return False if it is not a DATA/PRESENCE packet of this protocol
+     */
+    bool receivePacket(const char* data, size_t size);
+
+    /**
+     * @brief Reads in-order reliable bytes
+     * @return Bytes copied into buffer
+     */
+    size_t read(char* buffer, size_t size);
+
+    /**
+     * @brief Takes the newest presence payload received since the last call
+     */
+    bool takePresence(std::string& payload);
+
+    // === STATISTICS ===
+    float getRoundTripTime() const { return m_roundTripTime; }
+    float getTimeSinceReceive() const { return m_time - m_lastReceiveTime; }
+    unsigned long long getResends() const { return m_resends; }
+    size_t getUnackedChunks() const { return m_outgoing.size(); }
+
+    // === WIRE FORMAT HELPERS (shared with UdpTransport) ===
+    static void writeControlPacket(PacketType type, std::string& out);
+    static bool readPacketType(const char* data, size_t size, PacketType& type);
+
+    static constexpr uint16_t PROTOCOL_ID = 0x4D43;     // "MC"
+    static constexpr size_t HEADER_SIZE = 12;           // id, type, flags, seq, ack, ack bits
+    static constexpr size_t MAX_CHUNK_SIZE = 1024;      // reliable bytes per packet
+    static constexpr size_t MAX_UNACKED_CHUNKS = 256;   // send window
+    static constexpr float MIN_RESEND_DELAY = 0.05f;    // seconds, floor for the RTT-based resend timer
+    static constexpr float KEEPALIVE_INTERVAL = 0.5f;   // seconds of silence before an empty packet
+
+private:
+    struct OutgoingChunk {
+        uint16_t id;
+        std::string bytes;
+        float sentAt = 0.0f;
+        bool sent = false;
+        bool acked = false;
+    };
+
+    struct SentPacket {
+        uint16_t sequence = 0;
+        uint16_t chunkId = 0;
+        float sentAt = 0.0f;
+        bool valid = false;
+        bool hasChunk = false;
+        bool acked = false;
+    };
+
+    float m_time;
+    float m_lastReceiveTime;
+    float m_lastSendTime;
+    float m_roundTripTime;
+    unsigned long long m_resends;
+
+    // Packet sequencing and acks
+    uint16_t m_localSequence;
+    bool m_hasRemoteSequence;
+    uint16_t m_remoteSequence;    ///< Newest packet received from the peer
+    uint32_t m_receivedBits;      ///< Bit n: packet m_remoteSequence - 1 - n was received
+    bool m_ackPending;            ///< Received something that deserves an ack
+    std::array<SentPacket, 1024> m_sentPackets; ///< Indexed by sequence % size
+
+    // Reliable-ordered stream
+    std::deque<OutgoingChunk> m_outgoing;
+    uint16_t m_nextChunkId;
+    uint16_t m_expectedChunkId;
+    std::map<uint16_t, std::string> m_earlyChunks; ///< Arrived ahead of a missing one
+    std::string m_readable;
+
+    // Unreliable presence
+    std::string m_presenceOut;
+    bool m_presencePending;
+    std::string m_presenceIn;
+    bool m_presenceReceived;
+    bool m_hasPresenceSequence;
+    uint16_t m_presenceSequence;
+
+    void writePacket(PacketType type, OutgoingChunk* chunk, const std::string* payload,
+                     std::vector<std::string>& packets);
+    void recordReceived(uint16_t sequence);
+    void processAcks(uint16_t ack, uint32_t ackBits);
+    void acceptChunk(uint16_t id, const char* data, size_t size);
+
+    static bool sequenceGreater(uint16_t a, uint16_t b);
+};
@@ -0,0 +1,57 @@
+/**
+ * @file RenderSnapshot.h
+ * @brief Immutable copy of everything needed to draw the playing screen
+ *
+ * The simulation fills a BoardSnapshot after each step and the renderer
+ * draws only from it, never from the live Card and GameBoard objects.
+ * That is what lets the two run on different threads (see
+ * SimulationThread): the snapshot travels through a TripleBuffer, and
+ * each side works on its own copy.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <vector>
+
+#include "Card.h"
+#include "HudRenderer.h"
+
+/**
+ * @brief One card as the renderer sees it
+ *
+ * "previous" fields hold the state one simulation step earlier, so the
+ * renderer can interpolate between steps.
+ */
+struct CardSnapshot {
+    int id = 0;
+    CardState state = CardState::FACE_DOWN;
+    Vector2 position = {0.0f, 0.0f};
+    Vector2 previousPosition = {0.0f, 0.0f};
+    Vector2 size = {0.0f, 0.0f};
+    float flip = 0.0f;              ///< 0 = face down, 1 = face up
+    float previousFlip = 0.0f;
+};
+
+/**
+ * @brief The playing screen at one simulation step
+ */
+struct BoardSnapshot {
+    std::vector<CardSnapshot> cards;    ///< Same order as the board's cards
+    int hintCards[2] = {-1, -1};        ///< Indices of the cards an active hint highlights
+    int comboCount = 0;
+    float comboTime = 0.0f;
+    bool shuffling = false;
+    bool complete = false;              ///< Every pair matched
+    HudState hud;
+
+    // === Timing ===
+    unsigned long long step = 0;        ///< Simulation steps run so far
+    double publishTime = 0.0;           ///< When the snapshot was published (SimulationThread::now)
+    unsigned long long inputSequence = 0; ///< Newest click that flipped a card (0 = none)
+    double inputTime = 0.0;             ///< When that click was seen
+};
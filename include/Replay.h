@@ -0,0 +1,164 @@
+/**
+ * @file Replay.h
+ * @brief Compact binary recording of a game's inputs
+ *
+ * A game is fully determined by its deck seed, its difficulty and the
+ * inputs that changed the board, so that is all a replay stores. Inputs
+ * are timed in simulation steps (SimulationClock::DEFAULT_STEP each),
+ * counted from the start of the game, which is what the board logic
+ * itself advances by; they are stored as deltas from the previous input.
+ *
+ * Each input is one varint, delta * (slots + 4) + code, where the code is
+ * the clicked card slot (row * columns + column) or, past the slots, the
+ * kind of input. A HARD click up to 4 seconds after the previous input
+ * costs 2 bytes, so a full HARD game is a few hundred bytes.
+ *
+ * Only inputs that did something are recorded: clicks that flipped a
+ * card, hints that were shown, reshuffles that started, and pauses (with
+ * their length). Anything else left the board as it was.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Kinds of recorded input (stored as slot count + type, except clicks)
+ */
+enum class ReplayEventType : std::uint8_t {
+    CLICK = 0,      ///< A card slot was clicked and a card flipped
+    HINT = 1,       ///< A hint was shown
+    SHUFFLE = 2,    ///< A reshuffle started
+    PAUSE = 3,      ///< The game was paused (no steps run meanwhile)
+    END = 4         ///< The game was won; carries the final score and moves
+};
+
+/// Codes past the slots: HINT through END
+constexpr std::uint64_t REPLAY_CONTROL_CODES = 4;
+
+/**
+ * @brief One decoded input
+ */
+struct ReplayEvent {
+    ReplayEventType type = ReplayEventType::CLICK;
+    std::uint64_t step = 0;         ///< Simulation steps run before the input was applied
+    int slot = -1;                  ///< CLICK: card slot
+    std::uint32_t milliseconds = 0; ///< PAUSE: how long the game stayed paused
+    std::int32_t score = 0;         ///< END
+    std::int32_t moves = 0;         ///< END
+};
+
+/**
+ * @brief What a replay was recorded from
+ */
+struct ReplayHeader {
+    std::uint32_t seed = 0;         ///< Deck and shuffle seed given to the GameBoard
+    std::int32_t difficulty = 0;    ///< Number of cards (16, 36, 64)
+};
+
+/**
+ * @brief Records one game into a buffer allocated once, up front
+ *
+ * Every call is constant time and allocation-free, so it is safe to make
+ * from the frame (or simulation) thread. If a game outgrows the buffer
+ * the recording stops there and is marked truncated; room for the END
+ * event is always kept, so finish() still fits.
+ */
+class ReplayRecorder {
+public:
+    explicit ReplayRecorder(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Starts recording a new game, dropping the previous one
+     */
+    void begin(std::uint32_t seed, std::int32_t difficulty);
+
+    /**
+     * @brief Carries on recording a game saved part way through
+     * @param data The unfinished recording, as data() held it when the game was saved
+     * @return False, and not recording, if that is not an unfinished recording or does not fit
+     */
+    bool resume(const unsigned char* data, std::size_t size);
+
+    void click(std::uint64_t step, int slot);
+    void hint(std::uint64_t step);
+    void shuffle(std::uint64_t step);
+    void pause(std::uint64_t step, std::uint32_t milliseconds);
+
+    /**
+     * @brief Closes the recording with the game's result
+     */
+    void finish(std::uint64_t step, std::int32_t score, std::int32_t moves);
+
+    bool isRecording() const { return m_recording; }
+    bool isFinished() const { return m_finished; }
+    bool isTruncated() const { return m_truncated; }
+
+    const unsigned char* data() const { return m_buffer.data(); }
+    std::size_t size() const { return m_size; }
+    std::size_t getCapacity() const { return m_buffer.size(); }
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 16 * 1024;  ///< Far beyond any real game
+    static constexpr unsigned char FORMAT_VERSION = 1;
+
+private:
+    std::vector<unsigned char> m_buffer;    ///< Sized once; m_size bytes are in use
+    std::size_t m_size = 0;
+    std::int32_t m_slots = 0;
+    std::uint64_t m_lastStep = 0;
+    bool m_recording = false;
+    bool m_finished = false;
+    bool m_truncated = false;
+
+    bool reserve(bool final);
+    std::uint64_t controlCode(ReplayEventType type) const;
+    void putEvent(std::uint64_t step, std::uint64_t code);
+    void putVarint(std::uint64_t value);
+};
+
+/**
+ * @brief Decodes a recording, one event at a time
+ */
+class ReplayReader {
+public:
+    /**
+     * @brief Reads the header; the bytes must outlive the reader
+     */
+    ReplayReader(const unsigned char* data, std::size_t size);
+
+    /**
+     * @return False if the header is not a replay's
+     */
+    bool isValid() const { return m_valid; }
+    const ReplayHeader& getHeader() const { return m_header; }
+
+    /**
+     * @brief Decodes the next event
+     * @return False at the end of the recording, or on malformed data (see hasError())
+     */
+    bool next(ReplayEvent& event);
+
+    bool hasError() const { return m_error; }
+
+    /**
+     * @brief Card slots in a game of this many cards, or 0 if that is no difficulty
+     */
+    static std::int32_t slotCount(std::int32_t difficulty);
+
+private:
+    const unsigned char* m_data;
+    std::size_t m_size;
+    std::size_t m_offset = 0;
+    ReplayHeader m_header;
+    std::uint64_t m_step = 0;
+    bool m_valid = false;
+    bool m_error = false;
+
+    bool getVarint(std::uint64_t& value);
+};
@@ -0,0 +1,151 @@
+/**
+ * @file ReplayPlayer.h
+ * @brief Re-runs recorded games, to watch them or to check their scores
+ *
+ * A replay is played on a headless GameBoard dealt from the recorded seed.
+ * The recorded inputs go through the same handleClick(), showHint() and
+ * startShuffle() calls the game made, before the same simulation step, and
+ * reshuffles follow Game's rules (cooldown, point cost). The board logic
+ * only ever advances in fixed steps, so the replayed ScoreManager ends on
+ * exactly the score the game did. An input the board or the rules would
+ * have refused means the replay did not come from a real game.
+ *
+ * Playing forward keeps a keyframe of the whole game state every
+ * keyframe interval, so seeking anywhere costs one restore and fewer steps
+ * than an interval. verify() skips keyframes and just runs the game out,
+ * which is what checking leaderboard submissions in bulk needs.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "GameBoard.h"
+#include "Replay.h"
+#include "ScoreManager.h"
+
+/**
+ * @brief What re-running a replay showed
+ */
+enum class ReplayVerdict {
+    VALID,          ///< Won, with the recorded score
+    MALFORMED,      ///< Not a replay, or one cut short
+    TOO_LONG,       ///< Runs past ReplayPlayer::MAX_STEPS
+    ILLEGAL_INPUT,  ///< Contains an input the game would have ignored
+    NOT_WON,        ///< Ends with cards still unmatched
+    SCORE_MISMATCH  ///< Won, but with another score (or fewer moves than card flips)
+};
+
+/**
+ * @brief Result of playing a replay to its end
+ */
+struct ReplayCheck {
+    ReplayVerdict verdict = ReplayVerdict::MALFORMED;
+    std::int32_t difficulty = 0;
+    std::int32_t score = 0;         ///< Score the replayed game reached
+    std::int32_t claimedScore = 0;  ///< Score the replay says it ended with
+    std::int32_t moves = 0;         ///< Moves the replay says it took
+    std::uint64_t steps = 0;        ///< Simulation steps played
+    int hintsUsed = 0;
+    int shufflesUsed = 0;
+
+    bool isValid() const { return verdict == ReplayVerdict::VALID; }
+};
+
+/**
+ * @brief Plays one replay at a time, forwards step by step or by seeking
+ */
+class ReplayPlayer {
+public:
+    /**
+     * @param keyframeInterval Steps between keyframes; 0 keeps none (seeking back then restarts)
+     */
+    explicit ReplayPlayer(std::uint64_t keyframeInterval = KEYFRAME_INTERVAL);
+
+    /**
+     * @brief Decodes a replay and deals its board, ready before step 0
+     * @return False if it is malformed or too long (see getCheck())
+     */
+    bool load(const unsigned char* data, std::size_t size);
+
+    /**
+     * @brief Applies the inputs recorded for the current step, then runs the step
+     * @return False once the game is over: the end was reached or an input was refused
+     */
+    bool step();
+
+    /**
+     * @brief Moves to the given step, before its inputs (clamped to the end)
+     */
+    void seek(std::uint64_t target);
+
+    /**
+     * @brief Plays to the end and returns the verdict
+     */
+    const ReplayCheck& finish();
+
+    bool isLoaded() const { return m_board != nullptr; }
+    bool isOver() const { return m_over; }
+    std::uint64_t getStep() const { return m_step; }
+    std::uint64_t getEndStep() const { return m_events.empty() ? 0 : m_events.back().step; }
+    const ReplayHeader& getHeader() const { return m_header; }
+    const GameBoard* getBoard() const { return m_board.get(); }
+    int getScore() const { return m_score.getScore(); }
+    std::size_t getKeyframeCount() const { return m_keyframeCount; }
+
+    /**
+     * @brief The verdict, once isOver() (or after a failed load())
+     */
+    const ReplayCheck& getCheck() const { return m_check; }
+
+    /**
+     * @brief Headless fast-forward: plays a replay out without keyframes
+     */
+    static ReplayCheck verify(const unsigned char* data, std::size_t size);
+
+    static constexpr std::uint64_t KEYFRAME_INTERVAL = 300;            ///< 5 seconds of play
+    static constexpr std::uint64_t MAX_STEPS = 2ull * 60 * 60 * 60;    ///< 2 hours of play
+
+private:
+    /**
+     * @brief The whole game state at one step, inputs for that step not yet applied
+     */
+    struct Keyframe {
+        std::uint64_t step = 0;
+        std::size_t nextEvent = 0;
+        GameBoard::LogicState board;
+        ScoreManager score;
+        float shuffleCooldown = 0.0f;
+        int shufflesUsed = 0;
+        int flips = 0;
+    };
+
+    std::uint64_t m_keyframeInterval;
+    std::vector<Keyframe> m_keyframes;  ///< Kept across load() so their buffers are reused
+    std::size_t m_keyframeCount = 0;    ///< Keyframes in use, the one for step k * interval at index k
+
+    ReplayHeader m_header;
+    std::vector<ReplayEvent> m_events;
+    std::unique_ptr<GameBoard> m_board;
+    ScoreManager m_score;
+    std::size_t m_nextEvent = 0;
+    std::uint64_t m_step = 0;
+    float m_shuffleCooldown = 0.0f;     ///< Mirrors Game::m_shuffleCooldownTimer
+    int m_shufflesUsed = 0;
+    int m_flips = 0;                    ///< Clicks that turned a card, each one a move at least
+    bool m_over = false;
+    ReplayCheck m_check;
+
+    void restart();
+    bool apply(const ReplayEvent& event);
+    void judge(const ReplayEvent& end);
+    void saveKeyframe();
+    void restoreKeyframe(const Keyframe& keyframe);
+    void stop(ReplayVerdict verdict);
+};
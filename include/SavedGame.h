@@ -0,0 +1,62 @@
+/**
+ * @file SavedGame.h
+ * @brief A game in progress, kept to be continued later
+ *
+ * Quitting to the menu or closing the window mid-game no longer throws
+ * the game away: Game captures it into a SavedGame, encodes it and hands
+ * the bytes to its PersistenceWorker. Continuing deals a board from the
+ * saved seed, the same deal as before, and puts the saved logic state
+ * back into it. Dealing loads no textures (cards only load their own when
+ * CardRenderer's atlas is unavailable), so that takes microseconds.
+ *
+ * The snapshot is versioned and small, a few hundred bytes for a HARD
+ * board of which most is the replay so far. Counters are varints and
+ * timers raw little-endian floats. Card positions are in grid units, so a
+ * card resting in its slot costs one byte and a game carries on in a
+ * window of any size. The shuffle generator is kept as the number of
+ * values drawn since the seed, not its 2.5 KB of state.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameBoard.h"
+
+/**
+ * @brief Everything needed to carry on a game where it was left
+ */
+struct SavedGame {
+    std::int32_t difficulty = 0;        ///< Number of cards (16, 36, 64)
+    std::uint32_t seed = 0;             ///< Deck and shuffle seed of the board
+    std::uint64_t stepsPlayed = 0;      ///< Simulation steps since the game started
+    bool timerStarted = false;          ///< False during the opening shuffle
+    float elapsedSeconds = 0.0f;        ///< Game timer, pauses excluded
+    std::int32_t totalMoves = 0;
+    std::int32_t shufflesUsed = 0;
+    float shuffleCooldown = 0.0f;
+    std::int32_t scoreMoves = 0;        ///< ScoreManager
+    std::int32_t scoreMatches = 0;
+    std::int32_t score = 0;
+    GameBoard::LogicState board;        ///< From GameBoard::saveGridState()
+    std::vector<unsigned char> replay;  ///< The unfinished recording; empty if none was kept
+
+    /**
+     * @brief Encodes the game, reusing out's buffer
+     */
+    void encode(std::vector<unsigned char>& out) const;
+
+    /**
+     * @brief Decodes a snapshot, reusing this game's buffers
+     * @return False if it is not one, is of another version, or does not hold together
+     */
+    bool decode(const unsigned char* data, std::size_t size);
+
+    static constexpr unsigned char FORMAT_VERSION = 1;
+    static constexpr std::uint64_t MAX_RNG_DRAWS = 1u << 20;   ///< Thousands of reshuffles; a bound on decoding work
+};
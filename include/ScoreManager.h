@@ -1,5 +1,4 @@
 #pragma once
-#include <string>
 
 class ScoreManager {
 public:
@@ -8,18 +7,14 @@ public:
     void addMatch(int comboMultiplier = 1);
     void addMismatch();
     void resetScore();
+    void restore(int moves, int matches, int score); // saved game
 
     int getMoves() const;
     int getMatches() const;
     int getScore() const;
-    int getHighScore() const;
-    // Load high score from disk (if any) and save when updated
-    void loadHighScore();
-    void trySaveHighScore();
 
 private:
     int m_moves;
     int m_matches;
     int m_score;
-    int m_highScore;
 };
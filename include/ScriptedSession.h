@@ -0,0 +1,79 @@
+/**
+ * @file ScriptedSession.h
+ * @brief The player memory_perf plays the game as
+ *
+ * Goes menu -> HARD -> solves the board -> victory -> restart, as many
+ * games as asked, then back to the menu. It decides each frame from what
+ * the game shows: the buttons the last frame declared and the cards of
+ * the board. It cheats (it knows every card) and solves perfectly, one
+ * click per CLICK_INTERVAL, so every run plays the same number of clicks
+ * and frames differ only in timing.
+ *
+ * The decision is a ScriptedInput; memory_perf turns it into raylib
+ * input so the game reads it exactly like a real mouse or keyboard.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include "Game.h"
+#include "RenderSnapshot.h"
+#include "WidgetLayer.h"
+
+/**
+ * @brief One frame's synthetic input
+ */
+struct ScriptedInput {
+    enum class Type {
+        NONE,
+        CLICK,  ///< Left button at position
+        KEY     ///< key pressed
+    };
+    Type type = Type::NONE;
+    Vector2 position{0.0f, 0.0f};
+    int key = 0;
+};
+
+/**
+ * @brief Scripted menu -> HARD -> solve -> victory -> restart loop
+ */
+class ScriptedSession {
+public:
+    /**
+     * @param games Games to win before returning to the menu
+     */
+    explicit ScriptedSession(int games);
+
+    /**
+     * @brief Decides this frame's input
+     * @param state The game's state
+     * @param widgets The buttons declared by the last frame drawn
+     * @param board The board while playing; ignored otherwise
+     * @param deltaTime Seconds since the last frame
+     */
+    ScriptedInput next(GameState state, const WidgetLayer& widgets, const BoardSnapshot& board, float deltaTime);
+
+    /**
+     * @brief Every game won and the menu reached again
+     */
+    bool isFinished() const { return m_finished; }
+    int getGamesWon() const { return m_gamesWon; }
+
+    static constexpr float CLICK_INTERVAL = 0.1f;   ///< Seconds between card clicks
+    static constexpr float VICTORY_SECONDS = 2.0f;  ///< Time spent watching the victory screen
+
+private:
+    int m_games;
+    int m_gamesWon;
+    bool m_finished;
+    bool m_released;        ///< Nothing held since the last input, so the next one is a fresh press
+    float m_wait;           ///< Seconds before the next input
+    GameState m_lastState;
+
+    ScriptedInput clickWidget(const WidgetLayer& widgets, int id) const;
+    ScriptedInput clickCard(const BoardSnapshot& board) const;
+};
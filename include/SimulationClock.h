@@ -0,0 +1,73 @@
+/**
+ * @file SimulationClock.h
+ * @brief Fixed-timestep clock that decouples game logic from the frame rate
+ *
+ * Frame time is poured into an accumulator and drained in whole steps of
+ * a fixed size, so timers (flip-back delay, hint cooldown, shuffle
+ * stagger) advance by exactly the same amounts whether the game renders
+ * at 30, 60 or 240 FPS. The remainder, as a fraction of a step, is the
+ * interpolation factor the renderer uses to blend between the previous
+ * and the current simulation state. Long frames are capped at
+ * MAX_STEPS_PER_FRAME so a stall cannot snowball into ever longer
+ * catch-up frames.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+/**
+ * @brief Accumulator turning variable frame times into fixed simulation steps
+ */
+class SimulationClock {
+public:
+    /**
+     * @param step Simulation step in seconds
+     * @param maxStepsPerFrame Most steps a single frame may run; the excess is dropped
+     */
+    explicit SimulationClock(float step = DEFAULT_STEP, int maxStepsPerFrame = MAX_STEPS_PER_FRAME);
+
+    /**
+     * @brief Adds a frame's worth of time
+     * @param frameTime Seconds since the previous frame
+     * @return Number of fixed steps to run now
+     */
+    int advance(float frameTime);
+
+    /**
+     * @brief Drops any accumulated time (new game, resume after a load)
+     */
+    void reset();
+
+    /**
+     * @brief Fixed step length in seconds
+     */
+    float getStep() const { return m_step; }
+
+    /**
+     * @brief How far the render time is between the last two steps, in [0, 1)
+     */
+    float getAlpha() const { return static_cast<float>(m_accumulator / m_step); }
+
+    /**
+     * @brief Steps run since construction or the last reset
+     */
+    unsigned long long getStepCount() const { return m_stepCount; }
+
+    /**
+     * @brief Frame time that was dropped because a frame exceeded the step cap
+     */
+    double getDroppedTime() const { return m_droppedTime; }
+
+    static constexpr float DEFAULT_STEP = 1.0f / 60.0f;
+    static constexpr int MAX_STEPS_PER_FRAME = 8;
+
+private:
+    float m_step;
+    int m_maxStepsPerFrame;
+    double m_accumulator;   // double so a long session does not drift
+    unsigned long long m_stepCount;
+    double m_droppedTime;
+};
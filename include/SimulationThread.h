@@ -0,0 +1,106 @@
+/**
+ * @file SimulationThread.h
+ * @brief Runs fixed-step game logic on its own thread, fed by posted input
+ *
+ * raylib's window, GL context and input polling have to stay on the main
+ * thread, so that thread samples input, posts it here as InputEvents and
+ * draws whatever snapshot was published last. This thread owns the game
+ * logic while it runs: it applies input as soon as it arrives (it is
+ * woken up for it rather than waiting for the next step), advances the
+ * SimulationClock in real time, and calls the publish callback after
+ * anything changed. A slow frame on the main thread (texture upload,
+ * text layout) therefore no longer holds up input handling or the
+ * simulation.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SimulationClock.h"
+
+/**
+ * @brief A player action, sampled on the main thread
+ */
+struct InputEvent {
+    enum class Type {
+        CLICK,      ///< Left click at position
+        HINT,       ///< Hint key
+        SHUFFLE     ///< Reshuffle key
+    };
+
+    Type type = Type::CLICK;
+    Vector2 position = {0.0f, 0.0f};
+    unsigned long long sequence = 0;    ///< Assigned by postInput(), increasing from 1
+    double time = 0.0;                  ///< SimulationThread::now() when posted
+};
+
+/**
+ * @brief Worker thread driving the simulation callbacks
+ *
+ * The callbacks run on the worker only. Between start() and stop() the
+ * state they touch belongs to the worker; stop() joins the thread, after
+ * which the caller owns it again.
+ */
+class SimulationThread {
+public:
+    using InputCallback = std::function<void(const InputEvent&)>;
+    using StepCallback = std::function<void(float step)>;
+    using PublishCallback = std::function<void(const SimulationClock& clock)>;
+
+    explicit SimulationThread(float step = SimulationClock::DEFAULT_STEP);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /**
+     * @brief Starts the worker; it publishes once right away
+     * @return False if already running
+     */
+    bool start(InputCallback onInput, StepCallback onStep, PublishCallback onPublish);
+
+    /**
+     * @brief Stops and joins the worker; pending input is dropped
+     */
+    void stop();
+
+    bool isRunning() const { return m_thread.joinable(); }
+
+    /**
+     * @brief Queues an input event and wakes the worker (any thread)
+     * @return The sequence number given to the event
+     */
+    unsigned long long postInput(InputEvent event);
+
+    /**
+     * @brief Monotonic time in seconds, shared by both threads for latency measurements
+     */
+    static double now();
+
+private:
+    SimulationClock m_clock;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+
+    std::mutex m_inputMutex;
+    std::condition_variable m_wake;
+    std::vector<InputEvent> m_inputs;   ///< Guarded by m_inputMutex
+    unsigned long long m_nextSequence = 1;
+
+    InputCallback m_onInput;
+    StepCallback m_onStep;
+    PublishCallback m_onPublish;
+
+    void run();
+};
@@ -0,0 +1,104 @@
+/**
+ * @file SpectatorHub.h
+ * @brief Fan-out of game updates to read-only spectator connections
+ *
+ * Every outgoing update is encoded once into a reference-counted buffer
+ * that all spectator queues share; the bytes are written straight out of
+ * those shared buffers with a gather write, so adding viewers never copies
+ * or re-encodes a message. A viewer that cannot keep up is resynchronised
+ * with a snapshot and eventually dropped, it never blocks the players.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "NetSocket.h"
+
+/**
+ * @brief Immutable, shareable encoded message batch
+ */
+using BroadcastBuffer = std::shared_ptr<const std::string>;
+
+/**
+ * @brief Creates a broadcast buffer from an encoded batch
+ */
+BroadcastBuffer makeBroadcastBuffer(std::string bytes);
+
+/**
+ * @brief Manages the spectators subscribed to one game room
+ */
+class SpectatorHub {
+public:
+    SpectatorHub() = default;
+    ~SpectatorHub();
+
+    SpectatorHub(const SpectatorHub&) = delete;
+    SpectatorHub& operator=(const SpectatorHub&) = delete;
+
+    /**
+     * @brief Subscribes a connected socket; the hub takes ownership
+     * @param sock Non-blocking socket of the viewer
+     * @param snapshot Full state the viewer starts from
+     */
+    void addSpectator(SOCKET sock, const BroadcastBuffer& snapshot);
+
+    /**
+     * @brief Queues one update for every spectator (no copies are made)
+     */
+    void broadcast(const BroadcastBuffer& buffer);
+
+    /**
+     * @brief Writes queued data, reaps closed connections and drops stalled ones
+     * @param deltaTime Time elapsed since the previous pump
+     */
+    void pump(float deltaTime);
+
+    /**
+     * @brief Whether any spectator had its backlog discarded and needs a snapshot
+     */
+    bool needsSnapshot() const;
+
+    /**
+     * @brief Sends a snapshot to every spectator whose backlog was discarded
+     */
+    void resync(const BroadcastBuffer& snapshot);
+
+    /**
+     * @brief Disconnects every spectator
+     */
+    void clear();
+
+    size_t getSpectatorCount() const { return m_spectators.size(); }
+    unsigned long long getDroppedBacklogs() const { return m_droppedBacklogs; }
+
+    static constexpr size_t MAX_BACKLOG_BYTES = 64 * 1024; // queued bytes before a viewer is resynced
+    static constexpr float STALL_TIMEOUT = 10.0f;           // seconds without progress before a viewer is dropped
+
+private:
+    struct Spectator {
+        SOCKET socket = INVALID_SOCKET;
+        std::deque<BroadcastBuffer> queue;
+        size_t frontOffset = 0;     ///< Bytes of queue.front() already written
+        size_t queuedBytes = 0;     ///< Unwritten bytes across the whole queue
+        float stallTimer = 0.0f;    ///< Time since the socket last accepted data
+        bool needsSnapshot = false; ///< Backlog was discarded, waiting for a snapshot
+        bool closed = false;
+    };
+
+    std::vector<Spectator> m_spectators;
+    std::vector<ConstBuffer> m_scratch; ///< Reused gather list
+    unsigned long long m_droppedBacklogs = 0;
+
+    void enqueue(Spectator& spectator, const BroadcastBuffer& buffer);
+    void discardBacklog(Spectator& spectator);
+    void writeQueued(Spectator& spectator, float deltaTime);
+    void pollClosed(Spectator& spectator);
+};
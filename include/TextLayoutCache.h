@@ -0,0 +1,119 @@
+/**
+ * @file TextLayoutCache.h
+ * @brief Laid-out glyph runs keyed by (string, size)
+ *
+ * raylib's DrawText and MeasureText decode the string and look every
+ * character up in the font (a linear search over its glyphs) on each
+ * call, and the UI draws the same few dozen strings every frame, often
+ * twice for a shadow. The cache does that work once per (string, size)
+ * and keeps the resulting quads - position relative to the text origin
+ * and atlas texture coordinates - together with the measured width.
+ * Layout matches raylib's DrawText/MeasureText for the same font, so
+ * replacing those calls does not move anything on screen.
+ *
+ * Storage is fixed once a font is set: a set number of runs, each with
+ * room for RESERVED_GLYPHS, indexed by an open-addressed table and
+ * recycled least recently used first. A miss lays the new string out
+ * into a recycled run, so strings that change every second (timers,
+ * scores) cost no allocation; only a longer string grows its run, once.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief One glyph, ready to submit
+ */
+struct GlyphQuad {
+    float x, y, width, height;      ///< Relative to the text origin, in pixels
+    float u0, v0, u1, v1;           ///< Atlas texture coordinates
+};
+
+/**
+ * @brief A laid-out string at one size
+ */
+struct TextRun {
+    std::string text;
+    int fontSize = 0;
+    int width = 0;                  ///< Same as MeasureText
+    std::vector<GlyphQuad> quads;   ///< Spaces and line breaks produce none
+};
+
+/**
+ * @brief Lays out strings for one font and remembers the result
+ */
+class TextLayoutCache {
+public:
+    /**
+     * @param maxRuns Runs kept; past that the least recently used one is reused
+     */
+    explicit TextLayoutCache(std::size_t maxRuns = DEFAULT_MAX_RUNS);
+
+    /**
+     * @brief Sets the font to lay out with; drops every cached run
+     * @param font Font whose glyphs and atlas rectangles are used (not owned)
+     * @param spacingRatio Spacing between glyphs per pixel of font size
+     * @param minFontSize Sizes below this are drawn at this size
+     *
+     * The first call allocates every run's storage.
+     */
+    void setFont(const Font& font, float spacingRatio, int minFontSize);
+
+    /**
+     * @brief The run for text at fontSize, laid out on first use
+     *
+     * The reference stays valid until the run is recycled, at the earliest
+     * after maxRuns - 1 other strings have been laid out.
+     */
+    const TextRun& get(std::string_view text, int fontSize);
+
+    void clear();
+    std::size_t size() const { return m_count; }
+    unsigned long long getHits() const { return m_hits; }
+    unsigned long long getMisses() const { return m_misses; }
+
+    static constexpr std::size_t DEFAULT_MAX_RUNS = 256;
+    static constexpr std::size_t RESERVED_GLYPHS = 128;    ///< Text bytes and quads each run has room for
+
+private:
+    // Recency list and hash of one run, parallel to m_runs
+    struct Entry {
+        std::size_t hash = 0;
+        int newer = -1;
+        int older = -1;
+    };
+
+    static constexpr int EMPTY_SLOT = -1;
+
+    Font m_font{};
+    float m_spacingRatio = 0.0f;
+    int m_minFontSize = 1;
+    std::vector<int> m_asciiGlyphs;     ///< Codepoint -> glyph index for the first 128 codepoints
+    std::size_t m_maxRuns;
+    std::vector<TextRun> m_runs;        ///< Fixed storage, m_maxRuns runs once allocated
+    std::vector<Entry> m_entries;
+    std::vector<int> m_slots;           ///< Open-addressed (linear probing) run indices, a power of two long
+    std::size_t m_count = 0;            ///< Runs in use, m_runs[0, m_count)
+    int m_newest = -1;
+    int m_oldest = -1;
+    unsigned long long m_hits = 0;
+    unsigned long long m_misses = 0;
+
+    void allocateStorage();
+    int findRun(std::size_t hash, std::string_view text, int fontSize) const;
+    void insertSlot(int run);
+    void eraseSlot(int run);
+    void unlink(int run);
+    void pushNewest(int run);
+    int glyphIndex(int codepoint) const;
+    void layout(TextRun& run, std::string_view text, int fontSize) const;
+};
@@ -0,0 +1,81 @@
+/**
+ * @file TextRenderer.h
+ * @brief All UI text: one font atlas, cached layouts, batched quads
+ *
+ * Drop-in replacement for DrawText/MeasureText. The font is loaded once:
+ * a signed-distance-field atlas built from assets/fonts/arial.ttf when
+ * that file exists and OpenGL 3.3 is available (sharp at every size from
+ * one atlas, drawn with a small SDF shader), otherwise raylib's default
+ * font, which looks exactly like DrawText. Strings are laid out once per
+ * (string, size) by a TextLayoutCache and submitted as one run of quads
+ * into raylib's render batch.
+ *
+ * With the default font the atlas is also the shapes texture, so text
+ * and rectangles share draw calls. The SDF shader has to be switched on
+ * and off around each string; a text-heavy screen wraps its text in
+ * beginBatch()/endBatch() to switch it once.
+ *
+ * Needs a window; GPU resources are created on first use and released
+ * by unload(), which must run before CloseWindow().
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <string_view>
+
+#include "TextLayoutCache.h"
+
+/**
+ * @brief Static text drawing facade
+ */
+class TextRenderer {
+public:
+    /**
+     * @brief Draws text like DrawText(text, x, y, fontSize, color)
+     */
+    static void draw(std::string_view text, int x, int y, int fontSize, Color color);
+
+    /**
+     * @brief Text width in pixels, like MeasureText(text, fontSize)
+     */
+    static int measure(std::string_view text, int fontSize);
+
+    /**
+     * @brief Keeps the SDF shader on until endBatch(); nests
+     *
+     * Only text and plain shapes (DrawRectangle and friends) may be drawn
+     * inside a batch: the shader would sharpen the edges of other textures.
+     */
+    static void beginBatch();
+    static void endBatch();
+
+    /**
+     * @brief Releases the atlas and shader; the next draw loads them again
+     */
+    static void unload();
+
+    static bool isSdf() { return s_sdf; }
+    static const TextLayoutCache& getCache() { return s_cache; }
+
+    static constexpr const char* FONT_PATH = "assets/fonts/arial.ttf";
+    static constexpr int SDF_BASE_SIZE = 48;        ///< Glyph size the distance field is generated at
+    static constexpr int SDF_GLYPHS = 95;           ///< Printable ASCII
+    static constexpr int MAX_QUADS_PER_SUBMIT = 1024;
+
+private:
+    static bool s_loaded;
+    static bool s_sdf;
+    static Font s_font;
+    static Shader s_sdfShader;
+    static TextLayoutCache s_cache;
+    static int s_batchDepth;
+
+    static void load();
+    static bool loadSdfFont();
+    static void submit(const TextRun& run, float x, float y, Color color);
+};
@@ -0,0 +1,137 @@
+/**
+ * @file Transport.h
+ * @brief Byte-stream connection used by the multiplayer session
+ *
+ * NetworkSession only ever talks to a Transport, so the same game code runs
+ * over a real TCP socket, over UDP with its own reliability layer (see
+ * UdpTransport) or over an in-process link (see NetworkSimulator) that
+ * tests and benchmarks drive without touching the network.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "NetSocket.h"
+
+/**
+ * @brief Reliable, ordered, non-blocking byte stream
+ *
+ * Writes may be accepted partially and reads may return any slice of the
+ * stream, exactly like a non-blocking TCP socket; message framing is the
+ * caller's job (NetSync::feed).
+ */
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    /**
+     * @brief Advances connection setup
+     * @return true once the stream is usable
+     */
+    virtual bool poll() = 0;
+
+    /**
+     * @brief Whether the stream is established and has not failed
+     */
+    virtual bool isConnected() const = 0;
+
+    /**
+     * @brief Whether the stream is gone for good (refused, reset, closed)
+     *
+     * A connection that is still being set up is neither connected nor closed.
+     */
+    virtual bool isClosed() const = 0;
+
+    /**
+     * @brief Writes as much of the data as the stream accepts right now
+     * @return Bytes accepted, 0 if it would block, -1 if the connection failed
+     */
+    virtual long send(const char* data, size_t size) = 0;
+
+    /**
+     * @brief Reads whatever data has arrived
+     * @return Bytes read, 0 if nothing is available, -1 if the peer closed or the connection failed
+     */
+    virtual long receive(char* buffer, size_t size) = 0;
+
+    /**
+     * @brief Closes the stream; further calls fail
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief Hands the underlying socket over to the caller, if there is one
+     * @return The socket (the transport is closed afterwards), or INVALID_SOCKET
+     */
+    virtual SOCKET releaseSocket() { return INVALID_SOCKET; }
+
+    /**
+     * @brief Gives timer-driven transports (resends, keepalives) a chance to run
+     */
+    virtual void pump(float deltaTime) { (void)deltaTime; }
+
+    /**
+     * @brief Whether sendPresence() bypasses the ordered stream
+     *
+     * Without one, callers fall back to sending presence in the stream.
+     */
+    virtual bool hasUnreliableChannel() const { return false; }
+
+    /**
+     * @brief Sends a latest-wins payload that may be dropped, never resent
+     */
+    virtual bool sendPresence(const std::string& payload) { (void)payload; return false; }
+
+    /**
+     * @brief Takes the newest presence payload received since the last call
+     */
+    virtual bool receivePresence(std::string& payload) { (void)payload; return false; }
+
+    /**
+     * @brief Short protocol name for the status display
+     */
+    virtual const char* getName() const = 0;
+};
+
+/**
+ * @brief Transport over a non-blocking TCP socket
+ */
+class TcpTransport : public Transport {
+public:
+    /**
+     * @brief Takes ownership of a socket
+     * @param sock Non-blocking socket
+     * @param connected false while a non-blocking connect() is still in progress
+     */
+    explicit TcpTransport(SOCKET sock, bool connected = true);
+    ~TcpTransport() override;
+
+    TcpTransport(const TcpTransport&) = delete;
+    TcpTransport& operator=(const TcpTransport&) = delete;
+
+    /**
+     * @brief Starts a non-blocking connection to a server
+     * @return The transport (poll() reports when it is established), or nullptr on failure
+     */
+    static std::unique_ptr<TcpTransport> connectTo(const std::string& ip, unsigned short port);
+
+    bool poll() override;
+    bool isConnected() const override { return m_connected; }
+    bool isClosed() const override { return m_socket == INVALID_SOCKET; }
+    long send(const char* data, size_t size) override;
+    long receive(char* buffer, size_t size) override;
+    void close() override;
+    SOCKET releaseSocket() override;
+    const char* getName() const override { return "TCP"; }
+
+private:
+    SOCKET m_socket;
+    bool m_connected;
+};
@@ -0,0 +1,77 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Lock-free single-producer/single-consumer "latest value" handoff
+ *
+ * The writer fills its private buffer and publishes it; the reader picks
+ * up the most recently published one. Neither side ever waits for the
+ * other: a writer running ahead simply overwrites a value nobody read,
+ * and a reader running ahead keeps the one it has. Three buffers make
+ * that possible - one owned by each side and one in the middle, swapped
+ * with a single atomic exchange.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Triple buffer for one writer thread and one reader thread
+ * @tparam T Payload; reused in place, so containers keep their capacity
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // === Writer side ===
+
+    /**
+     * @brief The buffer the writer may fill; still holds what it wrote two publishes ago
+     */
+    T& writeBuffer() { return m_buffers[m_writeIndex]; }
+
+    /**
+     * @brief Hands the write buffer to the reader and takes the middle one in exchange
+     */
+    void publish() {
+        uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_writeIndex | FRESH_BIT), std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+    }
+
+    // === Reader side ===
+
+    /**
+     * @brief Switches to the newest published buffer, if there is one
+     * @return True when read() now returns a value it did not return before
+     */
+    bool update() {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) {
+            return false;
+        }
+        uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief The reader's current buffer (default-constructed until the first publish)
+     */
+    const T& read() const { return m_buffers[m_readIndex]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;   ///< Set while the middle buffer is unread
+
+    T m_buffers[3]{};
+    uint8_t m_writeIndex = 0;                   ///< Writer thread only
+    uint8_t m_readIndex = 1;                    ///< Reader thread only
+    std::atomic<uint8_t> m_middle{2};
+};
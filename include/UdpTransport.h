@@ -0,0 +1,144 @@
+/**
+ * @file UdpTransport.h
+ * @brief Optional UDP transport with reliable-ordered and presence channels
+ *
+ * Over TCP a single lost segment holds back everything behind it until the
+ * kernel's retransmit timer fires (200 ms or more), which on lossy Wi-Fi
+ * shows up as a frozen opponent. UdpTransport runs the game's byte stream
+ * over a ReliableChannel instead, which resends after about one round trip
+ * and acks up to 33 packets per datagram, and carries cursor/hover presence
+ * outside the ordered stream so it never waits for a resend.
+ *
+ * Clients try UDP first when asked to and fall back to TCP if the server
+ * does not answer; servers listen on both (see NetworkSession).
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "NetSocket.h"
+#include "ReliableChannel.h"
+#include "Transport.h"
+
+/**
+ * @brief Transport to one peer over UDP
+ *
+ * Client transports own their socket; server transports share the
+ * UdpListener's socket and are fed the datagrams it routes to them.
+ */
+class UdpTransport : public Transport {
+public:
+    ~UdpTransport() override;
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    /**
+     * @brief Starts a connection to a server (poll() reports when it answers)
+     * @param unanswered Set to true if the server never answers, so the caller can fall back to TCP
+     * @return The transport, or nullptr if no socket could be created
+     */
+    static std::unique_ptr<UdpTransport> connectTo(const std::string& ip, unsigned short port,
+                                                   std::shared_ptr<bool> unanswered = nullptr);
+
+    bool poll() override;
+    bool isConnected() const override { return m_state == State::CONNECTED; }
+    bool isClosed() const override { return m_state == State::CLOSED; }
+    long send(const char* data, size_t size) override;
+    long receive(char* buffer, size_t size) override;
+    void close() override;
+    void pump(float deltaTime) override;
+    bool hasUnreliableChannel() const override { return true; }
+    bool sendPresence(const std::string& payload) override;
+    bool receivePresence(std::string& payload) override;
+    const char* getName() const override { return "UDP"; }
+
+    const ReliableChannel& getChannel() const { return m_channel; }
+
+    static constexpr float CONNECT_RETRY_INTERVAL = 0.25f; // seconds between CONNECT packets
+    static constexpr float CONNECT_TIMEOUT = 3.0f;         // seconds without ACCEPT before giving up
+    static constexpr float PEER_TIMEOUT = 10.0f;           // seconds of silence before the peer is gone
+    static constexpr size_t MAX_DATAGRAM = 2048;
+
+private:
+    friend class UdpListener;
+
+    // Socket closed when its last user goes away
+    struct SharedSocket {
+        SOCKET sock;
+        explicit SharedSocket(SOCKET s) : sock(s) {}
+        ~SharedSocket() { CLOSE_SOCKET(sock); }
+    };
+    using Inbox = std::deque<std::string>;
+
+    enum class State { CONNECTING, CONNECTED, CLOSED };
+
+    UdpTransport(std::shared_ptr<SharedSocket> sock, const sockaddr_in& peer,
+                 std::shared_ptr<Inbox> inbox, State state);
+
+    std::shared_ptr<SharedSocket> m_socket;
+    sockaddr_in m_peer;
+    std::shared_ptr<Inbox> m_inbox;       ///< Server side: datagrams routed by the listener
+    std::shared_ptr<bool> m_unanswered;
+    State m_state;
+    float m_connectTimer;
+    float m_connectRetryTimer;
+    ReliableChannel m_channel;
+    std::vector<std::string> m_packets;   ///< Scratch list reused for every transmit
+
+    bool nextDatagram(std::string& datagram);
+    void handleDatagram(const std::string& datagram);
+    void sendControl(PacketType type);
+    void transmitPackets();
+};
+
+/**
+ * @brief Server-side UDP socket that turns CONNECT packets into transports
+ */
+class UdpListener {
+public:
+    UdpListener() = default;
+    ~UdpListener();
+
+    UdpListener(const UdpListener&) = delete;
+    UdpListener& operator=(const UdpListener&) = delete;
+
+    /**
+     * @brief Binds a UDP port on all interfaces (0 picks a free port)
+     */
+    bool open(unsigned short port);
+    void close();
+    bool isOpen() const { return m_socket != nullptr; }
+
+    /**
+     * @brief The bound port, useful after open(0)
+     */
+    unsigned short getPort() const;
+
+    /**
+     * @brief Routes waiting datagrams to their transports and returns a new peer, if any
+     */
+    std::unique_ptr<Transport> accept();
+
+    static constexpr size_t MAX_INBOX = 256; // datagrams buffered for a transport that is not pumped
+
+private:
+    struct Peer {
+        sockaddr_in address;
+        std::weak_ptr<UdpTransport::Inbox> inbox;
+    };
+
+    std::shared_ptr<UdpTransport::SharedSocket> m_socket;
+    std::vector<Peer> m_peers;
+    std::deque<std::unique_ptr<Transport>> m_accepted;
+
+    void receiveAll();
+};
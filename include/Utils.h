@@ -14,6 +14,7 @@
 
 #include <raylib.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <random>
 #include <chrono>
@@ -35,10 +36,11 @@ public:
     Utils() = delete; // Static class, no constructor
 
     // === LOGGING FUNCTIONS ===
-    static void logInfo(const std::string& message);
-    static void logWarning(const std::string& message);
-    static void logError(const std::string& message);
-    static void logDebug(const std::string& message);
+    // A string_view, so a literal message is not copied into a std::string first
+    static void logInfo(std::string_view message);
+    static void logWarning(std::string_view message);
+    static void logError(std::string_view message);
+    static void logDebug(std::string_view message);
 
     // === MATH UTILITIES ===
     static int randomInt(int min, int max);
@@ -77,6 +79,17 @@ public:
         }
         std::shuffle(vec.begin(), vec.end(), s_rng);
     }
+    // Seeded Fisher-Yates: the same seed gives the same order with every
+    // standard library (std::shuffle's algorithm is left unspecified).
+    // Draws vec.size() - 1 values from rng (a std::mt19937 or a callable
+    // wrapping one).
+    template<typename T, typename Rng>
+    static void shuffle(std::vector<T>& vec, Rng& rng) {
+        for (std::size_t i = vec.size(); i > 1; --i) {
+            std::size_t j = static_cast<std::size_t>(rng() % i);
+            std::swap(vec[i - 1], vec[j]);
+        }
+    }
     static std::vector<int> range(int start, int end);
     static std::vector<int> createCardPairs(int numPairs);
 
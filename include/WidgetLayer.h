@@ -0,0 +1,111 @@
+/**
+ * @file WidgetLayer.h
+ * @brief Per-frame widget list shared by drawing and input
+ *
+ * Each menu screen declares its buttons while it draws: begin(), then one
+ * button() per widget, then draw(). The next update() tests input against
+ * that same list - exactly what is on screen - in one pass that handles
+ * hover, clicks, keyboard focus and activation. Geometry is therefore
+ * computed once per frame, and what reacts to the mouse is by
+ * construction what was drawn.
+ *
+ * Widgets live in an arena: begin() only resets a count, so the entries
+ * and their label strings are reused from frame to frame and a screen
+ * that declares the same buttons every frame allocates nothing.
+ *
+ * @author MSTC DA-IICT
+ * @version 1.0.0
+ * @date 2025-10-14
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A button declared for the current frame
+ */
+struct Widget {
+    int id = -1;                ///< Caller's action id, returned when activated
+    Rectangle bounds{};
+    std::string label;
+    Color color = LIGHTGRAY;
+};
+
+/**
+ * @brief The input a widget pass looks at
+ */
+struct WidgetInput {
+    Vector2 mouse{0.0f, 0.0f};
+    bool mouseMoved = false;
+    bool clicked = false;       ///< Left button pressed this frame
+    int navigate = 0;           ///< -1 previous widget, +1 next
+    bool activate = false;      ///< Activates the focused widget
+
+    /**
+     * @brief This frame's mouse, arrow keys and Enter
+     */
+    static WidgetInput poll();
+};
+
+/**
+ * @brief Widgets of one screen, redeclared every frame
+ */
+class WidgetLayer {
+public:
+    /**
+     * @brief Starts declaring the widgets of a screen
+     *
+     * Focus carries over while the same screen keeps being declared
+     * (widgets are matched by position in the list) and is cleared when
+     * the screen changes.
+     */
+    void begin(int screen);
+
+    /**
+     * @brief Declares a button
+     */
+    void button(int id, Rectangle bounds, std::string_view label, Color color = LIGHTGRAY);
+
+    /**
+     * @brief Hover, focus and activation for this frame's input
+     * @param screen Screen whose input this is; widgets declared for another screen ignore it
+     * @return Id of the widget clicked or activated, or -1
+     */
+    int update(int screen, const WidgetInput& input);
+
+    /**
+     * @brief Draws every widget, the focused one highlighted
+     * @param scale Screen pixels per design pixel
+     */
+    void draw(float scale) const;
+
+    /**
+     * @brief Id of the focused widget, or -1
+     */
+    int getFocused() const;
+
+    int getScreen() const { return m_screen; }
+    std::size_t size() const { return m_count; }
+    const Widget& at(std::size_t index) const { return m_widgets[index]; }
+
+    /**
+     * @brief Draws one button in the menu style
+     */
+    static void drawButton(std::string_view label, Rectangle bounds, bool highlighted, Color color, float scale);
+
+    static constexpr int NO_SCREEN = -1;
+
+private:
+    std::vector<Widget> m_widgets;  ///< Arena; only the first m_count are this frame's
+    std::size_t m_count = 0;
+    int m_screen = NO_SCREEN;
+    int m_focus = -1;               ///< Index into m_widgets
+    bool m_hoverPending = false;    ///< New screen: take focus from the mouse even if it did not move
+
+    int widgetAt(Vector2 point) const;
+};
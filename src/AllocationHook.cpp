@@ -0,0 +1,37 @@
+/**
+ * @file AllocationHook.cpp
+ * @brief Global operator new replacement that feeds AllocationTracker
+ *
+ * Not part of the game's sources: linking this file is what turns
+ * allocation counting on (TRACK_ALLOCATIONS, the tests, memory_perf).
+ * The other forms of operator new (array, nothrow) forward to this one;
+ * nothing in the game uses over-aligned types, so the aligned forms are
+ * left to the library and not counted.
+ */
+
+#include "../include/AllocationTracker.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Runs during static initialization; counting itself works from the first allocation
+const bool s_installed = (AllocationTracker::markInstalled(), true);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    AllocationTracker::recordAllocation(size);
+    if (void* memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
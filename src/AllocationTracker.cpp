@@ -0,0 +1,155 @@
+/**
+ * @file AllocationTracker.cpp
+ * @brief Allocation counters, frame and phase bookkeeping, the budget check
+ */
+
+#include "../include/AllocationTracker.h"
+#include "../include/TextRenderer.h"
+#include "../include/Utils.h"
+#include <raylib.h>
+#include <atomic>
+#include <algorithm>
+#include <string>
+
+namespace {
+
+// Constant-initialized, so the hook can count allocations made before main()
+std::atomic<std::uint64_t> s_allocations{0};
+std::atomic<std::uint64_t> s_bytes{0};
+std::atomic<bool> s_installed{false};
+
+const char* const PHASE_NAMES[] = {"update", "draw"};
+
+AllocationCounts since(const AllocationCounts& start) {
+    AllocationCounts now = AllocationTracker::current();
+    return {now.allocations - start.allocations, now.bytes - start.bytes};
+}
+
+void add(AllocationCounts& to, const AllocationCounts& counts) {
+    to.allocations += counts.allocations;
+    to.bytes += counts.bytes;
+}
+
+std::string describe(const AllocationCounts& counts) {
+    return std::to_string(counts.allocations) + " (" + std::to_string(counts.bytes) + " B)";
+}
+
+std::string describePhases(const FrameAllocations& frame) {
+    std::string text;
+    for (int i = 0; i < static_cast<int>(AllocationPhase::COUNT); ++i) {
+        text += std::string(i > 0 ? ", " : "") + PHASE_NAMES[i] + " " + describe(frame.phases[i]);
+    }
+    return text;
+}
+
+} // namespace
+
+AllocationTracker::AllocationTracker()
+    : m_phase(-1),
+      m_frames(0),
+      m_violations(0),
+      m_budgetedFrames(0)
+{
+}
+
+// === The hook's side ===
+
+void AllocationTracker::recordAllocation(std::size_t bytes) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::markInstalled() {
+    s_installed.store(true, std::memory_order_relaxed);
+}
+
+bool AllocationTracker::isInstalled() {
+    return s_installed.load(std::memory_order_relaxed);
+}
+
+AllocationCounts AllocationTracker::current() {
+    return {s_allocations.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed)};
+}
+
+// === Frames and phases ===
+
+void AllocationTracker::beginFrame() {
+    m_frame = FrameAllocations();
+    m_phase = -1;
+    m_frameStart = current();
+}
+
+void AllocationTracker::endFrame(bool budgeted) {
+    if (m_phase >= 0) {
+        endPhase();
+    }
+    m_frame.total = since(m_frameStart);
+    m_lastFrame = m_frame;
+    if (m_frame.total.allocations > m_worstFrame.total.allocations) {
+        m_worstFrame = m_frame;
+    }
+    ++m_frames;
+
+    if (!budgeted) {
+        m_budgetedFrames = 0;
+        return;
+    }
+    if (++m_budgetedFrames <= BUDGET_WARMUP_FRAMES || m_frame.total.allocations == 0) {
+        return;
+    }
+    if (++m_violations <= MAX_REPORTED_VIOLATIONS) {
+        Utils::logWarning("Allocation budget: frame " + std::to_string(m_frames) + " allocated " +
+                          describe(m_frame.total) + ": " + describePhases(m_frame));
+    }
+}
+
+void AllocationTracker::beginPhase(AllocationPhase phase) {
+    if (m_phase >= 0) {
+        endPhase();
+    }
+    m_phase = static_cast<int>(phase);
+    m_phaseStart = current();
+}
+
+void AllocationTracker::endPhase() {
+    if (m_phase < 0) {
+        return;
+    }
+    add(m_frame.phases[m_phase], since(m_phaseStart));
+    m_phase = -1;
+}
+
+// === Reporting ===
+
+void AllocationTracker::drawOverlay(int x, int y) const {
+    std::string lines[3];
+    if (!isInstalled()) {
+        lines[0] = "Allocations: not tracked";
+        lines[1] = "(configure with -DTRACK_ALLOCATIONS=ON)";
+    } else {
+        lines[0] = "Allocs: " + describe(m_lastFrame.total) + " this frame";
+        lines[1] = "  " + describePhases(m_lastFrame);
+        lines[2] = "Worst " + describe(m_worstFrame.total) + ", over budget " + std::to_string(m_violations) + " frames";
+    }
+
+    int width = 0;
+    for (const std::string& line : lines) {
+        width = std::max(width, TextRenderer::measure(line, 16));
+    }
+    const Color color = m_lastFrame.total.allocations == 0 ? LIME : ORANGE;
+    DrawRectangle(x, y, width + 16, 3 * 20 + 8, ColorAlpha(BLACK, 0.7f));
+    for (int i = 0; i < 3; ++i) {
+        TextRenderer::draw(lines[i], x + 8, y + 6 + i * 20, 16, color);
+    }
+}
+
+void AllocationTracker::logSummary() const {
+    if (!isInstalled()) {
+        return;
+    }
+    Utils::logInfo("Allocations: worst frame " + describe(m_worstFrame.total) + " (" + describePhases(m_worstFrame) +
+                   ") over " + std::to_string(m_frames) + " frames");
+    if (m_violations > 0) {
+        Utils::logWarning("Allocation budget exceeded in " + std::to_string(m_violations) + " steady PLAYING frames");
+    }
+}
@@ -1,5 +1,8 @@
 #include "../include/Card.h"
+#include "../include/RenderSnapshot.h"
+#include "../include/TextRenderer.h"
 #include "../include/Utils.h"
+#include <cmath>
 
 Texture2D Card::s_defaultBackTexture{};
 bool Card::s_defaultTexturesLoaded = false;
@@ -10,18 +13,30 @@ Card::Card(int id, const std::string& texturePath, Vector2 position, Vector2 siz
     m_scaleX(1.0f), m_tint(WHITE), m_rotation(0.0f), m_isHovered(false),
       m_texturePath(texturePath)
 {
+    m_previousPosition = position;
+}
+
+Card::~Card() {
+    UnloadTexture(m_frontTexture);
+}
+
+void Card::loadTextures() {
+    if (m_texturePath.empty() || m_frontTexture.id != 0) {
+        return; // logic only, or loaded already
+    }
+
     if (!s_defaultTexturesLoaded) {
         loadDefaultTextures();
     }
     
     // Try to load texture from file. If loading fails, fall back to generated texture.
-    if (FileExists(texturePath.c_str())) {
-        Texture2D tmp = LoadTexture(texturePath.c_str());
+    if (FileExists(m_texturePath.c_str())) {
+        Texture2D tmp = LoadTexture(m_texturePath.c_str());
         if (tmp.width > 0 && tmp.height > 0) {
             m_frontTexture = tmp;
         } else {
             // Loading failed - log and generate fallback
-            Utils::logError(std::string("Failed to load front texture: ") + texturePath + ". Using generated color texture.");
+            Utils::logError(std::string("Failed to load front texture: ") + m_texturePath + ". Using generated color texture.");
             // ensure any invalid texture is unloaded
             if (tmp.id != 0) UnloadTexture(tmp);
             // fall through to generate
@@ -31,13 +46,7 @@ Card::Card(int id, const std::string& texturePath, Vector2 position, Vector2 siz
     // If front texture not loaded from file, generate a unique colored texture for this card ID
     if (m_frontTexture.id == 0) {
         // Generate a unique colored texture for this card ID
-        Color cardColor = Utils::colorFromHSV(m_id * 30.0f, 0.8f, 0.9f);
-        Image frontImg = GenImageColor(static_cast<int>(size.x), static_cast<int>(size.y), cardColor);
-        
-        // Draw card ID number on it
-        ImageDrawRectangle(&frontImg, 10, 10, static_cast<int>(size.x) - 20, static_cast<int>(size.y) - 20, WHITE);
-        ImageDrawRectangle(&frontImg, 15, 15, static_cast<int>(size.x) - 30, static_cast<int>(size.y) - 30, cardColor);
-        
+        Image frontImg = generateFrontImage(m_id, static_cast<int>(m_size.x), static_cast<int>(m_size.y));
         m_frontTexture = LoadTextureFromImage(frontImg);
         UnloadImage(frontImg);
     }
@@ -45,10 +54,6 @@ Card::Card(int id, const std::string& texturePath, Vector2 position, Vector2 siz
     m_backTexture = s_defaultBackTexture;
 }
 
-Card::~Card() {
-    UnloadTexture(m_frontTexture);
-}
-
 void Card::flipUp() {
     if (m_state == CardState::FACE_DOWN) {
         m_state = CardState::FLIPPING_UP;
@@ -58,6 +63,10 @@ void Card::flipUp() {
 void Card::flipDown() {
     if (m_state == CardState::FACE_UP) {
         m_state = CardState::FLIPPING_DOWN;
+    } else if (m_state == CardState::FLIPPING_UP) {
+        // Turn back from part way: the flip amount carries on from where it is
+        m_state = CardState::FLIPPING_DOWN;
+        m_animationProgress = 1.0f - m_animationProgress;
     }
 }
 
@@ -83,6 +92,8 @@ Rectangle Card::getBounds() const {
 
 void Card::setPosition(Vector2 pos) {
     m_position = pos;
+    m_previousPosition = pos; // a jump, not a move: nothing to interpolate
+    m_isMoving = false;
 }
 
 void Card::setSize(Vector2 size) {
@@ -96,6 +107,9 @@ bool Card::containsPoint(Vector2 point) const {
 }
 
 void Card::update(float deltaTime) {
+    m_previousPosition = m_position;
+    m_previousFlip = currentFlipAmount();
+
     // Update movement first (position lerp)
     if (m_isMoving) {
         m_moveTimer += deltaTime;
@@ -148,6 +162,28 @@ void Card::update(float deltaTime) {
     }
 }
 
+float Card::getFlipAmount(float alpha) const {
+    return Utils::lerp(m_previousFlip, currentFlipAmount(), alpha);
+}
+
+Vector2 Card::getRenderPosition(float alpha) const {
+    return {Utils::lerp(m_previousPosition.x, m_position.x, alpha),
+            Utils::lerp(m_previousPosition.y, m_position.y, alpha)};
+}
+
+float Card::currentFlipAmount() const {
+    switch (m_state) {
+        case CardState::FACE_DOWN: return 0.0f;
+        case CardState::FACE_UP:
+        case CardState::MATCHED: return 1.0f;
+        default: break;
+    }
+    // Smoothstep: slow start and finish, fastest when the card is edge-on
+    float p = m_animationProgress;
+    float eased = p * p * (3.0f - 2.0f * p);
+    return m_state == CardState::FLIPPING_UP ? eased : 1.0f - eased;
+}
+
 void Card::moveTo(Vector2 target, float duration) {
     m_moveStart = m_position;
     m_moveTarget = target;
@@ -160,110 +196,158 @@ bool Card::isMoving() const {
     return m_isMoving;
 }
 
-void Card::draw() const {
-    Rectangle rect = getBounds();
-    // If the card is animating a flip, we draw a scaled version (scaleX) and swap
-    // the texture at the midpoint to create a smooth flip illusion.
-    if (m_state == CardState::FLIPPING_UP || m_state == CardState::FLIPPING_DOWN) {
-        float p = m_animationProgress; // 0..1
-        bool showFront = false;
-        if (m_state == CardState::FLIPPING_UP) {
-            showFront = (p >= 0.5f);
-        } else { // FLIPPING_DOWN
-            showFront = (p < 0.5f);
-        }
+bool Card::isSettled() const {
+    return !m_isMoving && !isAnimating() &&
+           m_previousPosition.x == m_position.x && m_previousPosition.y == m_position.y &&
+           m_previousFlip == currentFlipAmount();
+}
 
-        // Compute destination rect centered with scaled width
-        float drawWidth = rect.width * std::max(0.001f, m_scaleX);
-        float drawX = rect.x + (rect.width - drawWidth) * 0.5f;
-        Rectangle sourceRect = {0, 0, (float)(showFront ? m_frontTexture.width : m_backTexture.width), (float)(showFront ? m_frontTexture.height : m_backTexture.height)};
-        Rectangle destRect = { drawX, rect.y, drawWidth, rect.height };
-        if (showFront) {
-            DrawTexturePro(m_frontTexture, sourceRect, destRect, {0,0}, 0.0f, WHITE);
-            // draw id text when front is visible and scale is reasonably large
-            if (m_scaleX > 0.35f) {
-                std::string idText = std::to_string(m_id);
-                int fontSize = static_cast<int>(rect.height * 0.4f);
-                int textWidth = MeasureText(idText.c_str(), fontSize);
-                DrawText(idText.c_str(), 
-                         static_cast<int>(rect.x + rect.width / 2 - textWidth / 2), 
-                         static_cast<int>(rect.y + rect.height / 2 - fontSize / 2), 
-                         fontSize, BLACK);
-            }
-        } else {
-            DrawTexturePro(m_backTexture, sourceRect, destRect, {0,0}, 0.0f, WHITE);
-        }
-    } else {
-        // Not animating: draw normally depending on revealed state
-        if (isRevealed()) {
-            Rectangle sourceRect = {0, 0, (float)m_frontTexture.width, (float)m_frontTexture.height};
-            Rectangle destRect = {rect.x, rect.y, rect.width, rect.height};
-            DrawTexturePro(m_frontTexture, sourceRect, destRect, {0, 0}, 0.0f, WHITE);
-
-            // Draw card ID number on front
-            std::string idText = std::to_string(m_id);
-            int fontSize = static_cast<int>(rect.height * 0.4f); // Scale font with card size
-            int textWidth = MeasureText(idText.c_str(), fontSize);
-            DrawText(idText.c_str(), 
-                     static_cast<int>(rect.x + rect.width / 2 - textWidth / 2), 
-                     static_cast<int>(rect.y + rect.height / 2 - fontSize / 2), 
-                     fontSize, BLACK);
-        } else {
-            Rectangle sourceRect = {0, 0, (float)m_backTexture.width, (float)m_backTexture.height};
-            Rectangle destRect = {rect.x, rect.y, rect.width, rect.height};
-            DrawTexturePro(m_backTexture, sourceRect, destRect, {0, 0}, 0.0f, WHITE);
-        }
+void Card::saveState(LogicState& state) const {
+    state.state = m_state;
+    state.position = m_position;
+    state.previousPosition = m_previousPosition;
+    state.previousFlip = m_previousFlip;
+    state.animationProgress = m_animationProgress;
+    state.scaleX = m_scaleX;
+    state.isMoving = m_isMoving;
+    state.moveStart = m_moveStart;
+    state.moveTarget = m_moveTarget;
+    state.moveTimer = m_moveTimer;
+    state.moveDuration = m_moveDuration;
+}
+
+void Card::restoreState(const LogicState& state) {
+    m_state = state.state;
+    m_position = state.position;
+    m_previousPosition = state.previousPosition;
+    m_previousFlip = state.previousFlip;
+    m_animationProgress = state.animationProgress;
+    m_scaleX = state.scaleX;
+    m_isMoving = state.isMoving;
+    m_moveStart = state.moveStart;
+    m_moveTarget = state.moveTarget;
+    m_moveTimer = state.moveTimer;
+    m_moveDuration = state.moveDuration;
+}
+
+void Card::fillSnapshot(CardSnapshot& snapshot) const {
+    snapshot.id = m_id;
+    snapshot.state = m_state;
+    snapshot.position = m_position;
+    snapshot.previousPosition = m_previousPosition;
+    snapshot.size = m_size;
+    snapshot.flip = currentFlipAmount();
+    snapshot.previousFlip = m_previousFlip;
+}
+
+void Card::draw(float alpha) const {
+    CardSnapshot snapshot;
+    fillSnapshot(snapshot);
+    draw(snapshot, alpha);
+}
+
+void Card::draw(const CardSnapshot& state, float alpha) const {
+    Rectangle rect = {Utils::lerp(state.previousPosition.x, state.position.x, alpha),
+                      Utils::lerp(state.previousPosition.y, state.position.y, alpha),
+                      state.size.x, state.size.y};
+    float flip = Utils::lerp(state.previousFlip, state.flip, alpha);
+
+    // Fake the turn by narrowing the card around its centre, swapping
+    // faces when it is edge-on
+    bool showFront = flip >= 0.5f;
+    float scaleX = std::fabs(std::cos(flip * PI));
+    const Texture2D& texture = showFront ? m_frontTexture : m_backTexture;
+    float drawWidth = rect.width * std::max(0.001f, scaleX);
+    Rectangle sourceRect = {0, 0, (float)texture.width, (float)texture.height};
+    Rectangle destRect = {rect.x + (rect.width - drawWidth) * 0.5f, rect.y, drawWidth, rect.height};
+    DrawTexturePro(texture, sourceRect, destRect, {0, 0}, 0.0f, WHITE);
+
+    // Draw card ID number on front, once it is wide enough to read
+    if (showFront && scaleX > 0.35f) {
+        std::string idText = std::to_string(m_id);
+        int fontSize = static_cast<int>(rect.height * 0.4f); // Scale font with card size
+        int textWidth = TextRenderer::measure(idText, fontSize);
+        TextRenderer::draw(idText,
+                           static_cast<int>(rect.x + rect.width / 2 - textWidth / 2),
+                           static_cast<int>(rect.y + rect.height / 2 - fontSize / 2),
+                           fontSize, BLACK);
     }
 
     // Draw border
     DrawRectangleLinesEx(rect, 2.0f, BORDER_COLOR);
-    
+
     // Draw glow effect for matched cards
-    if (isMatched()) {
+    if (state.state == CardState::MATCHED) {
         DrawRectangleLinesEx(rect, 4.0f, GREEN);
     }
 }
 
 // Static method implementations
-void Card::loadDefaultTextures() {
-    if (!s_defaultTexturesLoaded) {
-        // Prefer using a provided image for the card back if available.
-        const char* preferredPaths[] = {
-            "assets/textures/card_back.png",
-            "assets/textures/card1.png",
-            "assets/textures/back.png",
-            nullptr
-        };
-
-        bool loaded = false;
-        for (int i = 0; preferredPaths[i] != nullptr; ++i) {
-            const char* p = preferredPaths[i];
-            if (FileExists(p)) {
-                Texture2D tmp = LoadTexture(p);
-                if (tmp.width > 0 && tmp.height > 0) {
-                    s_defaultBackTexture = tmp;
-                    loaded = true;
-                    Utils::logInfo(std::string("Loaded card back texture: ") + p);
-                    break;
-                } else {
-                    Utils::logError(std::string("Failed to load back texture: ") + p + " - trying next option");
-                    if (tmp.id != 0) UnloadTexture(tmp);
-                }
-            }
+Image Card::generateFrontImage(int id, int width, int height) {
+    Color cardColor = Utils::colorFromHSV(id * 30.0f, 0.8f, 0.9f);
+    Image frontImg = GenImageColor(width, height, cardColor);
+    ImageDrawRectangle(&frontImg, 10, 10, width - 20, height - 20, WHITE);
+    ImageDrawRectangle(&frontImg, 15, 15, width - 30, height - 30, cardColor);
+    return frontImg;
+}
+
+Image Card::createFaceImage(int id, const std::string& texturePath, int width, int height) {
+    Image face{};
+    if (FileExists(texturePath.c_str())) {
+        face = LoadImage(texturePath.c_str());
+        if (face.data != nullptr) {
+            ImageResize(&face, width, height);
         }
+    }
+    if (face.data == nullptr) {
+        face = generateFrontImage(id, width, height);
+    }
+
+    // Bake the id number the way draw() prints it
+    std::string idText = std::to_string(id);
+    int fontSize = static_cast<int>(height * 0.4f);
+    int textWidth = MeasureText(idText.c_str(), fontSize);
+    ImageDrawText(&face, idText.c_str(), width / 2 - textWidth / 2, height / 2 - fontSize / 2, fontSize, BLACK);
+    return face;
+}
 
-        if (!loaded) {
-            // Fallback: create a small default back texture (will be scaled)
-            int texSize = 100;
-            Image backImg = GenImageColor(texSize, texSize, BLUE);
-            // Draw a pattern on the back (optional decoration)
-            ImageDrawRectangle(&backImg, texSize/10, texSize/10, texSize*8/10, texSize*8/10, DARKBLUE);
-            ImageDrawRectangle(&backImg, texSize/5, texSize/5, texSize*3/5, texSize*3/5, BLUE);
-            s_defaultBackTexture = LoadTextureFromImage(backImg);
-            UnloadImage(backImg);
-            Utils::logInfo("Generated default card back texture (fallback)");
+Image Card::createBackImage() {
+    // Prefer using a provided image for the card back if available.
+    const char* preferredPaths[] = {
+        "assets/textures/card_back.png",
+        "assets/textures/card1.png",
+        "assets/textures/back.png",
+        nullptr
+    };
+
+    for (int i = 0; preferredPaths[i] != nullptr; ++i) {
+        const char* p = preferredPaths[i];
+        if (FileExists(p)) {
+            Image tmp = LoadImage(p);
+            if (tmp.data != nullptr && tmp.width > 0 && tmp.height > 0) {
+                Utils::logInfo(std::string("Loaded card back texture: ") + p);
+                return tmp;
+            }
+            Utils::logError(std::string("Failed to load back texture: ") + p + " - trying next option");
+            UnloadImage(tmp);
         }
+    }
 
+    // Fallback: create a small default back texture (will be scaled)
+    int texSize = 100;
+    Image backImg = GenImageColor(texSize, texSize, BLUE);
+    // Draw a pattern on the back (optional decoration)
+    ImageDrawRectangle(&backImg, texSize/10, texSize/10, texSize*8/10, texSize*8/10, DARKBLUE);
+    ImageDrawRectangle(&backImg, texSize/5, texSize/5, texSize*3/5, texSize*3/5, BLUE);
+    Utils::logInfo("Generated default card back texture (fallback)");
+    return backImg;
+}
+
+void Card::loadDefaultTextures() {
+    if (!s_defaultTexturesLoaded) {
+        Image backImg = createBackImage();
+        s_defaultBackTexture = LoadTextureFromImage(backImg);
+        UnloadImage(backImg);
         s_defaultTexturesLoaded = true;
     }
 }
@@ -288,7 +372,9 @@ Card::Card(const Card& other)
       m_scaleX(other.m_scaleX),
       m_tint(other.m_tint),
       m_rotation(other.m_rotation),
-      m_isHovered(other.m_isHovered)
+      m_isHovered(other.m_isHovered),
+      m_previousPosition(other.m_previousPosition),
+      m_previousFlip(other.m_previousFlip)
 {
     // Load textures for the new card
     if (!other.m_texturePath.empty()) {
@@ -321,6 +407,8 @@ Card& Card::operator=(const Card& other) {
         m_tint = other.m_tint;
         m_rotation = other.m_rotation;
         m_isHovered = other.m_isHovered;
+        m_previousPosition = other.m_previousPosition;
+        m_previousFlip = other.m_previousFlip;
         
         // Load new texture
         if (!other.m_texturePath.empty()) {
@@ -351,7 +439,9 @@ Card::Card(Card&& other) noexcept
       m_scaleX(other.m_scaleX),
       m_tint(other.m_tint),
       m_rotation(other.m_rotation),
-      m_isHovered(other.m_isHovered)
+      m_isHovered(other.m_isHovered),
+      m_previousPosition(other.m_previousPosition),
+      m_previousFlip(other.m_previousFlip)
 {
     // Invalidate the moved-from object's texture
     other.m_frontTexture = Texture2D{};
@@ -378,6 +468,8 @@ Card& Card::operator=(Card&& other) noexcept {
         m_tint = other.m_tint;
         m_rotation = other.m_rotation;
         m_isHovered = other.m_isHovered;
+        m_previousPosition = other.m_previousPosition;
+        m_previousFlip = other.m_previousFlip;
         
         // Invalidate the moved-from object's texture
         other.m_frontTexture = Texture2D{};
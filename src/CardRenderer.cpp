@@ -0,0 +1,301 @@
+/**
+ * @file CardRenderer.cpp
+ * @brief Instanced card rendering implementation
+ */
+
+#include "../include/CardRenderer.h"
+#include "../include/Card.h"
+#include "../include/RenderSnapshot.h"
+#include "../include/Utils.h"
+#include <rlgl.h>
+#include <raymath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+// The card turns about its vertical axis; dividing by the depth gives
+// the near edge its perspective, and scaling gl_Position by the same
+// factor keeps the texture interpolation perspective-correct
+const char* CARD_VS = R"(#version 330
+in vec2 vertexPosition;
+in vec4 instanceRect;
+in vec2 instanceFace;
+in float instanceFlip;
+uniform mat4 mvp;
+out vec2 fragUV;
+flat out float fragFacing;
+flat out float fragSlot;
+flat out float fragMatched;
+flat out vec2 fragSize;
+void main() {
+    float angle = instanceFlip*3.14159265;
+    vec2 local = (vertexPosition - 0.5)*instanceRect.zw;
+    float depth = local.x*sin(angle);
+    float eye = 4.0*max(instanceRect.z, instanceRect.w);
+    float w = (eye + depth)/eye;
+    vec2 center = instanceRect.xy + 0.5*instanceRect.zw;
+    vec2 projected = center + vec2(local.x*cos(angle), local.y)/w;
+    gl_Position = mvp*vec4(projected, 0.0, 1.0)*w;
+    fragUV = vertexPosition;
+    fragFacing = cos(angle);
+    fragSlot = instanceFace.x;
+    fragMatched = instanceFace.y;
+    fragSize = instanceRect.zw;
+}
+)";
+
+const char* CARD_FS = R"(#version 330
+in vec2 fragUV;
+flat in float fragFacing;
+flat in float fragSlot;
+flat in float fragMatched;
+flat in vec2 fragSize;
+uniform sampler2D atlas;
+uniform vec2 atlasGrid;
+out vec4 finalColor;
+void main() {
+    vec2 uv = fragUV;
+    float slot = 0.0;
+    if (fragFacing < 0.0) {
+        // Past edge-on the front faces us, seen from behind the quad
+        uv.x = 1.0 - uv.x;
+        slot = fragSlot;
+    }
+    vec2 cell = vec2(mod(slot, atlasGrid.x), floor(slot/atlasGrid.x));
+    vec4 color = texture(atlas, (cell + uv)/atlasGrid);
+
+    vec2 edges = min(fragUV, 1.0 - fragUV)*fragSize;
+    float edge = min(edges.x, edges.y);
+    if (edge < 2.0) color = vec4(200.0/255.0, 200.0/255.0, 200.0/255.0, 1.0);
+    if (fragMatched > 0.5 && edge < 4.0) color = vec4(0.0, 228.0/255.0, 48.0/255.0, 1.0);
+    finalColor = color;
+}
+)";
+
+const float QUAD_CORNERS[12] = {
+    0.0f, 0.0f,  0.0f, 1.0f,  1.0f, 1.0f,
+    0.0f, 0.0f,  1.0f, 1.0f,  1.0f, 0.0f,
+};
+
+} // namespace
+
+CardRenderer::~CardRenderer() {
+    unload();
+}
+
+// === Resources ===
+
+void CardRenderer::load(const std::vector<CardSnapshot>& cards) {
+    m_loaded = true;
+    m_available = false;
+
+    const int version = rlGetVersion();
+    if (version != RL_OPENGL_33 && version != RL_OPENGL_43) {
+        Utils::logInfo("Instanced card rendering needs OpenGL 3.3, drawing cards one by one");
+        return;
+    }
+
+    m_shader = LoadShaderFromMemory(CARD_VS, CARD_FS);
+    if (!IsShaderReady(m_shader)) {
+        Utils::logWarning("Card shader failed to build, drawing cards one by one");
+        return;
+    }
+    m_mvpLoc = GetShaderLocation(m_shader, "mvp");
+
+    if (!buildAtlas(cards) || !buildBuffers()) {
+        Utils::logWarning("Card atlas or buffers unavailable, drawing cards one by one");
+        unload();
+        m_loaded = true;
+        return;
+    }
+
+    // Atlas grid and sampler never change for this board
+    float grid[2] = {static_cast<float>(m_atlasColumns), static_cast<float>(m_atlasRows)};
+    SetShaderValue(m_shader, GetShaderLocation(m_shader, "atlasGrid"), grid, SHADER_UNIFORM_VEC2);
+    int unit = 0;
+    SetShaderValue(m_shader, GetShaderLocation(m_shader, "atlas"), &unit, SHADER_UNIFORM_INT);
+
+    m_available = true;
+    Utils::logInfo("Instanced card rendering ready (" + Utils::toString(static_cast<int>(cards.size())) +
+                   " cards, " + Utils::toString(static_cast<int>(m_faceSlots.size())) + " faces)");
+}
+
+bool CardRenderer::buildAtlas(const std::vector<CardSnapshot>& cards) {
+    const Vector2 size = cards.front().size;
+    const int slotWidth = std::max(1, static_cast<int>(size.x));
+    const int slotHeight = std::max(1, static_cast<int>(size.y));
+
+    // Slot 0 is the back, then one slot per distinct id
+    std::map<int, int> faces;
+    for (const CardSnapshot& card : cards) {
+        faces.emplace(card.id, 0);
+    }
+    const int slots = 1 + static_cast<int>(faces.size());
+    m_atlasColumns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(slots))));
+    m_atlasRows = (slots + m_atlasColumns - 1) / m_atlasColumns;
+
+    Image atlas = GenImageColor(m_atlasColumns * slotWidth, m_atlasRows * slotHeight, BLANK);
+    auto place = [&](Image& image, int slot) {
+        Rectangle source = {0.0f, 0.0f, static_cast<float>(image.width), static_cast<float>(image.height)};
+        Rectangle dest = {static_cast<float>((slot % m_atlasColumns) * slotWidth),
+                          static_cast<float>((slot / m_atlasColumns) * slotHeight),
+                          static_cast<float>(slotWidth), static_cast<float>(slotHeight)};
+        ImageDraw(&atlas, image, source, dest, WHITE);
+        UnloadImage(image);
+    };
+
+    Image back = Card::createBackImage();
+    place(back, 0);
+
+    m_faceSlots.clear();
+    int slot = 1;
+    for (const auto& face : faces) {
+        Image image = Card::createFaceImage(face.first, m_faceTexturePath, slotWidth, slotHeight);
+        place(image, slot);
+        m_faceSlots[face.first] = slot++;
+    }
+
+    m_atlas = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    if (!IsTextureReady(m_atlas)) {
+        return false;
+    }
+    // Smooths the foreshortened faces; the border covers any bleed from neighbouring slots
+    SetTextureFilter(m_atlas, TEXTURE_FILTER_BILINEAR);
+    return true;
+}
+
+bool CardRenderer::buildBuffers() {
+    const int cornerLoc = GetShaderLocationAttrib(m_shader, "vertexPosition");
+    const int rectLoc = GetShaderLocationAttrib(m_shader, "instanceRect");
+    const int faceLoc = GetShaderLocationAttrib(m_shader, "instanceFace");
+    const int flipLoc = GetShaderLocationAttrib(m_shader, "instanceFlip");
+    if (cornerLoc < 0 || rectLoc < 0 || faceLoc < 0 || flipLoc < 0 || m_mvpLoc < 0) {
+        return false;
+    }
+
+    m_vao = rlLoadVertexArray();
+    rlEnableVertexArray(m_vao);
+
+    m_cornerVbo = rlLoadVertexBuffer(QUAD_CORNERS, sizeof(QUAD_CORNERS), false);
+    rlSetVertexAttribute(cornerLoc, 2, RL_FLOAT, false, 0, nullptr);
+    rlEnableVertexAttribute(cornerLoc);
+
+    // Real contents are sent by the first draw()
+    m_layoutVbo = rlLoadVertexBuffer(m_layout.data(), static_cast<int>(m_layout.size() * sizeof(CardLayout)), true);
+    rlSetVertexAttribute(rectLoc, 4, RL_FLOAT, false, sizeof(CardLayout),
+                         reinterpret_cast<const void*>(offsetof(CardLayout, x)));
+    rlEnableVertexAttribute(rectLoc);
+    rlSetVertexAttributeDivisor(rectLoc, 1);
+    rlSetVertexAttribute(faceLoc, 2, RL_FLOAT, false, sizeof(CardLayout),
+                         reinterpret_cast<const void*>(offsetof(CardLayout, faceSlot)));
+    rlEnableVertexAttribute(faceLoc);
+    rlSetVertexAttributeDivisor(faceLoc, 1);
+
+    m_flipVbo = rlLoadVertexBuffer(m_flip.data(), static_cast<int>(m_flip.size() * sizeof(float)), true);
+    rlSetVertexAttribute(flipLoc, 1, RL_FLOAT, false, 0, nullptr);
+    rlEnableVertexAttribute(flipLoc);
+    rlSetVertexAttributeDivisor(flipLoc, 1);
+
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    return m_vao != 0 && m_layoutVbo != 0 && m_flipVbo != 0;
+}
+
+void CardRenderer::unload() {
+    if (m_vao != 0) rlUnloadVertexArray(m_vao);
+    if (m_cornerVbo != 0) rlUnloadVertexBuffer(m_cornerVbo);
+    if (m_layoutVbo != 0) rlUnloadVertexBuffer(m_layoutVbo);
+    if (m_flipVbo != 0) rlUnloadVertexBuffer(m_flipVbo);
+    if (IsTextureReady(m_atlas)) UnloadTexture(m_atlas);
+    if (IsShaderReady(m_shader)) UnloadShader(m_shader);
+
+    m_vao = m_cornerVbo = m_layoutVbo = m_flipVbo = 0;
+    m_atlas = Texture2D{};
+    m_shader = Shader{};
+    m_mvpLoc = -1;
+    m_faceSlots.clear();
+    m_loaded = false;
+    m_available = false;
+}
+
+// === Drawing ===
+
+CardRenderer::CardLayout CardRenderer::layoutFor(const CardSnapshot& card, float alpha) const {
+    const auto slot = m_faceSlots.find(card.id);
+    return {Utils::lerp(card.previousPosition.x, card.position.x, alpha),
+            Utils::lerp(card.previousPosition.y, card.position.y, alpha),
+            card.size.x, card.size.y,
+            slot != m_faceSlots.end() ? static_cast<float>(slot->second) : 0.0f,
+            card.state == CardState::MATCHED ? 1.0f : 0.0f};
+}
+
+bool CardRenderer::draw(const std::vector<CardSnapshot>& cards, float alpha) {
+    if (cards.empty()) {
+        return true;
+    }
+    if (m_loaded && m_layout.size() != cards.size()) {
+        unload();
+    }
+    const bool fresh = !m_loaded;
+    if (fresh) {
+        // Sized before the buffers are created; filled in below
+        m_layout.assign(cards.size(), CardLayout{});
+        m_flip.assign(cards.size(), 0.0f);
+        load(cards);
+    }
+    if (!m_available) {
+        return false;
+    }
+
+    // Layout only changes while shuffling or when a pair gets matched
+    bool layoutChanged = fresh;
+    for (std::size_t i = 0; i < cards.size(); ++i) {
+        CardLayout layout = layoutFor(cards[i], alpha);
+        CardLayout& current = m_layout[i];
+        if (layout.x != current.x || layout.y != current.y || layout.width != current.width ||
+            layout.height != current.height || layout.faceSlot != current.faceSlot ||
+            layout.matched != current.matched) {
+            current = layout;
+            layoutChanged = true;
+        }
+    }
+    if (layoutChanged) {
+        rlUpdateVertexBuffer(m_layoutVbo, m_layout.data(), static_cast<int>(m_layout.size() * sizeof(CardLayout)), 0);
+        ++m_layoutUploads;
+    }
+
+    // One float per card that is mid-flip (or just finished)
+    for (std::size_t i = 0; i < cards.size(); ++i) {
+        float flip = Utils::lerp(cards[i].previousFlip, cards[i].flip, alpha);
+        if (fresh) {
+            m_flip[i] = flip;
+        } else if (flip != m_flip[i]) {
+            m_flip[i] = flip;
+            rlUpdateVertexBuffer(m_flipVbo, &m_flip[i], sizeof(float), static_cast<int>(i * sizeof(float)));
+            ++m_flipUploads;
+        }
+    }
+    if (fresh) {
+        rlUpdateVertexBuffer(m_flipVbo, m_flip.data(), static_cast<int>(m_flip.size() * sizeof(float)), 0);
+    }
+
+    // Whatever is queued in the 2D batch belongs underneath the cards
+    rlDrawRenderBatchActive();
+
+    // A card past edge-on shows its other side, i.e. the quad's back face
+    rlDisableBackfaceCulling();
+    rlEnableShader(m_shader.id);
+    rlSetUniformMatrix(m_mvpLoc, MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlActiveTextureSlot(0);
+    rlEnableTexture(m_atlas.id);
+    rlEnableVertexArray(m_vao);
+    rlDrawVertexArrayInstanced(0, 6, static_cast<int>(cards.size()));
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
+    rlEnableBackfaceCulling();
+    return true;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file Format.cpp
+ * @brief to_chars based number formatting and the MM:SS clock
+ */
+
+#include "../include/Format.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+// "00" to "99", two characters each
+constexpr char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+constexpr unsigned long long POWERS_OF_TEN[] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull};
+
+// Above 6 decimals a float times 10^precision may no longer be exact in a double
+constexpr int EXACT_PRECISION = 6;
+constexpr double EXACT_LIMIT = 9007199254740992.0;     // 2^53
+
+void writePair(char* out, int value) {
+    out[0] = DIGIT_PAIRS[value * 2];
+    out[1] = DIGIT_PAIRS[value * 2 + 1];
+}
+
+} // namespace
+
+std::size_t Format::integer(char* out, std::size_t capacity, long long value) {
+    std::to_chars_result result = std::to_chars(out, out + capacity, value);
+    return result.ec == std::errc() ? static_cast<std::size_t>(result.ptr - out) : 0;
+}
+
+std::size_t Format::integer(char* out, std::size_t capacity, unsigned long long value) {
+    std::to_chars_result result = std::to_chars(out, out + capacity, value);
+    return result.ec == std::errc() ? static_cast<std::size_t>(result.ptr - out) : 0;
+}
+
+std::size_t Format::decimal(char* out, std::size_t capacity, float value, int precision) {
+    if (precision < 0) precision = 0;
+    if (precision > MAX_PRECISION) precision = MAX_PRECISION;
+
+    const double scaled = std::fabs(static_cast<double>(value)) * static_cast<double>(POWERS_OF_TEN[std::min(precision, EXACT_PRECISION)]);
+    if (precision > EXACT_PRECISION || !std::isfinite(value) || scaled >= EXACT_LIMIT) {
+        std::to_chars_result result = std::to_chars(out, out + capacity, value, std::chars_format::fixed, precision);
+        return result.ec == std::errc() ? static_cast<std::size_t>(result.ptr - out) : 0;
+    }
+
+    // Integer fast path: the scaled value is exact, so rounding it to even is printf's rounding
+    const unsigned long long units = static_cast<unsigned long long>(std::nearbyint(scaled));
+    const unsigned long long whole = units / POWERS_OF_TEN[precision];
+    unsigned long long fraction = units % POWERS_OF_TEN[precision];
+
+    char* end = out + capacity;
+    char* cursor = out;
+    if (std::signbit(value)) {
+        if (cursor == end) return 0;
+        *cursor++ = '-';
+    }
+    std::to_chars_result result = std::to_chars(cursor, end, whole);
+    if (result.ec != std::errc()) return 0;
+    cursor = result.ptr;
+    if (precision > 0) {
+        if (end - cursor < precision + 1) return 0;
+        *cursor++ = '.';
+        for (int i = precision - 1; i >= 0; --i) {
+            cursor[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        cursor += precision;
+    }
+    return static_cast<std::size_t>(cursor - out);
+}
+
+std::size_t Format::clock(char* out, std::size_t capacity, float seconds) {
+    // Truncated to whole seconds; NaN and negative times read as zero
+    const long long total = seconds > 0.0f ? static_cast<long long>(std::min(seconds, MAX_CLOCK_SECONDS)) : 0;
+    const long long minutes = total / 60;
+    const int secs = static_cast<int>(total % 60);
+
+    std::size_t written = 0;
+    if (minutes < 100) {
+        if (capacity < 5) return 0;
+        writePair(out, static_cast<int>(minutes));
+        written = 2;
+    } else {
+        written = integer(out, capacity, minutes);
+        if (written == 0 || capacity - written < 3) return 0;
+    }
+    out[written] = ':';
+    writePair(out + written + 1, secs);
+    return written + 3;
+}
+
+// === ClockText ===
+
+std::string_view ClockText::update(float seconds) {
+    const long long second = seconds > 0.0f ? static_cast<long long>(std::min(seconds, Format::MAX_CLOCK_SECONDS)) : 0;
+    if (second != m_second) {
+        m_second = second;
+        m_text.clear().appendClock(seconds);
+    }
+    return m_text.view();
+}
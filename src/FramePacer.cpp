@@ -0,0 +1,174 @@
+/**
+ * @file FramePacer.cpp
+ * @brief Frame pacing and latency statistics implementation
+ */
+
+#include "../include/FramePacer.h"
+#include "../include/Format.h"
+#include "../include/TextRenderer.h"
+#include "../include/Utils.h"
+#include <raylib.h>
+#include <algorithm>
+
+void LatencyStats::add(double seconds) {
+    min = (count == 0) ? seconds : std::min(min, seconds);
+    max = std::max(max, seconds);
+    last = seconds;
+    total += seconds;
+    ++count;
+}
+
+FramePacer::FramePacer(PacingMode mode, int fixedFps)
+    : m_mode(mode),
+      m_fixedFps(fixedFps > 0 ? fixedFps : DEFAULT_FPS),
+      m_refreshRate(0),
+      m_adaptiveFps(m_fixedFps),
+      m_slowFrames(0),
+      m_fastFrames(0),
+      m_frameTimes(FRAME_HISTORY, 0.0f),
+      m_nextFrame(0) {
+}
+
+bool FramePacer::parseMode(const std::string& name, PacingMode& mode) {
+    for (PacingMode candidate : {PacingMode::FIXED, PacingMode::VSYNC, PacingMode::UNCAPPED, PacingMode::ADAPTIVE}) {
+        if (name == getModeName(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* FramePacer::getModeName(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::FIXED: return "fixed";
+        case PacingMode::VSYNC: return "vsync";
+        case PacingMode::UNCAPPED: return "uncapped";
+        case PacingMode::ADAPTIVE: return "adaptive";
+    }
+    return "fixed";
+}
+
+void FramePacer::setRefreshRate(int hz) {
+    m_refreshRate = std::max(0, hz);
+    m_adaptiveFps = fullRateFps();
+    m_slowFrames = 0;
+    m_fastFrames = 0;
+}
+
+int FramePacer::fullRateFps() const {
+    return m_refreshRate > 0 ? m_refreshRate : m_fixedFps;
+}
+
+int FramePacer::getTargetFps() const {
+    switch (m_mode) {
+        case PacingMode::FIXED: return m_fixedFps;
+        case PacingMode::ADAPTIVE: return m_adaptiveFps;
+        case PacingMode::VSYNC:     // the swap does the pacing
+        case PacingMode::UNCAPPED: return 0;
+    }
+    return m_fixedFps;
+}
+
+bool FramePacer::frameFinished(float frameTime, float workTime) {
+    m_frameTimes[m_nextFrame] = frameTime;
+    m_nextFrame = (m_nextFrame + 1) % m_frameTimes.size();
+
+    if (m_mode != PacingMode::ADAPTIVE) {
+        return false;
+    }
+
+    // Count consecutive frames that overrun the current budget, or that
+    // would fit the full rate comfortably
+    const float budget = 1.0f / m_adaptiveFps;
+    const float fullRateBudget = 1.0f / fullRateFps();
+    if (workTime > budget * SLOW_WORK_RATIO) {
+        ++m_slowFrames;
+        m_fastFrames = 0;
+    } else if (workTime < fullRateBudget * FAST_WORK_RATIO) {
+        ++m_fastFrames;
+        m_slowFrames = 0;
+    } else {
+        m_slowFrames = 0;
+        m_fastFrames = 0;
+    }
+
+    int previous = m_adaptiveFps;
+    if (m_slowFrames >= ADAPT_FRAMES && m_adaptiveFps > MIN_ADAPTIVE_FPS) {
+        m_adaptiveFps = std::max(MIN_ADAPTIVE_FPS, m_adaptiveFps / 2);
+    } else if (m_fastFrames >= ADAPT_FRAMES && m_adaptiveFps < fullRateFps()) {
+        m_adaptiveFps = fullRateFps();
+    }
+    if (m_adaptiveFps == previous) {
+        return false;
+    }
+    m_slowFrames = 0;
+    m_fastFrames = 0;
+    Utils::logInfo("Adaptive frame cap " + Utils::toString(previous) + " -> " + Utils::toString(m_adaptiveFps) + " FPS");
+    return true;
+}
+
+float FramePacer::getAverageFrameTime() const {
+    float total = 0.0f;
+    int frames = 0;
+    for (float frameTime : m_frameTimes) {
+        if (frameTime > 0.0f) {
+            total += frameTime;
+            ++frames;
+        }
+    }
+    return frames > 0 ? total / frames : 0.0f;
+}
+
+float FramePacer::getWorstFrameTime() const {
+    return *std::max_element(m_frameTimes.begin(), m_frameTimes.end());
+}
+
+void FramePacer::drawOverlay(int x, int y) const {
+    const float average = getAverageFrameTime();
+    FormatBuffer<96> lines[3];
+    lines[0].append("Pacing: ").append(getModeName(m_mode)).append(", cap ");
+    if (getTargetFps() > 0) {
+        lines[0].append(getTargetFps());
+    } else {
+        lines[0].append("none");
+    }
+    lines[0].append(", display ");
+    if (m_refreshRate > 0) {
+        lines[0].append(m_refreshRate).append(" Hz");
+    } else {
+        lines[0].append('?');
+    }
+    lines[1].append("Frame: ").appendDecimal(average * 1000.0f, 2).append(" ms avg (")
+        .append(average > 0.0f ? static_cast<int>(1.0f / average + 0.5f) : 0).append(" FPS), ")
+        .appendDecimal(getWorstFrameTime() * 1000.0f, 2).append(" ms worst");
+    if (m_flipLatency.count > 0) {
+        lines[2].append("Click to flip: ").appendDecimal(static_cast<float>(m_flipLatency.last * 1000.0), 1).append(" ms last, ")
+            .appendDecimal(static_cast<float>(m_flipLatency.average() * 1000.0), 1).append(" avg, ")
+            .appendDecimal(static_cast<float>(m_flipLatency.max * 1000.0), 1).append(" max (")
+            .append(m_flipLatency.count).append(')');
+    } else {
+        lines[2].append("Click to flip: no samples yet");
+    }
+
+    int width = 0;
+    for (const FormatBuffer<96>& line : lines) {
+        width = std::max(width, TextRenderer::measure(line, 16));
+    }
+    DrawRectangle(x, y, width + 16, 3 * 20 + 8, ColorAlpha(BLACK, 0.7f));
+    for (int i = 0; i < 3; ++i) {
+        TextRenderer::draw(lines[i], x + 8, y + 6 + i * 20, 16, LIME);
+    }
+}
+
+void FramePacer::logSummary() const {
+    Utils::logInfo(std::string("Frame pacing: ") + getModeName(m_mode) + ", " +
+                   Utils::toString(getAverageFrameTime() * 1000.0f, 2) + " ms average frame over the last " +
+                   Utils::toString(FRAME_HISTORY) + " frames");
+    if (m_flipLatency.count > 0) {
+        Utils::logInfo("Click to flip visible: " + Utils::toString(static_cast<float>(m_flipLatency.average() * 1000.0), 2) +
+                       " ms avg, " + Utils::toString(static_cast<float>(m_flipLatency.min * 1000.0), 2) + " ms min, " +
+                       Utils::toString(static_cast<float>(m_flipLatency.max * 1000.0), 2) + " ms max over " +
+                       std::to_string(m_flipLatency.count) + " flips");
+    }
+}
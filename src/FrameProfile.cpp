@@ -0,0 +1,100 @@
+/**
+ * @file FrameProfile.cpp
+ * @brief Frame sample summaries and baseline comparison
+ */
+
+#include "../include/FrameProfile.h"
+#include "../include/Utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+double FrameProfile::percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    // Nearest rank: the smallest value with at least fraction of them at or below it
+    std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+    rank = std::min(std::max<std::size_t>(rank, 1), values.size());
+    std::nth_element(values.begin(), values.begin() + (rank - 1), values.end());
+    return values[rank - 1];
+}
+
+std::vector<PerfMetric> FrameProfile::summarize() const {
+    std::vector<PerfMetric> metrics;
+    if (m_samples.empty()) {
+        return metrics;
+    }
+
+    std::vector<double> values(m_samples.size());
+    auto addSeries = [&](const std::string& name, const char* unit, double slack, auto valueOf) {
+        for (std::size_t i = 0; i < m_samples.size(); ++i) {
+            values[i] = valueOf(m_samples[i]);
+        }
+        metrics.push_back({name + "_p50" + unit, percentile(values, 0.50), slack});
+        metrics.push_back({name + "_p99" + unit, percentile(values, 0.99), slack});
+        metrics.push_back({name + "_max" + unit, percentile(values, 1.0), slack});
+    };
+    addSeries("update", "_ms", TIME_SLACK_MS, [](const FrameSample& s) { return s.updateMs; });
+    addSeries("draw", "_ms", TIME_SLACK_MS, [](const FrameSample& s) { return s.drawMs; });
+    addSeries("frame", "_ms", TIME_SLACK_MS, [](const FrameSample& s) { return s.updateMs + s.drawMs; });
+    addSeries("allocations", "", ALLOCATION_SLACK, [](const FrameSample& s) { return s.allocations; });
+    return metrics;
+}
+
+// === Baseline ===
+
+bool FrameProfile::readBaseline(const std::string& path, std::vector<PerfMetric>& metrics) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    metrics.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        PerfMetric metric;
+        if (!(fields >> metric.name >> metric.value)) {
+            Utils::logError("Baseline " + path + ": cannot read '" + line + "'");
+            return false;
+        }
+        metrics.push_back(metric);
+    }
+    return true;
+}
+
+bool FrameProfile::writeBaseline(const std::string& path, const std::vector<PerfMetric>& metrics) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << "# memory_perf baseline: per-frame milliseconds and allocations (memory_perf --write-baseline)\n";
+    for (const PerfMetric& metric : metrics) {
+        file << metric.name << ' ' << metric.value << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+std::vector<std::string> FrameProfile::findRegressions(const std::vector<PerfMetric>& baseline,
+                                                       const std::vector<PerfMetric>& run, double tolerance) {
+    std::vector<std::string> regressions;
+    for (const PerfMetric& metric : run) {
+        auto known = std::find_if(baseline.begin(), baseline.end(),
+                                  [&](const PerfMetric& b) { return b.name == metric.name; });
+        if (known == baseline.end()) {
+            continue; // new metric: nothing to hold it to yet
+        }
+        const double allowed = known->value * (1.0 + tolerance) + metric.slack;
+        if (metric.value > allowed) {
+            std::ostringstream line;
+            line << metric.name << ' ' << metric.value << " > " << allowed << " allowed (baseline " << known->value << ')';
+            regressions.push_back(line.str());
+        }
+    }
+    return regressions;
+}
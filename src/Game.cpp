@@ -4,9 +4,43 @@
  */
 
 #include "../include/Game.h"
+#include "../include/Format.h"
+#include "../include/TextRenderer.h"
 #include "../include/Utils.h"
 #include <algorithm>
 #include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+namespace {
+
+// Widget ids on the screens with fixed buttons (the menus use item indices)
+constexpr int RESTART_BUTTON = 0;
+constexpr int MENU_BUTTON = 1;
+constexpr int SOUND_TOGGLE = 0;
+
+int screenId(GameState state) {
+    return static_cast<int>(state);
+}
+
+std::vector<unsigned char> readFile(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+const char* difficultyName(Difficulty difficulty) {
+    switch (difficulty) {
+        case Difficulty::EASY: return "EASY";
+        case Difficulty::MEDIUM: return "MEDIUM";
+        case Difficulty::HARD: return "HARD";
+    }
+    return "";
+}
+
+} // namespace
 
 // --------------------- Constructor & Destructor ---------------------
 
@@ -16,8 +50,6 @@ Game::Game(int screenWidth, int screenHeight)
       m_currentState(GameState::MAIN_MENU),
       m_previousState(GameState::MAIN_MENU),
       m_difficulty(Difficulty::EASY),
-      m_selectedMenuItem(0),
-      m_selectedDifficulty(0),
       m_totalMoves(0),
       m_matchesFound(0),
       m_gameWon(false),
@@ -27,12 +59,60 @@ Game::Game(int screenWidth, int screenHeight)
       m_gameBoard(nullptr),
       m_audioManager(nullptr),
       m_scoreManager(nullptr),
+      m_lastRank(0),
+      m_scoresDifficulty(Difficulty::EASY),
       m_gameStartTime(0.0f),
       m_currentTime(0.0f),
-      m_pausedTime(0.0f)
+      m_pausedTime(0.0f),
+      m_backgroundTime(0.0f),
+      m_idle(false),
+      m_backgroundParticles(BACKGROUND_PARTICLES),
+      m_celebration(CELEBRATION_CAPACITY),
+      m_fireworkTimer(0.0f),
+      m_threadedSimulation(false),
+      m_appliedInput(0),
+      m_appliedInputTime(0.0),
+      m_inputSequence(0),
+      m_inputTime(0.0),
+      m_drawnInput(0),
+      m_drawnInputTime(0.0),
+      m_presentedInput(0),
+      m_reportMoves(false),
+      m_openFlipSlot(-1),
+      m_deckSeed(0),
+      m_stepsPlayed(0)
 {
     loadResources();
     
+    // Slow dust drifting across the screen, wrapping at the edges
+    ParticleEmitter dust;
+    dust.position = {screenWidth / 2.0f, screenHeight / 2.0f};
+    dust.spread = {screenWidth / 2.0f, screenHeight / 2.0f};
+    dust.minSpeed = 20.0f;
+    dust.maxSpeed = 30.0f;
+    dust.minAngle = 30.0f;
+    dust.maxAngle = 45.0f;
+    dust.minSize = 1.0f;
+    dust.maxSize = 4.0f;
+    dust.lifetime = 0.0f;
+    dust.color = ColorAlpha(WHITE, 0.3f);
+    m_backgroundParticles.setWrap(static_cast<float>(screenWidth), static_cast<float>(screenHeight));
+    m_backgroundParticles.emit(dust, BACKGROUND_PARTICLES);
+    m_celebration.setGravity({0.0f, 120.0f});
+    
+    m_leaderboard.load();
+    
+    // A game left unfinished last time; decoded again when continued
+    m_savedGameBytes = readFile(SAVED_GAME_PATH);
+    if (!m_savedGameBytes.empty() && !m_savedGame.decode(m_savedGameBytes.data(), m_savedGameBytes.size())) {
+        Utils::logWarning("Saved game unreadable or from another version, ignored");
+        m_savedGameBytes.clear();
+    }
+    
+    buildLayout();
+    m_layout.resize(screenWidth, screenHeight);
+    m_hud.setScale(m_layout.getScale());
+    
     // Test audio device
     if (IsAudioDeviceReady()) {
         Utils::logInfo("Audio device is ready and working!");
@@ -42,6 +122,12 @@ Game::Game(int screenWidth, int screenHeight)
 }
 
 Game::~Game() {
+    // The worker's callbacks use the board and score manager
+    stopSimulationThread();
+    // Closing the window mid-game keeps the game; m_writer finishes the write before it is destroyed
+    if (m_currentState == GameState::PLAYING || m_currentState == GameState::PAUSED) {
+        saveUnfinishedGame();
+    }
     unloadResources();
 }
 
@@ -66,6 +152,9 @@ void Game::loadResources() {
 }
 
 void Game::unloadResources() {
+    m_hud.unload();
+    m_backgroundParticles.unload();
+    m_celebration.unload();
     if (m_titleFont.texture.id != GetFontDefault().texture.id) {
         UnloadFont(m_titleFont);
     }
@@ -82,6 +171,11 @@ void Game::unloadResources() {
 // --------------------- Game State Updates ---------------------
 
 void Game::update() {
+    if (!m_idle) {
+        m_backgroundTime += GetFrameTime();
+        m_backgroundParticles.update(GetFrameTime());
+    }
+
     switch (m_currentState) {
         case GameState::MAIN_MENU: updateMainMenu(); break;
         case GameState::DIFFICULTY: updateDifficultySelection(); break;
@@ -102,26 +196,175 @@ void Game::updateDifficultySelection() {
 }
 
 void Game::updatePlaying() {
-    float deltaTime = GetFrameTime();
+    if (m_threadedSimulation) {
+        updatePlayingThreaded();
+        return;
+    }
+
+    // Board logic runs in fixed steps so timers do not depend on the frame rate
+    int steps = m_simulationClock.advance(GetFrameTime());
+
+    // Input is sampled once per rendered frame; none while the board is
+    // running a shuffle animation
+    if (!(m_gameBoard && m_gameBoard->isShuffling())) {
+        handlePlayingInput();
+    }
+
+    for (int i = 0; i < steps && m_currentState == GameState::PLAYING; ++i) {
+        stepPlaying(m_simulationClock.getStep());
+        checkWinCondition();
+    }
+}
+
+void Game::updatePlayingThreaded() {
+    if (!m_simThread.isRunning()) {
+        startSimulationThread();
+    }
+
+    // The worker owns the board; the win is handled here once it stops
+    m_snapshots.update();
+    if (m_snapshots.read().complete) {
+        stopSimulationThread();
+        checkWinCondition();
+        return;
+    }
+
+    if (IsKeyPressed(KEY_P)) {
+        stopSimulationThread();
+        pauseGame();
+        return;
+    }
+
+    // Same rules as handlePlayingInput(): no input during a shuffle animation
+    if (m_snapshots.read().shuffling) {
+        return;
+    }
+    InputEvent event;
+    if (IsKeyPressed(KEY_H)) {
+        event.type = InputEvent::Type::HINT;
+        m_simThread.postInput(event);
+    }
+    if (IsKeyPressed(KEY_R)) {
+        event.type = InputEvent::Type::SHUFFLE;
+        m_simThread.postInput(event);
+    }
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        event.type = InputEvent::Type::CLICK;
+        event.position = GetMousePosition();
+        m_simThread.postInput(event);
+    }
+}
+
+void Game::startSimulationThread() {
+    // Publish the current board first, so the first frame never shows a
+    // snapshot left over from an earlier game
+    m_appliedInput = 0;
+    m_appliedInputTime = 0.0;
+    publishSnapshot(0);
+    m_snapshots.update();
+
+    m_simThread.start(
+        [this](const InputEvent& event) { applyInput(event); },
+        [this](float step) { stepPlaying(step); },
+        [this](const SimulationClock& clock) { publishSnapshot(clock.getStepCount()); });
+    Utils::logInfo("Simulation thread started");
+}
+
+void Game::stopSimulationThread() {
+    if (m_simThread.isRunning()) {
+        m_simThread.stop();
+        Utils::logInfo("Simulation thread stopped");
+    }
+}
+
+void Game::applyInput(const InputEvent& event) {
+    if (m_gameBoard) {
+        switch (event.type) {
+            case InputEvent::Type::CLICK: {
+                const int matchesBefore = m_gameBoard->getMatchesFound();
+                if (m_gameBoard->handleClick(event.position)) {
+                    const int slot = m_gameBoard->slotAt(event.position);
+                    m_replay.click(m_stepsPlayed, slot);
+                    reportFlip(slot, matchesBefore);
+                    m_appliedInput = event.sequence;
+                    m_appliedInputTime = event.time;
+                }
+                m_totalMoves++;
+                break;
+            }
+            case InputEvent::Type::HINT:
+                showHint();
+                break;
+            case InputEvent::Type::SHUFFLE:
+                if (canTriggerShuffle()) {
+                    triggerShuffle();
+                } else {
+                    Utils::logDebug("Shuffle requested but unavailable (cooldown or animation)");
+                }
+                break;
+        }
+    }
+}
+
+void Game::reportFlip(int slot, int matchesBefore) {
+    // The second card of a pair closes it, matched or not
+    const int pairedWith = m_openFlipSlot;
+    m_openFlipSlot = pairedWith < 0 ? slot : -1;
+
+    std::lock_guard<std::mutex> lock(m_movesMutex);
+    if (!m_reportMoves) {
+        return;
+    }
+    m_moves.push_back({BoardMove::Type::FLIP, slot, -1});
+    if (pairedWith >= 0 && m_gameBoard->getMatchesFound() > matchesBefore) {
+        m_moves.push_back({BoardMove::Type::MATCH, pairedWith, slot});
+    }
+}
 
+void Game::setMoveReporting(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_movesMutex);
+    m_reportMoves = enabled;
+    m_moves.clear();
+    m_moves.reserve(RESERVED_MOVES);
+}
+
+void Game::takeBoardMoves(std::vector<BoardMove>& out) {
+    std::lock_guard<std::mutex> lock(m_movesMutex);
+    out.insert(out.end(), m_moves.begin(), m_moves.end());
+    m_moves.clear();
+}
+
+void Game::publishSnapshot(unsigned long long step) {
+    BoardSnapshot& snapshot = m_snapshots.writeBuffer();
+    if (m_gameBoard) {
+        m_gameBoard->fillSnapshot(snapshot);
+    } else {
+        snapshot = BoardSnapshot();
+    }
+    snapshot.hud = buildHudState();
+    snapshot.step = step;
+    snapshot.publishTime = SimulationThread::now();
+    snapshot.inputSequence = m_appliedInput;
+    snapshot.inputTime = m_appliedInputTime;
+    m_snapshots.publish();
+}
+
+void Game::stepPlaying(float deltaTime) {
+    ++m_stepsPlayed;
     if (m_shuffleCooldownTimer > 0.0f) {
         m_shuffleCooldownTimer = std::max(0.0f, m_shuffleCooldownTimer - deltaTime);
     }
 
-    // If the board is running a shuffle animation, only update the board
-    // and prevent player input until the shuffle finishes. Start the game timer
-    // once shuffling completes.
+    // If the board is running a shuffle animation, only update the board.
+    // Start the game timer once shuffling completes.
     if (m_gameBoard && m_gameBoard->isShuffling()) {
         m_gameBoard->update(deltaTime);
         if (!m_gameBoard->isShuffling() && m_gameStartTime <= 0.0f) {
             m_gameStartTime = GetTime();
         }
-        return; // don't process input while shuffling
+        return;
     }
 
-    // Normal playing input/update
-    handlePlayingInput();
-
     if (m_gameBoard) {
         m_gameBoard->update(deltaTime);
     }
@@ -130,8 +373,6 @@ void Game::updatePlaying() {
     if (m_gameStartTime <= 0.0f) {
         m_gameStartTime = GetTime();
     }
-
-    checkWinCondition();
 }
 
 void Game::updatePaused() {
@@ -139,6 +380,17 @@ void Game::updatePaused() {
 }
 
 void Game::updateGameOver() {
+    float deltaTime = GetFrameTime();
+    
+    m_fireworkTimer -= deltaTime;
+    if (m_fireworkTimer <= 0.0f) {
+        m_fireworkTimer = FIREWORK_INTERVAL;
+        Vector2 position = {Utils::randomFloat(100.0f, m_screenWidth - 100.0f),
+                            Utils::randomFloat(80.0f, m_screenHeight / 2.0f)};
+        launchFirework(position, FIREWORK_PARTICLES);
+    }
+    m_celebration.update(deltaTime);
+    
     handleGameOverInput();
 }
 
@@ -164,196 +416,123 @@ void Game::draw() {
 }
 
 void Game::drawGradientBackground() {
-    // Animated gradient background
-    float time = GetTime();
+    // Animated gradient background (frozen while idle)
+    float time = m_backgroundTime;
     Color topColor = Utils::colorFromHSV(fmod(time * 20, 360), 0.6f, 0.4f);
     Color bottomColor = Utils::colorFromHSV(fmod(time * 20 + 180, 360), 0.6f, 0.2f);
     
     DrawRectangleGradientV(0, 0, m_screenWidth, m_screenHeight, topColor, bottomColor);
     
-    // Draw floating particles
-    for (int i = 0; i < 20; ++i) {
-        float x = fmod(i * 73.5f + time * 20, m_screenWidth);
-        float y = fmod(i * 127.3f + time * 15, m_screenHeight);
-        float size = 2 + sin(time + i) * 2;
-        DrawCircle(static_cast<int>(x), static_cast<int>(y), size, ColorAlpha(WHITE, 0.3f));
-    }
+    // Floating particles
+    m_backgroundParticles.draw();
 }
 
 void Game::drawMainMenu() {
     // Draw title with shadow and glow
     const char* title = "MEMORY CARD GAME";
-    int titleSize = 50;
-    int titleWidth = MeasureText(title, titleSize);
-    int titleX = m_screenWidth / 2 - titleWidth / 2;
-    int titleY = 80;
+    int titleSize = m_layout.pixels(50);
+    int titleWidth = TextRenderer::measure(title, titleSize);
+    int titleX = static_cast<int>(m_layout.getCenter(m_ui.menuTitle).x) - titleWidth / 2;
+    int titleY = static_cast<int>(m_layout.get(m_ui.menuTitle).y);
+    int shadow = m_layout.pixels(4);
     
     // Shadow
-    DrawText(title, titleX + 4, titleY + 4, titleSize, ColorAlpha(BLACK, 0.5f));
+    TextRenderer::draw(title, titleX + shadow, titleY + shadow, titleSize, ColorAlpha(BLACK, 0.5f));
     // Glow effect
-    DrawText(title, titleX, titleY, titleSize, ColorAlpha(GOLD, 0.3f));
+    TextRenderer::draw(title, titleX, titleY, titleSize, ColorAlpha(GOLD, 0.3f));
     // Main text
-    DrawText(title, titleX, titleY, titleSize, GOLD);
+    TextRenderer::draw(title, titleX, titleY, titleSize, GOLD);
 
-    // Draw menu buttons with enhanced style
+    // Menu buttons; handleMainMenuInput() tests the next frame's input against them
+    m_widgets.begin(screenId(GameState::MAIN_MENU));
+    int slot = m_ui.menuButtons;
+    if (!m_savedGameBytes.empty()) {
+        m_widgets.button(CONTINUE_ITEM, m_layout.get(slot++), "Continue", DARKGREEN);
+    }
     for (size_t i = 0; i < m_mainMenuItems.size(); ++i) {
-        Rectangle buttonRect = { 
-            m_screenWidth / 2.0f - BUTTON_WIDTH / 2,
-            220.0f + i * (BUTTON_HEIGHT + BUTTON_SPACING),
-            BUTTON_WIDTH, 
-            BUTTON_HEIGHT 
-        };
-        bool isSelected = m_selectedMenuItem == (int)i;
-        drawEnhancedButton(m_mainMenuItems[i], buttonRect, isSelected);
+        m_widgets.button(static_cast<int>(i), m_layout.get(slot++), m_mainMenuItems[i]);
     }
-    
+    m_widgets.draw(m_layout.getScale());
 }
 
 void Game::drawDifficultySelection() {
     // Draw title
     const char* title = "SELECT DIFFICULTY";
-    int titleSize = 40;
-    int titleWidth = MeasureText(title, titleSize);
-    DrawText(title, m_screenWidth / 2 - titleWidth / 2 + 3, 123, titleSize, ColorAlpha(BLACK, 0.5f));
-    DrawText(title, m_screenWidth / 2 - titleWidth / 2, 120, titleSize, GOLD);
+    int titleSize = m_layout.pixels(40);
+    int titleWidth = TextRenderer::measure(title, titleSize);
+    int titleX = static_cast<int>(m_layout.getCenter(m_ui.difficultyTitle).x) - titleWidth / 2;
+    int titleY = static_cast<int>(m_layout.get(m_ui.difficultyTitle).y);
+    int shadow = m_layout.pixels(3);
+    TextRenderer::draw(title, titleX + shadow, titleY + shadow, titleSize, ColorAlpha(BLACK, 0.5f));
+    TextRenderer::draw(title, titleX, titleY, titleSize, GOLD);
 
     // Draw difficulty buttons
+    m_widgets.begin(screenId(GameState::DIFFICULTY));
     for (size_t i = 0; i < m_difficultyNames.size(); ++i) {
-        Rectangle buttonRect = { 
-            m_screenWidth / 2.0f - BUTTON_WIDTH / 2,
-            250.0f + i * (BUTTON_HEIGHT + BUTTON_SPACING),
-            BUTTON_WIDTH, 
-            BUTTON_HEIGHT 
-        };
-        bool isSelected = m_selectedDifficulty == (int)i;
-        drawEnhancedButton(m_difficultyNames[i], buttonRect, isSelected);
+        m_widgets.button(static_cast<int>(i), m_layout.get(m_ui.difficultyButtons + static_cast<int>(i)),
+                         m_difficultyNames[i]);
     }
+    m_widgets.draw(m_layout.getScale());
     
     // Draw back hint with icon
-    DrawText("< ESC", 20, m_screenHeight - 40, 24, ColorAlpha(WHITE, 0.8f));
+    Rectangle backHint = m_layout.get(m_ui.backHint);
+    TextRenderer::draw("< ESC", static_cast<int>(backHint.x), static_cast<int>(backHint.y), m_layout.pixels(24),
+                       ColorAlpha(WHITE, 0.8f));
 }
 
 void Game::drawPlaying() {
-    // Draw game board
+    if (m_simThread.isRunning()) {
+        // Newest published step, blended in over the step that follows it
+        m_snapshots.update();
+        const BoardSnapshot& snapshot = m_snapshots.read();
+        float sincePublish = static_cast<float>(SimulationThread::now() - snapshot.publishTime);
+        float alpha = Utils::clamp(sincePublish / m_simulationClock.getStep(), 0.0f, 1.0f);
+        if (m_gameBoard)
+            m_gameBoard->drawSnapshot(snapshot, alpha);
+        m_hud.draw(snapshot.hud, m_screenWidth, m_screenHeight);
+        m_hud.drawCombo(snapshot.comboCount, snapshot.comboTime, m_screenWidth);
+        m_drawnInput = snapshot.inputSequence;
+        m_drawnInputTime = snapshot.inputTime;
+        return;
+    }
+
+    // Draw game board, blended towards the next simulation step
     if (m_gameBoard)
-        m_gameBoard->draw();
+        m_gameBoard->draw(m_simulationClock.getAlpha());
 
     // Draw enhanced HUD
     drawEnhancedHUD();
+    m_drawnInput = m_inputSequence;
+    m_drawnInputTime = m_inputTime;
 }
 
 void Game::drawEnhancedHUD() {
-    // Top bar background with transparency
-    DrawRectangle(0, 0, m_screenWidth, 80, ColorAlpha(BLACK, 0.7f));
-    DrawRectangleGradientV(0, 0, m_screenWidth, 80, ColorAlpha(BLACK, 0.5f), ColorAlpha(BLACK, 0.2f));
-    
-    // Stats panel on left
-    int matches = m_gameBoard ? m_gameBoard->getMatchesFound() : 0;
-    int totalPairs = (static_cast<int>(m_difficulty) / 2);
-    
-    // Moves counter
-    Rectangle movesRect = {15, 15, 150, 50};
-    DrawRectangleRounded(movesRect, 0.3f, 8, ColorAlpha(DARKBLUE, 0.8f));
-    Utils::drawRoundedRectangleLines(movesRect, 0.3f, 8, 2, SKYBLUE);
-    std::string movesStr = "MOVES: " + std::to_string(m_totalMoves);
-    DrawText(movesStr.c_str(), 30, 30, 24, WHITE);
-    
-    // Matches counter with progress
-    Rectangle matchesRect = {180, 15, 180, 50};
-    DrawRectangleRounded(matchesRect, 0.3f, 8, ColorAlpha(DARKGREEN, 0.8f));
-    Utils::drawRoundedRectangleLines(matchesRect, 0.3f, 8, 2, LIME);
-    std::string matchesStr = "PAIRS: " + std::to_string(matches) + "/" + std::to_string(totalPairs);
-    DrawText(matchesStr.c_str(), 195, 30, 24, WHITE);
-
-    // Score display
-    int score = m_scoreManager ? m_scoreManager->getScore() : 0;
-    std::string scoreStr = "SCORE: " + std::to_string(score);
-    DrawText(scoreStr.c_str(), 380, 30, 24, GOLD);
-    
-    // Progress bar
-    float progress = totalPairs > 0 ? (float)matches / totalPairs : 0;
-    DrawRectangleRounded({195, 53, 150 * progress, 8}, 0.5f, 8, LIME);
-    
-    // Timer on right
-    float elapsed = getElapsedTime();
-    std::string timerText = Utils::formatTime(elapsed);
-    
-    Rectangle timerRect = {m_screenWidth - 170.0f, 15, 155, 50};
-    DrawRectangleRounded(timerRect, 0.3f, 8, ColorAlpha(MAROON, 0.8f));
-    Utils::drawRoundedRectangleLines(timerRect, 0.3f, 8, 2, RED);
-    DrawText("TIME", m_screenWidth - 155, 22, 16, LIGHTGRAY);
-    DrawText(timerText.c_str(), m_screenWidth - 155, 38, 28, GOLD);
-    
-    // Combo display (animated)
-    if (m_gameBoard) {
-        int comboCount = m_gameBoard->getComboCount();
-        float comboTimer = m_gameBoard->getComboDisplayTime();
-        if (comboCount > 1 && comboTimer > 0.0f) {
-            float comboScale = 1.0f + 0.2f * sin(GetTime() * 8.0f);
-            int comboMultiplier = std::min(comboCount, 5);
-            std::string comboText = std::to_string(comboMultiplier) + "x COMBO";
-            int fontSize = static_cast<int>(32 * comboScale);
-            int textWidth = MeasureText(comboText.c_str(), fontSize);
-            int comboX = m_screenWidth / 2 - textWidth / 2;
-            int comboY = 100;
-
-            float fade = std::min(1.0f, comboTimer / 2.0f);
-
-            // Shadow
-            DrawText(comboText.c_str(), comboX + 2, comboY + 2, fontSize, ColorAlpha(BLACK, 0.5f * fade));
-            // Glow effect
-            DrawText(comboText.c_str(), comboX, comboY, fontSize, ColorAlpha(ORANGE, 0.8f * fade));
-            // Main text
-            DrawText(comboText.c_str(), comboX, comboY, fontSize, ColorAlpha(GOLD, fade));
-            std::string multiplierHint = "Score multiplier " + std::to_string(comboMultiplier) + "x";
-            DrawText(multiplierHint.c_str(), comboX, comboY + fontSize + 6, 18, ColorAlpha(WHITE, 0.7f * fade));
-        }
-    }
-    
-    // Hint system display
+    // Only the values go in here; HudRenderer redraws text when one of them changes
+    m_hud.draw(buildHudState(), m_screenWidth, m_screenHeight);
+
+    // Combo display (animated every frame)
     if (m_gameBoard) {
-        int hintsRemaining = m_gameBoard->getHintsRemaining();
-        float hintCooldown = m_gameBoard->getHintCooldown();
-        bool canUse = m_gameBoard->canUseHint();
-        
-        // Hint counter and cooldown
-        Rectangle hintRect = {m_screenWidth - 200.0f, static_cast<float>(m_screenHeight - 100), 180.0f, 80.0f};
-        DrawRectangleRounded(hintRect, 0.3f, 8, ColorAlpha(DARKPURPLE, 0.8f));
-        Utils::drawRoundedRectangleLines(hintRect, 0.3f, 8, 2, VIOLET);
-        
-        std::string hintText = "HINTS: " + std::to_string(hintsRemaining);
-        DrawText(hintText.c_str(), m_screenWidth - 190, m_screenHeight - 90, 20, WHITE);
-        
-        if (canUse) {
-            DrawText("Press H to use", m_screenWidth - 190, m_screenHeight - 65, 16, LIME);
-            DrawText("Hint reveals a", m_screenWidth - 190, m_screenHeight - 50, 14, LIGHTGRAY);
-            DrawText("matching pair", m_screenWidth - 190, m_screenHeight - 35, 14, LIGHTGRAY);
-        } else if (hintCooldown > 0.0f) {
-            std::string cooldownText = "Cooldown: " + std::to_string(static_cast<int>(hintCooldown)) + "s";
-            DrawText(cooldownText.c_str(), m_screenWidth - 190, m_screenHeight - 65, 16, ColorAlpha(YELLOW, 0.7f));
-        } else {
-            DrawText("No hints left", m_screenWidth - 190, m_screenHeight - 65, 16, ColorAlpha(RED, 0.7f));
-        }
+        m_hud.drawCombo(m_gameBoard->getComboCount(), m_gameBoard->getComboDisplayTime(), m_screenWidth);
     }
+}
 
-    // Shuffle ability display (bottom-left)
-    Rectangle shuffleRect = {15.0f, static_cast<float>(m_screenHeight - 100), 220.0f, 80.0f};
-    DrawRectangleRounded(shuffleRect, 0.3f, 8, ColorAlpha(DARKBROWN, 0.85f));
-    Utils::drawRoundedRectangleLines(shuffleRect, 0.3f, 8, 2, ColorAlpha(BEIGE, 0.9f));
-    DrawText("RESHUFFLE", 30, m_screenHeight - 90, 20, BEIGE);
-    if (canTriggerShuffle()) {
-        DrawText("Press R to mix cards", 30, m_screenHeight - 65, 16, LIME);
-    } else {
-        int cooldown = static_cast<int>(std::ceil(m_shuffleCooldownTimer));
-        std::string cooldownText = "Cooldown: " + std::to_string(cooldown) + "s";
-        DrawText(cooldownText.c_str(), 30, m_screenHeight - 65, 16, ColorAlpha(WHITE, 0.7f));
+HudState Game::buildHudState() const {
+    HudState state;
+    state.moves = m_totalMoves;
+    state.matches = m_gameBoard ? m_gameBoard->getMatchesFound() : 0;
+    state.totalPairs = static_cast<int>(m_difficulty) / 2;
+    state.score = m_scoreManager ? m_scoreManager->getScore() : 0;
+    state.elapsedSeconds = static_cast<int>(getElapsedTime());
+    state.canShuffle = canTriggerShuffle();
+    state.shuffleCooldownSeconds = static_cast<int>(std::ceil(m_shuffleCooldownTimer));
+    state.shufflesUsed = m_shufflesUsed;
+    if (m_gameBoard) {
+        state.hasBoard = true;
+        state.hintsRemaining = m_gameBoard->getHintsRemaining();
+        state.canUseHint = m_gameBoard->canUseHint();
+        state.hintCooldownSeconds = static_cast<int>(m_gameBoard->getHintCooldown());
     }
-    std::string usedText = "Used: " + std::to_string(m_shufflesUsed);
-    DrawText(usedText.c_str(), 30, m_screenHeight - 40, 14, ColorAlpha(WHITE, 0.6f));
-    
-    // Bottom hint
-    DrawText("P-Pause | H-Hint (-points, cooldown) | R-Reshuffle (-points, cooldown)",
-             40, m_screenHeight - 20, 16, ColorAlpha(WHITE, 0.6f));
+    return state;
 }
 
 void Game::drawPaused() {
@@ -365,25 +544,33 @@ void Game::drawPaused() {
     DrawRectangle(0, 0, m_screenWidth, m_screenHeight, ColorAlpha(BLACK, 0.8f));
     
     // Pause panel
-    Rectangle panel = {m_screenWidth / 2.0f - 250, m_screenHeight / 2.0f - 200, 500, 400};
+    Rectangle panel = m_layout.get(m_ui.pausePanel);
     DrawRectangleRounded(panel, 0.1f, 16, ColorAlpha(DARKBLUE, 0.95f));
-    Utils::drawRoundedRectangleLines(panel, 0.1f, 16, 4, SKYBLUE);
+    Utils::drawRoundedRectangleLines(panel, 0.1f, 16, m_layout.getScale() * 4, SKYBLUE);
     
     // Pause text
     const char* pauseText = "PAUSED";
-    int textSize = 60;
-    int textWidth = MeasureText(pauseText, textSize);
-    DrawText(pauseText, m_screenWidth / 2 - textWidth / 2 + 3, m_screenHeight / 2 - 123, textSize, ColorAlpha(BLACK, 0.5f));
-    DrawText(pauseText, m_screenWidth / 2 - textWidth / 2, m_screenHeight / 2 - 120, textSize, GOLD);
+    int textSize = m_layout.pixels(60);
+    int textWidth = TextRenderer::measure(pauseText, textSize);
+    int textX = static_cast<int>(m_layout.getCenter(m_ui.pauseTitle).x) - textWidth / 2;
+    int textY = static_cast<int>(m_layout.get(m_ui.pauseTitle).y);
+    int shadow = m_layout.pixels(3);
+    TextRenderer::draw(pauseText, textX + shadow, textY - shadow, textSize, ColorAlpha(BLACK, 0.5f));
+    TextRenderer::draw(pauseText, textX, textY, textSize, GOLD);
     
     // Instructions with icons
     const char* resume = "SPACE - Resume";
-    const char* menu = "M - Main Menu";
-    int resumeWidth = MeasureText(resume, 24);
-    int menuWidth = MeasureText(menu, 24);
-    
-    DrawText(resume, m_screenWidth / 2 - resumeWidth / 2, m_screenHeight / 2, 24, WHITE);
-    DrawText(menu, m_screenWidth / 2 - menuWidth / 2, m_screenHeight / 2 + 40, 24, LIGHTGRAY);
+    const char* menu = "M - Save and quit to menu";
+    int lineSize = m_layout.pixels(24);
+    int resumeWidth = TextRenderer::measure(resume, lineSize);
+    int menuWidth = TextRenderer::measure(menu, lineSize);
+    Vector2 resumeLine = m_layout.getCenter(m_ui.pauseLines);
+    Vector2 menuLine = m_layout.getCenter(m_ui.pauseLines + 1);
+    
+    TextRenderer::draw(resume, static_cast<int>(resumeLine.x) - resumeWidth / 2, static_cast<int>(resumeLine.y),
+                       lineSize, WHITE);
+    TextRenderer::draw(menu, static_cast<int>(menuLine.x) - menuWidth / 2, static_cast<int>(menuLine.y),
+                       lineSize, LIGHTGRAY);
 }
 
 void Game::drawGameOver() {
@@ -394,142 +581,166 @@ void Game::drawGameOver() {
     // Victory overlay
     DrawRectangle(0, 0, m_screenWidth, m_screenHeight, ColorAlpha(BLACK, 0.85f));
     
+    // Fireworks behind the panel
+    m_celebration.draw();
+    
     // Victory panel
-    Rectangle panel = {m_screenWidth / 2.0f - 300, m_screenHeight / 2.0f - 250, 600, 500};
+    Rectangle panel = m_layout.get(m_ui.victoryPanel);
     DrawRectangleRounded(panel, 0.1f, 16, ColorAlpha(DARKGREEN, 0.95f));
-    Utils::drawRoundedRectangleLines(panel, 0.1f, 16, 4, LIME);
-    
-    // Animated stars/particles
-    float time = GetTime();
-    for (int i = 0; i < 30; ++i) {
-        float angle = (i * 12.0f + time * 50) * DEG2RAD;
-        float dist = 150 + sin(time * 2 + i) * 30;
-        float x = m_screenWidth / 2.0f + cos(angle) * dist;
-        float y = m_screenHeight / 2.0f - 100 + sin(angle) * dist;
-        float size = 3 + sin(time * 3 + i) * 2;
-        DrawCircle(static_cast<int>(x), static_cast<int>(y), size, ColorAlpha(GOLD, 0.8f));
-    }
+    Utils::drawRoundedRectangleLines(panel, 0.1f, 16, m_layout.getScale() * 4, LIME);
     
     // Victory text with glow
     const char* winText = "VICTORY!";
-    int textSize = 70;
-    int textWidth = MeasureText(winText, textSize);
-    DrawText(winText, m_screenWidth / 2 - textWidth / 2 + 4, m_screenHeight / 2 - 164, textSize, ColorAlpha(BLACK, 0.5f));
-    DrawText(winText, m_screenWidth / 2 - textWidth / 2, m_screenHeight / 2 - 160, textSize, GOLD);
+    int textSize = m_layout.pixels(70);
+    int textWidth = TextRenderer::measure(winText, textSize);
+    int textX = static_cast<int>(m_layout.getCenter(m_ui.victoryTitle).x) - textWidth / 2;
+    int textY = static_cast<int>(m_layout.get(m_ui.victoryTitle).y);
+    int shadow = m_layout.pixels(4);
+    TextRenderer::draw(winText, textX + shadow, textY - shadow, textSize, ColorAlpha(BLACK, 0.5f));
+    TextRenderer::draw(winText, textX, textY, textSize, GOLD);
     
     // Stats boxes
     float elapsedTime = getElapsedTime();
-    std::string timeStr = Utils::formatTime(elapsedTime);
-    std::string movesStr = std::to_string(m_totalMoves);
+    FormatBuffer<Format::CLOCK_CHARS> timeStr;
+    timeStr.appendClock(elapsedTime);
+    FormatBuffer<Format::INTEGER_CHARS> movesStr;
+    movesStr.append(m_totalMoves);
+    int labelSize = m_layout.pixels(20);
+    int valueSize = m_layout.pixels(32);
+    int inset = m_layout.pixels(30);
+    int labelY = m_layout.pixels(15);
+    int valueY = m_layout.pixels(45);
     
     // Time stat
-    DrawRectangleRounded({m_screenWidth / 2.0f - 250, m_screenHeight / 2.0f - 50, 200, 80}, 0.2f, 8, ColorAlpha(MAROON, 0.8f));
-    DrawText("TIME", m_screenWidth / 2 - 220, m_screenHeight / 2 - 35, 20, LIGHTGRAY);
-    DrawText(timeStr.c_str(), m_screenWidth / 2 - 220, m_screenHeight / 2 - 5, 32, GOLD);
+    Rectangle timeBox = m_layout.get(m_ui.timeBox);
+    DrawRectangleRounded(timeBox, 0.2f, 8, ColorAlpha(MAROON, 0.8f));
+    TextRenderer::draw("TIME", static_cast<int>(timeBox.x) + inset, static_cast<int>(timeBox.y) + labelY, labelSize, LIGHTGRAY);
+    TextRenderer::draw(timeStr, static_cast<int>(timeBox.x) + inset, static_cast<int>(timeBox.y) + valueY, valueSize, GOLD);
     
     // Moves stat
-    DrawRectangleRounded({m_screenWidth / 2.0f - 20, m_screenHeight / 2.0f - 50, 200, 80}, 0.2f, 8, ColorAlpha(DARKBLUE, 0.8f));
-    DrawText("MOVES", m_screenWidth / 2 + 10, m_screenHeight / 2 - 35, 20, LIGHTGRAY);
-    DrawText(movesStr.c_str(), m_screenWidth / 2 + 10, m_screenHeight / 2 - 5, 32, SKYBLUE);
-    
-    // Action buttons with hover detection
-    Vector2 mousePos = GetMousePosition();
-    Rectangle restartBtn = {m_screenWidth / 2.0f - 230, m_screenHeight / 2.0f + 80, 200, 60};
-    Rectangle menuBtn = {m_screenWidth / 2.0f + 30, m_screenHeight / 2.0f + 80, 200, 60};
-    
-    bool restartHovered = CheckCollisionPointRec(mousePos, restartBtn);
-    bool menuHovered = CheckCollisionPointRec(mousePos, menuBtn);
-    
-    drawEnhancedButton("RESTART (R)", restartBtn, restartHovered, DARKGREEN);
-    drawEnhancedButton("MENU (ESC)", menuBtn, menuHovered, DARKBLUE);
+    Rectangle movesBox = m_layout.get(m_ui.movesBox);
+    DrawRectangleRounded(movesBox, 0.2f, 8, ColorAlpha(DARKBLUE, 0.8f));
+    TextRenderer::draw("MOVES", static_cast<int>(movesBox.x) + inset, static_cast<int>(movesBox.y) + labelY, labelSize, LIGHTGRAY);
+    TextRenderer::draw(movesStr, static_cast<int>(movesBox.x) + inset, static_cast<int>(movesBox.y) + valueY, valueSize, SKYBLUE);
+    
+    // Place among every game of this difficulty
+    FormatBuffer<64> rankStr;
+    rankStr.append("Rank #").append(m_lastRank + 1).append(" of ")
+        .append(m_leaderboard.count(static_cast<int>(m_difficulty))).append(" (")
+        .append(difficultyName(m_difficulty)).append(')');
+    int rankSize = m_layout.pixels(24);
+    Vector2 rankLine = m_layout.getCenter(m_ui.victoryRank);
+    TextRenderer::draw(rankStr, static_cast<int>(rankLine.x) - TextRenderer::measure(rankStr, rankSize) / 2,
+                       static_cast<int>(m_layout.get(m_ui.victoryRank).y), rankSize, m_lastRank == 0 ? GOLD : WHITE);
+    
+    // Action buttons
+    m_widgets.begin(screenId(GameState::GAME_OVER));
+    m_widgets.button(RESTART_BUTTON, m_layout.get(m_ui.restartButton), "RESTART (R)", DARKGREEN);
+    m_widgets.button(MENU_BUTTON, m_layout.get(m_ui.menuButton), "MENU (ESC)", DARKBLUE);
+    m_widgets.draw(m_layout.getScale());
 }
 
 void Game::drawSettings() {
     // Draw title
     const char* title = "SETTINGS";
-    int titleSize = 40;
-    int titleWidth = MeasureText(title, titleSize);
-    DrawText(title, m_screenWidth / 2 - titleWidth / 2 + 3, 103, titleSize, ColorAlpha(BLACK, 0.5f));
-    DrawText(title, m_screenWidth / 2 - titleWidth / 2, 100, titleSize, GOLD);
+    int titleSize = m_layout.pixels(40);
+    int titleWidth = TextRenderer::measure(title, titleSize);
+    int titleX = static_cast<int>(m_layout.getCenter(m_ui.settingsTitle).x) - titleWidth / 2;
+    int titleY = static_cast<int>(m_layout.get(m_ui.settingsTitle).y);
+    int shadow = m_layout.pixels(3);
+    TextRenderer::draw(title, titleX + shadow, titleY + shadow, titleSize, ColorAlpha(BLACK, 0.5f));
+    TextRenderer::draw(title, titleX, titleY, titleSize, GOLD);
     
     // Settings panel
-    Rectangle panel = {m_screenWidth / 2.0f - 300, 200, 600, 400};
+    Rectangle panel = m_layout.get(m_ui.settingsPanel);
     DrawRectangleRounded(panel, 0.1f, 16, ColorAlpha(DARKBLUE, 0.8f));
-    Utils::drawRoundedRectangleLines(panel, 0.1f, 16, 3, SKYBLUE);
+    Utils::drawRoundedRectangleLines(panel, 0.1f, 16, m_layout.getScale() * 3, SKYBLUE);
     
-    DrawText("Settings", m_screenWidth / 2 - 40, m_screenHeight / 2 - 80, 28, WHITE);
+    Rectangle label = m_layout.get(m_ui.settingsLabel);
+    TextRenderer::draw("Settings", static_cast<int>(label.x), static_cast<int>(label.y), m_layout.pixels(28), WHITE);
 
     // Sound toggle
-    Rectangle toggleRect = { m_screenWidth / 2.0f - 100, m_screenHeight / 2.0f - 10, 200, 60 };
-    Vector2 mousePos = GetMousePosition();
-    bool hovered = CheckCollisionPointRec(mousePos, toggleRect);
-    Color baseColor = m_soundEnabled ? DARKGREEN : DARKGRAY;
-    drawEnhancedButton(std::string("Sound: ") + (m_soundEnabled ? "ON" : "OFF"), toggleRect, hovered, baseColor);
+    m_widgets.begin(screenId(GameState::SETTINGS));
+    m_widgets.button(SOUND_TOGGLE, m_layout.get(m_ui.soundToggle), m_soundEnabled ? "Sound: ON" : "Sound: OFF",
+                     m_soundEnabled ? DARKGREEN : DARKGRAY);
+    m_widgets.draw(m_layout.getScale());
 
-    DrawText("Click the button or press 'S' to toggle sound", m_screenWidth / 2 - 220, m_screenHeight / 2 + 80, 18, LIGHTGRAY);
+    Rectangle help = m_layout.get(m_ui.settingsHelp);
+    TextRenderer::draw("Click the button or press 'S' to toggle sound", static_cast<int>(help.x), static_cast<int>(help.y),
+                       m_layout.pixels(18), LIGHTGRAY);
     
     // Draw back hint
-    DrawText("< ESC", 20, m_screenHeight - 40, 24, ColorAlpha(WHITE, 0.8f));
+    Rectangle backHint = m_layout.get(m_ui.backHint);
+    TextRenderer::draw("< ESC", static_cast<int>(backHint.x), static_cast<int>(backHint.y), m_layout.pixels(24),
+                       ColorAlpha(WHITE, 0.8f));
 }
 
 void Game::drawHighScores() {
     const char* title = "HIGH SCORES";
-    int titleSize = 48;
-    int titleWidth = MeasureText(title, titleSize);
-    DrawText(title, m_screenWidth / 2 - titleWidth / 2 + 3, 80, titleSize, ColorAlpha(BLACK, 0.5f));
-    DrawText(title, m_screenWidth / 2 - titleWidth / 2, 76, titleSize, GOLD);
+    int titleSize = m_layout.pixels(48);
+    int titleWidth = TextRenderer::measure(title, titleSize);
+    int titleX = static_cast<int>(m_layout.getCenter(m_ui.scoresTitle).x) - titleWidth / 2;
+    int titleY = static_cast<int>(m_layout.get(m_ui.scoresTitle).y);
+    TextRenderer::draw(title, titleX + m_layout.pixels(3), titleY + m_layout.pixels(4), titleSize, ColorAlpha(BLACK, 0.5f));
+    TextRenderer::draw(title, titleX, titleY, titleSize, GOLD);
 
     // Draw panel
-    Rectangle panel = { m_screenWidth / 2.0f - 300, 180, 600, 420 };
+    Rectangle panel = m_layout.get(m_ui.scoresPanel);
     DrawRectangleRounded(panel, 0.1f, 16, ColorAlpha(DARKBLUE, 0.9f));
-    Utils::drawRoundedRectangleLines(panel, 0.1f, 16, 3, SKYBLUE);
-
-    // Show high score
-    int high = m_scoreManager ? m_scoreManager->getHighScore() : 0;
-    std::string hs = "High Score: " + std::to_string(high);
-    int y = m_screenHeight / 2 - 10;
-    DrawText(hs.c_str(), m_screenWidth / 2 - MeasureText(hs.c_str(), 28) / 2, y, 28, GOLD);
+    Utils::drawRoundedRectangleLines(panel, 0.1f, 16, m_layout.getScale() * 3, SKYBLUE);
+
+    // Difficulty tab
+    const int difficulty = static_cast<int>(m_scoresDifficulty);
+    FormatBuffer<64> tab;
+    tab.append("<  ").append(difficultyName(m_scoresDifficulty)).append(" - ")
+        .append(m_leaderboard.count(difficulty)).append(" games  >");
+    int tabSize = m_layout.pixels(28);
+    TextRenderer::draw(tab, static_cast<int>(m_layout.getCenter(m_ui.scoresTab).x) - TextRenderer::measure(tab, tabSize) / 2,
+                       static_cast<int>(m_layout.get(m_ui.scoresTab).y), tabSize, GOLD);
+
+    m_leaderboard.top(difficulty, SCORES_ROWS, m_scoresTable);
+    if (m_scoresTable.empty()) {
+        const char* empty = "No games won yet";
+        int lineSize = m_layout.pixels(28);
+        Vector2 line = m_layout.getCenter(m_ui.scoresLine);
+        TextRenderer::draw(empty, static_cast<int>(line.x) - TextRenderer::measure(empty, lineSize) / 2,
+                           static_cast<int>(line.y), lineSize, LIGHTGRAY);
+    } else {
+        // Columns as fractions of the row width
+        static constexpr float COLUMNS[] = {0.0f, 0.12f, 0.34f, 0.56f, 0.74f, 0.88f};
+        int rowSize = m_layout.pixels(22);
+        auto drawRow = [&](Rectangle row, const std::string_view* cells, Color color) {
+            for (int i = 0; i < 6; ++i) {
+                TextRenderer::draw(cells[i], static_cast<int>(row.x + COLUMNS[i] * row.width),
+                                   static_cast<int>(row.y), rowSize, color);
+            }
+        };
+        const std::string_view header[] = {"#", "SCORE", "TIME", "MOVES", "HINTS", "SHUFFLES"};
+        drawRow(m_layout.get(m_ui.scoresHeader), header, SKYBLUE);
+        FormatBuffer<Format::INTEGER_CHARS> rank, score, moves, hints, shuffles;
+        FormatBuffer<Format::CLOCK_CHARS> time;
+        for (std::size_t i = 0; i < m_scoresTable.size(); ++i) {
+            const LeaderboardEntry& entry = m_scoresTable[i];
+            rank.clear().append(i + 1);
+            score.clear().append(entry.score);
+            time.clear().appendClock(entry.milliseconds / 1000.0f);
+            moves.clear().append(entry.moves);
+            hints.clear().append(entry.hintsUsed);
+            shuffles.clear().append(entry.shufflesUsed);
+            const std::string_view cells[] = {rank, score, time, moves, hints, shuffles};
+            drawRow(m_layout.get(m_ui.scoresRows + static_cast<int>(i)), cells, i == 0 ? GOLD : WHITE);
+        }
+    }
 
-    DrawText("Press <ESC> to return", 20, m_screenHeight - 40, 20, ColorAlpha(WHITE, 0.8f));
+    Rectangle backHint = m_layout.get(m_ui.backHint);
+    TextRenderer::draw("<LEFT>/<RIGHT> difficulty, <ESC> to return", static_cast<int>(backHint.x), static_cast<int>(backHint.y),
+                       m_layout.pixels(20), ColorAlpha(WHITE, 0.8f));
 }
 
 
 
 void Game::drawEnhancedButton(const std::string& text, Rectangle bounds, bool isSelected, Color baseColor) {
-    // Button animation
-    float scale = isSelected ? 1.05f : 1.0f;
-    Rectangle animBounds = {
-        bounds.x - (bounds.width * scale - bounds.width) / 2,
-        bounds.y - (bounds.height * scale - bounds.height) / 2,
-        bounds.width * scale,
-        bounds.height * scale
-    };
-    
-    // Shadow
-    DrawRectangleRounded({animBounds.x + 6, animBounds.y + 6, animBounds.width, animBounds.height}, 
-                         0.2f, 16, ColorAlpha(BLACK, 0.5f));
-    
-    // Button background with gradient effect
-    Color bgColor = isSelected ? Utils::adjustBrightness(baseColor, 1.3f) : baseColor;
-    DrawRectangleRounded(animBounds, 0.2f, 16, bgColor);
-    
-    // Glow effect for selected
-    if (isSelected) {
-        Utils::drawRoundedRectangleLines(animBounds, 0.2f, 16, 3, GOLD);
-        Rectangle outerBounds = {animBounds.x - 2, animBounds.y - 2, animBounds.width + 4, animBounds.height + 4};
-        Utils::drawRoundedRectangleLines(outerBounds, 0.2f, 16, 1, ColorAlpha(GOLD, 0.5f));
-    } else {
-        Utils::drawRoundedRectangleLines(animBounds, 0.2f, 16, 2, Utils::adjustBrightness(baseColor, 1.5f));
-    }
-    
-    // Text with shadow
-    int textSize = 24;
-    int textWidth = MeasureText(text.c_str(), textSize);
-    int textX = static_cast<int>(animBounds.x + (animBounds.width - textWidth) / 2);
-    int textY = static_cast<int>(animBounds.y + (animBounds.height - textSize) / 2);
-    
-    DrawText(text.c_str(), textX + 2, textY + 2, textSize, ColorAlpha(BLACK, 0.6f));
-    DrawText(text.c_str(), textX, textY, textSize, isSelected ? GOLD : WHITE);
+    WidgetLayer::drawButton(text, bounds, isSelected, baseColor, m_layout.getScale());
 }
 
 // --------------------- State Transitions ---------------------
@@ -540,20 +751,38 @@ void Game::changeState(GameState newState) {
 }
 
 void Game::startNewGame(Difficulty difficulty) {
+    // Dealt from a fresh seed the replay keeps
+    dealBoard(difficulty, std::random_device{}());
+    m_stepsPlayed = 0;
+    m_replay.begin(m_deckSeed, static_cast<int>(difficulty));
+
+    m_totalMoves = 0;
+    m_matchesFound = 0;
+    m_gameWon = false;
+    m_shufflesUsed = 0;
+    m_shuffleCooldownTimer = SHUFFLE_INITIAL_DELAY_SECONDS;
+    // Start pre-game shuffle animation; game timer will begin after shuffle completes
+    if (m_gameBoard) {
+        m_gameBoard->startShuffle(OPENING_SHUFFLE_SECONDS);
+    }
+    m_gameStartTime = 0.0f; // will be set after shuffle ends
+    m_simulationClock.reset();
+    
+    Utils::logInfo("New game started");
+}
+
+void Game::dealBoard(Difficulty difficulty, std::uint32_t seed) {
     m_difficulty = difficulty;
+    m_openFlipSlot = -1;
 
     int numCards = static_cast<int>(difficulty);
     int gridSize = static_cast<int>(sqrt(numCards));
-    Vector2 cardSize = Utils::calculateOptimalCardSize(
-        gridSize, gridSize,
-        Rectangle{0, 100, (float)m_screenWidth, (float)m_screenHeight - 200},
-        15.0f
-    );
 
     // Create game board first
+    m_deckSeed = seed;
     m_gameBoard = std::make_unique<GameBoard>(
-        gridSize, gridSize, cardSize, 15.0f,
-        Rectangle{0, 100, (float)m_screenWidth, (float)m_screenHeight - 150}
+        gridSize, gridSize, getCardSize(gridSize), getBoardPadding(),
+        m_layout.get(m_ui.boardBounds), m_deckSeed
     );
 
     // Create audio manager
@@ -575,19 +804,77 @@ void Game::startNewGame(Difficulty difficulty) {
         m_gameBoard->setAudioManager(m_audioManager.get());
         Utils::logInfo("AudioManager connected to GameBoard");
     }
+}
 
-    m_totalMoves = 0;
-    m_matchesFound = 0;
-    m_gameWon = false;
-    m_shufflesUsed = 0;
-    m_shuffleCooldownTimer = SHUFFLE_INITIAL_DELAY_SECONDS;
-    // Start pre-game shuffle animation; game timer will begin after shuffle completes
-    if (m_gameBoard) {
-        m_gameBoard->startShuffle(1.8f); // ~1.8 seconds of quick reveals
+void Game::saveUnfinishedGame() {
+    if (!m_gameBoard || !m_scoreManager || m_gameWon || m_gameBoard->allMatched()) {
+        return;
     }
-    m_gameStartTime = 0.0f; // will be set after shuffle ends
-    
-    Utils::logInfo("New game started");
+
+    // The timer stands still while paused
+    const float now = m_currentState == GameState::PAUSED ? m_pausedTime : static_cast<float>(GetTime());
+    m_savedGame.difficulty = static_cast<std::int32_t>(m_difficulty);
+    m_savedGame.seed = m_deckSeed;
+    m_savedGame.stepsPlayed = m_stepsPlayed;
+    m_savedGame.timerStarted = m_gameStartTime > 0.0f;
+    m_savedGame.elapsedSeconds = m_savedGame.timerStarted ? std::max(0.0f, now - m_gameStartTime) : 0.0f;
+    m_savedGame.totalMoves = m_totalMoves;
+    m_savedGame.shufflesUsed = m_shufflesUsed;
+    m_savedGame.shuffleCooldown = m_shuffleCooldownTimer;
+    m_savedGame.scoreMoves = m_scoreManager->getMoves();
+    m_savedGame.scoreMatches = m_scoreManager->getMatches();
+    m_savedGame.score = m_scoreManager->getScore();
+    m_gameBoard->saveGridState(m_savedGame.board);
+    if (m_replay.isRecording()) {
+        m_savedGame.replay.assign(m_replay.data(), m_replay.data() + m_replay.size());
+    } else {
+        m_savedGame.replay.clear();   // outgrew its buffer: the rest of the game goes unrecorded
+    }
+    m_savedGame.encode(m_savedGameBytes);
+
+    m_writer.post([bytes = m_savedGameBytes] {
+        return PersistenceWorker::writeAtomically(SAVED_GAME_PATH, bytes.data(), bytes.size());
+    });
+    Utils::logInfo("Game saved (" + Utils::toString(static_cast<int>(m_savedGameBytes.size())) + " bytes)");
+}
+
+bool Game::continueSavedGame() {
+    // Continued or not, the save is used up
+    const bool decoded = m_savedGame.decode(m_savedGameBytes.data(), m_savedGameBytes.size());
+    m_savedGameBytes.clear();
+    m_writer.post([] {
+        std::error_code error;
+        std::filesystem::remove(SAVED_GAME_PATH, error);
+        return !error;
+    });
+    if (!decoded) {
+        Utils::logWarning("Saved game unreadable, not continued");
+        return false;
+    }
+
+    // The same deal as before, then the saved state on top
+    dealBoard(static_cast<Difficulty>(m_savedGame.difficulty), m_savedGame.seed);
+    m_gameBoard->restoreGridState(std::move(m_savedGame.board));
+    m_scoreManager->restore(m_savedGame.scoreMoves, m_savedGame.scoreMatches, m_savedGame.score);
+    m_stepsPlayed = m_savedGame.stepsPlayed;
+    if (!m_replay.resume(m_savedGame.replay.data(), m_savedGame.replay.size())) {
+        // Left not recording: a replay missing its start would never verify
+        Utils::logWarning("Saved game has no usable replay; this game will not save one");
+    }
+
+    m_totalMoves = m_savedGame.totalMoves;
+    m_matchesFound = m_gameBoard->getMatchesFound();
+    m_gameWon = false;
+    m_shufflesUsed = m_savedGame.shufflesUsed;
+    m_shuffleCooldownTimer = m_savedGame.shuffleCooldown;
+    m_simulationClock.reset();
+
+    // Back paused, so the player picks up when ready
+    m_pausedTime = GetTime();
+    m_gameStartTime = m_savedGame.timerStarted ? m_pausedTime - m_savedGame.elapsedSeconds : 0.0f;
+    changeState(GameState::PAUSED);
+    Utils::logInfo("Saved game continued");
+    return true;
 }
 
 void Game::pauseGame() {
@@ -597,7 +884,10 @@ void Game::pauseGame() {
 
 void Game::resumeGame() {
     float pausedDuration = GetTime() - m_pausedTime;
-    m_gameStartTime += pausedDuration;
+    if (m_gameStartTime > 0.0f) {
+        m_gameStartTime += pausedDuration;
+    }
+    m_replay.pause(m_stepsPlayed, static_cast<std::uint32_t>(std::max(0.0f, pausedDuration) * 1000.0f));
     changeState(GameState::PLAYING);
 }
 
@@ -616,9 +906,58 @@ void Game::checkWinCondition() {
         m_gameWon = true;
         m_pausedTime = GetTime();
         m_matchesFound = m_gameBoard->getMatchesFound();
-        // Save high score if applicable
-        if (m_scoreManager) m_scoreManager->trySaveHighScore();
+        recordFinishedGame();
         changeState(GameState::GAME_OVER);
+        
+        m_celebration.clear();
+        Vector2 center = m_layout.getCenter(m_ui.frame);
+        launchFirework({center.x, center.y - 100 * m_layout.getScale()}, CELEBRATION_BURST);
+        m_fireworkTimer = FIREWORK_INTERVAL;
+    }
+}
+
+void Game::launchFirework(Vector2 position, std::size_t count) {
+    ParticleEmitter burst;
+    burst.position = position;
+    burst.minSpeed = 40.0f;
+    burst.maxSpeed = 320.0f;
+    burst.minSize = 1.5f;
+    burst.maxSize = 3.5f;
+    burst.lifetime = 2.2f;
+    burst.color = Utils::colorFromHSV(Utils::randomFloat(0.0f, 360.0f), 0.7f, 1.0f);
+    burst.hueJitter = 40.0f;
+    m_celebration.emit(burst, count);
+}
+
+void Game::recordFinishedGame() {
+    LeaderboardEntry entry;
+    entry.timestamp = static_cast<std::int64_t>(std::time(nullptr));
+    entry.difficulty = static_cast<std::int32_t>(m_difficulty);
+    entry.score = m_scoreManager ? m_scoreManager->getScore() : 0;
+    entry.milliseconds = static_cast<std::uint32_t>(std::max(0.0f, getElapsedTime()) * 1000.0f);
+    entry.moves = m_totalMoves;
+    entry.hintsUsed = m_gameBoard ? m_gameBoard->getHintsUsed() : 0;
+    entry.shufflesUsed = m_shufflesUsed;
+    const LeaderboardEntry& recorded = m_leaderboard.record(entry);
+    m_lastRank = m_leaderboard.rankOf(recorded);
+    m_scoresDifficulty = m_difficulty;
+
+    // Named after when the game ended and how it was dealt, not the entry's
+    // sequence: the leaderboard hands sequence numbers out again after it
+    // recovers from a torn tail or its backup, and an old replay would be
+    // overwritten
+    m_replay.finish(m_stepsPlayed, entry.score, entry.moves);
+    if (m_replay.isTruncated()) {
+        Utils::logWarning("Replay outgrew its buffer and was not saved");
+    } else if (m_replay.isFinished()) {
+        std::vector<unsigned char> bytes(m_replay.data(), m_replay.data() + m_replay.size());
+        std::string path = std::string(REPLAY_DIRECTORY) + "/replay_" + std::to_string(entry.timestamp) + "_" +
+                           std::to_string(m_deckSeed) + ".mcr";
+        m_writer.post([bytes = std::move(bytes), path = std::move(path)] {
+            std::error_code error;
+            std::filesystem::create_directories(REPLAY_DIRECTORY, error);
+            return PersistenceWorker::writeAtomically(path, bytes.data(), bytes.size());
+        });
     }
 }
 
@@ -629,6 +968,38 @@ float Game::getElapsedTime() const {
     return GetTime() - m_gameStartTime;
 }
 
+bool Game::takeFlipLatency(double& seconds) {
+    if (m_drawnInput <= m_presentedInput) {
+        return false;
+    }
+    m_presentedInput = m_drawnInput;
+    seconds = SimulationThread::now() - m_drawnInputTime;
+    return true;
+}
+
+void Game::resize(int screenWidth, int screenHeight) {
+    if (!m_layout.resize(screenWidth, screenHeight)) {
+        return;
+    }
+    m_screenWidth = screenWidth;
+    m_screenHeight = screenHeight;
+    m_hud.setScale(m_layout.getScale());
+    m_backgroundParticles.setWrap(static_cast<float>(screenWidth), static_cast<float>(screenHeight));
+
+    if (m_gameBoard) {
+        // The worker owns the board; updatePlayingThreaded() starts it again
+        stopSimulationThread();
+        int gridSize = static_cast<int>(sqrt(static_cast<int>(m_difficulty)));
+        m_gameBoard->setLayout(getCardSize(gridSize), getBoardPadding(), m_layout.get(m_ui.boardBounds));
+    }
+    Utils::logInfo("Window resized to " + Utils::toString(screenWidth) + "x" + Utils::toString(screenHeight) +
+                   ", UI scale " + Utils::toString(m_layout.getScale(), 2));
+}
+
+bool Game::isAnimating() const {
+    return m_currentState == GameState::PLAYING || m_currentState == GameState::GAME_OVER;
+}
+
 bool Game::canTriggerShuffle() const {
     if (!m_gameBoard) {
         return false;
@@ -639,13 +1010,26 @@ bool Game::canTriggerShuffle() const {
     return m_shuffleCooldownTimer <= 0.0f;
 }
 
+void Game::showHint() {
+    if (!m_gameBoard) {
+        return;
+    }
+    const int before = m_gameBoard->getHintsRemaining();
+    m_gameBoard->showHint();
+    if (m_gameBoard->getHintsRemaining() < before) {
+        m_replay.hint(m_stepsPlayed);
+    }
+}
+
 void Game::triggerShuffle() {
     if (!m_gameBoard) {
         return;
     }
 
-    m_gameBoard->startShuffle(1.35f);
+    m_gameBoard->startShuffle(RESHUFFLE_SECONDS);
     if (m_gameBoard->isShuffling()) {
+        m_replay.shuffle(m_stepsPlayed);
+        m_openFlipSlot = -1;    // every card goes face down
         m_shuffleCooldownTimer = SHUFFLE_COOLDOWN_SECONDS;
         ++m_shufflesUsed;
         if (m_scoreManager) {
@@ -655,6 +1039,87 @@ void Game::triggerShuffle() {
     }
 }
 
+void Game::buildLayout() {
+    // Design pixels: the positions the screens were drawn at in a 1024x768
+    // window, which is also what they come out as at that size
+    LayoutNode frame;
+    frame.anchor = frame.pivot = {0.5f, 0.5f};
+    frame.size = {DESIGN_WIDTH, DESIGN_HEIGHT};
+    m_ui.frame = m_layout.add(frame);
+
+    LayoutNode backHint;
+    backHint.anchor = {0.0f, 1.0f};
+    backHint.offset = {20.0f, -40.0f};
+    m_ui.backHint = m_layout.add(backHint);
+
+    // Lines of text and buttons centred horizontally, from the top of the frame
+    auto fromTop = [this](float y, Vector2 size) {
+        LayoutNode node;
+        node.parent = m_ui.frame;
+        node.anchor = {0.5f, 0.0f};
+        node.pivot = {0.5f, 0.0f};
+        node.offset = {0.0f, y};
+        node.size = size;
+        return node;
+    };
+    // Offset from the centre of the frame to the node's top-left corner
+    auto fromCenter = [this](float x, float y, Vector2 size) {
+        LayoutNode node;
+        node.parent = m_ui.frame;
+        node.anchor = {0.5f, 0.5f};
+        node.offset = {x, y};
+        node.size = size;
+        return node;
+    };
+    const Vector2 button = {BUTTON_WIDTH, BUTTON_HEIGHT};
+    const Vector2 buttonStep = {0.0f, BUTTON_HEIGHT + BUTTON_SPACING};
+
+    m_ui.menuTitle = m_layout.add(fromTop(80.0f, {0.0f, 50.0f}));
+    m_ui.menuButtons = m_layout.addStack(fromTop(220.0f, button), MAIN_MENU_ITEMS + 1, buttonStep);
+
+    m_ui.difficultyTitle = m_layout.add(fromTop(120.0f, {0.0f, 40.0f}));
+    m_ui.difficultyButtons = m_layout.addStack(fromTop(250.0f, button), DIFFICULTY_OPTIONS, buttonStep);
+
+    m_ui.pausePanel = m_layout.add(fromCenter(-250.0f, -200.0f, {500.0f, 400.0f}));
+    m_ui.pauseTitle = m_layout.add(fromCenter(0.0f, -120.0f, {0.0f, 60.0f}));
+    m_ui.pauseLines = m_layout.addStack(fromCenter(0.0f, 0.0f, {0.0f, 0.0f}), 2, {0.0f, 40.0f});
+
+    m_ui.victoryPanel = m_layout.add(fromCenter(-300.0f, -250.0f, {600.0f, 500.0f}));
+    m_ui.victoryTitle = m_layout.add(fromCenter(0.0f, -160.0f, {0.0f, 70.0f}));
+    m_ui.timeBox = m_layout.add(fromCenter(-250.0f, -50.0f, {200.0f, 80.0f}));
+    m_ui.movesBox = m_layout.add(fromCenter(-20.0f, -50.0f, {200.0f, 80.0f}));
+    m_ui.victoryRank = m_layout.add(fromCenter(0.0f, 44.0f, {0.0f, 24.0f}));
+    m_ui.restartButton = m_layout.add(fromCenter(-230.0f, 80.0f, {200.0f, 60.0f}));
+    m_ui.menuButton = m_layout.add(fromCenter(30.0f, 80.0f, {200.0f, 60.0f}));
+
+    m_ui.settingsTitle = m_layout.add(fromTop(100.0f, {0.0f, 40.0f}));
+    m_ui.settingsPanel = m_layout.add(fromTop(200.0f, {600.0f, 400.0f}));
+    m_ui.settingsLabel = m_layout.add(fromCenter(-40.0f, -80.0f, {0.0f, 28.0f}));
+    m_ui.soundToggle = m_layout.add(fromCenter(-100.0f, -10.0f, {200.0f, 60.0f}));
+    m_ui.settingsHelp = m_layout.add(fromCenter(-220.0f, 80.0f, {0.0f, 18.0f}));
+
+    m_ui.scoresTitle = m_layout.add(fromTop(76.0f, {0.0f, 48.0f}));
+    m_ui.scoresPanel = m_layout.add(fromTop(180.0f, {600.0f, 420.0f}));
+    m_ui.scoresLine = m_layout.add(fromCenter(0.0f, -10.0f, {0.0f, 0.0f}));
+    m_ui.scoresTab = m_layout.add(fromTop(200.0f, {0.0f, 28.0f}));
+    m_ui.scoresHeader = m_layout.add(fromTop(250.0f, {520.0f, 22.0f}));
+    m_ui.scoresRows = m_layout.addStack(fromTop(282.0f, {520.0f, 22.0f}), SCORES_ROWS, {0.0f, 30.0f});
+
+    // The board spans the window below the HUD's top bar and above its
+    // bottom panels, whose heights scale with everything else
+    LayoutNode boardArea;
+    boardArea.offset = {0.0f, 100.0f};
+    boardArea.size = {0.0f, -200.0f};
+    boardArea.stretch = {1.0f, 1.0f};
+    m_ui.boardArea = m_layout.add(boardArea);
+    boardArea.size = {0.0f, -150.0f};
+    m_ui.boardBounds = m_layout.add(boardArea);
+}
+
+Vector2 Game::getCardSize(int gridSize) const {
+    return Utils::calculateOptimalCardSize(gridSize, gridSize, m_layout.get(m_ui.boardArea), getBoardPadding());
+}
+
 void Game::drawButton(const std::string& text, Rectangle bounds, bool isSelected, Color color) {
     drawEnhancedButton(text, bounds, isSelected, color);
 }
@@ -675,114 +1140,27 @@ void Game::drawTimer() {
 // --------------------- Input Handling ---------------------
 
 void Game::handleMainMenuInput() {
-    Vector2 mousePos = GetMousePosition();
-    
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-        for (size_t i = 0; i < m_mainMenuItems.size(); ++i) {
-            Rectangle buttonRect = {
-                m_screenWidth / 2.0f - BUTTON_WIDTH / 2,
-                220.0f + i * (BUTTON_HEIGHT + BUTTON_SPACING),
-                BUTTON_WIDTH,
-                BUTTON_HEIGHT
-            };
-            
-            if (CheckCollisionPointRec(mousePos, buttonRect)) {
-                switch (i) {
-                    case 0: changeState(GameState::DIFFICULTY); break;
-                    case 1: changeState(GameState::SETTINGS); break;
-                    case 2: changeState(GameState::HIGH_SCORES); break;
-                    case 3: CloseWindow(); break;
-                }
-            }
-        }
-    }
-    
-    m_selectedMenuItem = -1;
-    for (size_t i = 0; i < m_mainMenuItems.size(); ++i) {
-        Rectangle buttonRect = {
-            m_screenWidth / 2.0f - BUTTON_WIDTH / 2,
-            220.0f + i * (BUTTON_HEIGHT + BUTTON_SPACING),
-            BUTTON_WIDTH,
-            BUTTON_HEIGHT
-        };
-        
-        if (CheckCollisionPointRec(mousePos, buttonRect)) {
-            m_selectedMenuItem = static_cast<int>(i);
-        }
-    }
-    
-    if (IsKeyPressed(KEY_DOWN)) {
-        m_selectedMenuItem = (m_selectedMenuItem + 1) % m_mainMenuItems.size();
-    }
-    if (IsKeyPressed(KEY_UP)) {
-        m_selectedMenuItem = (m_selectedMenuItem - 1 + m_mainMenuItems.size()) % m_mainMenuItems.size();
-    }
-    if (IsKeyPressed(KEY_ENTER)) {
-        if (m_selectedMenuItem >= 0) {
-            switch (m_selectedMenuItem) {
-                case 0: changeState(GameState::DIFFICULTY); break;
-                case 1: changeState(GameState::SETTINGS); break;
-                case 2: Utils::logInfo("High Scores clicked"); break;
-                case 3: CloseWindow(); break;
-            }
-        }
+    // Hover, arrow keys, Enter and clicks on the buttons drawn last frame
+    switch (m_widgets.update(screenId(GameState::MAIN_MENU), WidgetInput::poll())) {
+        case 0: changeState(GameState::DIFFICULTY); break;
+        case 1: changeState(GameState::SETTINGS); break;
+        case 2: changeState(GameState::HIGH_SCORES); break;
+        case 3: CloseWindow(); break;
+        case CONTINUE_ITEM: continueSavedGame(); break;
     }
 }
 
 void Game::handleDifficultySelectionInput() {
-    Vector2 mousePos = GetMousePosition();
-    
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-        for (size_t i = 0; i < m_difficultyNames.size(); ++i) {
-            Rectangle buttonRect = {
-                m_screenWidth / 2.0f - BUTTON_WIDTH / 2,
-                250.0f + i * (BUTTON_HEIGHT + BUTTON_SPACING),
-                BUTTON_WIDTH,
-                BUTTON_HEIGHT
-            };
-            
-            if (CheckCollisionPointRec(mousePos, buttonRect)) {
-                switch (i) {
-                    case 0: m_difficulty = Difficulty::EASY; break;
-                    case 1: m_difficulty = Difficulty::MEDIUM; break;
-                    case 2: m_difficulty = Difficulty::HARD; break;
-                }
-                startNewGame(m_difficulty);
-                changeState(GameState::PLAYING);
-            }
-        }
-    }
-    
-    m_selectedDifficulty = -1;
-    for (size_t i = 0; i < m_difficultyNames.size(); ++i) {
-        Rectangle buttonRect = {
-            m_screenWidth / 2.0f - BUTTON_WIDTH / 2,
-            250.0f + i * (BUTTON_HEIGHT + BUTTON_SPACING),
-            BUTTON_WIDTH,
-            BUTTON_HEIGHT
-        };
-        
-        if (CheckCollisionPointRec(mousePos, buttonRect)) {
-            m_selectedDifficulty = static_cast<int>(i);
-        }
-    }
-    
-    if (IsKeyPressed(KEY_DOWN)) {
-        m_selectedDifficulty = (m_selectedDifficulty + 1) % m_difficultyNames.size();
-    }
-    if (IsKeyPressed(KEY_UP)) {
-        m_selectedDifficulty = (m_selectedDifficulty - 1 + m_difficultyNames.size()) % m_difficultyNames.size();
-    }
-    if (IsKeyPressed(KEY_ENTER)) {
-        if (m_selectedDifficulty >= 0) {
-            switch (m_selectedDifficulty) {
-                case 0: m_difficulty = Difficulty::EASY; break;
-                case 1: m_difficulty = Difficulty::MEDIUM; break;
-                case 2: m_difficulty = Difficulty::HARD; break;
-            }
-            startNewGame(m_difficulty);
-            changeState(GameState::PLAYING);
+    int chosen = m_widgets.update(screenId(GameState::DIFFICULTY), WidgetInput::poll());
+    if (chosen >= 0) {
+        switch (chosen) {
+            case 0: m_difficulty = Difficulty::EASY; break;
+            case 1: m_difficulty = Difficulty::MEDIUM; break;
+            case 2: m_difficulty = Difficulty::HARD; break;
         }
+        startNewGame(m_difficulty);
+        changeState(GameState::PLAYING);
+        return;
     }
     if (IsKeyPressed(KEY_ESCAPE)) {
         changeState(GameState::MAIN_MENU);
@@ -798,7 +1176,7 @@ void Game::handlePlayingInput() {
     
     // Handle hint system (H key)
     if (IsKeyPressed(KEY_H) && m_gameBoard) {
-        m_gameBoard->showHint();
+        showHint();
     }
 
     // Trigger reshuffle ability with R key
@@ -812,8 +1190,17 @@ void Game::handlePlayingInput() {
     
     // Handle card clicks
     if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && m_gameBoard) {
+        // Click-to-flip latency is measured from here to the frame that shows the flip
+        double clickTime = SimulationThread::now();
         Vector2 mousePos = GetMousePosition();
-        m_gameBoard->handleClick(mousePos);
+        const int matchesBefore = m_gameBoard->getMatchesFound();
+        if (m_gameBoard->handleClick(mousePos)) {
+            const int slot = m_gameBoard->slotAt(mousePos);
+            m_replay.click(m_stepsPlayed, slot);
+            reportFlip(slot, matchesBefore);
+            ++m_inputSequence;
+            m_inputTime = clickTime;
+        }
         m_totalMoves++;
     }
 }
@@ -824,53 +1211,39 @@ void Game::handlePausedInput() {
     }
     
     if (IsKeyPressed(KEY_M)) {
+        saveUnfinishedGame();
         returnToMainMenu();
     }
 }
 
 void Game::handleGameOverInput() {
-    // Handle keyboard input
-    if (IsKeyPressed(KEY_R) || IsKeyPressed(KEY_ENTER)) {
-        restartGame();
-        changeState(GameState::PLAYING);
+    // Buttons first (Enter activates the focused one), then the shortcuts
+    int action = m_widgets.update(screenId(GameState::GAME_OVER), WidgetInput::poll());
+    if (action < 0) {
+        if (IsKeyPressed(KEY_R) || IsKeyPressed(KEY_ENTER)) {
+            action = RESTART_BUTTON;
+        } else if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_M)) {
+            action = MENU_BUTTON;
+        }
     }
     
-    if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_M)) {
+    if (action == RESTART_BUTTON) {
+        restartGame();
+        changeState(GameState::PLAYING);
+    } else if (action == MENU_BUTTON) {
         returnToMainMenu();
     }
-    
-    // Handle mouse clicks on buttons
-    Vector2 mousePos = GetMousePosition();
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-        Rectangle restartBtn = {m_screenWidth / 2.0f - 230, m_screenHeight / 2.0f + 80, 200, 60};
-        Rectangle menuBtn = {m_screenWidth / 2.0f + 30, m_screenHeight / 2.0f + 80, 200, 60};
-        
-        if (CheckCollisionPointRec(mousePos, restartBtn)) {
-            restartGame();
-            changeState(GameState::PLAYING);
-        } else if (CheckCollisionPointRec(mousePos, menuBtn)) {
-            returnToMainMenu();
-        }
-    }
 }
 
 void Game::handleSettingsInput() {
-    // Toggle sound with 'S'
-    if (IsKeyPressed(KEY_S)) {
+    // Toggle with 'S', or by clicking or activating the toggle button
+    bool toggled = m_widgets.update(screenId(GameState::SETTINGS), WidgetInput::poll()) == SOUND_TOGGLE;
+    if (toggled || IsKeyPressed(KEY_S)) {
         m_soundEnabled = !m_soundEnabled;
         Utils::logInfo(std::string("Settings: soundEnabled = ") + (m_soundEnabled ? "true" : "false"));
         if (m_audioManager) m_audioManager->setMuted(!m_soundEnabled);
     }
 
-    // Toggle via mouse click on the toggle button area
-    Vector2 mousePos = GetMousePosition();
-    Rectangle toggleRect = { m_screenWidth / 2.0f - 100, m_screenHeight / 2.0f - 10, 200, 60 };
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionPointRec(mousePos, toggleRect)) {
-        m_soundEnabled = !m_soundEnabled;
-        Utils::logInfo(std::string("Settings (mouse): soundEnabled = ") + (m_soundEnabled ? "true" : "false"));
-        if (m_audioManager) m_audioManager->setMuted(!m_soundEnabled);
-    }
-
     if (IsKeyPressed(KEY_ESCAPE)) {
         // Return to main menu instead of exiting the program (Exit key disabled in main)
         changeState(GameState::MAIN_MENU);
@@ -878,6 +1251,13 @@ void Game::handleSettingsInput() {
 }
 
 void Game::handleHighScoresInput() {
+    // Left and right page through the difficulties
+    static constexpr Difficulty TABS[] = {Difficulty::EASY, Difficulty::MEDIUM, Difficulty::HARD};
+    int step = IsKeyPressed(KEY_RIGHT) ? 1 : (IsKeyPressed(KEY_LEFT) ? -1 : 0);
+    if (step != 0) {
+        int tab = static_cast<int>(std::find(std::begin(TABS), std::end(TABS), m_scoresDifficulty) - std::begin(TABS));
+        m_scoresDifficulty = TABS[(tab + step + DIFFICULTY_OPTIONS) % DIFFICULTY_OPTIONS];
+    }
     if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER) || IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
         changeState(GameState::MAIN_MENU);
     }
@@ -733,7 +733,8 @@
 #include <algorithm>
 #include <cmath>
 
-GameBoard::GameBoard(int rows, int cols, Vector2 cardSize, float padding, Rectangle screenBounds)
+GameBoard::GameBoard(int rows, int cols, Vector2 cardSize, float padding, Rectangle screenBounds, std::uint32_t seed,
+                     bool headless)
     : m_rows(rows), 
       m_cols(cols), 
       m_cardSize(cardSize), 
@@ -753,9 +754,13 @@ GameBoard::GameBoard(int rows, int cols, Vector2 cardSize, float padding, Rectan
       m_hintCard1(nullptr),
       m_hintCard2(nullptr),
       m_hintDisplayTime(0.0f),
-      m_hintAutoFlipBack(false)
+      m_hintAutoFlipBack(false),
+      m_rng(seed),
+      m_seed(seed),
+      m_headless(headless)
 {
-    Utils::logInfo("GameBoard constructor called");
+    Utils::logDebug("GameBoard constructor called");
+    m_cardRenderer.setFaceTexturePath(CARD_TEXTURE_PATH);
     createCards();
 }
 
@@ -763,11 +768,17 @@ void GameBoard::startShuffle(float durationSeconds) {
     if (m_cards.empty()) {
         return;
     }
+    if (m_isShuffling) {
+        // Cards part way to their targets have no slot to be shuffled from
+        Utils::logDebug("Shuffle skipped - already shuffling");
+        return;
+    }
 
-    std::vector<int> movableIndices;
-    movableIndices.reserve(m_cards.size());
-    std::vector<Vector2> availablePositions;
-    availablePositions.reserve(m_cards.size());
+    // Built in the members' buffers, reserved with the deal, so a reshuffle does not allocate
+    std::vector<int>& movableIndices = m_shuffleOrder;
+    std::vector<Vector2>& availablePositions = m_shufflePositions;
+    movableIndices.clear();
+    availablePositions.clear();
 
     for (size_t i = 0; i < m_cards.size(); ++i) {
         Card* card = m_cards[i].get();
@@ -779,18 +790,20 @@ void GameBoard::startShuffle(float durationSeconds) {
     }
 
     if (movableIndices.size() <= 1) {
-        Utils::logInfo("Shuffle skipped - insufficient unmatched cards");
+        movableIndices.clear();
+        Utils::logDebug("Shuffle skipped - insufficient unmatched cards");
         return;
     }
 
-    Utils::shuffle(movableIndices);
-    Utils::shuffle(availablePositions);
+    auto draw = [this] { return nextRandom(); };
+    Utils::shuffle(movableIndices, draw);
+    Utils::shuffle(availablePositions, draw);
 
     m_isShuffling = true;
+    m_cardsSettled = false;
     m_shuffleDuration = durationSeconds;
     m_shuffleTimer = 0.0f;
     m_nextShuffleStartIndex = 0;
-    m_shuffleOrder = movableIndices;
 
     m_shuffleTargets.assign(m_cards.size(), Vector2{});
     for (size_t i = 0; i < m_cards.size(); ++i) {
@@ -813,10 +826,9 @@ void GameBoard::startShuffle(float durationSeconds) {
         resetFlippedCards();
     }
 
+    // Face up or still turning up: a card must not be left up once nothing tracks it
     for (int index : movableIndices) {
-        if (!m_cards[index]->isMatched() && m_cards[index]->isRevealed()) {
-            m_cards[index]->flipDown();
-        }
+        m_cards[index]->flipDown();
     }
 
     // Clear any active hints when reshuffling occurs
@@ -828,14 +840,47 @@ void GameBoard::startShuffle(float durationSeconds) {
     m_comboCount = 0;
     m_comboDisplayTime = 0.0f;
 
-    Utils::logInfo("Position shuffle started: duration=" + Utils::toString(m_shuffleDuration) +
+#ifdef DEBUG
+    Utils::logDebug("Position shuffle started: duration=" + Utils::toString(m_shuffleDuration) +
                    " cards=" + Utils::toString(static_cast<int>(movableIndices.size())));
+#endif
+}
+
+void GameBoard::setLayout(Vector2 cardSize, float padding, Rectangle screenBounds) {
+    // Maps a position on the old grid to the same row and column on the new one
+    auto relocate = [&](Vector2 position) {
+        float col = std::round((position.x - m_screenBounds.x) / (m_cardSize.x + m_padding));
+        float row = std::round((position.y - m_screenBounds.y) / (m_cardSize.y + m_padding));
+        return Vector2{screenBounds.x + col * (cardSize.x + padding), screenBounds.y + row * (cardSize.y + padding)};
+    };
+
+    // A card sliding somewhere lands there right away; cards still waiting
+    // for their turn in a shuffle keep waiting, for the relocated target
+    for (auto& card : m_cards) {
+        card->setPosition(relocate(card->getDestination()));
+        card->setSize(cardSize);
+    }
+    m_cardsSettled = false;
+    for (Vector2& target : m_shuffleTargets) {
+        target = relocate(target);
+    }
+
+    m_cardSize = cardSize;
+    m_padding = padding;
+    m_screenBounds = screenBounds;
+    // The instanced renderer's atlas was drawn at the old card size
+    m_cardRenderer.unload();
 }
 
 void GameBoard::createCards() {
+    // Pairs in a fixed order, then one seeded shuffle: the deal depends on the seed alone
     int numPairs = (m_rows * m_cols) / 2;
-    std::vector<int> ids = Utils::createCardPairs(numPairs);
-    Utils::shuffle(ids);
+    std::vector<int> ids(numPairs * 2);
+    for (int i = 0; i < numPairs * 2; ++i) {
+        ids[i] = i / 2;
+    }
+    auto draw = [this] { return nextRandom(); };
+    Utils::shuffle(ids, draw);
 
     m_cards.clear();
     int index = 0;
@@ -845,16 +890,24 @@ void GameBoard::createCards() {
                 m_screenBounds.x + x * (m_cardSize.x + m_padding),
                 m_screenBounds.y + y * (m_cardSize.y + m_padding) 
             };
-            m_cards.push_back(std::make_unique<Card>(ids[index++], "assets/textures/card.png", pos, m_cardSize));
+            m_cards.push_back(std::make_unique<Card>(ids[index++], m_headless ? "" : CARD_TEXTURE_PATH, pos, m_cardSize));
         }
     }
-    Utils::logInfo("Created " + Utils::toString(m_rows * m_cols) + " cards");
+    m_shuffleOrder.reserve(m_cards.size());
+    m_shuffleTargets.reserve(m_cards.size());
+    m_shufflePositions.reserve(m_cards.size());
+    Utils::logDebug("Created " + Utils::toString(m_rows * m_cols) + " cards");
 }
 
 void GameBoard::update(float deltaTime) {
-    // Update all cards
-    for (auto& card : m_cards) {
-        card->update(deltaTime);
+    // Update all cards, unless none of them has anything left to do
+    if (!m_cardsSettled) {
+        bool settled = true;
+        for (auto& card : m_cards) {
+            card->update(deltaTime);
+            settled = settled && card->isSettled();
+        }
+        m_cardsSettled = settled;
     }
     
     // Update combo display timer
@@ -885,6 +938,7 @@ void GameBoard::update(float deltaTime) {
                 if (m_hintCard2 && !m_hintCard2->isMatched() && m_hintCard2->isRevealed()) {
                     m_hintCard2->flipDown();
                 }
+                m_cardsSettled = false;
             }
             m_hintCard1 = nullptr;
             m_hintCard2 = nullptr;
@@ -905,6 +959,7 @@ void GameBoard::update(float deltaTime) {
             int cardIndex = m_shuffleOrder[m_nextShuffleStartIndex];
             if (cardIndex >= 0 && cardIndex < cardCount) {
                 m_cards[cardIndex]->moveTo(m_shuffleTargets[cardIndex], m_shuffleMoveDuration);
+                m_cardsSettled = false;
             }
             m_nextShuffleStartIndex++;
         }
@@ -926,7 +981,7 @@ void GameBoard::update(float deltaTime) {
                 m_nextShuffleStartIndex = 0;
                 m_shuffleTargets.clear();
                 m_shuffleOrder.clear();
-                Utils::logInfo("Position shuffle completed");
+                Utils::logDebug("Position shuffle completed");
             }
         }
 
@@ -944,6 +999,7 @@ void GameBoard::update(float deltaTime) {
                 if (m_firstFlippedCard->getId() != m_secondFlippedCard->getId()) {
                     m_firstFlippedCard->flipDown();
                     m_secondFlippedCard->flipDown();
+                    m_cardsSettled = false;
                 }
             }
             resetFlippedCards();
@@ -951,26 +1007,78 @@ void GameBoard::update(float deltaTime) {
     }
 }
 
-void GameBoard::draw() const {
-    for (auto& card : m_cards)
-        card->draw();
+void GameBoard::draw(float alpha) const {
+    fillSnapshot(m_drawSnapshot);
+    drawSnapshot(m_drawSnapshot, alpha);
+}
+
+void GameBoard::fillSnapshot(BoardSnapshot& snapshot) const {
+    snapshot.cards.resize(m_cards.size());
+    snapshot.hintCards[0] = -1;
+    snapshot.hintCards[1] = -1;
+    for (size_t i = 0; i < m_cards.size(); ++i) {
+        m_cards[i]->fillSnapshot(snapshot.cards[i]);
+        if (m_hintDisplayTime > 0.0f) {
+            if (m_cards[i].get() == m_hintCard1) snapshot.hintCards[0] = static_cast<int>(i);
+            if (m_cards[i].get() == m_hintCard2) snapshot.hintCards[1] = static_cast<int>(i);
+        }
+    }
+    snapshot.comboCount = m_comboCount;
+    snapshot.comboTime = m_comboDisplayTime;
+    snapshot.shuffling = m_isShuffling;
+    snapshot.complete = allMatched();
+}
+
+void GameBoard::drawSnapshot(const BoardSnapshot& snapshot, float alpha) const {
+    // Whole board in one instanced call; one by one when that is unavailable.
+    // Only the textures are read from the cards themselves, which are loaded
+    // here the first time and never change after.
+    if (!m_cardRenderer.draw(snapshot.cards, alpha)) {
+        for (size_t i = 0; i < snapshot.cards.size() && i < m_cards.size(); ++i) {
+            m_cards[i]->loadTextures();
+            m_cards[i]->draw(snapshot.cards[i], alpha);
+        }
+    }
     
     // Draw hint highlighting
-    if (m_hintDisplayTime > 0.0f && m_hintCard1 && m_hintCard2) {
-        Rectangle r1 = m_hintCard1->getBounds();
-        Rectangle r2 = m_hintCard2->getBounds();
-        float alpha = 0.5f + 0.3f * sin(GetTime() * 5.0f); // Pulsing effect
-        Color hintColor = ColorAlpha(YELLOW, alpha);
-        DrawRectangleLinesEx(r1, 4.0f, hintColor);
-        DrawRectangleLinesEx(r2, 4.0f, hintColor);
+    if (snapshot.hintCards[0] >= 0 && snapshot.hintCards[1] >= 0) {
+        float pulse = 0.5f + 0.3f * sin(GetTime() * 5.0f); // Pulsing effect
+        Color hintColor = ColorAlpha(YELLOW, pulse);
+        for (int index : snapshot.hintCards) {
+            const CardSnapshot& card = snapshot.cards[index];
+            Rectangle bounds = {card.position.x, card.position.y, card.size.x, card.size.y};
+            DrawRectangleLinesEx(bounds, 4.0f, hintColor);
+        }
     }
 }
 
-void GameBoard::handleClick(Vector2 mousePos) {
+int GameBoard::slotAt(Vector2 point) const {
+    const float col = std::floor((point.x - m_screenBounds.x) / (m_cardSize.x + m_padding));
+    const float row = std::floor((point.y - m_screenBounds.y) / (m_cardSize.y + m_padding));
+    if (col < 0.0f || row < 0.0f || col >= m_cols || row >= m_rows) {
+        return -1;
+    }
+    // In the padding between two cards is no slot
+    const float x = point.x - (m_screenBounds.x + col * (m_cardSize.x + m_padding));
+    const float y = point.y - (m_screenBounds.y + row * (m_cardSize.y + m_padding));
+    if (x > m_cardSize.x || y > m_cardSize.y) {
+        return -1;
+    }
+    return static_cast<int>(row) * m_cols + static_cast<int>(col);
+}
+
+Vector2 GameBoard::getSlotCenter(int slot) const {
+    const int row = slot / m_cols;
+    const int col = slot % m_cols;
+    return {m_screenBounds.x + col * (m_cardSize.x + m_padding) + m_cardSize.x / 2.0f,
+            m_screenBounds.y + row * (m_cardSize.y + m_padding) + m_cardSize.y / 2.0f};
+}
+
+bool GameBoard::handleClick(Vector2 mousePos) {
     // Don't allow clicks while processing a match
     if (m_isProcessingMatch || m_isShuffling || (m_hintDisplayTime > 0.0f && m_hintAutoFlipBack)) {
         Utils::logDebug("Click ignored - board temporarily locked");
-        return;
+        return false;
     }
     
     // Find clicked card
@@ -979,30 +1087,34 @@ void GameBoard::handleClick(Vector2 mousePos) {
             // Can only click face-down cards
             if (card->getState() == CardState::FACE_DOWN) {
                 card->flipUp();
+                m_cardsSettled = false;
                 
-                // Play flip sound - DEBUG VERSION
+                // Play flip sound (boards without audio, like replay checks, stay silent)
                 if (m_audioManager) {
-                    Utils::logInfo("Audio manager exists, calling playFlip()");
                     m_audioManager->playFlip();
-                } else {
-                    Utils::logError("Audio manager is NULL! Cannot play sound.");
                 }
                 
                 // Track flipped cards
                 if (!m_firstFlippedCard) {
                     m_firstFlippedCard = card.get();
+#ifdef DEBUG
                     Utils::logDebug("First card flipped: ID " + Utils::toString(card->getId()));
+#endif
                 } else if (!m_secondFlippedCard && card.get() != m_firstFlippedCard) {
                     m_secondFlippedCard = card.get();
+#ifdef DEBUG
                     Utils::logDebug("Second card flipped: ID " + Utils::toString(card->getId()));
+#endif
                     
                     // Check for match after second card is flipped
                     checkMatch();
                 }
+                return true;
             }
             break; // Only handle one card click at a time
         }
     }
+    return false;
 }
 
 void GameBoard::checkMatch() {
@@ -1024,20 +1136,20 @@ void GameBoard::checkMatch() {
         // Calculate combo multiplier (1x, 2x, 3x, etc., max 5x)
         int comboMultiplier = std::min(m_comboCount, 5);
         
-        // Play match sound - DEBUG VERSION
+        // Play match sound
         if (m_audioManager) {
-            Utils::logInfo("Match found! Audio manager exists, calling playMatch()");
             m_audioManager->playMatch();
-        } else {
-            Utils::logError("Audio manager is NULL! Cannot play match sound.");
         }
         
-        Utils::logInfo("Match found! Card ID: " + Utils::toString(m_firstFlippedCard->getId()) + 
+#ifdef DEBUG
+        Utils::logDebug("Match found! Card ID: " + Utils::toString(m_firstFlippedCard->getId()) + 
                       " | Total matches: " + Utils::toString(m_matchesFound) +
                       " | Combo: " + Utils::toString(m_comboCount) + "x");
+#endif
         
         m_firstFlippedCard->setMatched();
         m_secondFlippedCard->setMatched();
+        m_cardsSettled = false;
         // Update score manager with combo multiplier
         if (m_scoreManager) {
             m_scoreManager->addMatch(comboMultiplier);
@@ -1121,7 +1233,129 @@ void GameBoard::showHint() {
         if (!m_hintCard2->isRevealed()) {
             m_hintCard2->flipUp();
         }
+        m_cardsSettled = false;
 
-        Utils::logInfo("Hint shown! Remaining hints: " + Utils::toString(m_hintsRemaining));
+#ifdef DEBUG
+        Utils::logDebug("Hint shown! Remaining hints: " + Utils::toString(m_hintsRemaining));
+#endif
     }
-}
\ No newline at end of file
+}
+
+// === Replay keyframes ===
+
+int GameBoard::indexOf(const Card* card) const {
+    for (size_t i = 0; i < m_cards.size(); ++i) {
+        if (m_cards[i].get() == card) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+Card* GameBoard::cardAt(int index) const {
+    return index >= 0 && index < static_cast<int>(m_cards.size()) ? m_cards[index].get() : nullptr;
+}
+
+std::uint32_t GameBoard::nextRandom() {
+    ++m_rngDraws;
+    return static_cast<std::uint32_t>(m_rng());
+}
+
+void GameBoard::saveState(LogicState& state) const {
+    state.cards.resize(m_cards.size());
+    for (size_t i = 0; i < m_cards.size(); ++i) {
+        m_cards[i]->saveState(state.cards[i]);
+    }
+    state.firstFlipped = indexOf(m_firstFlippedCard);
+    state.secondFlipped = indexOf(m_secondFlippedCard);
+    state.hintCard1 = indexOf(m_hintCard1);
+    state.hintCard2 = indexOf(m_hintCard2);
+    state.flipBackTimer = m_flipBackTimer;
+    state.isProcessingMatch = m_isProcessingMatch;
+    state.matchesFound = m_matchesFound;
+    state.comboCount = m_comboCount;
+    state.comboDisplayTime = m_comboDisplayTime;
+    state.hintsRemaining = m_hintsRemaining;
+    state.hintCooldown = m_hintCooldown;
+    state.hintDisplayTime = m_hintDisplayTime;
+    state.hintAutoFlipBack = m_hintAutoFlipBack;
+    state.rng = m_rng;
+    state.rngDraws = m_rngDraws;
+    state.isShuffling = m_isShuffling;
+    state.shuffleDuration = m_shuffleDuration;
+    state.shuffleTimer = m_shuffleTimer;
+    state.shuffleOrder.assign(m_shuffleOrder.begin(), m_shuffleOrder.end());
+    state.shuffleTargets.assign(m_shuffleTargets.begin(), m_shuffleTargets.end());
+    state.nextShuffleStartIndex = m_nextShuffleStartIndex;
+}
+
+void GameBoard::restoreState(const LogicState& state) {
+    if (state.cards.size() != m_cards.size()) {
+        Utils::logError("Board state from a different board ignored");
+        return;
+    }
+    for (size_t i = 0; i < m_cards.size(); ++i) {
+        m_cards[i]->restoreState(state.cards[i]);
+    }
+    m_cardsSettled = false;
+    m_firstFlippedCard = cardAt(state.firstFlipped);
+    m_secondFlippedCard = cardAt(state.secondFlipped);
+    m_hintCard1 = cardAt(state.hintCard1);
+    m_hintCard2 = cardAt(state.hintCard2);
+    m_flipBackTimer = state.flipBackTimer;
+    m_isProcessingMatch = state.isProcessingMatch;
+    m_matchesFound = state.matchesFound;
+    m_comboCount = state.comboCount;
+    m_comboDisplayTime = state.comboDisplayTime;
+    m_hintsRemaining = state.hintsRemaining;
+    m_hintCooldown = state.hintCooldown;
+    m_hintDisplayTime = state.hintDisplayTime;
+    m_hintAutoFlipBack = state.hintAutoFlipBack;
+    m_rng = state.rng;
+    m_rngDraws = state.rngDraws;
+    m_isShuffling = state.isShuffling;
+    m_shuffleDuration = state.shuffleDuration;
+    m_shuffleTimer = state.shuffleTimer;
+    m_shuffleOrder.assign(state.shuffleOrder.begin(), state.shuffleOrder.end());
+    m_shuffleTargets.assign(state.shuffleTargets.begin(), state.shuffleTargets.end());
+    m_nextShuffleStartIndex = state.nextShuffleStartIndex;
+}
+
+// === Saved games ===
+
+Vector2 GameBoard::toGrid(Vector2 position) const {
+    return {(position.x - m_screenBounds.x) / (m_cardSize.x + m_padding),
+            (position.y - m_screenBounds.y) / (m_cardSize.y + m_padding)};
+}
+
+Vector2 GameBoard::fromGrid(Vector2 cell) const {
+    // The same expression createCards() places the cards with
+    return {m_screenBounds.x + cell.x * (m_cardSize.x + m_padding),
+            m_screenBounds.y + cell.y * (m_cardSize.y + m_padding)};
+}
+
+void GameBoard::saveGridState(LogicState& state) const {
+    saveState(state);
+    for (Card::LogicState& card : state.cards) {
+        card.position = toGrid(card.position);
+        card.previousPosition = toGrid(card.previousPosition);
+        card.moveStart = toGrid(card.moveStart);
+        card.moveTarget = toGrid(card.moveTarget);
+    }
+    for (Vector2& target : state.shuffleTargets) {
+        target = toGrid(target);
+    }
+}
+
+void GameBoard::restoreGridState(LogicState state) {
+    for (Card::LogicState& card : state.cards) {
+        card.position = fromGrid(card.position);
+        card.previousPosition = fromGrid(card.previousPosition);
+        card.moveStart = fromGrid(card.moveStart);
+        card.moveTarget = fromGrid(card.moveTarget);
+    }
+    for (Vector2& target : state.shuffleTargets) {
+        target = fromGrid(target);
+    }
+    state.rng.seed(m_seed);
+    state.rng.discard(state.rngDraws);
+    restoreState(state);
+}
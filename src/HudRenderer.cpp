@@ -0,0 +1,269 @@
+/**
+ * @file HudRenderer.cpp
+ * @brief Cached HUD layers implementation
+ */
+
+#include "../include/HudRenderer.h"
+#include "../include/TextRenderer.h"
+#include "../include/Utils.h"
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+
+bool HudState::operator==(const HudState& other) const {
+    return moves == other.moves && matches == other.matches && totalPairs == other.totalPairs &&
+           score == other.score && elapsedSeconds == other.elapsedSeconds && hasBoard == other.hasBoard &&
+           hintsRemaining == other.hintsRemaining && canUseHint == other.canUseHint &&
+           hintCooldownSeconds == other.hintCooldownSeconds && canShuffle == other.canShuffle &&
+           shuffleCooldownSeconds == other.shuffleCooldownSeconds && shufflesUsed == other.shufflesUsed;
+}
+
+HudRenderer::~HudRenderer() {
+    unload();
+}
+
+// === Layer management ===
+
+void HudRenderer::ensureTargets(int width, int height) {
+    if (width == m_width && height == m_height) {
+        return;
+    }
+
+    unload();
+    m_width = width;
+    m_height = height;
+    m_chrome = LoadRenderTexture(width, height);
+    m_text = LoadRenderTexture(width, height);
+    m_useTextures = IsRenderTextureReady(m_chrome) && IsRenderTextureReady(m_text);
+    if (!m_useTextures) {
+        Utils::logWarning("HUD render textures unavailable, drawing the HUD directly");
+        if (IsRenderTextureReady(m_chrome)) UnloadRenderTexture(m_chrome);
+        if (IsRenderTextureReady(m_text)) UnloadRenderTexture(m_text);
+        m_chrome = RenderTexture2D{};
+        m_text = RenderTexture2D{};
+    }
+}
+
+void HudRenderer::setScale(float scale) {
+    if (scale > 0.0f && scale != m_scale) {
+        m_scale = scale;
+        invalidate();
+    }
+}
+
+void HudRenderer::invalidate() {
+    m_chromeValid = false;
+    m_textValid = false;
+}
+
+void HudRenderer::unload() {
+    if (m_useTextures) {
+        UnloadRenderTexture(m_chrome);
+        UnloadRenderTexture(m_text);
+    }
+    m_chrome = RenderTexture2D{};
+    m_text = RenderTexture2D{};
+    m_useTextures = false;
+    m_width = 0;
+    m_height = 0;
+    invalidate();
+}
+
+void HudRenderer::beginScaled(int& width, int& height) const {
+    // Design pixels from here on; width and height become the window's size in them
+    rlPushMatrix();
+    rlScalef(m_scale, m_scale, 1.0f);
+    width = static_cast<int>(m_width / m_scale);
+    height = static_cast<int>(m_height / m_scale);
+}
+
+void HudRenderer::endScaled() {
+    rlPopMatrix();
+}
+
+void HudRenderer::beginBake(const RenderTexture2D& target) {
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    // Plain alpha blending would square the alpha of translucent panels in
+    // an empty target; this keeps coverage right and leaves the colour
+    // premultiplied, which drawLayer() composites accordingly
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+void HudRenderer::endBake() {
+    EndBlendMode();
+    EndTextureMode();
+}
+
+void HudRenderer::drawLayer(const RenderTexture2D& layer) {
+    // Render textures are stored bottom-up
+    Rectangle source = {0.0f, 0.0f, static_cast<float>(layer.texture.width), -static_cast<float>(layer.texture.height)};
+    DrawTextureRec(layer.texture, source, {0.0f, 0.0f}, WHITE);
+}
+
+// === Drawing ===
+
+void HudRenderer::draw(const HudState& state, int screenWidth, int screenHeight) {
+    ensureTargets(screenWidth, screenHeight);
+
+    if (!m_useTextures) {
+        drawChrome();
+        if (state != m_lastState || !m_textValid) {
+            ++m_textRebuilds;
+        }
+        m_lastState = state;
+        m_textValid = true;
+        drawText(state);
+        return;
+    }
+
+    if (!m_chromeValid) {
+        beginBake(m_chrome);
+        drawChrome();
+        endBake();
+        m_chromeValid = true;
+    }
+    if (!m_textValid || state != m_lastState) {
+        beginBake(m_text);
+        drawText(state);
+        endBake();
+        m_lastState = state;
+        m_textValid = true;
+        ++m_textRebuilds;
+    }
+
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    drawLayer(m_chrome);
+    drawLayer(m_text);
+    EndBlendMode();
+}
+
+void HudRenderer::drawChrome() const {
+    int w = 0;
+    int h = 0;
+    beginScaled(w, h);
+
+    // Top bar background with transparency
+    DrawRectangle(0, 0, w, 80, ColorAlpha(BLACK, 0.7f));
+    DrawRectangleGradientV(0, 0, w, 80, ColorAlpha(BLACK, 0.5f), ColorAlpha(BLACK, 0.2f));
+
+    // Moves panel
+    Rectangle movesRect = {15, 15, 150, 50};
+    DrawRectangleRounded(movesRect, 0.3f, 8, ColorAlpha(DARKBLUE, 0.8f));
+    Utils::drawRoundedRectangleLines(movesRect, 0.3f, 8, 2, SKYBLUE);
+
+    // Matches panel
+    Rectangle matchesRect = {180, 15, 180, 50};
+    DrawRectangleRounded(matchesRect, 0.3f, 8, ColorAlpha(DARKGREEN, 0.8f));
+    Utils::drawRoundedRectangleLines(matchesRect, 0.3f, 8, 2, LIME);
+
+    // Timer panel
+    Rectangle timerRect = {w - 170.0f, 15, 155, 50};
+    DrawRectangleRounded(timerRect, 0.3f, 8, ColorAlpha(MAROON, 0.8f));
+    Utils::drawRoundedRectangleLines(timerRect, 0.3f, 8, 2, RED);
+    TextRenderer::draw("TIME", w - 155, 22, 16, LIGHTGRAY);
+
+    // Hint panel (bottom-right)
+    Rectangle hintRect = {w - 200.0f, static_cast<float>(h - 100), 180.0f, 80.0f};
+    DrawRectangleRounded(hintRect, 0.3f, 8, ColorAlpha(DARKPURPLE, 0.8f));
+    Utils::drawRoundedRectangleLines(hintRect, 0.3f, 8, 2, VIOLET);
+
+    // Shuffle panel (bottom-left)
+    Rectangle shuffleRect = {15.0f, static_cast<float>(h - 100), 220.0f, 80.0f};
+    DrawRectangleRounded(shuffleRect, 0.3f, 8, ColorAlpha(DARKBROWN, 0.85f));
+    Utils::drawRoundedRectangleLines(shuffleRect, 0.3f, 8, 2, ColorAlpha(BEIGE, 0.9f));
+    TextRenderer::draw("RESHUFFLE", 30, h - 90, 20, BEIGE);
+
+    // Bottom hint
+    TextRenderer::draw("P-Pause | H-Hint (-points, cooldown) | R-Reshuffle (-points, cooldown)",
+                       40, h - 20, 16, ColorAlpha(WHITE, 0.6f));
+    endScaled();
+}
+
+void HudRenderer::drawText(const HudState& state) {
+    int w = 0;
+    int h = 0;
+    beginScaled(w, h);
+
+    // Every string is built on the stack: this runs whenever a number changes
+    FormatBuffer<64> text;
+    TextRenderer::draw(text.append("MOVES: ").append(state.moves), 30, 30, 24, WHITE);
+    TextRenderer::draw(text.clear().append("PAIRS: ").append(state.matches).append('/').append(state.totalPairs),
+                       195, 30, 24, WHITE);
+    TextRenderer::draw(text.clear().append("SCORE: ").append(state.score), 380, 30, 24, GOLD);
+
+    // Progress bar
+    float progress = state.totalPairs > 0 ? static_cast<float>(state.matches) / state.totalPairs : 0.0f;
+    DrawRectangleRounded({195, 53, 150 * progress, 8}, 0.5f, 8, LIME);
+
+    TextRenderer::draw(m_clock.update(static_cast<float>(state.elapsedSeconds)), w - 155, 38, 28, GOLD);
+
+    if (state.hasBoard) {
+        TextRenderer::draw(text.clear().append("HINTS: ").append(state.hintsRemaining), w - 190, h - 90, 20, WHITE);
+
+        if (state.canUseHint) {
+            TextRenderer::draw("Press H to use", w - 190, h - 65, 16, LIME);
+            TextRenderer::draw("Hint reveals a", w - 190, h - 50, 14, LIGHTGRAY);
+            TextRenderer::draw("matching pair", w - 190, h - 35, 14, LIGHTGRAY);
+        } else if (state.hintCooldownSeconds > 0) {
+            text.clear().append("Cooldown: ").append(state.hintCooldownSeconds).append('s');
+            TextRenderer::draw(text, w - 190, h - 65, 16, ColorAlpha(YELLOW, 0.7f));
+        } else {
+            TextRenderer::draw("No hints left", w - 190, h - 65, 16, ColorAlpha(RED, 0.7f));
+        }
+    }
+
+    if (state.canShuffle) {
+        TextRenderer::draw("Press R to mix cards", 30, h - 65, 16, LIME);
+    } else {
+        text.clear().append("Cooldown: ").append(state.shuffleCooldownSeconds).append('s');
+        TextRenderer::draw(text, 30, h - 65, 16, ColorAlpha(WHITE, 0.7f));
+    }
+    TextRenderer::draw(text.clear().append("Used: ").append(state.shufflesUsed), 30, h - 40, 14, ColorAlpha(WHITE, 0.6f));
+    endScaled();
+}
+
+void HudRenderer::drawCombo(int comboCount, float comboTimer, int screenWidth) {
+    if (comboCount <= 1 || comboTimer <= 0.0f) {
+        return;
+    }
+
+    int comboMultiplier = std::min(comboCount, 5);
+    if (comboMultiplier != m_comboMultiplier) {
+        m_comboMultiplier = comboMultiplier;
+        m_comboText.clear().append(comboMultiplier).append("x COMBO");
+        m_comboHint.clear().append("Score multiplier ").append(comboMultiplier).append('x');
+    }
+
+    // The banner pulses by scaling one layout about its centre: a font size
+    // per frame would lay the text out again at every size it passes through
+    float comboScale = 1.0f + 0.2f * sin(GetTime() * 8.0f);
+    int textWidth = TextRenderer::measure(m_comboText, COMBO_FONT_SIZE);
+    float centerX = (screenWidth / m_scale) / 2.0f;
+    int comboY = 100;
+    int hintX = static_cast<int>(centerX - textWidth * comboScale / 2.0f);
+    int hintY = comboY + static_cast<int>(COMBO_FONT_SIZE * comboScale) + 6;
+
+    float fade = std::min(1.0f, comboTimer / 2.0f);
+
+    // Laid out in design pixels like the layers
+    rlPushMatrix();
+    rlScalef(m_scale, m_scale, 1.0f);
+
+    rlPushMatrix();
+    rlTranslatef(centerX, static_cast<float>(comboY), 0.0f);
+    rlScalef(comboScale, comboScale, 1.0f);
+    int comboX = -textWidth / 2;
+    // Shadow
+    TextRenderer::draw(m_comboText, comboX + 2, 2, COMBO_FONT_SIZE, ColorAlpha(BLACK, 0.5f * fade));
+    // Glow effect
+    TextRenderer::draw(m_comboText, comboX, 0, COMBO_FONT_SIZE, ColorAlpha(ORANGE, 0.8f * fade));
+    // Main text
+    TextRenderer::draw(m_comboText, comboX, 0, COMBO_FONT_SIZE, ColorAlpha(GOLD, fade));
+    rlPopMatrix();
+
+    TextRenderer::draw(m_comboHint, hintX, hintY, 18, ColorAlpha(WHITE, 0.7f * fade));
+    rlPopMatrix();
+}
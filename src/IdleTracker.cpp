@@ -0,0 +1,24 @@
+/**
+ * @file IdleTracker.cpp
+ * @brief Idle detection implementation
+ */
+
+#include "../include/IdleTracker.h"
+
+IdleTracker::IdleTracker(float idleDelay)
+    : m_idleDelay(idleDelay), m_quietTime(0.0f), m_idleFrames(0) {
+}
+
+void IdleTracker::update(float deltaTime, bool active) {
+    if (active) {
+        m_quietTime = 0.0f;
+        return;
+    }
+    // Saturate so a long idle stretch cannot lose float precision
+    if (m_quietTime < m_idleDelay) {
+        m_quietTime += deltaTime;
+    }
+    if (isIdle()) {
+        ++m_idleFrames;
+    }
+}
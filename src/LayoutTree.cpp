@@ -0,0 +1,90 @@
+/**
+ * @file LayoutTree.cpp
+ * @brief Layout node placement
+ */
+
+#include "../include/LayoutTree.h"
+#include <algorithm>
+#include <cmath>
+
+LayoutTree::LayoutTree(float designWidth, float designHeight)
+    : m_designWidth(std::max(1.0f, designWidth)),
+      m_designHeight(std::max(1.0f, designHeight)) {
+}
+
+int LayoutTree::add(const LayoutNode& node) {
+    LayoutNode checked = node;
+    if (checked.parent < 0 || checked.parent >= getNodeCount()) {
+        checked.parent = LayoutNode::WINDOW;
+    }
+    m_nodes.push_back(checked);
+    // Parents come first, so a node added after resize() can be placed right away
+    m_rects.push_back(m_width > 0 ? computeNode(checked) : Rectangle{});
+    return getNodeCount() - 1;
+}
+
+int LayoutTree::addStack(const LayoutNode& node, int count, Vector2 step) {
+    const int first = getNodeCount();
+    LayoutNode item = node;
+    for (int i = 0; i < count; ++i) {
+        add(item);
+        item.offset.x += step.x;
+        item.offset.y += step.y;
+    }
+    return first;
+}
+
+bool LayoutTree::resize(int width, int height) {
+    if (width == m_width && height == m_height) {
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+    m_scale = std::min(width / m_designWidth, height / m_designHeight);
+    for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+        m_rects[i] = computeNode(m_nodes[i]);
+    }
+    ++m_layoutPasses;
+    return true;
+}
+
+Rectangle LayoutTree::computeNode(const LayoutNode& node) const {
+    const Rectangle parent = node.parent == LayoutNode::WINDOW
+        ? Rectangle{0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height)}
+        : m_rects[node.parent];
+
+    Rectangle rect;
+    rect.width = std::max(0.0f, node.size.x * m_scale + node.stretch.x * parent.width);
+    rect.height = std::max(0.0f, node.size.y * m_scale + node.stretch.y * parent.height);
+    rect.x = parent.x + node.anchor.x * parent.width - node.pivot.x * rect.width + node.offset.x * m_scale;
+    rect.y = parent.y + node.anchor.y * parent.height - node.pivot.y * rect.height + node.offset.y * m_scale;
+    return rect;
+}
+
+Rectangle LayoutTree::get(int id) const {
+    if (id < 0 || id >= getNodeCount()) {
+        return Rectangle{};
+    }
+    return m_rects[id];
+}
+
+Vector2 LayoutTree::getCenter(int id) const {
+    Rectangle rect = get(id);
+    return {rect.x + rect.width / 2.0f, rect.y + rect.height / 2.0f};
+}
+
+int LayoutTree::hitTest(Vector2 point, int first, int count) const {
+    for (int i = 0; i < count; ++i) {
+        Rectangle rect = get(first + i);
+        if (point.x >= rect.x && point.x <= rect.x + rect.width &&
+            point.y >= rect.y && point.y <= rect.y + rect.height) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int LayoutTree::pixels(float designPixels) const {
+    const int value = static_cast<int>(std::lround(designPixels * m_scale));
+    return (designPixels > 0.0f) ? std::max(1, value) : value;
+}
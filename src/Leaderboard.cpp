@@ -0,0 +1,357 @@
+/**
+ * @file Leaderboard.cpp
+ * @brief Leaderboard log format, loading and the per-difficulty treaps
+ */
+
+#include "../include/Leaderboard.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+namespace {
+
+constexpr unsigned char MAGIC[4] = {'M', 'C', 'L', 'B'};
+constexpr std::size_t LOAD_CHUNK_RECORDS = 4096;
+
+void putU32(unsigned char* bytes, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+void putU64(unsigned char* bytes, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+std::uint32_t getU32(const unsigned char* bytes) {
+    std::uint32_t value = 0;
+    for (int i = 3; i >= 0; --i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+std::uint64_t getU64(const unsigned char* bytes) {
+    std::uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+// FNV-1a; enough to tell a torn or scribbled record from a written one
+std::uint32_t checksum(const unsigned char* bytes, std::size_t length) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// What reading a log file found
+struct LogScan {
+    enum State { MISSING, FOREIGN, READ } state = MISSING;
+    std::uint64_t fileSize = 0;
+    std::uint64_t validBytes = 0;   ///< Header and every record up to the first bad one
+};
+
+// Appends a log's intact records to records
+LogScan scanLog(const std::string& path, std::vector<LeaderboardEntry>& records) {
+    LogScan scan;
+    std::error_code error;
+    scan.fileSize = std::filesystem::file_size(path, error);
+    if (error) {
+        scan.fileSize = 0;
+        return scan;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        scan.state = LogScan::FOREIGN;
+        return scan;
+    }
+    scan.state = LogScan::READ;
+
+    // Shorter than a header: a log whose first write was torn
+    unsigned char header[Leaderboard::HEADER_SIZE];
+    if (scan.fileSize < Leaderboard::HEADER_SIZE || !in.read(reinterpret_cast<char*>(header), Leaderboard::HEADER_SIZE)) {
+        return scan;
+    }
+    if (!std::equal(MAGIC, MAGIC + 4, header) || getU32(header + 4) != Leaderboard::FORMAT_VERSION) {
+        scan.state = LogScan::FOREIGN;
+        return scan;
+    }
+    scan.validBytes = Leaderboard::HEADER_SIZE;
+
+    std::vector<unsigned char> chunk(LOAD_CHUNK_RECORDS * Leaderboard::RECORD_SIZE);
+    records.reserve(records.size() + static_cast<std::size_t>((scan.fileSize - Leaderboard::HEADER_SIZE) / Leaderboard::RECORD_SIZE));
+    while (in) {
+        in.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+        const std::size_t whole = static_cast<std::size_t>(in.gcount()) / Leaderboard::RECORD_SIZE;
+        for (std::size_t i = 0; i < whole; ++i) {
+            LeaderboardEntry entry;
+            if (!Leaderboard::decode(chunk.data() + i * Leaderboard::RECORD_SIZE, entry)) {
+                return scan;
+            }
+            records.push_back(entry);
+            scan.validBytes += Leaderboard::RECORD_SIZE;
+        }
+    }
+    return scan;
+}
+
+} // namespace
+
+// === LeaderboardIndex ===
+
+bool LeaderboardIndex::ahead(const LeaderboardEntry& a, const LeaderboardEntry& b) {
+    if (a.score != b.score) return a.score > b.score;
+    if (a.milliseconds != b.milliseconds) return a.milliseconds < b.milliseconds;
+    if (a.moves != b.moves) return a.moves < b.moves;
+    return a.sequence < b.sequence;
+}
+
+void LeaderboardIndex::refresh(std::uint32_t node) {
+    Node& n = m_nodes[node];
+    n.size = 1 + sizeOf(n.left) + sizeOf(n.right);
+}
+
+void LeaderboardIndex::insert(std::uint32_t entry, const std::vector<LeaderboardEntry>& records) {
+    // xorshift32 priorities keep the treap balanced in expectation
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    Node node;
+    node.entry = entry;
+    node.priority = m_seed;
+    node.size = 1;
+    m_nodes.push_back(node);
+    m_root = insertAt(m_root, static_cast<std::uint32_t>(m_nodes.size() - 1), records);
+}
+
+std::uint32_t LeaderboardIndex::insertAt(std::uint32_t node, std::uint32_t fresh,
+                                         const std::vector<LeaderboardEntry>& records) {
+    if (node == NIL) {
+        return fresh;
+    }
+    if (m_nodes[fresh].priority > m_nodes[node].priority) {
+        // The new node takes this subtree's place and the subtree splits around it
+        split(node, records[m_nodes[fresh].entry], records, m_nodes[fresh].left, m_nodes[fresh].right);
+        refresh(fresh);
+        return fresh;
+    }
+    if (ahead(records[m_nodes[fresh].entry], records[m_nodes[node].entry])) {
+        m_nodes[node].left = insertAt(m_nodes[node].left, fresh, records);
+    } else {
+        m_nodes[node].right = insertAt(m_nodes[node].right, fresh, records);
+    }
+    refresh(node);
+    return node;
+}
+
+void LeaderboardIndex::split(std::uint32_t node, const LeaderboardEntry& key,
+                             const std::vector<LeaderboardEntry>& records,
+                             std::uint32_t& better, std::uint32_t& rest) {
+    if (node == NIL) {
+        better = rest = NIL;
+        return;
+    }
+    if (ahead(records[m_nodes[node].entry], key)) {
+        split(m_nodes[node].right, key, records, m_nodes[node].right, rest);
+        better = node;
+    } else {
+        split(m_nodes[node].left, key, records, better, m_nodes[node].left);
+        rest = node;
+    }
+    refresh(node);
+}
+
+std::size_t LeaderboardIndex::countAhead(const LeaderboardEntry& probe,
+                                         const std::vector<LeaderboardEntry>& records) const {
+    std::size_t count = 0;
+    std::uint32_t node = m_root;
+    while (node != NIL) {
+        const Node& n = m_nodes[node];
+        if (ahead(records[n.entry], probe)) {
+            count += sizeOf(n.left) + 1;
+            node = n.right;
+        } else {
+            node = n.left;
+        }
+    }
+    return count;
+}
+
+void LeaderboardIndex::top(std::size_t k, const std::vector<LeaderboardEntry>& records,
+                           std::vector<LeaderboardEntry>& out) const {
+    // In-order walk with an explicit stack; stops after k nodes
+    m_walk.clear();
+    std::uint32_t node = m_root;
+    std::size_t taken = 0;
+    while (taken < k && (node != NIL || !m_walk.empty())) {
+        while (node != NIL) {
+            m_walk.push_back(node);
+            node = m_nodes[node].left;
+        }
+        node = m_walk.back();
+        m_walk.pop_back();
+        out.push_back(records[m_nodes[node].entry]);
+        ++taken;
+        node = m_nodes[node].right;
+    }
+}
+
+// === Leaderboard ===
+
+Leaderboard::Leaderboard(std::string path)
+    : m_path(std::move(path)),
+      m_writable(!m_path.empty()) {
+}
+
+void Leaderboard::encode(const LeaderboardEntry& entry, unsigned char* bytes) {
+    putU64(bytes + 0, entry.sequence);
+    putU64(bytes + 8, static_cast<std::uint64_t>(entry.timestamp));
+    putU32(bytes + 16, static_cast<std::uint32_t>(entry.difficulty));
+    putU32(bytes + 20, static_cast<std::uint32_t>(entry.score));
+    putU32(bytes + 24, entry.milliseconds);
+    putU32(bytes + 28, static_cast<std::uint32_t>(entry.moves));
+    putU32(bytes + 32, static_cast<std::uint32_t>(entry.hintsUsed));
+    putU32(bytes + 36, static_cast<std::uint32_t>(entry.shufflesUsed));
+    putU32(bytes + 40, checksum(bytes, RECORD_SIZE - 4));
+}
+
+bool Leaderboard::decode(const unsigned char* bytes, LeaderboardEntry& entry) {
+    if (getU32(bytes + 40) != checksum(bytes, RECORD_SIZE - 4)) {
+        return false;
+    }
+    entry.sequence = getU64(bytes + 0);
+    entry.timestamp = static_cast<std::int64_t>(getU64(bytes + 8));
+    entry.difficulty = static_cast<std::int32_t>(getU32(bytes + 16));
+    entry.score = static_cast<std::int32_t>(getU32(bytes + 20));
+    entry.milliseconds = getU32(bytes + 24);
+    entry.moves = static_cast<std::int32_t>(getU32(bytes + 28));
+    entry.hintsUsed = static_cast<std::int32_t>(getU32(bytes + 32));
+    entry.shufflesUsed = static_cast<std::int32_t>(getU32(bytes + 36));
+    return true;
+}
+
+bool Leaderboard::load() {
+    m_writer.flush();
+    m_records.clear();
+    m_indexes.clear();
+    m_durableBytes = 0;
+    m_writable = !m_path.empty();
+    if (!m_writable) {
+        return true;
+    }
+
+    const LogScan log = scanLog(m_path, m_records);
+    const std::string backupPath = getBackupPath();
+    bool usable = log.state != LogScan::FOREIGN;
+    bool restored = false;
+    std::uint64_t validBytes = log.validBytes;
+
+    // A damaged or missing log falls back to the last good copy when that holds more games
+    if (log.state != LogScan::READ || log.validBytes < log.fileSize) {
+        std::vector<LeaderboardEntry> saved;
+        const LogScan backup = scanLog(backupPath, saved);
+        if (backup.state == LogScan::READ && saved.size() > m_records.size()) {
+            Utils::logWarning("Leaderboard damaged or missing, restoring the last good copy (" +
+                              Utils::toString(static_cast<int>(saved.size())) + " games)");
+            m_records.swap(saved);
+            validBytes = backup.validBytes;
+            usable = true;
+            restored = true;
+            m_writer.post([backupPath, path = m_path, validBytes] {
+                return PersistenceWorker::copyAtomically(backupPath, path, validBytes);
+            });
+        } else if (log.state == LogScan::FOREIGN) {
+            Utils::logError("Not a leaderboard log (or an unknown version), leaving it alone: " + m_path);
+        } else if (log.state == LogScan::READ) {
+            // Whatever follows the last good record was never completely written
+            std::error_code error;
+            std::filesystem::resize_file(m_path, log.validBytes, error);
+            if (error) {
+                Utils::logError("Failed to cut the damaged end off the leaderboard: " + m_path);
+                usable = false;
+            } else {
+                Utils::logWarning("Leaderboard had a damaged end, dropped " +
+                                  Utils::toString(static_cast<int>(log.fileSize - log.validBytes)) + " bytes");
+            }
+        }
+    }
+    if (usable && !restored && validBytes > HEADER_SIZE) {
+        // The verified log becomes the new last good copy, unless that already matches it
+        std::error_code error;
+        if (std::filesystem::file_size(backupPath, error) != validBytes || error) {
+            m_writer.post([path = m_path, backupPath, validBytes] {
+                return PersistenceWorker::copyAtomically(path, backupPath, validBytes);
+            });
+        }
+    }
+
+    if (!usable) {
+        m_records.clear();
+        m_writable = false;
+        return false;
+    }
+    for (std::size_t i = 0; i < m_records.size(); ++i) {
+        m_records[i].sequence = i;
+        index(static_cast<std::uint32_t>(i));
+    }
+    m_durableBytes = validBytes;
+    Utils::logInfo("Leaderboard loaded: " + Utils::toString(static_cast<int>(m_records.size())) + " games");
+    return true;
+}
+
+const LeaderboardEntry& Leaderboard::record(LeaderboardEntry entry) {
+    entry.sequence = m_records.size();
+    m_records.push_back(entry);
+    index(static_cast<std::uint32_t>(m_records.size() - 1));
+
+    if (m_writable) {
+        std::array<unsigned char, HEADER_SIZE + RECORD_SIZE> bytes;
+        std::copy(MAGIC, MAGIC + 4, bytes.begin());
+        putU32(bytes.data() + 4, FORMAT_VERSION);
+        encode(entry, bytes.data() + HEADER_SIZE);
+        m_writer.post([this, bytes] {
+            // The header goes in front of a new log's first record
+            const std::size_t skip = m_durableBytes == 0 ? 0 : HEADER_SIZE;
+            if (!PersistenceWorker::appendDurably(m_path, bytes.data() + skip, bytes.size() - skip, m_durableBytes)) {
+                return false;
+            }
+            m_durableBytes += bytes.size() - skip;
+            return true;
+        });
+    }
+    return m_records.back();
+}
+
+void Leaderboard::index(std::uint32_t entry) {
+    m_indexes[m_records[entry].difficulty].insert(entry, m_records);
+}
+
+void Leaderboard::top(std::int32_t difficulty, std::size_t k, std::vector<LeaderboardEntry>& out) const {
+    out.clear();
+    auto it = m_indexes.find(difficulty);
+    if (it != m_indexes.end()) {
+        it->second.top(k, m_records, out);
+    }
+}
+
+std::size_t Leaderboard::rankOf(const LeaderboardEntry& entry) const {
+    auto it = m_indexes.find(entry.difficulty);
+    return it == m_indexes.end() ? 0 : it->second.countAhead(entry, m_records);
+}
+
+std::size_t Leaderboard::count(std::int32_t difficulty) const {
+    auto it = m_indexes.find(difficulty);
+    return it == m_indexes.end() ? 0 : it->second.size();
+}
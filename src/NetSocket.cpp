@@ -0,0 +1,64 @@
+/**
+ * @file NetSocket.cpp
+ * @brief Portable socket helpers
+ */
+
+#include "../include/NetSocket.h"
+
+void setSocketNonBlocking(SOCKET sock) {
+#ifdef _WIN32
+    u_long mode = 1;
+    ioctlsocket(sock, FIONBIO, &mode);
+#else
+    int flags = fcntl(sock, F_GETFL, 0);
+    fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+#endif
+}
+
+bool socketWouldBlock() {
+    int error = SOCKET_ERROR_CODE;
+#ifdef _WIN32
+    return error == WSAEWOULDBLOCK || error == WSAEINPROGRESS;
+#else
+    return error == EAGAIN || error == EWOULDBLOCK;
+#endif
+}
+
+long sendBuffers(SOCKET sock, const ConstBuffer* buffers, int count) {
+    static constexpr int MAX_BUFFERS = 64;
+    if (count > MAX_BUFFERS) {
+        count = MAX_BUFFERS; // the rest goes out on the next call
+    }
+
+#ifdef _WIN32
+    WSABUF vec[MAX_BUFFERS];
+    for (int i = 0; i < count; ++i) {
+        vec[i].buf = const_cast<char*>(buffers[i].data);
+        vec[i].len = static_cast<ULONG>(buffers[i].size);
+    }
+    DWORD sent = 0;
+    if (WSASend(sock, vec, static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) == SOCKET_ERROR) {
+        return socketWouldBlock() ? 0 : -1;
+    }
+    return static_cast<long>(sent);
+#else
+    iovec vec[MAX_BUFFERS];
+    for (int i = 0; i < count; ++i) {
+        vec[i].iov_base = const_cast<char*>(buffers[i].data);
+        vec[i].iov_len = buffers[i].size;
+    }
+    // sendmsg rather than writev so a closed peer cannot raise SIGPIPE
+    msghdr msg{};
+    msg.msg_iov = vec;
+    msg.msg_iovlen = static_cast<size_t>(count);
+#ifdef MSG_NOSIGNAL
+    ssize_t sent = sendmsg(sock, &msg, MSG_NOSIGNAL);
+#else
+    ssize_t sent = sendmsg(sock, &msg, 0);
+#endif
+    if (sent < 0) {
+        return socketWouldBlock() ? 0 : -1;
+    }
+    return static_cast<long>(sent);
+#endif
+}
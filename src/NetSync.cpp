@@ -0,0 +1,234 @@
+/**
+ * @file NetSync.cpp
+ * @brief Change-driven network state synchronisation implementation
+ */
+
+#include "../include/NetSync.h"
+#include <algorithm>
+#include <charconv>
+
+NetSync::NetSync() {
+    reset();
+}
+
+void NetSync::reset() {
+    m_turn = 0;
+    m_scores[0] = m_scores[1] = 0;
+    m_sentTurn = 0;
+    m_sentScores[0] = m_sentScores[1] = 0;
+    m_events.clear();
+    m_snapshotRequested = false;
+    m_heartbeatEnabled = true;
+    m_idleTimer = 0.0f;
+    m_recvBuffer.clear();
+    resetSequence();
+    m_stats = NetStats{};
+    m_statsTimer = 0.0f;
+    m_windowBytesSent = 0;
+    m_windowBytesReceived = 0;
+    m_windowMessagesSent = 0;
+    m_windowMessagesReceived = 0;
+}
+
+// === Outgoing state ===
+
+void NetSync::setTurn(int turn) {
+    m_turn = turn;
+}
+
+void NetSync::setScore(int player, int score) {
+    if (player >= 0 && player < 2) {
+        m_scores[player] = score;
+    }
+}
+
+void NetSync::noteRemoteTurn(int turn) {
+    m_turn = turn;
+    m_sentTurn = turn;
+}
+
+void NetSync::noteRemoteScore(int player, int score) {
+    if (player >= 0 && player < 2) {
+        m_scores[player] = score;
+        m_sentScores[player] = score;
+    }
+}
+
+// === Outgoing events ===
+
+void NetSync::queueFlip(int slot) {
+    m_events += "FLIP ";
+    appendInt(m_events, slot);
+    m_events += '\n';
+}
+
+void NetSync::queueMatch(int slot1, int slot2) {
+    m_events += "MATCH ";
+    appendInt(m_events, slot1);
+    m_events += ' ';
+    appendInt(m_events, slot2);
+    m_events += '\n';
+}
+
+void NetSync::queueMessage(const std::string& message) {
+    m_events += message;
+    m_events += '\n';
+}
+
+void NetSync::requestSnapshot() {
+    m_snapshotRequested = true;
+}
+
+bool NetSync::flush(float deltaTime, std::string& out) {
+    out.clear();
+    m_idleTimer += deltaTime;
+
+    // Events first so the peer sees flips/matches before the score they caused
+    out += m_events;
+    m_events.clear();
+
+    if (m_snapshotRequested || (out.empty() && m_heartbeatEnabled && m_idleTimer >= HEARTBEAT_INTERVAL &&
+                                m_turn == m_sentTurn &&
+                                m_scores[0] == m_sentScores[0] &&
+                                m_scores[1] == m_sentScores[1])) {
+        // A snapshot carries every value, so it replaces individual deltas
+        appendSnapshot(out);
+        m_snapshotRequested = false;
+    } else {
+        for (int player = 0; player < 2; ++player) {
+            if (m_scores[player] != m_sentScores[player]) {
+                out += "SCORE ";
+                appendInt(out, player);
+                out += ' ';
+                appendInt(out, m_scores[player]);
+                out += '\n';
+            }
+        }
+        if (m_turn != m_sentTurn) {
+            out += "TURN ";
+            appendInt(out, m_turn);
+            out += '\n';
+        }
+    }
+
+    if (out.empty()) {
+        return false;
+    }
+
+    // Keep the lines numbered so they can be replayed to a peer that reconnects
+    size_t start = 0;
+    size_t newline;
+    while ((newline = out.find('\n', start)) != std::string::npos) {
+        m_history.emplace_back(out, start, newline - start + 1);
+        ++m_sentSeq;
+        start = newline + 1;
+    }
+    while (m_history.size() > RESUME_HISTORY) {
+        m_history.pop_front();
+    }
+
+    m_sentTurn = m_turn;
+    m_sentScores[0] = m_scores[0];
+    m_sentScores[1] = m_scores[1];
+    m_idleTimer = 0.0f;
+    return true;
+}
+
+void NetSync::appendSnapshot(std::string& out) const {
+    // Format: "STATE turn:0 score0:10 score1:5"
+    out += "STATE turn:";
+    appendInt(out, m_turn);
+    out += " score0:";
+    appendInt(out, m_scores[0]);
+    out += " score1:";
+    appendInt(out, m_scores[1]);
+    out += '\n';
+}
+
+// === Incoming ===
+
+void NetSync::feed(const char* data, size_t size, std::vector<std::string>& lines) {
+    m_recvBuffer.append(data, size);
+
+    size_t start = 0;
+    size_t newline;
+    while ((newline = m_recvBuffer.find('\n', start)) != std::string::npos) {
+        if (newline > start) {
+            lines.emplace_back(m_recvBuffer, start, newline - start);
+        }
+        start = newline + 1;
+    }
+    m_recvBuffer.erase(0, start);
+}
+
+// === Session resume ===
+
+bool NetSync::appendReplay(unsigned int afterSeq, std::string& out) const {
+    if (afterSeq >= m_sentSeq) {
+        return true;
+    }
+    unsigned int missing = m_sentSeq - afterSeq;
+    if (missing > m_history.size()) {
+        return false;
+    }
+    for (size_t i = m_history.size() - missing; i < m_history.size(); ++i) {
+        out += m_history[i];
+    }
+    return true;
+}
+
+void NetSync::resetSequence() {
+    m_sentSeq = 0;
+    m_receivedSeq = 0;
+    m_history.clear();
+}
+
+void NetSync::restartSequenceAfter(unsigned int afterSeq) {
+    size_t keep = (afterSeq >= m_sentSeq) ? 0 : m_sentSeq - afterSeq;
+    keep = std::min(keep, m_history.size());
+    while (m_history.size() > keep) {
+        m_history.pop_front();
+    }
+    m_sentSeq = static_cast<unsigned int>(keep);
+    m_receivedSeq = 0;
+}
+
+// === Statistics ===
+
+void NetSync::recordSent(size_t bytes, int messages) {
+    m_stats.bytesSent += bytes;
+    m_stats.messagesSent += messages;
+    m_windowBytesSent += bytes;
+    m_windowMessagesSent += messages;
+}
+
+void NetSync::recordReceived(size_t bytes, int messages) {
+    m_stats.bytesReceived += bytes;
+    m_stats.messagesReceived += messages;
+    m_windowBytesReceived += bytes;
+    m_windowMessagesReceived += messages;
+}
+
+void NetSync::updateStats(float deltaTime) {
+    m_statsTimer += deltaTime;
+    if (m_statsTimer < STATS_WINDOW) {
+        return;
+    }
+
+    m_stats.bytesSentPerSecond = m_windowBytesSent / m_statsTimer;
+    m_stats.bytesReceivedPerSecond = m_windowBytesReceived / m_statsTimer;
+    m_stats.messagesSentPerSecond = m_windowMessagesSent / m_statsTimer;
+    m_stats.messagesReceivedPerSecond = m_windowMessagesReceived / m_statsTimer;
+
+    m_statsTimer = 0.0f;
+    m_windowBytesSent = 0;
+    m_windowBytesReceived = 0;
+    m_windowMessagesSent = 0;
+    m_windowMessagesReceived = 0;
+}
+
+void NetSync::appendInt(std::string& out, int value) {
+    char buffer[16];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
@@ -0,0 +1,763 @@
+/**
+ * @file NetworkSession.cpp
+ * @brief Multiplayer session implementation
+ */
+
+#include "../include/NetworkSession.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+namespace {
+
+// Handshake and presence lines are not part of the numbered game stream
+bool isControlMessage(const std::string& msg) {
+    return msg.compare(0, 5, "HELLO") == 0 || msg.compare(0, 7, "WELCOME") == 0 ||
+           msg.compare(0, 8, "PRESENCE") == 0;
+}
+
+// Opaque resume token; only has to be hard to guess for other clients
+std::string makeSessionToken() {
+    static const char* HEX = "0123456789abcdef";
+    std::random_device device;
+    std::mt19937_64 rng((static_cast<unsigned long long>(device()) << 32) ^ device());
+    unsigned long long value = rng();
+    std::string token(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        token[i] = HEX[value & 0xF];
+        value >>= 4;
+    }
+    return token;
+}
+
+} // namespace
+
+NetworkSession::~NetworkSession() {
+    if (m_mode != NetworkMode::NONE) {
+        stop();
+    }
+}
+
+// === Session control ===
+
+void NetworkSession::initSockets() {
+#ifdef _WIN32
+    if (!m_socketsInitialized) {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            Utils::logError("WSAStartup failed");
+            return;
+        }
+    }
+#endif
+    m_socketsInitialized = true;
+}
+
+void NetworkSession::cleanupSockets() {
+#ifdef _WIN32
+    if (m_socketsInitialized) {
+        WSACleanup();
+    }
+#endif
+    m_socketsInitialized = false;
+}
+
+void NetworkSession::enterMode(NetworkMode mode) {
+    m_mode = mode;
+    m_myPlayerID = (mode == NetworkMode::SERVER) ? 0 : (mode == NetworkMode::CLIENT ? 1 : -1);
+    m_currentTurn = 0;
+    m_isMyTurn = (mode == NetworkMode::SERVER);
+    m_connectionState = ConnectionState::OFFLINE;
+    m_connectAttempts = 0;
+    m_resumeCount = 0;
+    m_sessionToken.clear();
+    m_presenceDirty = false;
+    m_presenceTimer = 0.0f;
+    m_hasRemotePresence = false;
+}
+
+bool NetworkSession::startServer(unsigned short port) {
+    if (m_mode != NetworkMode::NONE) {
+        Utils::logError("Already in network mode!");
+        return false;
+    }
+
+    initSockets();
+
+    m_serverSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_serverSocket == INVALID_SOCKET) {
+        Utils::logError("Failed to create server socket");
+        return false;
+    }
+
+    // Set socket options
+    int opt = 1;
+#ifdef _WIN32
+    setsockopt(m_serverSocket, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
+#else
+    setsockopt(m_serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+#endif
+
+    sockaddr_in serverAddr{};
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_addr.s_addr = INADDR_ANY;
+    serverAddr.sin_port = htons(port);
+
+    if (bind(m_serverSocket, (sockaddr*)&serverAddr, sizeof(serverAddr)) == SOCKET_ERROR) {
+        Utils::logError("Failed to bind server socket on port " + std::to_string(port));
+        CLOSE_SOCKET(m_serverSocket);
+        m_serverSocket = INVALID_SOCKET;
+        return false;
+    }
+
+    // Backlog covers the opponent plus a few spectators joining at once
+    if (listen(m_serverSocket, 8) == SOCKET_ERROR) {
+        Utils::logError("Failed to listen on server socket");
+        CLOSE_SOCKET(m_serverSocket);
+        m_serverSocket = INVALID_SOCKET;
+        return false;
+    }
+
+    setSocketNonBlocking(m_serverSocket);
+
+    // UDP is optional: clients that get no answer fall back to TCP
+    if (!m_udpListener.open(port)) {
+        Utils::logWarning("UDP unavailable, players will connect over TCP");
+    }
+
+    enterMode(NetworkMode::SERVER);
+    m_port = port;
+
+    Utils::logInfo("Server started on port " + std::to_string(port) + ". Waiting for client...");
+    return true;
+}
+
+bool NetworkSession::startClient(const std::string& ip, unsigned short port, bool spectate, bool preferUdp) {
+    if (m_mode != NetworkMode::NONE) {
+        Utils::logError("Already in network mode!");
+        return false;
+    }
+
+    initSockets();
+
+    m_remoteIP = ip;
+    m_port = port;
+    Utils::logInfo("Connecting to server at " + ip + ":" + std::to_string(port) + "...");
+
+    // Spectators need a TCP socket for the server's broadcast path
+    const bool tryUdp = preferUdp && !spectate;
+    auto udpUnanswered = std::make_shared<bool>(false);
+    return startClient(spectate ? NetworkMode::SPECTATOR : NetworkMode::CLIENT,
+                       [ip, port, tryUdp, udpUnanswered]() -> std::unique_ptr<Transport> {
+                           if (tryUdp && !*udpUnanswered) {
+                               if (auto transport = UdpTransport::connectTo(ip, port, udpUnanswered)) {
+                                   return transport;
+                               }
+                           }
+                           return TcpTransport::connectTo(ip, port);
+                       });
+}
+
+bool NetworkSession::startClient(NetworkMode mode, TransportFactory factory) {
+    if (m_mode != NetworkMode::NONE) {
+        Utils::logError("Already in network mode!");
+        return false;
+    }
+    if ((mode != NetworkMode::CLIENT && mode != NetworkMode::SPECTATOR) || !factory) {
+        return false;
+    }
+
+    enterMode(mode);
+    m_factory = std::move(factory);
+    beginConnect();
+    return true;
+}
+
+void NetworkSession::attach(NetworkMode mode, std::unique_ptr<Transport> transport) {
+    if (m_mode != NetworkMode::NONE) {
+        Utils::logError("Already in network mode!");
+        return;
+    }
+    if (mode == NetworkMode::NONE || (!transport && mode != NetworkMode::SERVER)) {
+        return;
+    }
+
+    enterMode(mode);
+    if (mode == NetworkMode::SERVER) {
+        if (transport) {
+            joinPlayer(std::move(transport), false, 0, std::string());
+        }
+    } else {
+        m_transport = std::move(transport);
+        m_connectionState = ConnectionState::CONNECTING;
+        m_stateTimer = 0.0f;
+    }
+}
+
+void NetworkSession::acceptTransport(std::unique_ptr<Transport> transport) {
+    if (m_mode != NetworkMode::SERVER || !transport) {
+        return;
+    }
+    PendingConnection connection;
+    connection.transport = std::move(transport);
+    m_pending.push_back(std::move(connection));
+}
+
+// === Client connection state machine ===
+
+void NetworkSession::beginConnect() {
+    m_transport = m_factory ? m_factory() : nullptr;
+    if (!m_transport) {
+        scheduleRetry();
+        return;
+    }
+    m_connectionState = ConnectionState::CONNECTING;
+    m_stateTimer = 0.0f;
+}
+
+void NetworkSession::scheduleRetry() {
+    m_transport.reset();
+    m_connected = false;
+    m_awaitingWelcome = false;
+
+    if (!m_factory || m_connectAttempts >= MAX_CONNECT_ATTEMPTS) {
+        m_connectionState = ConnectionState::FAILED;
+        Utils::logError("Could not reach the server, giving up");
+        return;
+    }
+
+    m_retryDelay = std::min(INITIAL_RETRY_DELAY * static_cast<float>(1 << m_connectAttempts), MAX_RETRY_DELAY);
+    ++m_connectAttempts;
+    m_connectionState = ConnectionState::WAITING_TO_RETRY;
+    m_stateTimer = 0.0f;
+    Utils::logWarning("Reconnecting in " + Utils::toString(m_retryDelay, 1) + "s (attempt " +
+                      std::to_string(m_connectAttempts) + " of " + std::to_string(MAX_CONNECT_ATTEMPTS) + ")");
+}
+
+void NetworkSession::updateClientConnection(float deltaTime) {
+    switch (m_connectionState) {
+    case ConnectionState::CONNECTING:
+        m_stateTimer += deltaTime;
+        if (m_transport->poll()) {
+            onClientConnected();
+        } else if (m_transport->isClosed()) {
+            Utils::logWarning("Connection attempt failed");
+            scheduleRetry();
+        } else if (m_stateTimer >= CONNECT_TIMEOUT) {
+            Utils::logWarning("Connection attempt timed out");
+            scheduleRetry();
+        }
+        break;
+    case ConnectionState::CONNECTED:
+        if (!m_connected) {
+            scheduleRetry();
+        }
+        break;
+    case ConnectionState::WAITING_TO_RETRY:
+        m_stateTimer += deltaTime;
+        if (m_stateTimer >= m_retryDelay) {
+            beginConnect();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void NetworkSession::onClientConnected() {
+    m_connectionState = ConnectionState::CONNECTED;
+    m_connected = true;
+    m_connectAttempts = 0;
+    m_sendBuffer.clear();
+    m_sync.resetFraming();
+
+    // The handshake goes out ahead of any game data
+    if (m_mode == NetworkMode::SPECTATOR) {
+        m_sendBuffer = "HELLO SPECTATOR\n";
+        Utils::logInfo("Connected to server!");
+        return;
+    }
+
+    m_helloSeq = m_sync.getSentSeq();
+    m_awaitingWelcome = true;
+    if (m_sessionToken.empty()) {
+        m_sendBuffer = "HELLO PLAYER\n";
+        Utils::logInfo("Connected to server!");
+    } else {
+        m_sendBuffer = "HELLO RESUME " + m_sessionToken + " " + std::to_string(m_sync.getReceivedSeq()) + "\n";
+        Utils::logInfo("Reconnected, resuming session...");
+    }
+}
+
+void NetworkSession::onWelcome(const std::string& token, unsigned int peerReceived, unsigned int resumeFrom) {
+    bool resumed = !m_sessionToken.empty() && token == m_sessionToken;
+    if (!resumed) {
+        // New session: only what was produced since HELLO is still news
+        m_sync.restartSequenceAfter(m_helloSeq);
+    }
+    m_sessionToken = token;
+    m_sync.setReceivedSeq(resumeFrom);
+
+    // Resend everything the server did not get, including output held back during the handshake
+    std::string replay;
+    if (!m_sync.appendReplay(peerReceived, replay)) {
+        Utils::logWarning("Some moves made while disconnected could not be resent");
+        replay.clear();
+    }
+    m_sendBuffer += replay;
+    m_awaitingWelcome = false;
+
+    if (resumed) {
+        ++m_resumeCount;
+        Utils::logInfo("Session resumed");
+    }
+}
+
+// === Server player seat ===
+
+void NetworkSession::joinPlayer(std::unique_ptr<Transport> transport, bool resume, unsigned int peerReceived,
+                                const std::string& gameBytes) {
+    m_transport = std::move(transport);
+    m_sendBuffer.clear();
+    m_sync.resetFraming();
+
+    std::string replay;
+    unsigned int resumeFrom = 0;
+    if (!resume) {
+        m_sessionToken = makeSessionToken();
+        m_sync.resetSequence();
+    } else if (m_sync.appendReplay(peerReceived, replay)) {
+        resumeFrom = peerReceived;
+    } else {
+        // Too much was missed: the snapshot below has to do
+        Utils::logWarning("Resume history exhausted, resynchronising with a snapshot only");
+        replay.clear();
+        resumeFrom = m_sync.getSentSeq();
+    }
+
+    m_sendBuffer = "WELCOME " + m_sessionToken + " " + std::to_string(m_sync.getReceivedSeq()) + " " +
+                   std::to_string(resumeFrom) + "\n" + replay;
+    if (!gameBytes.empty()) {
+        m_sync.feed(gameBytes.data(), gameBytes.size(), m_incomingMessages);
+    }
+
+    m_connected = true;
+    // Send current state
+    m_sync.requestSnapshot();
+    if (resume) {
+        ++m_resumeCount;
+        Utils::logInfo("Client reconnected, session resumed");
+    } else {
+        Utils::logInfo("Client connected!");
+    }
+}
+
+void NetworkSession::stop() {
+    m_transport.reset();
+    m_factory = nullptr;
+    m_connectionState = ConnectionState::OFFLINE;
+    m_awaitingWelcome = false;
+
+    if (m_serverSocket != INVALID_SOCKET) {
+        SHUTDOWN_SOCKET(m_serverSocket);
+        CLOSE_SOCKET(m_serverSocket);
+        m_serverSocket = INVALID_SOCKET;
+    }
+    m_udpListener.close();
+
+    m_pending.clear();
+    m_spectators.clear();
+    m_spectatorBatch.clear();
+
+    m_mode = NetworkMode::NONE;
+    m_connected = false;
+    m_isMyTurn = true;
+    m_incomingMessages.clear();
+    m_remoteEvents.clear();
+    m_sendBuffer.clear();
+    m_sync.reset();
+
+    cleanupSockets();
+    Utils::logInfo("Network stopped");
+}
+
+// === Transport I/O ===
+
+void NetworkSession::sendMessage(const std::string& message) {
+    // Queued and written together with everything else at the end of the tick
+    m_sync.queueMessage(message);
+}
+
+void NetworkSession::sendFlip(int slot) {
+    m_sync.queueFlip(slot);
+}
+
+void NetworkSession::sendMatch(int slot1, int slot2) {
+    m_sync.queueMatch(slot1, slot2);
+}
+
+void NetworkSession::flushSendBuffer() {
+    if (!m_connected || !m_transport || m_sendBuffer.empty()) {
+        return;
+    }
+
+    long sent = m_transport->send(m_sendBuffer.data(), m_sendBuffer.size());
+    if (sent < 0) {
+        Utils::logError("Send failed, disconnecting");
+        m_connected = false;
+        return;
+    }
+    if (sent == 0) {
+        return;
+    }
+
+    // Count only complete messages that left the buffer
+    int messages = static_cast<int>(std::count(m_sendBuffer.begin(), m_sendBuffer.begin() + sent, '\n'));
+    m_sync.recordSent(static_cast<size_t>(sent), messages);
+    m_sendBuffer.erase(0, static_cast<size_t>(sent));
+}
+
+void NetworkSession::sendPresence(float deltaTime) {
+    m_presenceTimer += deltaTime;
+    if (!m_presenceDirty || m_presenceTimer < PRESENCE_INTERVAL || !isHandshakeComplete() ||
+        m_mode == NetworkMode::SPECTATOR) {
+        return;
+    }
+
+    std::string payload = "PRESENCE " + std::to_string(m_localPresence[0]) + " " + std::to_string(m_localPresence[1]);
+    if (!m_transport->hasUnreliableChannel() || !m_transport->sendPresence(payload)) {
+        m_sendBuffer += payload;
+        m_sendBuffer += '\n';
+    }
+    m_presenceDirty = false;
+    m_presenceTimer = 0.0f;
+}
+
+void NetworkSession::receiveGameState() {
+    if (!m_connected || !m_transport) return;
+
+    char buffer[1024];
+    for (;;) {
+        long received = m_transport->receive(buffer, sizeof(buffer));
+        if (received > 0) {
+            size_t before = m_incomingMessages.size();
+            m_sync.feed(buffer, static_cast<size_t>(received), m_incomingMessages);
+            m_sync.recordReceived(static_cast<size_t>(received),
+                                  static_cast<int>(m_incomingMessages.size() - before));
+            continue;
+        }
+        if (received < 0) {
+            Utils::logWarning("Connection closed by peer");
+            m_connected = false;
+        }
+        break;
+    }
+
+    std::string presence;
+    while (m_transport && m_transport->receivePresence(presence)) {
+        m_incomingMessages.push_back(presence);
+    }
+}
+
+void NetworkSession::handleIncomingMessage(const std::string& msg) {
+    std::istringstream iss(msg);
+    std::string command;
+    iss >> command;
+
+    if (command == "FLIP") {
+        int cardIndex = -1;
+        iss >> cardIndex;
+        Utils::logDebug("Received FLIP command for card " + std::to_string(cardIndex));
+        m_remoteEvents.push_back(msg);
+    } else if (command == "MATCH") {
+        int card1 = -1, card2 = -1;
+        iss >> card1 >> card2;
+        Utils::logDebug("Received MATCH: " + std::to_string(card1) + " and " + std::to_string(card2));
+        m_remoteEvents.push_back(msg);
+    } else if (command == "TURN") {
+        int turn;
+        iss >> turn;
+        m_currentTurn = turn;
+        m_isMyTurn = (turn == m_myPlayerID);
+        m_sync.noteRemoteTurn(turn);
+        Utils::logDebug("Turn changed to player " + std::to_string(turn));
+    } else if (command == "SCORE") {
+        int player, score;
+        iss >> player >> score;
+        if (player >= 0 && player < 2) {
+            m_playerScores[player] = score;
+            m_sync.noteRemoteScore(player, score);
+        }
+    } else if (command == "STATE") {
+        std::string token;
+        while (iss >> token) {
+            size_t colon = token.find(':');
+            if (colon != std::string::npos) {
+                std::string key = token.substr(0, colon);
+                std::string value = token.substr(colon + 1);
+                if (key == "turn") {
+                    m_currentTurn = std::stoi(value);
+                    m_isMyTurn = (m_currentTurn == m_myPlayerID);
+                    m_sync.noteRemoteTurn(m_currentTurn);
+                } else if (key == "score0") {
+                    m_playerScores[0] = std::stoi(value);
+                    m_sync.noteRemoteScore(0, m_playerScores[0]);
+                } else if (key == "score1") {
+                    m_playerScores[1] = std::stoi(value);
+                    m_sync.noteRemoteScore(1, m_playerScores[1]);
+                }
+            }
+        }
+    } else if (command == "PRESENCE") {
+        int x = 0, y = 0;
+        if (iss >> x >> y) {
+            m_remotePresence[0] = x;
+            m_remotePresence[1] = y;
+            m_hasRemotePresence = true;
+        }
+    } else if (command == "HELLO") {
+        // Connection handshake, handled before the game stream starts
+    } else if (command == "WELCOME") {
+        std::string token;
+        unsigned int peerReceived = 0, resumeFrom = 0;
+        iss >> token >> peerReceived >> resumeFrom;
+        if (m_mode == NetworkMode::CLIENT && !token.empty()) {
+            onWelcome(token, peerReceived, resumeFrom);
+        }
+    } else if (command == "END") {
+        int winner;
+        iss >> winner;
+        Utils::logInfo("Game ended. Winner: Player " + std::to_string(winner));
+        m_remoteEvents.push_back(msg);
+    }
+}
+
+// === Server connection handling ===
+
+void NetworkSession::acceptConnections() {
+    for (;;) {
+        sockaddr_in clientAddr{};
+        socklen_t clientLen = sizeof(clientAddr);
+        SOCKET newClient = accept(m_serverSocket, (sockaddr*)&clientAddr, &clientLen);
+        if (newClient == INVALID_SOCKET) {
+            break;
+        }
+        setSocketNonBlocking(newClient);
+        acceptTransport(std::make_unique<TcpTransport>(newClient));
+    }
+
+    while (auto transport = m_udpListener.accept()) {
+        acceptTransport(std::move(transport));
+    }
+}
+
+void NetworkSession::classifyPendingConnections(float deltaTime) {
+    // Clients announce themselves with "HELLO PLAYER", "HELLO RESUME <token> <received>"
+    // or "HELLO SPECTATOR". Silent clients (older builds) are treated as players once
+    // the wait expires.
+    constexpr float HELLO_TIMEOUT = 1.0f;
+
+    for (size_t i = 0; i < m_pending.size();) {
+        PendingConnection& connection = m_pending[i];
+        connection.age += deltaTime;
+        connection.transport->pump(deltaTime);
+
+        char buffer[128];
+        long received = connection.transport->receive(buffer, sizeof(buffer));
+        if (received > 0) {
+            connection.received.append(buffer, static_cast<size_t>(received));
+        } else if (received < 0) {
+            m_pending.erase(m_pending.begin() + i);
+            continue;
+        }
+
+        size_t newline = connection.received.find('\n');
+        if (newline == std::string::npos && connection.age < HELLO_TIMEOUT) {
+            ++i;
+            continue;
+        }
+
+        std::istringstream hello(connection.received.substr(0, newline));
+        std::string word, kind, token;
+        unsigned int peerReceived = 0;
+        hello >> word >> kind >> token >> peerReceived;
+
+        std::string gameBytes = connection.received;
+        if (word == "HELLO") {
+            gameBytes = (newline == std::string::npos) ? std::string() : connection.received.substr(newline + 1);
+        }
+
+        // A returning player takes its seat back even if the old connection has not timed out yet
+        bool resume = (kind == "RESUME") && !m_sessionToken.empty() && token == m_sessionToken;
+        if (resume || (kind != "SPECTATOR" && !m_connected)) {
+            joinPlayer(std::move(connection.transport), resume, peerReceived, gameBytes);
+        } else {
+            SOCKET sock = connection.transport->releaseSocket();
+            if (sock != INVALID_SOCKET) {
+                std::string snapshot;
+                m_sync.appendSnapshot(snapshot);
+                m_spectators.addSpectator(sock, makeBroadcastBuffer(std::move(snapshot)));
+            } else {
+                Utils::logWarning("Spectators are only supported over TCP, connection refused");
+            }
+        }
+        m_pending.erase(m_pending.begin() + i);
+    }
+}
+
+// === Tick ===
+
+void NetworkSession::update(float deltaTime) {
+    if (m_mode == NetworkMode::NONE) {
+        return;
+    }
+    const bool isServer = (m_mode == NetworkMode::SERVER);
+    const ConnectionState stateBefore = m_connectionState;
+    const bool connectedBefore = m_connected;
+    const size_t spectatorsBefore = m_spectators.getSpectatorCount();
+    const int turnBefore = m_currentTurn;
+    const int scoresBefore[2] = {m_playerScores[0], m_playerScores[1]};
+    const int presenceBefore[2] = {m_remotePresence[0], m_remotePresence[1]};
+    const size_t eventsBefore = m_remoteEvents.size();
+
+    if (isServer) {
+        // Release the opponent's connection once it has gone away so the seat can be refilled
+        if (!m_connected && m_transport) {
+            m_transport.reset();
+            m_sendBuffer.clear();
+        }
+        if (m_serverSocket != INVALID_SOCKET) {
+            acceptConnections();
+        }
+        classifyPendingConnections(deltaTime);
+        if (m_transport) {
+            m_transport->pump(deltaTime);
+        }
+    } else {
+        if (m_transport) {
+            m_transport->pump(deltaTime);
+        }
+        updateClientConnection(deltaTime);
+    }
+
+    // Receive and apply messages
+    receiveGameState();
+    for (const auto& msg : m_incomingMessages) {
+        handleIncomingMessage(msg);
+        if (isControlMessage(msg)) {
+            continue;
+        }
+        m_sync.markReceived();
+        if (isServer) {
+            // Spectators see the opponent's moves too
+            m_spectatorBatch += msg;
+            m_spectatorBatch += '\n';
+        }
+    }
+    m_incomingMessages.clear();
+
+    // Everything that changed this tick goes out in a single write. Output produced
+    // while the opponent is away stays in the resume history and is replayed later.
+    m_sync.setHeartbeatEnabled(m_connected && m_mode != NetworkMode::SPECTATOR);
+    m_sync.setTurn(m_currentTurn);
+    m_sync.setScore(0, m_playerScores[0]);
+    m_sync.setScore(1, m_playerScores[1]);
+
+    std::string batch;
+    if (m_sync.flush(deltaTime, batch)) {
+        if (m_connected && !m_awaitingWelcome) {
+            m_sendBuffer += batch;
+        }
+        m_spectatorBatch += batch;
+    }
+    sendPresence(deltaTime);
+    flushSendBuffer();
+
+    if (isServer) {
+        // Encoded once, shared by every spectator queue
+        if (!m_spectatorBatch.empty()) {
+            m_spectators.broadcast(makeBroadcastBuffer(std::move(m_spectatorBatch)));
+            m_spectatorBatch.clear();
+        }
+        if (m_spectators.needsSnapshot()) {
+            std::string snapshot;
+            m_sync.appendSnapshot(snapshot);
+            m_spectators.resync(makeBroadcastBuffer(std::move(snapshot)));
+        }
+        m_spectators.pump(deltaTime);
+    }
+
+    m_sync.updateStats(deltaTime);
+
+    // Heartbeats that repeat known state do not count
+    if (m_connectionState != stateBefore || m_connected != connectedBefore ||
+        m_spectators.getSpectatorCount() != spectatorsBefore || m_currentTurn != turnBefore ||
+        m_playerScores[0] != scoresBefore[0] || m_playerScores[1] != scoresBefore[1] ||
+        m_remotePresence[0] != presenceBefore[0] || m_remotePresence[1] != presenceBefore[1] ||
+        m_remoteEvents.size() != eventsBefore ||
+        m_connectionState == ConnectionState::WAITING_TO_RETRY) { // the countdown is on screen
+        m_activity = true;
+    }
+}
+
+bool NetworkSession::takeActivity() {
+    bool activity = m_activity;
+    m_activity = false;
+    return activity;
+}
+
+// === Gameplay ===
+
+void NetworkSession::nextTurn() {
+    m_currentTurn = 1 - m_currentTurn;
+    m_isMyTurn = (m_currentTurn == m_myPlayerID);
+    // The TURN delta is sent by the next network tick
+}
+
+bool NetworkSession::isMyTurn() const {
+    return m_isMyTurn || !m_connected;
+}
+
+void NetworkSession::updateScore(int player, int delta) {
+    if (player >= 0 && player < 2) {
+        m_playerScores[player] += delta;
+        // The SCORE delta is sent by the next network tick
+    }
+}
+
+void NetworkSession::setPresence(int x, int y) {
+    if (x != m_localPresence[0] || y != m_localPresence[1]) {
+        m_localPresence[0] = x;
+        m_localPresence[1] = y;
+        m_presenceDirty = true;
+    }
+}
+
+bool NetworkSession::getRemotePresence(int& x, int& y) const {
+    if (!m_hasRemotePresence || !m_connected) {
+        return false;
+    }
+    x = m_remotePresence[0];
+    y = m_remotePresence[1];
+    return true;
+}
+
+int NetworkSession::getPlayerScore(int player) const {
+    return (player >= 0 && player < 2) ? m_playerScores[player] : 0;
+}
+
+void NetworkSession::takeRemoteEvents(std::vector<std::string>& out) {
+    out.insert(out.end(), m_remoteEvents.begin(), m_remoteEvents.end());
+    m_remoteEvents.clear();
+}
+
+void NetworkSession::serializeState(std::string& output) const {
+    output.clear();
+    m_sync.appendSnapshot(output);
+    output.pop_back(); // strip the line terminator
+}
+
+void NetworkSession::deserializeState(const std::string& input) {
+    handleIncomingMessage(input);
+}
@@ -0,0 +1,275 @@
+/**
+ * @file NetworkSimulator.cpp
+ * @brief Deterministic loopback link implementation
+ */
+
+#include "../include/NetworkSimulator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// State shared by every link: clock, conditions and random source
+struct NetworkSimulator::Network {
+    NetworkConditions conditions;
+    std::mt19937 rng;
+    float now = 0.0f;
+    bool reachable = true;
+    std::vector<std::weak_ptr<Link>> links;
+    std::deque<std::unique_ptr<Transport>> acceptQueue; ///< Server ends of connect() calls, in call order
+    unsigned long long segmentsSent = 0;
+    unsigned long long retransmissions = 0;
+
+    Network(const NetworkConditions& initial, unsigned int seed)
+        : conditions(initial), rng(seed) {
+    }
+
+    // Uniform [0, 1) built from raw generator output, which is identical on
+    // every standard library (the <random> distributions are not)
+    float random01() {
+        return static_cast<float>(rng() >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+struct NetworkSimulator::Link {
+    struct Segment {
+        float arrival;
+        std::string bytes;
+    };
+
+    // One direction of the wire, indexed by the sending side
+    struct Direction {
+        std::deque<Segment> inFlight;
+        std::string readable;    ///< Arrived, in-order bytes the receiver has not read yet
+        float wireFreeAt = 0.0f; ///< When the sender's last segment finishes serialising
+    };
+
+    std::shared_ptr<Network> network;
+    float establishedAt = 0.0f;
+    bool open = true;
+    bool endpointClosed[2] = {false, false};
+    Direction directions[2];
+
+    Link(std::shared_ptr<Network> owner, float established)
+        : network(std::move(owner)), establishedAt(established) {
+    }
+
+    bool isEstablished() const {
+        return network->now >= establishedAt;
+    }
+
+    void transmit(int from, const char* data, size_t size) {
+        const NetworkConditions& conditions = network->conditions;
+        Direction& direction = directions[from];
+        const size_t segmentSize = conditions.maxSegmentSize > 0 ? conditions.maxSegmentSize : size;
+
+        for (size_t offset = 0; offset < size; offset += segmentSize) {
+            size_t length = std::min(segmentSize, size - offset);
+
+            float start = std::max(network->now, direction.wireFreeAt);
+            float serialisation = conditions.bandwidth > 0.0f ? length / conditions.bandwidth : 0.0f;
+            direction.wireFreeAt = start + serialisation;
+
+            float delay = conditions.latency;
+            if (conditions.jitter > 0.0f) {
+                delay += (network->random01() * 2.0f - 1.0f) * conditions.jitter;
+            }
+            delay = std::max(delay, 0.0f);
+
+            // Each loss costs one retransmission; capped so lossRate = 1 cannot spin forever
+            for (int attempt = 0; attempt < 16 && conditions.lossRate > 0.0f && network->random01() < conditions.lossRate; ++attempt) {
+                delay += conditions.retransmitDelay;
+                ++network->retransmissions;
+            }
+
+            float arrival = direction.wireFreeAt + delay;
+            if (conditions.coalesceWindow > 0.0f) {
+                arrival = std::ceil(arrival / conditions.coalesceWindow) * conditions.coalesceWindow;
+            }
+
+            direction.inFlight.push_back(Segment{arrival, std::string(data + offset, length)});
+            ++network->segmentsSent;
+        }
+    }
+
+    void deliver() {
+        for (Direction& direction : directions) {
+            // In-order delivery: a late segment holds back everything behind it
+            while (!direction.inFlight.empty() && direction.inFlight.front().arrival <= network->now) {
+                direction.readable += direction.inFlight.front().bytes;
+                direction.inFlight.pop_front();
+            }
+        }
+    }
+
+    void cut() {
+        open = false;
+        for (Direction& direction : directions) {
+            direction.inFlight.clear();
+            direction.readable.clear();
+        }
+    }
+};
+
+class NetworkSimulator::Endpoint : public Transport {
+public:
+    Endpoint(std::shared_ptr<Link> link, int side)
+        : m_link(std::move(link)), m_side(side) {
+    }
+
+    ~Endpoint() override {
+        close();
+    }
+
+    bool poll() override {
+        return isConnected();
+    }
+
+    bool isConnected() const override {
+        return !isClosed() && m_link->isEstablished();
+    }
+
+    bool isClosed() const override {
+        return m_closed || !m_link->open;
+    }
+
+    const char* getName() const override {
+        return "SIM";
+    }
+
+    long send(const char* data, size_t size) override {
+        if (isClosed() || m_link->endpointClosed[1 - m_side]) {
+            return -1;
+        }
+        if (!m_link->isEstablished()) {
+            return 0;
+        }
+        m_link->transmit(m_side, data, size);
+        return static_cast<long>(size);
+    }
+
+    long receive(char* buffer, size_t size) override {
+        if (isClosed()) {
+            return -1;
+        }
+        Link::Direction& incoming = m_link->directions[1 - m_side];
+        if (!incoming.readable.empty()) {
+            size_t count = std::min(size, incoming.readable.size());
+            std::memcpy(buffer, incoming.readable.data(), count);
+            incoming.readable.erase(0, count);
+            return static_cast<long>(count);
+        }
+        // The peer's close arrives after everything it sent before closing
+        if (m_link->endpointClosed[1 - m_side] && incoming.inFlight.empty()) {
+            m_closed = true;
+            return -1;
+        }
+        return 0;
+    }
+
+    void close() override {
+        m_closed = true;
+        m_link->endpointClosed[m_side] = true;
+    }
+
+private:
+    std::shared_ptr<Link> m_link;
+    int m_side;
+    bool m_closed = false;
+};
+
+NetworkSimulator::NetworkSimulator(const NetworkConditions& conditions, unsigned int seed)
+    : m_network(std::make_shared<Network>(conditions, seed)) {
+    m_primary = std::make_shared<Link>(m_network, 0.0f);
+    m_network->links.push_back(m_primary);
+}
+
+NetworkSimulator::~NetworkSimulator() {
+    // Queued endpoints reference the network through their link; drop them to break the cycle
+    m_network->acceptQueue.clear();
+}
+
+std::unique_ptr<Transport> NetworkSimulator::takeEndpoint(int side) {
+    if (side < 0 || side > 1 || m_taken[side]) {
+        return nullptr;
+    }
+    m_taken[side] = true;
+    return std::make_unique<Endpoint>(m_primary, side);
+}
+
+std::unique_ptr<Transport> NetworkSimulator::connect() {
+    // The handshake takes one round trip; an unreachable host never answers
+    float established = m_network->reachable
+        ? m_network->now + 2.0f * m_network->conditions.latency
+        : std::numeric_limits<float>::infinity();
+
+    auto link = std::make_shared<Link>(m_network, established);
+    m_network->links.push_back(link);
+    if (m_network->reachable) {
+        m_network->acceptQueue.push_back(std::make_unique<Endpoint>(link, 0));
+    }
+    return std::make_unique<Endpoint>(link, 1);
+}
+
+std::unique_ptr<Transport> NetworkSimulator::accept() {
+    auto& queue = m_network->acceptQueue;
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if ((*it)->isConnected()) {
+            std::unique_ptr<Transport> endpoint = std::move(*it);
+            queue.erase(it);
+            return endpoint;
+        }
+    }
+    return nullptr;
+}
+
+void NetworkSimulator::advance(float deltaTime) {
+    m_network->now += deltaTime;
+
+    auto& links = m_network->links;
+    links.erase(std::remove_if(links.begin(), links.end(),
+                               [](const std::weak_ptr<Link>& link) { return link.expired(); }),
+                links.end());
+    for (const auto& weak : links) {
+        if (auto link = weak.lock()) {
+            link->deliver();
+        }
+    }
+}
+
+void NetworkSimulator::disconnect() {
+    for (const auto& weak : m_network->links) {
+        if (auto link = weak.lock()) {
+            link->cut();
+        }
+    }
+    m_network->acceptQueue.clear();
+}
+
+void NetworkSimulator::setReachable(bool reachable) {
+    m_network->reachable = reachable;
+}
+
+void NetworkSimulator::setConditions(const NetworkConditions& conditions) {
+    m_network->conditions = conditions;
+}
+
+const NetworkConditions& NetworkSimulator::getConditions() const {
+    return m_network->conditions;
+}
+
+float NetworkSimulator::getTime() const {
+    return m_network->now;
+}
+
+unsigned long long NetworkSimulator::getSegmentsSent() const {
+    return m_network->segmentsSent;
+}
+
+unsigned long long NetworkSimulator::getRetransmissions() const {
+    return m_network->retransmissions;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file ParticleSystem.cpp
+ * @brief SoA particle system implementation
+ */
+
+#include "../include/ParticleSystem.h"
+#include "../include/Utils.h"
+#include <rlgl.h>
+#include <raymath.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Unit quad expanded around each particle; the corner doubles as the
+// sprite coordinate the fragment shader rounds off
+const char* PARTICLE_VS = R"(#version 330
+in vec2 vertexPosition;
+in vec3 instanceData;
+in vec4 instanceColor;
+uniform mat4 mvp;
+out vec2 fragCorner;
+out vec4 fragColor;
+void main() {
+    fragCorner = vertexPosition;
+    fragColor = instanceColor;
+    gl_Position = mvp*vec4(instanceData.xy + vertexPosition*instanceData.z, 0.0, 1.0);
+}
+)";
+
+const char* PARTICLE_FS = R"(#version 330
+in vec2 fragCorner;
+in vec4 fragColor;
+out vec4 finalColor;
+void main() {
+    float d = dot(fragCorner, fragCorner);
+    if (d > 1.0) discard;
+    finalColor = vec4(fragColor.rgb, fragColor.a*(1.0 - smoothstep(0.5, 1.0, d)));
+}
+)";
+
+const float QUAD_CORNERS[12] = {
+    -1.0f, -1.0f,  1.0f, -1.0f,  1.0f, 1.0f,
+    -1.0f, -1.0f,  1.0f,  1.0f, -1.0f, 1.0f,
+};
+
+} // namespace
+
+ParticleSystem::ParticleSystem(std::size_t capacity, unsigned int seed)
+    : m_capacity(capacity), m_rng(seed) {
+    m_x.resize(capacity);
+    m_y.resize(capacity);
+    m_vx.resize(capacity);
+    m_vy.resize(capacity);
+    m_size.resize(capacity);
+    m_life.resize(capacity);
+    m_fade.resize(capacity);
+    m_color.resize(capacity);
+}
+
+ParticleSystem::~ParticleSystem() {
+    unload();
+}
+
+// === Simulation ===
+
+std::size_t ParticleSystem::emit(const ParticleEmitter& emitter, std::size_t count) {
+    count = std::min(count, m_capacity - m_count);
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const float fade = emitter.lifetime > 0.0f ? 1.0f / emitter.lifetime : 0.0f;
+    const Vector3 hsv = emitter.hueJitter > 0.0f ? ColorToHSV(emitter.color) : Vector3{0.0f, 0.0f, 0.0f};
+
+    for (std::size_t k = 0; k < count; ++k) {
+        const std::size_t i = m_count++;
+        const float angle = Utils::lerp(emitter.minAngle, emitter.maxAngle, unit(m_rng)) * DEG2RAD;
+        const float speed = Utils::lerp(emitter.minSpeed, emitter.maxSpeed, unit(m_rng));
+
+        m_x[i] = emitter.position.x + emitter.spread.x * (unit(m_rng) * 2.0f - 1.0f);
+        m_y[i] = emitter.position.y + emitter.spread.y * (unit(m_rng) * 2.0f - 1.0f);
+        m_vx[i] = std::cos(angle) * speed;
+        m_vy[i] = std::sin(angle) * speed;
+        m_size[i] = Utils::lerp(emitter.minSize, emitter.maxSize, unit(m_rng));
+        m_life[i] = 1.0f;
+        m_fade[i] = fade;
+
+        Color color = emitter.color;
+        if (emitter.hueJitter > 0.0f) {
+            float hue = std::fmod(hsv.x + emitter.hueJitter * (unit(m_rng) * 2.0f - 1.0f) + 360.0f, 360.0f);
+            color = ColorFromHSV(hue, hsv.y, hsv.z);
+            color.a = emitter.color.a;
+        }
+        m_color[i] = color;
+    }
+    return count;
+}
+
+void ParticleSystem::update(float deltaTime) {
+    const std::size_t n = m_count;
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    float* life = m_life.data();
+    const float* fade = m_fade.data();
+
+    // One field at a time keeps every loop a straight SIMD-friendly stream
+    const float gx = m_gravity.x * deltaTime;
+    const float gy = m_gravity.y * deltaTime;
+    for (std::size_t i = 0; i < n; ++i) {
+        vx[i] += gx;
+        vy[i] += gy;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        life[i] -= fade[i] * deltaTime;
+    }
+
+    if (m_wrapWidth > 0.0f && m_wrapHeight > 0.0f) {
+        const float invW = 1.0f / m_wrapWidth;
+        const float invH = 1.0f / m_wrapHeight;
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] -= m_wrapWidth * std::floor(x[i] * invW);
+            y[i] -= m_wrapHeight * std::floor(y[i] * invH);
+        }
+    }
+
+    removeDead();
+}
+
+void ParticleSystem::removeDead() {
+    std::size_t i = 0;
+    while (i < m_count) {
+        if (m_life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        // Swap-remove: the last live particle takes this slot
+        const std::size_t last = --m_count;
+        m_x[i] = m_x[last];
+        m_y[i] = m_y[last];
+        m_vx[i] = m_vx[last];
+        m_vy[i] = m_vy[last];
+        m_size[i] = m_size[last];
+        m_life[i] = m_life[last];
+        m_fade[i] = m_fade[last];
+        m_color[i] = m_color[last];
+    }
+}
+
+void ParticleSystem::setWrap(float width, float height) {
+    m_wrapWidth = std::max(0.0f, width);
+    m_wrapHeight = std::max(0.0f, height);
+}
+
+// === Rendering ===
+
+void ParticleSystem::loadGpu() {
+    m_gpuLoaded = true;
+
+    const int version = rlGetVersion();
+    if (version == RL_OPENGL_33 || version == RL_OPENGL_43) {
+        m_shader = LoadShaderFromMemory(PARTICLE_VS, PARTICLE_FS);
+    }
+    if (IsShaderReady(m_shader)) {
+        const int cornerLoc = GetShaderLocationAttrib(m_shader, "vertexPosition");
+        const int dataLoc = GetShaderLocationAttrib(m_shader, "instanceData");
+        const int colorLoc = GetShaderLocationAttrib(m_shader, "instanceColor");
+        m_mvpLoc = GetShaderLocation(m_shader, "mvp");
+
+        if (cornerLoc >= 0 && dataLoc >= 0 && colorLoc >= 0 && m_mvpLoc >= 0) {
+            m_vao = rlLoadVertexArray();
+            rlEnableVertexArray(m_vao);
+
+            m_quadVbo = rlLoadVertexBuffer(QUAD_CORNERS, sizeof(QUAD_CORNERS), false);
+            rlSetVertexAttribute(cornerLoc, 2, RL_FLOAT, false, 0, nullptr);
+            rlEnableVertexAttribute(cornerLoc);
+
+            // Sized for a full pool once, so draw() never reallocates on the GPU
+            m_instances.resize(m_capacity);
+            m_instanceVbo = rlLoadVertexBuffer(nullptr, static_cast<int>(m_capacity * sizeof(Instance)), true);
+            rlSetVertexAttribute(dataLoc, 3, RL_FLOAT, false, sizeof(Instance),
+                                 reinterpret_cast<const void*>(offsetof(Instance, x)));
+            rlEnableVertexAttribute(dataLoc);
+            rlSetVertexAttributeDivisor(dataLoc, 1);
+            rlSetVertexAttribute(colorLoc, 4, RL_UNSIGNED_BYTE, true, sizeof(Instance),
+                                 reinterpret_cast<const void*>(offsetof(Instance, color)));
+            rlEnableVertexAttribute(colorLoc);
+            rlSetVertexAttributeDivisor(colorLoc, 1);
+
+            rlDisableVertexArray();
+            rlDisableVertexBuffer();
+            m_instanced = true;
+        } else {
+            UnloadShader(m_shader);
+            m_shader = Shader{};
+        }
+    }
+
+    if (!m_instanced) {
+        Utils::logInfo("Instanced particles unavailable, using the batched fallback");
+        Image dot = GenImageGradientRadial(32, 32, 0.5f, WHITE, BLANK);
+        m_sprite = LoadTextureFromImage(dot);
+        UnloadImage(dot);
+    }
+}
+
+void ParticleSystem::unload() {
+    if (m_instanced) {
+        rlUnloadVertexArray(m_vao);
+        rlUnloadVertexBuffer(m_quadVbo);
+        rlUnloadVertexBuffer(m_instanceVbo);
+        UnloadShader(m_shader);
+    }
+    if (IsTextureReady(m_sprite)) {
+        UnloadTexture(m_sprite);
+    }
+    m_shader = Shader{};
+    m_sprite = Texture2D{};
+    m_vao = 0;
+    m_quadVbo = 0;
+    m_instanceVbo = 0;
+    m_mvpLoc = -1;
+    m_instances.clear();
+    m_instances.shrink_to_fit();
+    m_instanced = false;
+    m_gpuLoaded = false;
+}
+
+void ParticleSystem::draw() {
+    if (m_count == 0) {
+        return;
+    }
+    if (!m_gpuLoaded) {
+        loadGpu();
+    }
+
+    if (m_instanced) {
+        drawInstanced();
+    } else {
+        drawBatched();
+    }
+}
+
+void ParticleSystem::drawInstanced() {
+    for (std::size_t i = 0; i < m_count; ++i) {
+        Color color = m_color[i];
+        color.a = static_cast<unsigned char>(color.a * m_life[i]);
+        m_instances[i] = {m_x[i], m_y[i], m_size[i], color};
+    }
+
+    // Whatever is queued in the 2D batch was drawn before us
+    rlDrawRenderBatchActive();
+
+    rlUpdateVertexBuffer(m_instanceVbo, m_instances.data(), static_cast<int>(m_count * sizeof(Instance)), 0);
+    rlEnableShader(m_shader.id);
+    rlSetUniformMatrix(m_mvpLoc, MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlEnableVertexArray(m_vao);
+    rlDrawVertexArrayInstanced(0, 6, static_cast<int>(m_count));
+    rlDisableVertexArray();
+    rlDisableShader();
+}
+
+void ParticleSystem::drawBatched() {
+    rlSetTexture(m_sprite.id != 0 ? m_sprite.id : rlGetTextureIdDefault());
+    rlBegin(RL_QUADS);
+    for (std::size_t i = 0; i < m_count; ++i) {
+        // Flushes a full batch and carries on in a new one
+        rlCheckRenderBatchLimit(4);
+
+        const float r = m_size[i];
+        const Color color = m_color[i];
+        rlColor4ub(color.r, color.g, color.b, static_cast<unsigned char>(color.a * m_life[i]));
+        rlTexCoord2f(0.0f, 0.0f);
+        rlVertex2f(m_x[i] - r, m_y[i] - r);
+        rlTexCoord2f(0.0f, 1.0f);
+        rlVertex2f(m_x[i] - r, m_y[i] + r);
+        rlTexCoord2f(1.0f, 1.0f);
+        rlVertex2f(m_x[i] + r, m_y[i] + r);
+        rlTexCoord2f(1.0f, 0.0f);
+        rlVertex2f(m_x[i] + r, m_y[i] - r);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
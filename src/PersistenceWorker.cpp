@@ -0,0 +1,244 @@
+/**
+ * @file PersistenceWorker.cpp
+ * @brief Write job queue and the durable file helpers
+ */
+
+#include "../include/PersistenceWorker.h"
+#include "../include/Utils.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+    #include <sys/stat.h>
+    // Only MoveFileExA is needed; keep out the GDI and USER names raylib also uses
+    #define WIN32_LEAN_AND_MEAN
+    #define NOGDI
+    #define NOUSER
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t COPY_CHUNK = 64 * 1024;
+
+// === Thin, portable file descriptor layer ===
+
+#ifdef _WIN32
+int openForWrite(const std::string& path, bool truncate) {
+    int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : 0);
+    return _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+}
+bool seekTo(int fd, std::uint64_t offset) { return _lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) >= 0; }
+long long sizeOf(int fd) { return _filelengthi64(fd); }
+bool truncateTo(int fd, std::uint64_t size) { return _chsize_s(fd, static_cast<__int64>(size)) == 0; }
+bool syncFile(int fd) { return _commit(fd) == 0; }
+int closeFile(int fd) { return _close(fd); }
+long writeSome(int fd, const char* data, std::size_t size) {
+    return _write(fd, data, static_cast<unsigned>(size > 0x40000000 ? 0x40000000 : size));
+}
+bool replaceFile(const std::string& from, const std::string& to) {
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+void syncDirectoryOf(const std::string&) {
+    // MOVEFILE_WRITE_THROUGH already waits for the rename to reach the disk
+}
+#else
+int openForWrite(const std::string& path, bool truncate) {
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0), 0644);
+}
+bool seekTo(int fd, std::uint64_t offset) { return ::lseek(fd, static_cast<off_t>(offset), SEEK_SET) >= 0; }
+long long sizeOf(int fd) {
+    struct stat info;
+    return ::fstat(fd, &info) == 0 ? static_cast<long long>(info.st_size) : -1;
+}
+bool truncateTo(int fd, std::uint64_t size) { return ::ftruncate(fd, static_cast<off_t>(size)) == 0; }
+bool syncFile(int fd) { return ::fsync(fd) == 0; }
+int closeFile(int fd) { return ::close(fd); }
+long writeSome(int fd, const char* data, std::size_t size) { return static_cast<long>(::write(fd, data, size)); }
+bool replaceFile(const std::string& from, const std::string& to) { return std::rename(from.c_str(), to.c_str()) == 0; }
+void syncDirectoryOf(const std::string& path) {
+    // A rename is only durable once the directory entry itself is on disk
+    std::string::size_type slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+#endif
+
+bool writeAll(int fd, const void* data, std::size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        long written = writeSome(fd, bytes, size);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+// Syncs and closes a finished temporary file and renames it over path
+bool commitTemporary(int fd, const std::string& temporary, const std::string& path) {
+    bool ok = syncFile(fd);
+    ok = (closeFile(fd) == 0) && ok;
+    ok = ok && replaceFile(temporary, path);
+    if (!ok) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    syncDirectoryOf(path);
+    return true;
+}
+
+} // namespace
+
+// === Worker ===
+
+PersistenceWorker::PersistenceWorker() {
+    // Started here, once the queue and its locks exist
+    m_thread = std::thread(&PersistenceWorker::run, this);
+}
+
+PersistenceWorker::~PersistenceWorker() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void PersistenceWorker::post(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_wake.notify_one();
+}
+
+void PersistenceWorker::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_jobs.empty() && !m_busy; });
+}
+
+void PersistenceWorker::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+        if (m_jobs.empty()) {
+            return;     // stopping, and everything posted has been written
+        }
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_busy = true;
+        lock.unlock();
+
+        if (!job()) {
+            ++m_failures;
+        }
+        ++m_completed;
+
+        lock.lock();
+        m_busy = false;
+        if (m_jobs.empty()) {
+            m_idle.notify_all();
+        }
+    }
+}
+
+// === Durable file helpers ===
+
+bool PersistenceWorker::appendDurably(const std::string& path, const void* data, std::size_t size,
+                                      std::uint64_t expectedSize) {
+    int fd = openForWrite(path, false);
+    if (fd < 0) {
+        Utils::logError("Failed to open for appending: " + path);
+        return false;
+    }
+    const long long current = sizeOf(fd);
+    if (current < 0 || static_cast<std::uint64_t>(current) < expectedSize) {
+        Utils::logError("File is shorter than expected, not appending: " + path);
+        closeFile(fd);
+        return false;
+    }
+    // Cut off what a failed earlier append may have left behind
+    bool ok = (static_cast<std::uint64_t>(current) == expectedSize || truncateTo(fd, expectedSize)) &&
+              seekTo(fd, expectedSize) && writeAll(fd, data, size) && syncFile(fd);
+    if (!ok) {
+        Utils::logError("Failed to append to: " + path);
+        truncateTo(fd, expectedSize);
+    }
+    closeFile(fd);
+    if (ok && expectedSize == 0) {
+        syncDirectoryOf(path);  // a new file's directory entry
+    }
+    return ok;
+}
+
+bool PersistenceWorker::writeAtomically(const std::string& path, const void* data, std::size_t size) {
+    const std::string temporary = path + ".tmp";
+    int fd = openForWrite(temporary, true);
+    if (fd < 0) {
+        Utils::logError("Failed to create: " + temporary);
+        return false;
+    }
+    if (!writeAll(fd, data, size)) {
+        closeFile(fd);
+        std::remove(temporary.c_str());
+        Utils::logError("Failed to write: " + temporary);
+        return false;
+    }
+    if (!commitTemporary(fd, temporary, path)) {
+        Utils::logError("Failed to replace: " + path);
+        return false;
+    }
+    return true;
+}
+
+bool PersistenceWorker::copyAtomically(const std::string& source, const std::string& destination,
+                                       std::uint64_t length) {
+    std::ifstream in(source, std::ios::binary);
+    if (!in.is_open()) {
+        Utils::logError("Failed to open for copying: " + source);
+        return false;
+    }
+    const std::string temporary = destination + ".tmp";
+    int fd = openForWrite(temporary, true);
+    if (fd < 0) {
+        Utils::logError("Failed to create: " + temporary);
+        return false;
+    }
+
+    std::vector<char> chunk(COPY_CHUNK);
+    std::uint64_t remaining = length;
+    bool ok = true;
+    while (ok && remaining > 0) {
+        const std::size_t want = remaining < chunk.size() ? static_cast<std::size_t>(remaining) : chunk.size();
+        in.read(chunk.data(), static_cast<std::streamsize>(want));
+        ok = static_cast<std::size_t>(in.gcount()) == want && writeAll(fd, chunk.data(), want);
+        remaining -= want;
+    }
+    if (!ok) {
+        closeFile(fd);
+        std::remove(temporary.c_str());
+        Utils::logError("Failed to copy " + source + " to " + temporary);
+        return false;
+    }
+    if (!commitTemporary(fd, temporary, destination)) {
+        Utils::logError("Failed to replace: " + destination);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,291 @@
+/**
+ * @file ReliableChannel.cpp
+ * @brief Datagram reliability layer implementation
+ */
+
+#include "../include/ReliableChannel.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint8_t FLAG_HAS_ACK = 0x01;
+
+// All multi-byte fields are little-endian on the wire
+void put16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+void put32(std::string& out, uint32_t value) {
+    put16(out, static_cast<uint16_t>(value & 0xFFFF));
+    put16(out, static_cast<uint16_t>(value >> 16));
+}
+
+uint16_t get16(const char* data) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t get32(const char* data) {
+    return static_cast<uint32_t>(get16(data)) | (static_cast<uint32_t>(get16(data + 2)) << 16);
+}
+
+} // namespace
+
+ReliableChannel::ReliableChannel()
+    : m_time(0.0f), m_lastReceiveTime(0.0f), m_lastSendTime(0.0f),
+      m_roundTripTime(0.1f), m_resends(0),
+      m_localSequence(0), m_hasRemoteSequence(false), m_remoteSequence(0),
+      m_receivedBits(0), m_ackPending(false),
+      m_nextChunkId(0), m_expectedChunkId(0),
+      m_presencePending(false), m_presenceReceived(false),
+      m_hasPresenceSequence(false), m_presenceSequence(0) {
+}
+
+// === OUTGOING ===
+
+size_t ReliableChannel::send(const char* data, size_t size) {
+    size_t accepted = 0;
+    while (accepted < size && m_outgoing.size() < MAX_UNACKED_CHUNKS) {
+        size_t length = std::min(MAX_CHUNK_SIZE, size - accepted);
+        OutgoingChunk chunk;
+        chunk.id = m_nextChunkId++;
+        chunk.bytes.assign(data + accepted, length);
+        m_outgoing.push_back(std::move(chunk));
+        accepted += length;
+    }
+    return accepted;
+}
+
+void ReliableChannel::sendPresence(const std::string& payload) {
+    m_presenceOut = payload;
+    m_presencePending = true;
+}
+
+void ReliableChannel::flush(std::vector<std::string>& packets) {
+    for (OutgoingChunk& chunk : m_outgoing) {
+        if (!chunk.sent) {
+            writePacket(PacketType::DATA, &chunk, nullptr, packets);
+        }
+    }
+    if (m_presencePending) {
+        writePacket(PacketType::PRESENCE, nullptr, &m_presenceOut, packets);
+        m_presencePending = false;
+    }
+}
+
+void ReliableChannel::update(float deltaTime, std::vector<std::string>& packets) {
+    m_time += deltaTime;
+
+    // The peer acks on its next tick, so allow a little on top of the RTT
+    const float resendDelay = std::max(MIN_RESEND_DELAY, m_roundTripTime * 1.25f + 0.03f);
+    for (OutgoingChunk& chunk : m_outgoing) {
+        if (chunk.sent && !chunk.acked && m_time - chunk.sentAt >= resendDelay) {
+            writePacket(PacketType::DATA, &chunk, nullptr, packets);
+            ++m_resends;
+        }
+    }
+
+    flush(packets);
+
+    if (m_ackPending || m_time - m_lastSendTime >= KEEPALIVE_INTERVAL) {
+        writePacket(PacketType::DATA, nullptr, nullptr, packets);
+    }
+}
+
+void ReliableChannel::writePacket(PacketType type, OutgoingChunk* chunk, const std::string* payload,
+                                  std::vector<std::string>& packets) {
+    const uint16_t sequence = m_localSequence++;
+
+    std::string packet;
+    packet.reserve(HEADER_SIZE + 2 + (chunk ? chunk->bytes.size() : 0) + (payload ? payload->size() : 0));
+    put16(packet, PROTOCOL_ID);
+    packet.push_back(static_cast<char>(type));
+    packet.push_back(static_cast<char>(m_hasRemoteSequence ? FLAG_HAS_ACK : 0));
+    put16(packet, sequence);
+    put16(packet, m_remoteSequence);
+    put32(packet, m_receivedBits);
+
+    SentPacket& record = m_sentPackets[sequence % m_sentPackets.size()];
+    record = SentPacket{};
+    record.sequence = sequence;
+    record.sentAt = m_time;
+    record.valid = true;
+
+    if (chunk) {
+        put16(packet, chunk->id);
+        packet += chunk->bytes;
+        record.hasChunk = true;
+        record.chunkId = chunk->id;
+        chunk->sent = true;
+        chunk->sentAt = m_time;
+    } else if (payload) {
+        packet += *payload;
+    }
+
+    packets.push_back(std::move(packet));
+    m_ackPending = false;
+    m_lastSendTime = m_time;
+}
+
+// === INCOMING ===
+
+bool ReliableChannel::receivePacket(const char* data, size_t size) {
+    PacketType type;
+    if (!readPacketType(data, size, type) || size < HEADER_SIZE ||
+        (type != PacketType::DATA && type != PacketType::PRESENCE)) {
+        return false;
+    }
+
+    const uint8_t flags = static_cast<uint8_t>(data[3]);
+    const uint16_t sequence = get16(data + 4);
+    m_lastReceiveTime = m_time;
+
+    recordReceived(sequence);
+    if (flags & FLAG_HAS_ACK) {
+        processAcks(get16(data + 6), get32(data + 8));
+    }
+
+    const char* body = data + HEADER_SIZE;
+    const size_t bodySize = size - HEADER_SIZE;
+    if (type == PacketType::DATA) {
+        // An empty DATA packet is a bare ack; acking it would ping-pong forever
+        if (bodySize >= 2) {
+            acceptChunk(get16(body), body + 2, bodySize - 2);
+            m_ackPending = true;
+        }
+    } else {
+        if (!m_hasPresenceSequence || sequenceGreater(sequence, m_presenceSequence)) {
+            m_presenceIn.assign(body, bodySize);
+            m_presenceReceived = true;
+            m_hasPresenceSequence = true;
+            m_presenceSequence = sequence;
+        }
+        m_ackPending = true;
+    }
+    return true;
+}
+
+void ReliableChannel::recordReceived(uint16_t sequence) {
+    if (!m_hasRemoteSequence) {
+        m_hasRemoteSequence = true;
+        m_remoteSequence = sequence;
+        m_receivedBits = 0;
+        return;
+    }
+
+    if (sequenceGreater(sequence, m_remoteSequence)) {
+        const uint16_t shift = static_cast<uint16_t>(sequence - m_remoteSequence);
+        // The previous newest packet becomes bit (shift - 1)
+        if (shift > 32) {
+            m_receivedBits = 0;
+        } else {
+            m_receivedBits = (shift == 32 ? 0 : m_receivedBits << shift) | (1u << (shift - 1));
+        }
+        m_remoteSequence = sequence;
+    } else {
+        const uint16_t distance = static_cast<uint16_t>(m_remoteSequence - sequence);
+        if (distance >= 1 && distance <= 32) {
+            m_receivedBits |= 1u << (distance - 1);
+        }
+    }
+}
+
+void ReliableChannel::processAcks(uint16_t ack, uint32_t ackBits) {
+    bool chunkAcked = false;
+    for (int i = 0; i <= 32; ++i) {
+        if (i > 0 && !(ackBits & (1u << (i - 1)))) {
+            continue;
+        }
+        const uint16_t sequence = static_cast<uint16_t>(ack - i);
+        SentPacket& record = m_sentPackets[sequence % m_sentPackets.size()];
+        if (!record.valid || record.sequence != sequence || record.acked) {
+            continue;
+        }
+        record.acked = true;
+        if (i == 0) {
+            // Older packets may have been acked by an earlier, lost ack, so
+            // only the newest one gives a clean round-trip sample
+            m_roundTripTime += (m_time - record.sentAt - m_roundTripTime) * 0.125f;
+        }
+
+        if (record.hasChunk) {
+            for (OutgoingChunk& chunk : m_outgoing) {
+                if (chunk.id == record.chunkId) {
+                    chunk.acked = true;
+                    chunkAcked = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (chunkAcked) {
+        while (!m_outgoing.empty() && m_outgoing.front().acked) {
+            m_outgoing.pop_front();
+        }
+    }
+}
+
+void ReliableChannel::acceptChunk(uint16_t id, const char* data, size_t size) {
+    const uint16_t ahead = static_cast<uint16_t>(id - m_expectedChunkId);
+    if (ahead >= MAX_UNACKED_CHUNKS) {
+        return; // Duplicate of a chunk already delivered (or garbage)
+    }
+    if (ahead > 0) {
+        m_earlyChunks.emplace(id, std::string(data, size));
+        return;
+    }
+
+    m_readable.append(data, size);
+    ++m_expectedChunkId;
+    for (auto it = m_earlyChunks.find(m_expectedChunkId); it != m_earlyChunks.end();
+         it = m_earlyChunks.find(m_expectedChunkId)) {
+        m_readable += it->second;
+        m_earlyChunks.erase(it);
+        ++m_expectedChunkId;
+    }
+}
+
+size_t ReliableChannel::read(char* buffer, size_t size) {
+    const size_t count = std::min(size, m_readable.size());
+    if (count > 0) {
+        std::memcpy(buffer, m_readable.data(), count);
+        m_readable.erase(0, count);
+    }
+    return count;
+}
+
+bool ReliableChannel::takePresence(std::string& payload) {
+    if (!m_presenceReceived) {
+        return false;
+    }
+    payload = m_presenceIn;
+    m_presenceReceived = false;
+    return true;
+}
+
+// === WIRE FORMAT HELPERS ===
+
+void ReliableChannel::writeControlPacket(PacketType type, std::string& out) {
+    out.clear();
+    put16(out, PROTOCOL_ID);
+    out.push_back(static_cast<char>(type));
+}
+
+bool ReliableChannel::readPacketType(const char* data, size_t size, PacketType& type) {
+    if (size < 3 || get16(data) != PROTOCOL_ID) {
+        return false;
+    }
+    const uint8_t raw = static_cast<uint8_t>(data[2]);
+    if (raw < static_cast<uint8_t>(PacketType::CONNECT) || raw > static_cast<uint8_t>(PacketType::PRESENCE)) {
+        return false;
+    }
+    type = static_cast<PacketType>(raw);
+    return true;
+}
+
+bool ReliableChannel::sequenceGreater(uint16_t a, uint16_t b) {
+    return ((a > b) && (a - b <= 32768)) || ((a < b) && (b - a > 32768));
+}
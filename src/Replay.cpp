@@ -0,0 +1,221 @@
+/**
+ * @file Replay.cpp
+ * @brief Replay encoding and decoding
+ */
+
+#include "../include/Replay.h"
+#include <algorithm>
+
+namespace {
+
+constexpr unsigned char MAGIC[4] = {'M', 'C', 'R', 'P'};
+constexpr std::size_t MAX_EVENT_BYTES = 32;     ///< Largest encoded event (END: three varints)
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+} // namespace
+
+// === Recording ===
+
+ReplayRecorder::ReplayRecorder(std::size_t capacity)
+    : m_buffer(std::max<std::size_t>(capacity, 2 * MAX_EVENT_BYTES + 16)) {
+}
+
+void ReplayRecorder::begin(std::uint32_t seed, std::int32_t difficulty) {
+    m_size = 0;
+    m_slots = ReplayReader::slotCount(difficulty);
+    m_lastStep = 0;
+    m_recording = true;
+    m_finished = false;
+    m_truncated = false;
+
+    std::copy(MAGIC, MAGIC + 4, m_buffer.begin());
+    m_buffer[4] = FORMAT_VERSION;
+    m_size = 5;
+    putVarint(static_cast<std::uint64_t>(difficulty));
+    for (int i = 0; i < 4; ++i) {
+        m_buffer[m_size++] = static_cast<unsigned char>(seed >> (8 * i));
+    }
+}
+
+bool ReplayRecorder::resume(const unsigned char* data, std::size_t size) {
+    m_size = 0;
+    m_recording = false;
+    m_finished = false;
+    m_truncated = false;
+
+    // Walk the events for the step the next delta counts from
+    ReplayReader reader(data, size);
+    ReplayEvent event;
+    std::uint64_t lastStep = 0;
+    while (reader.next(event)) {
+        if (event.type == ReplayEventType::END) {
+            return false;
+        }
+        lastStep = event.step;
+    }
+    if (!reader.isValid() || reader.hasError() || size + 2 * MAX_EVENT_BYTES > m_buffer.size()) {
+        return false;
+    }
+
+    std::copy(data, data + size, m_buffer.begin());
+    m_size = size;
+    m_slots = ReplayReader::slotCount(reader.getHeader().difficulty);
+    m_lastStep = lastStep;
+    m_recording = true;
+    return true;
+}
+
+bool ReplayRecorder::reserve(bool final) {
+    if (!m_recording) {
+        return false;
+    }
+    // Room for this event, plus the END that has to follow it
+    const std::size_t needed = final ? MAX_EVENT_BYTES : 2 * MAX_EVENT_BYTES;
+    if (m_size + needed > m_buffer.size()) {
+        m_truncated = true;
+        return false;
+    }
+    return true;
+}
+
+void ReplayRecorder::putVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+        m_buffer[m_size++] = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    m_buffer[m_size++] = static_cast<unsigned char>(value);
+}
+
+void ReplayRecorder::putEvent(std::uint64_t step, std::uint64_t code) {
+    const std::uint64_t delta = step > m_lastStep ? step - m_lastStep : 0;
+    m_lastStep = std::max(m_lastStep, step);
+    putVarint(delta * (static_cast<std::uint64_t>(m_slots) + REPLAY_CONTROL_CODES) + code);
+}
+
+std::uint64_t ReplayRecorder::controlCode(ReplayEventType type) const {
+    return static_cast<std::uint64_t>(m_slots) + static_cast<std::uint64_t>(type) - 1;
+}
+
+void ReplayRecorder::click(std::uint64_t step, int slot) {
+    if (slot < 0 || slot >= m_slots || !reserve(false)) {
+        return;
+    }
+    putEvent(step, static_cast<std::uint64_t>(slot));
+}
+
+void ReplayRecorder::hint(std::uint64_t step) {
+    if (reserve(false)) {
+        putEvent(step, controlCode(ReplayEventType::HINT));
+    }
+}
+
+void ReplayRecorder::shuffle(std::uint64_t step) {
+    if (reserve(false)) {
+        putEvent(step, controlCode(ReplayEventType::SHUFFLE));
+    }
+}
+
+void ReplayRecorder::pause(std::uint64_t step, std::uint32_t milliseconds) {
+    if (reserve(false)) {
+        putEvent(step, controlCode(ReplayEventType::PAUSE));
+        putVarint(milliseconds);
+    }
+}
+
+void ReplayRecorder::finish(std::uint64_t step, std::int32_t score, std::int32_t moves) {
+    if (!reserve(true)) {
+        return;
+    }
+    putEvent(step, controlCode(ReplayEventType::END));
+    putVarint(zigzag(score));
+    putVarint(zigzag(moves));
+    m_recording = false;
+    m_finished = true;
+}
+
+// === Reading ===
+
+std::int32_t ReplayReader::slotCount(std::int32_t difficulty) {
+    switch (difficulty) {
+        case 16: case 36: case 64: return difficulty;
+        default: return 0;
+    }
+}
+
+ReplayReader::ReplayReader(const unsigned char* data, std::size_t size)
+    : m_data(data), m_size(size) {
+    if (size < 5 || !std::equal(MAGIC, MAGIC + 4, data) || data[4] != ReplayRecorder::FORMAT_VERSION) {
+        return;
+    }
+    m_offset = 5;
+    std::uint64_t difficulty = 0;
+    if (!getVarint(difficulty) || slotCount(static_cast<std::int32_t>(difficulty)) == 0 || m_size - m_offset < 4) {
+        return;
+    }
+    m_header.difficulty = static_cast<std::int32_t>(difficulty);
+    for (int i = 0; i < 4; ++i) {
+        m_header.seed |= static_cast<std::uint32_t>(m_data[m_offset++]) << (8 * i);
+    }
+    m_valid = true;
+}
+
+bool ReplayReader::getVarint(std::uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && m_offset < m_size; shift += 7) {
+        const unsigned char byte = m_data[m_offset++];
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    m_error = true;
+    return false;
+}
+
+bool ReplayReader::next(ReplayEvent& event) {
+    if (!m_valid || m_error || m_offset >= m_size) {
+        return false;
+    }
+    std::uint64_t packed = 0;
+    if (!getVarint(packed)) {
+        return false;
+    }
+    const std::uint64_t slots = static_cast<std::uint64_t>(m_header.difficulty);
+    const std::uint64_t code = packed % (slots + REPLAY_CONTROL_CODES);
+    const std::uint64_t delta = packed / (slots + REPLAY_CONTROL_CODES);
+
+    event = ReplayEvent();
+    event.type = code < slots ? ReplayEventType::CLICK : static_cast<ReplayEventType>(code - slots + 1);
+    switch (event.type) {
+        case ReplayEventType::CLICK:
+            event.slot = static_cast<int>(code);
+            break;
+        case ReplayEventType::HINT:
+        case ReplayEventType::SHUFFLE:
+            break;
+        case ReplayEventType::PAUSE: {
+            std::uint64_t milliseconds = 0;
+            if (!getVarint(milliseconds)) return false;
+            event.milliseconds = static_cast<std::uint32_t>(milliseconds);
+            break;
+        }
+        case ReplayEventType::END: {
+            std::uint64_t score = 0, moves = 0;
+            if (!getVarint(score) || !getVarint(moves)) return false;
+            event.score = static_cast<std::int32_t>(unzigzag(score));
+            event.moves = static_cast<std::int32_t>(unzigzag(moves));
+            m_offset = m_size;  // nothing follows the end
+            break;
+        }
+    }
+    m_step += delta;
+    event.step = m_step;
+    return true;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file ReplayPlayer.cpp
+ * @brief Replay playback, seeking and verification
+ */
+
+#include "../include/ReplayPlayer.h"
+#include "../include/Game.h"
+#include "../include/SimulationClock.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// The board is never drawn, so any layout does; only grid slots matter
+constexpr Vector2 CARD_SIZE = {100.0f, 100.0f};
+constexpr float CARD_PADDING = 10.0f;
+
+} // namespace
+
+ReplayPlayer::ReplayPlayer(std::uint64_t keyframeInterval)
+    : m_keyframeInterval(keyframeInterval), m_over(true) {
+}
+
+// === Loading ===
+
+bool ReplayPlayer::load(const unsigned char* data, std::size_t size) {
+    m_board.reset();
+    m_events.clear();
+    m_keyframeCount = 0;
+    m_check = ReplayCheck();
+    m_over = true;
+
+    ReplayReader reader(data, size);
+    ReplayEvent event;
+    while (reader.next(event)) {
+        m_events.push_back(event);
+    }
+    if (!reader.isValid() || reader.hasError() || m_events.empty() ||
+        m_events.back().type != ReplayEventType::END) {
+        return false;
+    }
+
+    m_header = reader.getHeader();
+    m_check.difficulty = m_header.difficulty;
+    m_check.claimedScore = m_events.back().score;
+    m_check.moves = m_events.back().moves;
+    if (getEndStep() > MAX_STEPS) {
+        m_check.verdict = ReplayVerdict::TOO_LONG;
+        return false;
+    }
+
+    restart();
+    if (m_keyframeInterval > 0) {
+        saveKeyframe();
+    }
+    return true;
+}
+
+void ReplayPlayer::restart() {
+    // What Game::startNewGame() sets up
+    const int gridSize = static_cast<int>(std::sqrt(m_header.difficulty));
+    const Rectangle bounds = {0.0f, 0.0f, gridSize * (CARD_SIZE.x + CARD_PADDING), gridSize * (CARD_SIZE.y + CARD_PADDING)};
+    m_board = std::make_unique<GameBoard>(gridSize, gridSize, CARD_SIZE, CARD_PADDING, bounds, m_header.seed, true);
+    m_score.resetScore();
+    m_board->setScoreManager(&m_score);
+    m_board->startShuffle(Game::OPENING_SHUFFLE_SECONDS);
+    m_shuffleCooldown = Game::SHUFFLE_INITIAL_DELAY_SECONDS;
+    m_shufflesUsed = 0;
+    m_flips = 0;
+    m_nextEvent = 0;
+    m_step = 0;
+    m_over = false;
+}
+
+// === Playback ===
+
+bool ReplayPlayer::step() {
+    if (m_over) {
+        return false;
+    }
+    if (m_keyframeInterval > 0 && m_step == m_keyframeCount * m_keyframeInterval) {
+        saveKeyframe();
+    }
+
+    while (m_nextEvent < m_events.size() && m_events[m_nextEvent].step == m_step) {
+        if (!apply(m_events[m_nextEvent++])) {
+            return false;
+        }
+    }
+
+    // Game::stepPlaying()
+    ++m_step;
+    if (m_shuffleCooldown > 0.0f) {
+        m_shuffleCooldown = std::max(0.0f, m_shuffleCooldown - SimulationClock::DEFAULT_STEP);
+    }
+    m_board->update(SimulationClock::DEFAULT_STEP);
+    return true;
+}
+
+bool ReplayPlayer::apply(const ReplayEvent& event) {
+    switch (event.type) {
+        case ReplayEventType::CLICK:
+            if (!m_board->handleClick(m_board->getSlotCenter(event.slot))) {
+                stop(ReplayVerdict::ILLEGAL_INPUT);
+                return false;
+            }
+            ++m_flips;
+            return true;
+
+        case ReplayEventType::HINT: {
+            const int before = m_board->getHintsRemaining();
+            m_board->showHint();
+            if (m_board->getHintsRemaining() == before) {
+                stop(ReplayVerdict::ILLEGAL_INPUT);
+                return false;
+            }
+            return true;
+        }
+
+        case ReplayEventType::SHUFFLE:
+            // Game::canTriggerShuffle(), then Game::triggerShuffle()
+            if (m_board->isShuffling() || m_board->allMatched() || m_board->isHintActive() || m_shuffleCooldown > 0.0f) {
+                stop(ReplayVerdict::ILLEGAL_INPUT);
+                return false;
+            }
+            m_board->startShuffle(Game::RESHUFFLE_SECONDS);
+            if (!m_board->isShuffling()) {
+                stop(ReplayVerdict::ILLEGAL_INPUT);
+                return false;
+            }
+            m_shuffleCooldown = Game::SHUFFLE_COOLDOWN_SECONDS;
+            ++m_shufflesUsed;
+            m_score.addMismatch();
+            return true;
+
+        case ReplayEventType::PAUSE:
+            return true; // no steps ran while paused
+
+        case ReplayEventType::END:
+            judge(event);
+            return false;
+    }
+    return false;
+}
+
+void ReplayPlayer::judge(const ReplayEvent& end) {
+    if (!m_board->allMatched()) {
+        stop(ReplayVerdict::NOT_WON);
+    } else if (m_score.getScore() != end.score || end.moves < m_flips) {
+        stop(ReplayVerdict::SCORE_MISMATCH);
+    } else {
+        stop(ReplayVerdict::VALID);
+    }
+}
+
+void ReplayPlayer::stop(ReplayVerdict verdict) {
+    m_over = true;
+    m_check.verdict = verdict;
+    m_check.score = m_score.getScore();
+    m_check.steps = m_step;
+    m_check.hintsUsed = m_board->getHintsUsed();
+    m_check.shufflesUsed = m_shufflesUsed;
+}
+
+const ReplayCheck& ReplayPlayer::finish() {
+    while (step()) {
+    }
+    return m_check;
+}
+
+ReplayCheck ReplayPlayer::verify(const unsigned char* data, std::size_t size) {
+    ReplayPlayer player(0);
+    player.load(data, size);
+    return player.finish();
+}
+
+// === Seeking ===
+
+void ReplayPlayer::seek(std::uint64_t target) {
+    if (!m_board) {
+        return;
+    }
+    target = std::min(target, getEndStep());
+
+    if (m_keyframeCount > 0) {
+        // The newest keyframe at or before the target, unless playing on from here is shorter
+        const std::size_t index = static_cast<std::size_t>(
+            std::min<std::uint64_t>(target / m_keyframeInterval, m_keyframeCount - 1));
+        if (target < m_step || m_keyframes[index].step > m_step) {
+            restoreKeyframe(m_keyframes[index]);
+        }
+    } else if (target < m_step) {
+        restart();
+    }
+
+    while (m_step < target && step()) {
+    }
+}
+
+void ReplayPlayer::saveKeyframe() {
+    if (m_keyframeCount == m_keyframes.size()) {
+        m_keyframes.emplace_back();
+    }
+    Keyframe& keyframe = m_keyframes[m_keyframeCount++];
+    keyframe.step = m_step;
+    keyframe.nextEvent = m_nextEvent;
+    m_board->saveState(keyframe.board);
+    keyframe.score = m_score;
+    keyframe.shuffleCooldown = m_shuffleCooldown;
+    keyframe.shufflesUsed = m_shufflesUsed;
+    keyframe.flips = m_flips;
+}
+
+void ReplayPlayer::restoreKeyframe(const Keyframe& keyframe) {
+    m_step = keyframe.step;
+    m_nextEvent = keyframe.nextEvent;
+    m_board->restoreState(keyframe.board);
+    m_score = keyframe.score;
+    m_shuffleCooldown = keyframe.shuffleCooldown;
+    m_shufflesUsed = keyframe.shufflesUsed;
+    m_flips = keyframe.flips;
+    m_over = false;
+}
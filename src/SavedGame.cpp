@@ -0,0 +1,398 @@
+/**
+ * @file SavedGame.cpp
+ * @brief Saved game encoding and decoding
+ */
+
+#include "../include/SavedGame.h"
+#include "../include/Replay.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr unsigned char MAGIC[4] = {'M', 'C', 'S', 'V'};
+constexpr unsigned char NO_CARD = 0;        ///< Card references are stored as index + 1
+constexpr unsigned char OFF_GRID = 0xFF;    ///< A point between slots: two floats follow
+constexpr float ON_SLOT_EPSILON = 1e-3f;    ///< In grid units
+
+// Card flags: the state in the low bits, then what else is stored
+constexpr unsigned char CARD_STATE_MASK = 0x07;
+constexpr unsigned char CARD_MOVING = 0x08;
+constexpr unsigned char CARD_PROGRESS = 0x10;
+constexpr unsigned char CARD_PREVIOUS_POSITION = 0x20;
+constexpr unsigned char CARD_PREVIOUS_FLIP = 0x40;
+
+// Board flags
+constexpr unsigned char BOARD_PROCESSING_MATCH = 0x01;
+constexpr unsigned char BOARD_HINT_AUTO_FLIP_BACK = 0x02;
+constexpr unsigned char BOARD_SHUFFLING = 0x04;
+
+// Game flags
+constexpr unsigned char GAME_TIMER_STARTED = 0x01;
+
+/// Flip amount of a card at rest in this state (what a saved previousFlip usually equals)
+float restingFlip(CardState state) {
+    return state == CardState::FACE_UP || state == CardState::MATCHED ? 1.0f : 0.0f;
+}
+
+bool samePoint(Vector2 a, Vector2 b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+class Writer {
+public:
+    Writer(std::vector<unsigned char>& out, int columns, int slots)
+        : m_out(out), m_columns(columns), m_slots(slots) {}
+
+    void byte(unsigned char value) { m_out.push_back(value); }
+
+    void varint(std::uint64_t value) {
+        while (value >= 0x80) {
+            m_out.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        m_out.push_back(static_cast<unsigned char>(value));
+    }
+
+    /// Zigzag, so small negative numbers stay short
+    void number(std::int32_t value) {
+        const std::int64_t wide = value;
+        varint((static_cast<std::uint64_t>(wide) << 1) ^ static_cast<std::uint64_t>(wide >> 63));
+    }
+
+    void u32(std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            m_out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    void real(float value) {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+
+    /// A point in grid units: a slot's index when it is on one
+    void point(Vector2 cell) {
+        const float column = std::round(cell.x);
+        const float row = std::round(cell.y);
+        if (std::fabs(cell.x - column) < ON_SLOT_EPSILON && std::fabs(cell.y - row) < ON_SLOT_EPSILON &&
+            column >= 0.0f && column < m_columns && row >= 0.0f && row * m_columns + column < m_slots) {
+            byte(static_cast<unsigned char>(row * m_columns + column));
+        } else {
+            byte(OFF_GRID);
+            real(cell.x);
+            real(cell.y);
+        }
+    }
+
+private:
+    std::vector<unsigned char>& m_out;
+    int m_columns;
+    int m_slots;
+};
+
+class Reader {
+public:
+    Reader(const unsigned char* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    bool ok() const { return m_ok; }
+    void fail() { m_ok = false; }
+    bool atEnd() const { return m_offset == m_size; }
+    void setGrid(int columns, int slots) {
+        m_columns = columns;
+        m_slots = slots;
+    }
+
+    unsigned char byte() {
+        if (m_offset >= m_size) {
+            m_ok = false;
+            return 0;
+        }
+        return m_data[m_offset++];
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const unsigned char next = byte();
+            value |= static_cast<std::uint64_t>(next & 0x7F) << shift;
+            if ((next & 0x80) == 0) {
+                return value;
+            }
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    /// A varint that has to fit a non-negative int
+    std::int32_t count(std::uint64_t limit = 0x7FFFFFFF) {
+        const std::uint64_t value = varint();
+        if (value > limit) {
+            m_ok = false;
+            return 0;
+        }
+        return static_cast<std::int32_t>(value);
+    }
+
+    std::int32_t number() {
+        const std::uint64_t value = varint();
+        const std::int64_t wide = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        if (wide < INT32_MIN || wide > INT32_MAX) {
+            m_ok = false;
+            return 0;
+        }
+        return static_cast<std::int32_t>(wide);
+    }
+
+    std::uint32_t u32() {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<std::uint32_t>(byte()) << (8 * i);
+        }
+        return value;
+    }
+
+    /// A finite float; timers and positions are never anything else
+    float real() {
+        const std::uint32_t bits = u32();
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            m_ok = false;
+            return 0.0f;
+        }
+        return value;
+    }
+
+    Vector2 point() {
+        const unsigned char slot = byte();
+        if (slot == OFF_GRID) {
+            const float x = real();
+            const float y = real();
+            return {x, y};
+        }
+        if (slot >= m_slots) {
+            m_ok = false;
+            return {};
+        }
+        return {static_cast<float>(slot % m_columns), static_cast<float>(slot / m_columns)};
+    }
+
+    /// A card reference: index + 1, or NO_CARD
+    int card() {
+        const unsigned char value = byte();
+        if (value > m_slots) {
+            m_ok = false;
+        }
+        return value == NO_CARD ? -1 : static_cast<int>(value) - 1;
+    }
+
+    void bytes(std::vector<unsigned char>& out, std::size_t count) {
+        if (count > m_size - m_offset) {
+            m_ok = false;
+            out.clear();
+            return;
+        }
+        out.assign(m_data + m_offset, m_data + m_offset + count);
+        m_offset += count;
+    }
+
+private:
+    const unsigned char* m_data;
+    std::size_t m_size;
+    std::size_t m_offset = 0;
+    int m_columns = 1;
+    int m_slots = 0;
+    bool m_ok = true;
+};
+
+int columnsOf(std::int32_t difficulty) {
+    return static_cast<int>(std::lround(std::sqrt(static_cast<double>(difficulty))));
+}
+
+void writeCard(Writer& out, const Card::LogicState& card) {
+    unsigned char flags = static_cast<unsigned char>(card.state);
+    if (card.isMoving) flags |= CARD_MOVING;
+    if (card.animationProgress != 0.0f) flags |= CARD_PROGRESS;
+    if (!samePoint(card.previousPosition, card.position)) flags |= CARD_PREVIOUS_POSITION;
+    if (card.previousFlip != restingFlip(card.state)) flags |= CARD_PREVIOUS_FLIP;
+
+    out.byte(flags);
+    out.point(card.position);
+    if (flags & CARD_MOVING) {
+        out.point(card.moveStart);
+        out.point(card.moveTarget);
+        out.real(card.moveTimer);
+        out.real(card.moveDuration);
+    }
+    if (flags & CARD_PROGRESS) out.real(card.animationProgress);
+    if (flags & CARD_PREVIOUS_POSITION) out.point(card.previousPosition);
+    if (flags & CARD_PREVIOUS_FLIP) out.real(card.previousFlip);
+}
+
+void readCard(Reader& in, Card::LogicState& card) {
+    const unsigned char flags = in.byte();
+    const unsigned char state = flags & CARD_STATE_MASK;
+    if (state > static_cast<unsigned char>(CardState::MATCHED) || (flags & 0x80)) {
+        in.fail();
+        return;
+    }
+    card.state = static_cast<CardState>(state);
+    card.position = in.point();
+    card.isMoving = (flags & CARD_MOVING) != 0;
+    if (card.isMoving) {
+        card.moveStart = in.point();
+        card.moveTarget = in.point();
+        card.moveTimer = in.real();
+        card.moveDuration = in.real();
+    } else {
+        // Not read until the next moveTo() sets them
+        card.moveStart = card.moveTarget = card.position;
+        card.moveTimer = card.moveDuration = 0.0f;
+    }
+    card.animationProgress = (flags & CARD_PROGRESS) ? in.real() : 0.0f;
+    card.previousPosition = (flags & CARD_PREVIOUS_POSITION) ? in.point() : card.position;
+    card.previousFlip = (flags & CARD_PREVIOUS_FLIP) ? in.real() : restingFlip(card.state);
+    card.scaleX = 1.0f;     // only ever drawn, and recomputed by the next update of a flip
+}
+
+} // namespace
+
+// === Encoding ===
+
+void SavedGame::encode(std::vector<unsigned char>& bytes) const {
+    bytes.clear();
+    const int slots = static_cast<int>(board.cards.size());
+    Writer out(bytes, columnsOf(difficulty), slots);
+
+    bytes.insert(bytes.end(), MAGIC, MAGIC + 4);
+    out.byte(FORMAT_VERSION);
+    out.varint(static_cast<std::uint64_t>(difficulty));
+    out.u32(seed);
+    out.varint(stepsPlayed);
+    out.byte(timerStarted ? GAME_TIMER_STARTED : 0);
+    out.real(elapsedSeconds);
+    out.varint(static_cast<std::uint32_t>(totalMoves));
+    out.varint(static_cast<std::uint32_t>(shufflesUsed));
+    out.real(shuffleCooldown);
+    out.varint(static_cast<std::uint32_t>(scoreMoves));
+    out.varint(static_cast<std::uint32_t>(scoreMatches));
+    out.number(score);
+
+    // The board; its cards come in deal order, so the ids follow from the seed
+    for (const Card::LogicState& card : board.cards) {
+        writeCard(out, card);
+    }
+    for (int card : {board.firstFlipped, board.secondFlipped, board.hintCard1, board.hintCard2}) {
+        out.byte(card < 0 ? NO_CARD : static_cast<unsigned char>(card + 1));
+    }
+    unsigned char flags = 0;
+    if (board.isProcessingMatch) flags |= BOARD_PROCESSING_MATCH;
+    if (board.hintAutoFlipBack) flags |= BOARD_HINT_AUTO_FLIP_BACK;
+    if (board.isShuffling) flags |= BOARD_SHUFFLING;
+    out.byte(flags);
+    out.real(board.flipBackTimer);
+    out.varint(static_cast<std::uint32_t>(board.matchesFound));
+    out.varint(static_cast<std::uint32_t>(board.comboCount));
+    out.real(board.comboDisplayTime);
+    out.varint(static_cast<std::uint32_t>(board.hintsRemaining));
+    out.real(board.hintCooldown);
+    out.real(board.hintDisplayTime);
+    out.varint(board.rngDraws);
+    if (board.isShuffling) {
+        // Order and targets only mean something while a shuffle runs
+        out.real(board.shuffleDuration);
+        out.real(board.shuffleTimer);
+        out.varint(static_cast<std::uint32_t>(board.nextShuffleStartIndex));
+        out.varint(board.shuffleOrder.size());
+        for (int card : board.shuffleOrder) {
+            out.byte(static_cast<unsigned char>(card));
+        }
+        for (Vector2 target : board.shuffleTargets) {
+            out.point(target);
+        }
+    }
+
+    out.varint(replay.size());
+    bytes.insert(bytes.end(), replay.begin(), replay.end());
+}
+
+// === Decoding ===
+
+bool SavedGame::decode(const unsigned char* data, std::size_t size) {
+    if (size < 5 || !std::equal(MAGIC, MAGIC + 4, data) || data[4] != FORMAT_VERSION) {
+        return false;
+    }
+    Reader in(data + 5, size - 5);
+
+    difficulty = in.count();
+    const int slots = ReplayReader::slotCount(difficulty);
+    if (!in.ok() || slots == 0) {
+        return false;
+    }
+    in.setGrid(columnsOf(difficulty), slots);
+    seed = in.u32();
+    stepsPlayed = in.varint();
+    timerStarted = (in.byte() & GAME_TIMER_STARTED) != 0;
+    elapsedSeconds = in.real();
+    totalMoves = in.count();
+    shufflesUsed = in.count();
+    shuffleCooldown = in.real();
+    scoreMoves = in.count();
+    scoreMatches = in.count();
+    score = in.number();
+
+    board.cards.resize(static_cast<std::size_t>(slots));
+    for (Card::LogicState& card : board.cards) {
+        readCard(in, card);
+    }
+    board.firstFlipped = in.card();
+    board.secondFlipped = in.card();
+    board.hintCard1 = in.card();
+    board.hintCard2 = in.card();
+    const unsigned char flags = in.byte();
+    board.isProcessingMatch = (flags & BOARD_PROCESSING_MATCH) != 0;
+    board.hintAutoFlipBack = (flags & BOARD_HINT_AUTO_FLIP_BACK) != 0;
+    board.isShuffling = (flags & BOARD_SHUFFLING) != 0;
+    board.flipBackTimer = in.real();
+    board.matchesFound = in.count(slots / 2);
+    board.comboCount = in.count();
+    board.comboDisplayTime = in.real();
+    board.hintsRemaining = in.count();
+    board.hintCooldown = in.real();
+    board.hintDisplayTime = in.real();
+    board.rngDraws = in.varint();
+    if (board.rngDraws > MAX_RNG_DRAWS) {
+        return false;
+    }
+    board.shuffleOrder.clear();
+    board.shuffleTargets.clear();
+    board.shuffleDuration = 0.0f;
+    board.shuffleTimer = 0.0f;
+    board.nextShuffleStartIndex = 0;
+    if (board.isShuffling) {
+        board.shuffleDuration = in.real();
+        board.shuffleTimer = in.real();
+        board.nextShuffleStartIndex = in.count(static_cast<std::uint64_t>(slots));
+        const std::int32_t order = in.count(static_cast<std::uint64_t>(slots));
+        for (std::int32_t i = 0; i < order && in.ok(); ++i) {
+            const unsigned char card = in.byte();
+            if (card >= slots) {
+                return false;
+            }
+            board.shuffleOrder.push_back(card);
+        }
+        if (board.nextShuffleStartIndex > order) {
+            return false;
+        }
+        for (int i = 0; i < slots && in.ok(); ++i) {
+            board.shuffleTargets.push_back(in.point());
+        }
+    }
+
+    const std::int32_t replaySize = in.count();
+    in.bytes(replay, static_cast<std::size_t>(replaySize));
+    return in.ok() && in.atEnd();
+}
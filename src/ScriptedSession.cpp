@@ -0,0 +1,128 @@
+/**
+ * @file ScriptedSession.cpp
+ * @brief The scripted player of memory_perf
+ */
+
+#include "../include/ScriptedSession.h"
+
+namespace {
+
+// Widget ids Game declares its buttons with
+constexpr int START_GAME_ITEM = 0;  // main menu
+constexpr int HARD_OPTION = 2;      // difficulty screen
+
+bool upAndUnmatched(CardState state) {
+    return state == CardState::FACE_UP || state == CardState::FLIPPING_UP;
+}
+
+} // namespace
+
+ScriptedSession::ScriptedSession(int games)
+    : m_games(games),
+      m_gamesWon(0),
+      m_finished(false),
+      m_released(true),
+      m_wait(CLICK_INTERVAL),
+      m_lastState(GameState::MAIN_MENU)
+{
+}
+
+ScriptedInput ScriptedSession::next(GameState state, const WidgetLayer& widgets, const BoardSnapshot& board,
+                                    float deltaTime) {
+    ScriptedInput input;
+    if (state != m_lastState) {
+        // A new screen: give it a frame to declare its buttons (and the victory a while to show)
+        m_lastState = state;
+        m_wait = CLICK_INTERVAL;
+        if (state == GameState::GAME_OVER) {
+            ++m_gamesWon;
+            m_wait = VICTORY_SECONDS;
+        }
+    }
+
+    // A press is released on the following frame; only then can the next one count
+    if (!m_released) {
+        m_released = true;
+        return input;
+    }
+    m_wait -= deltaTime;
+    if (m_wait > 0.0f || m_finished) {
+        return input;
+    }
+
+    switch (state) {
+        case GameState::MAIN_MENU:
+            if (m_gamesWon >= m_games) {
+                m_finished = true;
+            } else {
+                input = clickWidget(widgets, START_GAME_ITEM);
+            }
+            break;
+        case GameState::DIFFICULTY:
+            input = clickWidget(widgets, HARD_OPTION);
+            break;
+        case GameState::PLAYING:
+            input = clickCard(board);
+            break;
+        case GameState::GAME_OVER:
+            input.type = ScriptedInput::Type::KEY;
+            input.key = m_gamesWon < m_games ? KEY_R : KEY_M;
+            break;
+        case GameState::PAUSED:
+            input.type = ScriptedInput::Type::KEY;
+            input.key = KEY_P;
+            break;
+        case GameState::SETTINGS:
+        case GameState::HIGH_SCORES:
+            input.type = ScriptedInput::Type::KEY;
+            input.key = KEY_ESCAPE;
+            break;
+    }
+
+    if (input.type != ScriptedInput::Type::NONE) {
+        m_released = false;
+        m_wait = CLICK_INTERVAL;
+    }
+    return input;
+}
+
+ScriptedInput ScriptedSession::clickWidget(const WidgetLayer& widgets, int id) const {
+    ScriptedInput input;
+    for (std::size_t i = 0; i < widgets.size(); ++i) {
+        const Widget& widget = widgets.at(i);
+        if (widget.id == id) {
+            input.type = ScriptedInput::Type::CLICK;
+            input.position = {widget.bounds.x + widget.bounds.width / 2.0f, widget.bounds.y + widget.bounds.height / 2.0f};
+            break;
+        }
+    }
+    return input;
+}
+
+ScriptedInput ScriptedSession::clickCard(const BoardSnapshot& board) const {
+    ScriptedInput input;
+    if (board.shuffling) {
+        return input;
+    }
+
+    // The partner of the card that is up, or else the first card down
+    int upId = -1;
+    for (const CardSnapshot& card : board.cards) {
+        if (upAndUnmatched(card.state)) {
+            upId = card.id;
+            break;
+        }
+    }
+    const CardSnapshot* pick = nullptr;
+    for (const CardSnapshot& card : board.cards) {
+        if (card.state == CardState::FACE_DOWN && (upId < 0 || card.id == upId)) {
+            pick = &card;
+            break;
+        }
+    }
+    if (pick) {
+        input.type = ScriptedInput::Type::CLICK;
+        input.position = {pick->position.x + pick->size.x / 2.0f, pick->position.y + pick->size.y / 2.0f};
+    }
+    return input;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file SimulationClock.cpp
+ * @brief Fixed-timestep clock implementation
+ */
+
+#include "../include/SimulationClock.h"
+#include <cmath>
+
+SimulationClock::SimulationClock(float step, int maxStepsPerFrame)
+    : m_step(step > 0.0f ? step : DEFAULT_STEP),
+      m_maxStepsPerFrame(maxStepsPerFrame > 0 ? maxStepsPerFrame : 1),
+      m_accumulator(0.0), m_stepCount(0), m_droppedTime(0.0) {
+}
+
+int SimulationClock::advance(float frameTime) {
+    if (frameTime > 0.0f) {
+        m_accumulator += frameTime;
+    }
+
+    int steps = static_cast<int>(std::floor(m_accumulator / m_step));
+    if (steps > m_maxStepsPerFrame) {
+        // Too far behind (breakpoint, window drag): catch up partially and let the rest go
+        double excess = (steps - m_maxStepsPerFrame) * static_cast<double>(m_step);
+        m_droppedTime += excess;
+        m_accumulator -= excess;
+        steps = m_maxStepsPerFrame;
+    }
+
+    m_accumulator -= steps * static_cast<double>(m_step);
+    m_stepCount += steps;
+    return steps;
+}
+
+void SimulationClock::reset() {
+    m_accumulator = 0.0;
+    m_stepCount = 0;
+    m_droppedTime = 0.0;
+}
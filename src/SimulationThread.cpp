@@ -0,0 +1,97 @@
+/**
+ * @file SimulationThread.cpp
+ * @brief Simulation worker thread implementation
+ */
+
+#include "../include/SimulationThread.h"
+#include <chrono>
+
+SimulationThread::SimulationThread(float step)
+    : m_clock(step) {
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+double SimulationThread::now() {
+    using namespace std::chrono;
+    static const steady_clock::time_point origin = steady_clock::now();
+    return duration<double>(steady_clock::now() - origin).count();
+}
+
+bool SimulationThread::start(InputCallback onInput, StepCallback onStep, PublishCallback onPublish) {
+    if (isRunning()) {
+        return false;
+    }
+    m_onInput = std::move(onInput);
+    m_onStep = std::move(onStep);
+    m_onPublish = std::move(onPublish);
+    m_clock.reset();
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        m_inputs.clear();
+    }
+    m_running = true;
+    m_thread = std::thread(&SimulationThread::run, this);
+    return true;
+}
+
+void SimulationThread::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        m_running = false;
+        m_inputs.clear();
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+unsigned long long SimulationThread::postInput(InputEvent event) {
+    unsigned long long sequence;
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        sequence = m_nextSequence++;
+        event.sequence = sequence;
+        event.time = now();
+        m_inputs.push_back(event);
+    }
+    m_wake.notify_one();
+    return sequence;
+}
+
+void SimulationThread::run() {
+    std::vector<InputEvent> inputs;
+    double last = now();
+    m_onPublish(m_clock);
+
+    while (m_running) {
+        {
+            std::lock_guard<std::mutex> lock(m_inputMutex);
+            inputs.swap(m_inputs);
+        }
+        for (const InputEvent& event : inputs) {
+            m_onInput(event);
+        }
+
+        double current = now();
+        int steps = m_clock.advance(static_cast<float>(current - last));
+        last = current;
+        for (int i = 0; i < steps; ++i) {
+            m_onStep(m_clock.getStep());
+        }
+
+        if (!inputs.empty() || steps > 0) {
+            m_onPublish(m_clock);
+        }
+        inputs.clear();
+
+        // Sleep until the next step is due, or until input arrives
+        auto untilNextStep = std::chrono::duration<double>((1.0f - m_clock.getAlpha()) * m_clock.getStep());
+        std::unique_lock<std::mutex> lock(m_inputMutex);
+        m_wake.wait_for(lock, untilNextStep, [this] { return !m_running || !m_inputs.empty(); });
+    }
+}
@@ -0,0 +1,173 @@
+/**
+ * @file SpectatorHub.cpp
+ * @brief Spectator fan-out implementation
+ */
+
+#include "../include/SpectatorHub.h"
+#include "../include/Utils.h"
+#include <algorithm>
+
+BroadcastBuffer makeBroadcastBuffer(std::string bytes) {
+    return std::make_shared<const std::string>(std::move(bytes));
+}
+
+SpectatorHub::~SpectatorHub() {
+    clear();
+}
+
+void SpectatorHub::addSpectator(SOCKET sock, const BroadcastBuffer& snapshot) {
+    Spectator spectator;
+    spectator.socket = sock;
+    if (snapshot && !snapshot->empty()) {
+        spectator.queue.push_back(snapshot);
+        spectator.queuedBytes = snapshot->size();
+    }
+    m_spectators.push_back(std::move(spectator));
+    Utils::logInfo("Spectator joined (" + Utils::toString(static_cast<int>(m_spectators.size())) + " watching)");
+}
+
+void SpectatorHub::broadcast(const BroadcastBuffer& buffer) {
+    if (!buffer || buffer->empty()) {
+        return;
+    }
+    for (auto& spectator : m_spectators) {
+        enqueue(spectator, buffer);
+    }
+}
+
+void SpectatorHub::enqueue(Spectator& spectator, const BroadcastBuffer& buffer) {
+    if (spectator.closed || spectator.needsSnapshot) {
+        // Deltas are useless until the viewer has caught up with a snapshot
+        return;
+    }
+    if (spectator.queuedBytes + buffer->size() > MAX_BACKLOG_BYTES) {
+        discardBacklog(spectator);
+        return;
+    }
+    spectator.queue.push_back(buffer);
+    spectator.queuedBytes += buffer->size();
+}
+
+void SpectatorHub::discardBacklog(Spectator& spectator) {
+    // A partially written buffer must be completed or the stream would be torn mid-line
+    BroadcastBuffer inFlight;
+    if (spectator.frontOffset > 0 && !spectator.queue.empty()) {
+        inFlight = spectator.queue.front();
+    }
+    spectator.queue.clear();
+    spectator.queuedBytes = 0;
+    if (inFlight) {
+        spectator.queuedBytes = inFlight->size() - spectator.frontOffset;
+        spectator.queue.push_back(std::move(inFlight));
+    } else {
+        spectator.frontOffset = 0;
+    }
+    spectator.needsSnapshot = true;
+    ++m_droppedBacklogs;
+    Utils::logWarning("Spectator fell behind, backlog discarded until next snapshot");
+}
+
+bool SpectatorHub::needsSnapshot() const {
+    for (const auto& spectator : m_spectators) {
+        if (spectator.needsSnapshot && !spectator.closed) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SpectatorHub::resync(const BroadcastBuffer& snapshot) {
+    if (!snapshot || snapshot->empty()) {
+        return;
+    }
+    for (auto& spectator : m_spectators) {
+        if (spectator.needsSnapshot && !spectator.closed) {
+            spectator.queue.push_back(snapshot);
+            spectator.queuedBytes += snapshot->size();
+            spectator.needsSnapshot = false;
+        }
+    }
+}
+
+void SpectatorHub::pump(float deltaTime) {
+    bool anyClosed = false;
+    for (auto& spectator : m_spectators) {
+        pollClosed(spectator);
+        if (!spectator.closed) {
+            writeQueued(spectator, deltaTime);
+        }
+        if (spectator.closed) {
+            // Closed here, while the entry still owns its socket: after
+            // remove_if the tail holds moved-from copies of the survivors
+            CLOSE_SOCKET(spectator.socket);
+            spectator.socket = INVALID_SOCKET;
+            Utils::logInfo("Spectator left");
+            anyClosed = true;
+        }
+    }
+
+    if (anyClosed) {
+        m_spectators.erase(std::remove_if(m_spectators.begin(), m_spectators.end(),
+                                          [](const Spectator& spectator) { return spectator.closed; }),
+                           m_spectators.end());
+    }
+}
+
+void SpectatorHub::writeQueued(Spectator& spectator, float deltaTime) {
+    if (spectator.queue.empty()) {
+        spectator.stallTimer = 0.0f;
+        return;
+    }
+
+    m_scratch.clear();
+    for (size_t i = 0; i < spectator.queue.size(); ++i) {
+        const std::string& bytes = *spectator.queue[i];
+        size_t offset = (i == 0) ? spectator.frontOffset : 0;
+        m_scratch.push_back(ConstBuffer{bytes.data() + offset, bytes.size() - offset});
+    }
+
+    long sent = sendBuffers(spectator.socket, m_scratch.data(), static_cast<int>(m_scratch.size()));
+    if (sent < 0) {
+        spectator.closed = true;
+        return;
+    }
+    if (sent == 0) {
+        spectator.stallTimer += deltaTime;
+        if (spectator.stallTimer >= STALL_TIMEOUT) {
+            Utils::logWarning("Spectator stalled, disconnecting");
+            spectator.closed = true;
+        }
+        return;
+    }
+
+    spectator.stallTimer = 0.0f;
+    spectator.queuedBytes -= static_cast<size_t>(sent);
+    size_t remaining = static_cast<size_t>(sent);
+    while (remaining > 0 && !spectator.queue.empty()) {
+        size_t frontLeft = spectator.queue.front()->size() - spectator.frontOffset;
+        if (remaining < frontLeft) {
+            spectator.frontOffset += remaining;
+            break;
+        }
+        remaining -= frontLeft;
+        spectator.queue.pop_front();
+        spectator.frontOffset = 0;
+    }
+}
+
+void SpectatorHub::pollClosed(Spectator& spectator) {
+    // Spectators are read-only: anything they send is discarded
+    char buffer[256];
+    int received = recv(spectator.socket, buffer, sizeof(buffer), 0);
+    if (received == 0 || (received < 0 && !socketWouldBlock())) {
+        spectator.closed = true;
+    }
+}
+
+void SpectatorHub::clear() {
+    for (auto& spectator : m_spectators) {
+        SHUTDOWN_SOCKET(spectator.socket);
+        CLOSE_SOCKET(spectator.socket);
+    }
+    m_spectators.clear();
+}
@@ -0,0 +1,267 @@
+/**
+ * @file TextLayoutCache.cpp
+ * @brief Glyph run layout and caching
+ */
+
+#include "../include/TextLayoutCache.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+std::size_t runKey(std::string_view text, int fontSize) {
+    std::size_t hash = std::hash<std::string_view>{}(text);
+    return hash ^ (std::hash<int>{}(fontSize) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+}
+
+/**
+ * GetCodepointNext() on text that is not null-terminated: it reads up to
+ * four bytes, so the codepoint's bytes go through a small zero-padded
+ * window rather than a terminated copy of the whole string.
+ */
+int nextCodepoint(std::string_view text, std::size_t offset, int& bytes) {
+    const unsigned char lead = static_cast<unsigned char>(text[offset]);
+    if (lead < 0x80) {
+        bytes = 1;
+        return lead;
+    }
+    char window[5] = {};
+    std::memcpy(window, text.data() + offset, std::min<std::size_t>(4, text.size() - offset));
+    return GetCodepointNext(window, &bytes);
+}
+
+} // namespace
+
+TextLayoutCache::TextLayoutCache(std::size_t maxRuns)
+    : m_maxRuns(std::max<std::size_t>(1, maxRuns)) {
+}
+
+void TextLayoutCache::setFont(const Font& font, float spacingRatio, int minFontSize) {
+    m_font = font;
+    m_spacingRatio = spacingRatio;
+    m_minFontSize = std::max(1, minFontSize);
+
+    // Same fallback as GetGlyphIndex: '?' if the font has it, else glyph 0
+    int fallback = 0;
+    for (int i = 0; i < font.glyphCount; ++i) {
+        if (font.glyphs[i].value == '?') {
+            fallback = i;
+            break;
+        }
+    }
+    m_asciiGlyphs.assign(128, fallback);
+    for (int i = font.glyphCount - 1; i >= 0; --i) {
+        int value = font.glyphs[i].value;
+        if (value >= 0 && value < 128) {
+            m_asciiGlyphs[value] = i;
+        }
+    }
+    allocateStorage();
+    clear();
+}
+
+void TextLayoutCache::allocateStorage() {
+    if (!m_runs.empty()) {
+        return;
+    }
+    m_runs.resize(m_maxRuns);
+    for (TextRun& run : m_runs) {
+        run.text.reserve(RESERVED_GLYPHS);
+        run.quads.reserve(RESERVED_GLYPHS);
+    }
+    m_entries.resize(m_maxRuns);
+    // At most half full, so probe sequences stay short
+    std::size_t slots = 1;
+    while (slots < 2 * m_maxRuns) {
+        slots <<= 1;
+    }
+    m_slots.assign(slots, EMPTY_SLOT);
+}
+
+void TextLayoutCache::clear() {
+    std::fill(m_slots.begin(), m_slots.end(), EMPTY_SLOT);
+    m_count = 0;
+    m_newest = -1;
+    m_oldest = -1;
+}
+
+const TextRun& TextLayoutCache::get(std::string_view text, int fontSize) {
+    allocateStorage();
+    const std::size_t hash = runKey(text, fontSize);
+    int index = findRun(hash, text, fontSize);
+    if (index >= 0) {
+        ++m_hits;
+        if (index != m_newest) {
+            unlink(index);
+            pushNewest(index);
+        }
+        return m_runs[index];
+    }
+
+    ++m_misses;
+    if (m_count < m_maxRuns) {
+        index = static_cast<int>(m_count++);
+    } else {
+        // Full: the least recently used run is laid out again in place
+        index = m_oldest;
+        eraseSlot(index);
+        unlink(index);
+    }
+    layout(m_runs[index], text, fontSize);
+    m_entries[index].hash = hash;
+    insertSlot(index);
+    pushNewest(index);
+    return m_runs[index];
+}
+
+// === Index and recency ===
+
+int TextLayoutCache::findRun(std::size_t hash, std::string_view text, int fontSize) const {
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        const int index = m_slots[slot];
+        if (index == EMPTY_SLOT) {
+            return -1;
+        }
+        const TextRun& run = m_runs[index];
+        if (m_entries[index].hash == hash && run.fontSize == fontSize && run.text == text) {
+            return index;
+        }
+    }
+}
+
+void TextLayoutCache::insertSlot(int run) {
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = m_entries[run].hash & mask;
+    while (m_slots[slot] != EMPTY_SLOT) {
+        slot = (slot + 1) & mask;
+    }
+    m_slots[slot] = run;
+}
+
+void TextLayoutCache::eraseSlot(int run) {
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t hole = m_entries[run].hash & mask;
+    while (m_slots[hole] != run) {
+        hole = (hole + 1) & mask;
+    }
+    m_slots[hole] = EMPTY_SLOT;
+
+    // Backward shift: pull later entries of the cluster into the hole
+    // unless their home slot lies between the hole and where they are
+    for (std::size_t slot = (hole + 1) & mask; m_slots[slot] != EMPTY_SLOT; slot = (slot + 1) & mask) {
+        const std::size_t home = m_entries[m_slots[slot]].hash & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            m_slots[hole] = m_slots[slot];
+            m_slots[slot] = EMPTY_SLOT;
+            hole = slot;
+        }
+    }
+}
+
+void TextLayoutCache::unlink(int run) {
+    Entry& entry = m_entries[run];
+    if (entry.newer >= 0) {
+        m_entries[entry.newer].older = entry.older;
+    } else {
+        m_newest = entry.older;
+    }
+    if (entry.older >= 0) {
+        m_entries[entry.older].newer = entry.newer;
+    } else {
+        m_oldest = entry.newer;
+    }
+    entry.newer = entry.older = -1;
+}
+
+void TextLayoutCache::pushNewest(int run) {
+    Entry& entry = m_entries[run];
+    entry.newer = -1;
+    entry.older = m_newest;
+    if (m_newest >= 0) {
+        m_entries[m_newest].newer = run;
+    }
+    m_newest = run;
+    if (m_oldest < 0) {
+        m_oldest = run;
+    }
+}
+
+// === Layout ===
+
+int TextLayoutCache::glyphIndex(int codepoint) const {
+    if (codepoint >= 0 && codepoint < static_cast<int>(m_asciiGlyphs.size())) {
+        return m_asciiGlyphs[codepoint];
+    }
+    for (int i = 0; i < m_font.glyphCount; ++i) {
+        if (m_font.glyphs[i].value == codepoint) {
+            return i;
+        }
+    }
+    return m_asciiGlyphs.empty() ? 0 : m_asciiGlyphs['?'];
+}
+
+void TextLayoutCache::layout(TextRun& run, std::string_view text, int fontSize) const {
+    run.text.assign(text.data(), text.size());
+    run.fontSize = fontSize;
+    run.width = 0;
+    run.quads.clear();
+    if (m_font.glyphCount <= 0 || m_font.baseSize <= 0 || text.empty()) {
+        return;
+    }
+
+    // Mirrors DrawText(): small sizes are raised to the minimum and the
+    // spacing grows with the size in whole pixels
+    const int size = std::max(fontSize, m_minFontSize);
+    const float spacing = static_cast<float>(static_cast<int>(size * m_spacingRatio));
+    const float scale = static_cast<float>(size) / m_font.baseSize;
+    const float padding = static_cast<float>(m_font.glyphPadding);
+    const float atlasWidth = static_cast<float>(std::max(1, m_font.texture.width));
+    const float atlasHeight = static_cast<float>(std::max(1, m_font.texture.height));
+
+    float penX = 0.0f;
+    float penY = 0.0f;
+    // MeasureText(): widest line in font units, plus spacing between its characters
+    float lineUnits = 0.0f;
+    float widestUnits = 0.0f;
+    int lineChars = 0;
+    int widestChars = 0;
+
+    for (std::size_t i = 0; i < text.size();) {
+        int bytes = 0;
+        int codepoint = nextCodepoint(text, i, bytes);
+        i += static_cast<std::size_t>(std::max(1, bytes));
+        ++lineChars;
+
+        if (codepoint == '\n') {
+            penX = 0.0f;
+            penY += size + size / 2;
+            widestUnits = std::max(widestUnits, lineUnits);
+            lineUnits = 0.0f;
+            lineChars = 0;
+            continue;
+        }
+        widestChars = std::max(widestChars, lineChars);
+
+        const int index = glyphIndex(codepoint);
+        const GlyphInfo& glyph = m_font.glyphs[index];
+        const Rectangle& rec = m_font.recs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            GlyphQuad quad;
+            quad.x = penX + (glyph.offsetX - padding) * scale;
+            quad.y = penY + (glyph.offsetY - padding) * scale;
+            quad.width = (rec.width + 2.0f * padding) * scale;
+            quad.height = (rec.height + 2.0f * padding) * scale;
+            quad.u0 = (rec.x - padding) / atlasWidth;
+            quad.v0 = (rec.y - padding) / atlasHeight;
+            quad.u1 = (rec.x + rec.width + padding) / atlasWidth;
+            quad.v1 = (rec.y + rec.height + padding) / atlasHeight;
+            run.quads.push_back(quad);
+        }
+        penX += (glyph.advanceX != 0 ? glyph.advanceX : rec.width) * scale + spacing;
+        lineUnits += glyph.advanceX != 0 ? glyph.advanceX : rec.width + glyph.offsetX;
+    }
+    widestUnits = std::max(widestUnits, lineUnits);
+    run.width = widestChars > 0 ? static_cast<int>(widestUnits * scale + (widestChars - 1) * spacing) : 0;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file TextRenderer.cpp
+ * @brief Font atlas loading and batched text submission
+ */
+
+#include "../include/TextRenderer.h"
+#include "../include/Utils.h"
+#include <rlgl.h>
+#include <algorithm>
+
+bool TextRenderer::s_loaded = false;
+bool TextRenderer::s_sdf = false;
+Font TextRenderer::s_font{};
+Shader TextRenderer::s_sdfShader{};
+TextLayoutCache TextRenderer::s_cache;
+int TextRenderer::s_batchDepth = 0;
+
+namespace {
+
+// Alpha holds the distance to the glyph outline (0.5 on it); the screen
+// space derivative keeps the edge one pixel wide at any size
+const char* SDF_FS = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+out vec4 finalColor;
+void main() {
+    float distance = texture(texture0, fragTexCoord).a - 0.5;
+    float edge = length(vec2(dFdx(distance), dFdy(distance)));
+    float alpha = smoothstep(-edge, edge, distance);
+    finalColor = vec4(fragColor.rgb, fragColor.a * alpha);
+}
+)";
+
+// DrawText's rules for the default font: at least 10 px, one pixel of
+// spacing per 10 px of size
+constexpr int DEFAULT_FONT_MIN_SIZE = 10;
+constexpr float DEFAULT_FONT_SPACING = 0.1f;
+constexpr float SDF_FONT_SPACING = 0.05f;
+
+} // namespace
+
+// === Resources ===
+
+void TextRenderer::load() {
+    s_loaded = true;
+    s_sdf = loadSdfFont();
+    if (s_sdf) {
+        s_cache.setFont(s_font, SDF_FONT_SPACING, 1);
+        Utils::logInfo("Text: SDF font atlas loaded from " + std::string(FONT_PATH));
+    } else {
+        s_font = GetFontDefault();
+        s_cache.setFont(s_font, DEFAULT_FONT_SPACING, DEFAULT_FONT_MIN_SIZE);
+    }
+}
+
+bool TextRenderer::loadSdfFont() {
+    const int version = rlGetVersion();
+    if (!FileExists(FONT_PATH) || (version != RL_OPENGL_33 && version != RL_OPENGL_43)) {
+        return false;
+    }
+
+    s_sdfShader = LoadShaderFromMemory(nullptr, SDF_FS);
+    if (!IsShaderReady(s_sdfShader)) {
+        Utils::logWarning("SDF text shader failed to build, using the default font");
+        return false;
+    }
+
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(FONT_PATH, &dataSize);
+    Font font{};
+    font.baseSize = SDF_BASE_SIZE;
+    font.glyphCount = SDF_GLYPHS;
+    font.glyphs = data ? LoadFontData(data, dataSize, SDF_BASE_SIZE, nullptr, SDF_GLYPHS, FONT_SDF) : nullptr;
+    UnloadFileData(data);
+    if (!font.glyphs) {
+        UnloadShader(s_sdfShader);
+        s_sdfShader = Shader{};
+        Utils::logWarning("Could not read " + std::string(FONT_PATH) + ", using the default font");
+        return false;
+    }
+
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, SDF_BASE_SIZE, 0, 1);
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    s_font = font;
+    return true;
+}
+
+void TextRenderer::unload() {
+    if (s_sdf) {
+        UnloadFont(s_font);
+        UnloadShader(s_sdfShader);
+    }
+    s_font = Font{};
+    s_sdfShader = Shader{};
+    s_cache.setFont(s_font, 0.0f, 1);
+    s_loaded = false;
+    s_sdf = false;
+    s_batchDepth = 0;
+}
+
+// === Drawing ===
+
+int TextRenderer::measure(std::string_view text, int fontSize) {
+    if (!s_loaded) {
+        load();
+    }
+    return s_cache.get(text, fontSize).width;
+}
+
+void TextRenderer::draw(std::string_view text, int x, int y, int fontSize, Color color) {
+    if (!s_loaded) {
+        load();
+    }
+    const TextRun& run = s_cache.get(text, fontSize);
+    if (run.quads.empty()) {
+        return;
+    }
+
+    const bool switchShader = s_sdf && s_batchDepth == 0;
+    if (switchShader) {
+        BeginShaderMode(s_sdfShader);
+    }
+    submit(run, static_cast<float>(x), static_cast<float>(y), color);
+    if (switchShader) {
+        EndShaderMode();
+    }
+}
+
+void TextRenderer::beginBatch() {
+    if (!s_loaded) {
+        load();
+    }
+    if (s_batchDepth++ == 0 && s_sdf) {
+        BeginShaderMode(s_sdfShader);
+    }
+}
+
+void TextRenderer::endBatch() {
+    if (s_batchDepth == 0) {
+        return;
+    }
+    if (--s_batchDepth == 0 && s_sdf) {
+        EndShaderMode();
+    }
+}
+
+void TextRenderer::submit(const TextRun& run, float x, float y, Color color) {
+    // Same vertex order as DrawTexturePro, but one rlBegin for the whole run
+    rlSetTexture(s_font.texture.id);
+    for (std::size_t first = 0; first < run.quads.size(); first += MAX_QUADS_PER_SUBMIT) {
+        const std::size_t last = std::min(run.quads.size(), first + MAX_QUADS_PER_SUBMIT);
+        rlCheckRenderBatchLimit(static_cast<int>(4 * (last - first)));
+        rlBegin(RL_QUADS);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (std::size_t i = first; i < last; ++i) {
+            const GlyphQuad& quad = run.quads[i];
+            const float left = x + quad.x;
+            const float top = y + quad.y;
+            rlTexCoord2f(quad.u0, quad.v0);
+            rlVertex2f(left, top);
+            rlTexCoord2f(quad.u0, quad.v1);
+            rlVertex2f(left, top + quad.height);
+            rlTexCoord2f(quad.u1, quad.v1);
+            rlVertex2f(left + quad.width, top + quad.height);
+            rlTexCoord2f(quad.u1, quad.v0);
+            rlVertex2f(left + quad.width, top);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
@@ -0,0 +1,120 @@
+/**
+ * @file Transport.cpp
+ * @brief TCP transport implementation
+ */
+
+#include "../include/Transport.h"
+#include "../include/Utils.h"
+
+TcpTransport::TcpTransport(SOCKET sock, bool connected)
+    : m_socket(sock), m_connected(connected) {
+}
+
+TcpTransport::~TcpTransport() {
+    close();
+}
+
+std::unique_ptr<TcpTransport> TcpTransport::connectTo(const std::string& ip, unsigned short port) {
+    SOCKET sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock == INVALID_SOCKET) {
+        Utils::logError("Failed to create client socket");
+        return nullptr;
+    }
+
+    setSocketNonBlocking(sock);
+
+    sockaddr_in serverAddr{};
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(port);
+
+#ifdef _WIN32
+    if (inet_pton(AF_INET, ip.c_str(), &serverAddr.sin_addr) <= 0) {
+#else
+    if (inet_aton(ip.c_str(), &serverAddr.sin_addr) == 0) {
+#endif
+        Utils::logError("Invalid IP address: " + ip);
+        CLOSE_SOCKET(sock);
+        return nullptr;
+    }
+
+    // Non-blocking connect: completion is detected by poll()
+    int result = connect(sock, (sockaddr*)&serverAddr, sizeof(serverAddr));
+#ifdef _WIN32
+    bool inProgress = (result == SOCKET_ERROR) && socketWouldBlock();
+#else
+    bool inProgress = (result == SOCKET_ERROR) && errno == EINPROGRESS;
+#endif
+    if (result == SOCKET_ERROR && !inProgress) {
+        Utils::logError("Failed to connect to server");
+        CLOSE_SOCKET(sock);
+        return nullptr;
+    }
+
+    return std::make_unique<TcpTransport>(sock, result != SOCKET_ERROR);
+}
+
+bool TcpTransport::poll() {
+    if (m_connected || m_socket == INVALID_SOCKET) {
+        return m_connected;
+    }
+
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    FD_SET(m_socket, &writeSet);
+    timeval timeout{0, 0};
+
+    if (select((int)m_socket + 1, nullptr, &writeSet, nullptr, &timeout) > 0) {
+        int error = 0;
+        socklen_t len = sizeof(error);
+        if (getsockopt(m_socket, SOL_SOCKET, SO_ERROR, (char*)&error, &len) == 0 && error == 0) {
+            m_connected = true;
+        } else {
+            close(); // refused or unreachable
+        }
+    }
+    return m_connected;
+}
+
+long TcpTransport::send(const char* data, size_t size) {
+    if (!m_connected) {
+        return m_socket == INVALID_SOCKET ? -1 : 0;
+    }
+    ConstBuffer buffer{data, size};
+    long sent = sendBuffers(m_socket, &buffer, 1);
+    if (sent < 0) {
+        close();
+    }
+    return sent;
+}
+
+long TcpTransport::receive(char* buffer, size_t size) {
+    if (!m_connected) {
+        return m_socket == INVALID_SOCKET ? -1 : 0;
+    }
+    int received = recv(m_socket, buffer, (int)size, 0);
+    if (received > 0) {
+        return received;
+    }
+    if (received < 0 && socketWouldBlock()) {
+        return 0;
+    }
+    // Orderly shutdown by the peer or a hard error
+    close();
+    return -1;
+}
+
+void TcpTransport::close() {
+    if (m_socket != INVALID_SOCKET) {
+        SHUTDOWN_SOCKET(m_socket);
+        CLOSE_SOCKET(m_socket);
+        m_socket = INVALID_SOCKET;
+    }
+    m_connected = false;
+}
+
+SOCKET TcpTransport::releaseSocket() {
+    SOCKET sock = m_socket;
+    m_socket = INVALID_SOCKET;
+    m_connected = false;
+    return sock;
+}
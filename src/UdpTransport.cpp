@@ -0,0 +1,319 @@
+/**
+ * @file UdpTransport.cpp
+ * @brief UDP transport and listener implementation
+ */
+
+#include "../include/UdpTransport.h"
+#include "../include/Utils.h"
+#include <algorithm>
+
+namespace {
+
+bool sameAddress(const sockaddr_in& a, const sockaddr_in& b) {
+    return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
+}
+
+// Reads one datagram; false when nothing is waiting (or on error)
+bool receiveDatagram(SOCKET sock, std::string& datagram, sockaddr_in& from) {
+    char buffer[UdpTransport::MAX_DATAGRAM];
+    socklen_t fromLength = sizeof(from);
+    int received = recvfrom(sock, buffer, (int)sizeof(buffer), 0, (sockaddr*)&from, &fromLength);
+    if (received <= 0) {
+        // Would block, or an ICMP error reported on a UDP socket: both mean "nothing to read"
+        return false;
+    }
+    datagram.assign(buffer, received);
+    return true;
+}
+
+} // namespace
+
+// === UdpTransport ===
+
+UdpTransport::UdpTransport(std::shared_ptr<SharedSocket> sock, const sockaddr_in& peer,
+                           std::shared_ptr<Inbox> inbox, State state)
+    : m_socket(std::move(sock)), m_peer(peer), m_inbox(std::move(inbox)),
+      m_state(state), m_connectTimer(0.0f), m_connectRetryTimer(0.0f) {
+}
+
+UdpTransport::~UdpTransport() {
+    close();
+}
+
+std::unique_ptr<UdpTransport> UdpTransport::connectTo(const std::string& ip, unsigned short port,
+                                                      std::shared_ptr<bool> unanswered) {
+    sockaddr_in serverAddr{};
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(port);
+#ifdef _WIN32
+    if (inet_pton(AF_INET, ip.c_str(), &serverAddr.sin_addr) <= 0) {
+#else
+    if (inet_aton(ip.c_str(), &serverAddr.sin_addr) == 0) {
+#endif
+        Utils::logError("Invalid IP address: " + ip);
+        return nullptr;
+    }
+
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock == INVALID_SOCKET) {
+        Utils::logError("Failed to create UDP socket");
+        return nullptr;
+    }
+    setSocketNonBlocking(sock);
+
+    std::unique_ptr<UdpTransport> transport(new UdpTransport(
+        std::make_shared<SharedSocket>(sock), serverAddr, nullptr, State::CONNECTING));
+    transport->m_unanswered = std::move(unanswered);
+    transport->sendControl(PacketType::CONNECT);
+    return transport;
+}
+
+bool UdpTransport::poll() {
+    return m_state == State::CONNECTED;
+}
+
+long UdpTransport::send(const char* data, size_t size) {
+    if (m_state != State::CONNECTED) {
+        return m_state == State::CLOSED ? -1 : 0;
+    }
+    size_t accepted = m_channel.send(data, size);
+    m_channel.flush(m_packets);
+    transmitPackets();
+    return static_cast<long>(accepted);
+}
+
+long UdpTransport::receive(char* buffer, size_t size) {
+    long received = static_cast<long>(m_channel.read(buffer, size));
+    if (received == 0 && m_state == State::CLOSED) {
+        return -1;
+    }
+    return received;
+}
+
+bool UdpTransport::sendPresence(const std::string& payload) {
+    if (m_state != State::CONNECTED) {
+        return false;
+    }
+    m_channel.sendPresence(payload);
+    m_channel.flush(m_packets);
+    transmitPackets();
+    return true;
+}
+
+bool UdpTransport::receivePresence(std::string& payload) {
+    return m_channel.takePresence(payload);
+}
+
+void UdpTransport::close() {
+    if (m_state != State::CLOSED) {
+        sendControl(PacketType::DISCONNECT);
+        m_state = State::CLOSED;
+    }
+    m_inbox.reset();
+    m_socket.reset();
+}
+
+void UdpTransport::pump(float deltaTime) {
+    if (m_state == State::CLOSED) {
+        return;
+    }
+
+    std::string datagram;
+    while (m_state != State::CLOSED && nextDatagram(datagram)) {
+        handleDatagram(datagram);
+    }
+
+    if (m_state == State::CONNECTING) {
+        m_connectTimer += deltaTime;
+        m_connectRetryTimer += deltaTime;
+        if (m_connectTimer >= CONNECT_TIMEOUT) {
+            Utils::logWarning("No UDP answer from server");
+            if (m_unanswered) {
+                *m_unanswered = true;
+            }
+            close();
+        } else if (m_connectRetryTimer >= CONNECT_RETRY_INTERVAL) {
+            m_connectRetryTimer = 0.0f;
+            sendControl(PacketType::CONNECT);
+        }
+        return;
+    }
+
+    if (m_state == State::CONNECTED) {
+        m_channel.update(deltaTime, m_packets);
+        transmitPackets();
+        if (m_channel.getTimeSinceReceive() >= PEER_TIMEOUT) {
+            Utils::logWarning("UDP peer timed out");
+            close();
+        }
+    }
+}
+
+bool UdpTransport::nextDatagram(std::string& datagram) {
+    if (m_inbox) {
+        if (m_inbox->empty()) {
+            return false;
+        }
+        datagram = std::move(m_inbox->front());
+        m_inbox->pop_front();
+        return true;
+    }
+
+    sockaddr_in from{};
+    while (m_socket && receiveDatagram(m_socket->sock, datagram, from)) {
+        if (sameAddress(from, m_peer)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UdpTransport::handleDatagram(const std::string& datagram) {
+    PacketType type;
+    if (!ReliableChannel::readPacketType(datagram.data(), datagram.size(), type)) {
+        return;
+    }
+
+    switch (type) {
+    case PacketType::CONNECT:
+        // Server side: the client missed our ACCEPT
+        if (m_inbox) {
+            sendControl(PacketType::ACCEPT);
+        }
+        break;
+    case PacketType::ACCEPT:
+        if (m_state == State::CONNECTING) {
+            m_state = State::CONNECTED;
+        }
+        break;
+    case PacketType::DISCONNECT:
+        m_state = State::CLOSED;
+        break;
+    case PacketType::DATA:
+    case PacketType::PRESENCE:
+        // Data before ACCEPT means ACCEPT was lost on the way
+        if (m_state == State::CONNECTING) {
+            m_state = State::CONNECTED;
+        }
+        m_channel.receivePacket(datagram.data(), datagram.size());
+        break;
+    }
+}
+
+void UdpTransport::sendControl(PacketType type) {
+    std::string packet;
+    ReliableChannel::writeControlPacket(type, packet);
+    m_packets.push_back(std::move(packet));
+    transmitPackets();
+}
+
+void UdpTransport::transmitPackets() {
+    if (m_socket) {
+        for (const std::string& packet : m_packets) {
+            // Lost datagrams are the reliability layer's problem, so errors are ignored
+            sendto(m_socket->sock, packet.data(), (int)packet.size(), 0,
+                   (const sockaddr*)&m_peer, sizeof(m_peer));
+        }
+    }
+    m_packets.clear();
+}
+
+// === UdpListener ===
+
+UdpListener::~UdpListener() {
+    close();
+}
+
+bool UdpListener::open(unsigned short port) {
+    close();
+
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock == INVALID_SOCKET) {
+        Utils::logError("Failed to create UDP socket");
+        return false;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+    if (bind(sock, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR) {
+        Utils::logError("Failed to bind UDP port " + std::to_string(port));
+        CLOSE_SOCKET(sock);
+        return false;
+    }
+
+    setSocketNonBlocking(sock);
+    m_socket = std::make_shared<UdpTransport::SharedSocket>(sock);
+    return true;
+}
+
+void UdpListener::close() {
+    m_accepted.clear();
+    m_peers.clear();
+    m_socket.reset();
+}
+
+unsigned short UdpListener::getPort() const {
+    if (!m_socket) {
+        return 0;
+    }
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    if (getsockname(m_socket->sock, (sockaddr*)&address, &length) == SOCKET_ERROR) {
+        return 0;
+    }
+    return ntohs(address.sin_port);
+}
+
+std::unique_ptr<Transport> UdpListener::accept() {
+    receiveAll();
+    if (m_accepted.empty()) {
+        return nullptr;
+    }
+    std::unique_ptr<Transport> transport = std::move(m_accepted.front());
+    m_accepted.pop_front();
+    return transport;
+}
+
+void UdpListener::receiveAll() {
+    if (!m_socket) {
+        return;
+    }
+
+    // Forget peers whose transport has been destroyed or closed
+    m_peers.erase(std::remove_if(m_peers.begin(), m_peers.end(),
+                                 [](const Peer& peer) { return peer.inbox.expired(); }),
+                  m_peers.end());
+
+    std::string datagram;
+    sockaddr_in from{};
+    while (receiveDatagram(m_socket->sock, datagram, from)) {
+        PacketType type;
+        if (!ReliableChannel::readPacketType(datagram.data(), datagram.size(), type)) {
+            continue;
+        }
+
+        auto peer = std::find_if(m_peers.begin(), m_peers.end(),
+                                 [&](const Peer& p) { return sameAddress(p.address, from); });
+        if (peer != m_peers.end()) {
+            if (auto inbox = peer->inbox.lock()) {
+                if (inbox->size() < MAX_INBOX) {
+                    inbox->push_back(std::move(datagram));
+                }
+                continue;
+            }
+        }
+
+        if (type != PacketType::CONNECT) {
+            continue; // Stray packet from a peer we no longer know
+        }
+
+        auto inbox = std::make_shared<UdpTransport::Inbox>();
+        std::unique_ptr<UdpTransport> transport(new UdpTransport(
+            m_socket, from, inbox, UdpTransport::State::CONNECTED));
+        transport->sendControl(PacketType::ACCEPT);
+        m_peers.push_back(Peer{from, inbox});
+        m_accepted.push_back(std::move(transport));
+    }
+}
@@ -1,4 +1,5 @@
 #include "../include/Utils.h"
+#include "../include/Format.h"
 
 // Initialize static members
 std::mt19937 Utils::s_rng;
@@ -7,21 +8,23 @@ std::chrono::high_resolution_clock::time_point Utils::s_startTime;
 bool Utils::s_startTimeInitialized = false;
 
 // === Logging ===
-void Utils::logInfo(const std::string& message) {
+void Utils::logInfo(std::string_view message) {
     std::cout << "[INFO] " << message << std::endl;
 }
 
-void Utils::logWarning(const std::string& message) {
+void Utils::logWarning(std::string_view message) {
     std::cout << "[WARNING] " << message << std::endl;
 }
 
-void Utils::logError(const std::string& message) {
+void Utils::logError(std::string_view message) {
     std::cerr << "[ERROR] " << message << std::endl;
 }
 
-void Utils::logDebug(const std::string& message) {
+void Utils::logDebug(std::string_view message) {
 #ifdef DEBUG
     std::cout << "[DEBUG] " << message << std::endl;
+#else
+    (void)message;
 #endif
 }
 
@@ -84,23 +87,20 @@ Vector2 Utils::vector2Scale(Vector2 vector, float scalar) {
 }
 
 // === String ===
+// Formatted on the stack by Format; short results fit the string's own buffer
 std::string Utils::toString(int value) {
-    return std::to_string(value);
+    char text[Format::INTEGER_CHARS];
+    return std::string(text, Format::integer(text, sizeof(text), static_cast<long long>(value)));
 }
 
 std::string Utils::toString(float value, int precision) {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(precision) << value;
-    return oss.str();
+    char text[Format::DECIMAL_CHARS];
+    return std::string(text, Format::decimal(text, sizeof(text), value, precision));
 }
 
 std::string Utils::formatTime(float seconds) {
-    int mins = static_cast<int>(seconds) / 60;
-    int secs = static_cast<int>(seconds) % 60;
-    std::ostringstream oss;
-    oss << (mins < 10 ? "0" : "") << mins << ":"
-        << (secs < 10 ? "0" : "") << secs;
-    return oss.str();
+    char text[Format::CLOCK_CHARS];
+    return std::string(text, Format::clock(text, sizeof(text), seconds));
 }
 
 std::string Utils::toUpper(const std::string& str) {
@@ -0,0 +1,154 @@
+/**
+ * @file WidgetLayer.cpp
+ * @brief Widget arena, input pass and button drawing
+ */
+
+#include "../include/WidgetLayer.h"
+#include "../include/TextRenderer.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+int scaledPixels(float designPixels, float scale) {
+    return std::max(1, static_cast<int>(std::lround(designPixels * scale)));
+}
+
+} // namespace
+
+WidgetInput WidgetInput::poll() {
+    WidgetInput input;
+    input.mouse = GetMousePosition();
+    Vector2 delta = GetMouseDelta();
+    input.mouseMoved = delta.x != 0.0f || delta.y != 0.0f;
+    input.clicked = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+    if (IsKeyPressed(KEY_DOWN)) {
+        input.navigate = 1;
+    } else if (IsKeyPressed(KEY_UP)) {
+        input.navigate = -1;
+    }
+    input.activate = IsKeyPressed(KEY_ENTER);
+    return input;
+}
+
+// === Declaration ===
+
+void WidgetLayer::begin(int screen) {
+    if (screen != m_screen) {
+        m_screen = screen;
+        m_focus = -1;
+        m_hoverPending = true;
+    }
+    m_count = 0;
+}
+
+void WidgetLayer::button(int id, Rectangle bounds, std::string_view label, Color color) {
+    if (m_count == m_widgets.size()) {
+        m_widgets.emplace_back();
+    }
+    Widget& widget = m_widgets[m_count++];
+    widget.id = id;
+    widget.bounds = bounds;
+    widget.label.assign(label.data(), label.size());    // reuses the string's buffer
+    widget.color = color;
+}
+
+// === Input ===
+
+int WidgetLayer::widgetAt(Vector2 point) const {
+    for (std::size_t i = 0; i < m_count; ++i) {
+        const Rectangle& r = m_widgets[i].bounds;
+        if (point.x >= r.x && point.x <= r.x + r.width && point.y >= r.y && point.y <= r.y + r.height) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int WidgetLayer::update(int screen, const WidgetInput& input) {
+    if (screen != m_screen || m_count == 0) {
+        return -1;
+    }
+    const int count = static_cast<int>(m_count);
+    if (m_focus >= count) {
+        m_focus = -1;
+    }
+
+    // The mouse takes focus when it moves (or clicks); a still mouse leaves
+    // keyboard focus alone
+    const int hovered = widgetAt(input.mouse);
+    if (input.mouseMoved || input.clicked || m_hoverPending) {
+        m_focus = hovered;
+        m_hoverPending = false;
+    }
+
+    if (input.navigate != 0) {
+        if (m_focus < 0) {
+            m_focus = input.navigate > 0 ? 0 : count - 1;
+        } else {
+            m_focus = (m_focus + input.navigate + count) % count;
+        }
+    }
+
+    if (input.clicked && hovered >= 0) {
+        return m_widgets[hovered].id;
+    }
+    if (input.activate && m_focus >= 0) {
+        return m_widgets[m_focus].id;
+    }
+    return -1;
+}
+
+int WidgetLayer::getFocused() const {
+    return (m_focus >= 0 && m_focus < static_cast<int>(m_count)) ? m_widgets[m_focus].id : -1;
+}
+
+// === Drawing ===
+
+void WidgetLayer::draw(float scale) const {
+    for (std::size_t i = 0; i < m_count; ++i) {
+        const Widget& widget = m_widgets[i];
+        drawButton(widget.label, widget.bounds, static_cast<int>(i) == m_focus, widget.color, scale);
+    }
+}
+
+void WidgetLayer::drawButton(std::string_view label, Rectangle bounds, bool highlighted, Color color, float scale) {
+    // Button animation
+    float grow = highlighted ? 1.05f : 1.0f;
+    Rectangle animBounds = {
+        bounds.x - (bounds.width * grow - bounds.width) / 2,
+        bounds.y - (bounds.height * grow - bounds.height) / 2,
+        bounds.width * grow,
+        bounds.height * grow
+    };
+
+    // Shadow
+    float shadow = 6 * scale;
+    DrawRectangleRounded({animBounds.x + shadow, animBounds.y + shadow, animBounds.width, animBounds.height},
+                         0.2f, 16, ColorAlpha(BLACK, 0.5f));
+
+    // Button background with gradient effect
+    Color bgColor = highlighted ? Utils::adjustBrightness(color, 1.3f) : color;
+    DrawRectangleRounded(animBounds, 0.2f, 16, bgColor);
+
+    // Glow effect for the highlighted button
+    if (highlighted) {
+        Utils::drawRoundedRectangleLines(animBounds, 0.2f, 16, 3 * scale, GOLD);
+        Rectangle outerBounds = {animBounds.x - 2 * scale, animBounds.y - 2 * scale,
+                                 animBounds.width + 4 * scale, animBounds.height + 4 * scale};
+        Utils::drawRoundedRectangleLines(outerBounds, 0.2f, 16, scale, ColorAlpha(GOLD, 0.5f));
+    } else {
+        Utils::drawRoundedRectangleLines(animBounds, 0.2f, 16, 2 * scale, Utils::adjustBrightness(color, 1.5f));
+    }
+
+    // Text with shadow
+    int textSize = scaledPixels(24, scale);
+    int textWidth = TextRenderer::measure(label, textSize);
+    int textX = static_cast<int>(animBounds.x + (animBounds.width - textWidth) / 2);
+    int textY = static_cast<int>(animBounds.y + (animBounds.height - textSize) / 2);
+    int textShadow = scaledPixels(2, scale);
+
+    TextRenderer::draw(label, textX + textShadow, textY + textShadow, textSize, ColorAlpha(BLACK, 0.6f));
+    TextRenderer::draw(label, textX, textY, textSize, highlighted ? GOLD : WHITE);
+}
@@ -1,512 +1,216 @@
-git /**
+/**
  * @file main.cpp
  * @brief Entry point for the single player Memory Card Flip Game.
  */
 
 #include <raylib.h>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <string>
-#include <sstream>
-#include <thread>
-#include <atomic>
-#include <mutex>
-#include <vector>
-
-// Platform-specific socket includes
-#ifdef _WIN32
-    #include <winsock2.h>
-    #include <ws2tcpip.h>
-    #pragma comment(lib, "ws2_32.lib")
-    typedef int socklen_t;
-    #define SOCKET_ERROR_CODE WSAGetLastError()
-    #define CLOSE_SOCKET closesocket
-    #define SHUTDOWN_SOCKET(s) shutdown(s, SD_BOTH)
-#else
-    #include <sys/socket.h>
-    #include <netinet/in.h>
-    #include <arpa/inet.h>
-    #include <unistd.h>
-    #include <fcntl.h>
-    typedef int SOCKET;
-    #define INVALID_SOCKET -1
-    #define SOCKET_ERROR -1
-    #define SOCKET_ERROR_CODE errno
-    #define CLOSE_SOCKET close
-    #define SHUTDOWN_SOCKET(s) shutdown(s, SHUT_RDWR)
-#endif
 
+#include "AllocationTracker.h"
+#include "FramePacer.h"
 #include "Game.h"
+#include "IdleTracker.h"
+#include "LayoutTree.h"
+#include "NetworkSession.h"
+#include "TextRenderer.h"
 #include "Utils.h"
+#include <rlgl.h>
 
 constexpr int SCREEN_WIDTH = 1024;
 constexpr int SCREEN_HEIGHT = 768;
+constexpr int MIN_WINDOW_WIDTH = 320;
+constexpr int MIN_WINDOW_HEIGHT = 240;
 constexpr int TARGET_FPS = 60;
 constexpr const char* WINDOW_TITLE = "Memory Card Flip Game - MSTC DA-IICT";
 constexpr unsigned short DEFAULT_PORT = 5000;
 
 // ==================== Networking State ====================
-enum class NetworkMode {
-    NONE,
-    SERVER,
-    CLIENT
-};
-
-struct NetworkState {
-    NetworkMode mode = NetworkMode::NONE;
-    SOCKET serverSocket = INVALID_SOCKET;
-    SOCKET clientSocket = INVALID_SOCKET;
-    std::atomic<bool> connected{false};
-    std::atomic<bool> shouldStop{false};
-    std::mutex messageMutex;
-    std::vector<std::string> incomingMessages;
-    std::string remoteIP = "127.0.0.1";
-    unsigned short port = DEFAULT_PORT;
-    int myPlayerID = 0;  // 0 = server, 1 = client
-    int currentTurn = 0;  // Whose turn it is
-    int playerScores[2] = {0, 0};
-    bool isMyTurn = true;
-};
-
-static NetworkState g_network;
-
-// ==================== Network Functions ====================
-
-void initNetwork() {
-#ifdef _WIN32
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        Utils::logError("WSAStartup failed");
-    }
-#endif
-}
-
-void cleanupNetwork() {
-#ifdef _WIN32
-    WSACleanup();
-#endif
-}
-
-void setSocketNonBlocking(SOCKET sock) {
-#ifdef _WIN32
-    u_long mode = 1;
-    ioctlsocket(sock, FIONBIO, &mode);
-#else
-    int flags = fcntl(sock, F_GETFL, 0);
-    fcntl(sock, F_SETFL, flags | O_NONBLOCK);
-#endif
-}
-
-void startServer(unsigned short port) {
-    if (g_network.mode != NetworkMode::NONE) {
-        Utils::logError("Already in network mode!");
-        return;
-    }
-
-    initNetwork();
-    
-    g_network.serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-    if (g_network.serverSocket == INVALID_SOCKET) {
-        Utils::logError("Failed to create server socket");
-        return;
-    }
-
-    // Set socket options
-    int opt = 1;
-#ifdef _WIN32
-    setsockopt(g_network.serverSocket, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
-#else
-    setsockopt(g_network.serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-#endif
-
-    sockaddr_in serverAddr{};
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_addr.s_addr = INADDR_ANY;
-    serverAddr.sin_port = htons(port);
-
-    if (bind(g_network.serverSocket, (sockaddr*)&serverAddr, sizeof(serverAddr)) == SOCKET_ERROR) {
-        Utils::logError("Failed to bind server socket on port " + std::to_string(port));
-        CLOSE_SOCKET(g_network.serverSocket);
-        g_network.serverSocket = INVALID_SOCKET;
-        return;
-    }
-
-    if (listen(g_network.serverSocket, 1) == SOCKET_ERROR) {
-        Utils::logError("Failed to listen on server socket");
-        CLOSE_SOCKET(g_network.serverSocket);
-        g_network.serverSocket = INVALID_SOCKET;
-        return;
-    }
-
-    setSocketNonBlocking(g_network.serverSocket);
-    
-    g_network.mode = NetworkMode::SERVER;
-    g_network.port = port;
-    g_network.myPlayerID = 0;
-    g_network.currentTurn = 0;
-    g_network.isMyTurn = true;
-    
-    Utils::logInfo("Server started on port " + std::to_string(port) + ". Waiting for client...");
-}
-
-void startClient(const std::string& ip, unsigned short port) {
-    if (g_network.mode != NetworkMode::NONE) {
-        Utils::logError("Already in network mode!");
-        return;
-    }
-
-    initNetwork();
-    
-    g_network.clientSocket = socket(AF_INET, SOCK_STREAM, 0);
-    if (g_network.clientSocket == INVALID_SOCKET) {
-        Utils::logError("Failed to create client socket");
-        return;
-    }
-
-    setSocketNonBlocking(g_network.clientSocket);
-
-    sockaddr_in serverAddr{};
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_port = htons(port);
-    
-#ifdef _WIN32
-    if (inet_pton(AF_INET, ip.c_str(), &serverAddr.sin_addr) <= 0) {
-        Utils::logError("Invalid IP address: " + ip);
-        CLOSE_SOCKET(g_network.clientSocket);
-        g_network.clientSocket = INVALID_SOCKET;
-        return;
-    }
-#else
-    if (inet_aton(ip.c_str(), &serverAddr.sin_addr) == 0) {
-        Utils::logError("Invalid IP address: " + ip);
-        CLOSE_SOCKET(g_network.clientSocket);
-        g_network.clientSocket = INVALID_SOCKET;
-        return;
-    }
-#endif
-
-    // Try to connect (non-blocking)
-    int result = connect(g_network.clientSocket, (sockaddr*)&serverAddr, sizeof(serverAddr));
-    
-#ifdef _WIN32
-    if (result == SOCKET_ERROR) {
-        int error = WSAGetLastError();
-        if (error != WSAEWOULDBLOCK && error != WSAEINPROGRESS) {
-            Utils::logError("Failed to connect to server");
-            CLOSE_SOCKET(g_network.clientSocket);
-            g_network.clientSocket = INVALID_SOCKET;
-            return;
-        }
-    }
-#else
-    if (result == SOCKET_ERROR && errno != EINPROGRESS) {
-        Utils::logError("Failed to connect to server");
-        CLOSE_SOCKET(g_network.clientSocket);
-        g_network.clientSocket = INVALID_SOCKET;
-        return;
-    }
-#endif
-
-    g_network.mode = NetworkMode::CLIENT;
-    g_network.remoteIP = ip;
-    g_network.port = port;
-    g_network.myPlayerID = 1;
-    g_network.currentTurn = 0;
-    g_network.isMyTurn = false;
-    
-    Utils::logInfo("Connecting to server at " + ip + ":" + std::to_string(port) + "...");
-}
-
-void stopNetwork() {
-    g_network.shouldStop = true;
-    
-    if (g_network.clientSocket != INVALID_SOCKET) {
-        SHUTDOWN_SOCKET(g_network.clientSocket);
-        CLOSE_SOCKET(g_network.clientSocket);
-        g_network.clientSocket = INVALID_SOCKET;
-    }
-    
-    if (g_network.serverSocket != INVALID_SOCKET) {
-        SHUTDOWN_SOCKET(g_network.serverSocket);
-        CLOSE_SOCKET(g_network.serverSocket);
-        g_network.serverSocket = INVALID_SOCKET;
-    }
-    
-    g_network.mode = NetworkMode::NONE;
-    g_network.connected = false;
-    g_network.isMyTurn = true;
-    
-    cleanupNetwork();
-    Utils::logInfo("Network stopped");
-}
-
-void sendMessage(const std::string& message) {
-    SOCKET sock = INVALID_SOCKET;
-    if (g_network.mode == NetworkMode::SERVER && g_network.connected) {
-        sock = g_network.clientSocket;
-    } else if (g_network.mode == NetworkMode::CLIENT && g_network.connected) {
-        sock = g_network.clientSocket;
-    }
-    
-    if (sock == INVALID_SOCKET) return;
-    
-    std::string msgWithNewline = message + "\n";
-    int sent = send(sock, msgWithNewline.c_str(), (int)msgWithNewline.length(), 0);
-    if (sent == SOCKET_ERROR) {
-        int error = SOCKET_ERROR_CODE;
-#ifdef _WIN32
-        if (error != WSAEWOULDBLOCK) {
-#else
-        if (error != EAGAIN && error != EWOULDBLOCK) {
-#endif
-            Utils::logError("Send failed, disconnecting");
-            g_network.connected = false;
-        }
-    }
-}
-
-void sendGameState() {
-    // Send current game state
-    // Format: "STATE turn:0 score0:10 score1:5"
-    std::stringstream ss;
-    ss << "STATE turn:" << g_network.currentTurn 
-       << " score0:" << g_network.playerScores[0]
-       << " score1:" << g_network.playerScores[1];
-    sendMessage(ss.str());
-}
-
-void receiveGameState() {
-    SOCKET sock = INVALID_SOCKET;
-    if (g_network.mode == NetworkMode::SERVER && g_network.connected) {
-        sock = g_network.clientSocket;
-    } else if (g_network.mode == NetworkMode::CLIENT && g_network.connected) {
-        sock = g_network.clientSocket;
-    }
-    
-    if (sock == INVALID_SOCKET) return;
-    
-    char buffer[1024];
-    int received = recv(sock, buffer, sizeof(buffer) - 1, 0);
-    
-    if (received > 0) {
-        buffer[received] = '\0';
-        std::string message(buffer);
-        
-        std::lock_guard<std::mutex> lock(g_network.messageMutex);
-        g_network.incomingMessages.push_back(message);
-    } else if (received == 0) {
-        // Connection closed
-        Utils::logWarning("Connection closed by peer");
-        g_network.connected = false;
-    } else {
-        int error = SOCKET_ERROR_CODE;
-#ifdef _WIN32
-        if (error != WSAEWOULDBLOCK && error != WSAEINPROGRESS) {
-#else
-        if (error != EAGAIN && error != EWOULDBLOCK) {
-#endif
-            Utils::logError("Receive error, disconnecting");
-            g_network.connected = false;
-        }
-    }
-}
-
-void handleIncomingMessage(const std::string& msg) {
-    std::istringstream iss(msg);
-    std::string command;
-    iss >> command;
-    
-    if (command == "FLIP") {
-        int cardIndex;
-        iss >> cardIndex;
-        Utils::logInfo("Received FLIP command for card " + std::to_string(cardIndex));
-        // Note: We can't directly flip cards without modifying GameBoard
-        // This would require a workaround or modifying Game class
-    } else if (command == "MATCH") {
-        int card1, card2;
-        iss >> card1 >> card2;
-        Utils::logInfo("Received MATCH: " + std::to_string(card1) + " and " + std::to_string(card2));
-    } else if (command == "TURN") {
-        int turn;
-        iss >> turn;
-        g_network.currentTurn = turn;
-        g_network.isMyTurn = (turn == g_network.myPlayerID);
-        Utils::logInfo("Turn changed to player " + std::to_string(turn));
-    } else if (command == "SCORE") {
-        int player, score;
-        iss >> player >> score;
-        if (player >= 0 && player < 2) {
-            g_network.playerScores[player] = score;
-        }
-    } else if (command == "STATE") {
-        std::string token;
-        while (iss >> token) {
-            size_t colon = token.find(':');
-            if (colon != std::string::npos) {
-                std::string key = token.substr(0, colon);
-                std::string value = token.substr(colon + 1);
-                if (key == "turn") {
-                    g_network.currentTurn = std::stoi(value);
-                    g_network.isMyTurn = (g_network.currentTurn == g_network.myPlayerID);
-                } else if (key == "score0") {
-                    g_network.playerScores[0] = std::stoi(value);
-                } else if (key == "score1") {
-                    g_network.playerScores[1] = std::stoi(value);
-                }
-            }
-        }
-    } else if (command == "END") {
-        int winner;
-        iss >> winner;
-        Utils::logInfo("Game ended. Winner: Player " + std::to_string(winner));
-    }
-}
-
-void updateNetworkLoop(float deltaTime) {
-    static float networkTimer = 0.0f;
-    networkTimer += deltaTime;
-    
-    // Process incoming messages
-    {
-        std::lock_guard<std::mutex> lock(g_network.messageMutex);
-        for (const auto& msg : g_network.incomingMessages) {
-            handleIncomingMessage(msg);
-        }
-        g_network.incomingMessages.clear();
-    }
-    
-    // Server: Accept new connections
-    if (g_network.mode == NetworkMode::SERVER && !g_network.connected) {
-        sockaddr_in clientAddr{};
-        socklen_t clientLen = sizeof(clientAddr);
-        SOCKET newClient = accept(g_network.serverSocket, (sockaddr*)&clientAddr, &clientLen);
-        
-        if (newClient != INVALID_SOCKET) {
-            g_network.clientSocket = newClient;
-            setSocketNonBlocking(g_network.clientSocket);
-            g_network.connected = true;
-            Utils::logInfo("Client connected!");
-            
-            // Send initial state
-            sendMessage("TURN 0");
-        }
-    }
-    
-    // Client: Check connection status
-    if (g_network.mode == NetworkMode::CLIENT && !g_network.connected) {
-        // Check if connection is established
-        fd_set writeSet;
-        FD_ZERO(&writeSet);
-        FD_SET(g_network.clientSocket, &writeSet);
-        timeval timeout{0, 0};
-        
-        if (select((int)g_network.clientSocket + 1, nullptr, &writeSet, nullptr, &timeout) > 0) {
-            int error = 0;
-            socklen_t len = sizeof(error);
-            if (getsockopt(g_network.clientSocket, SOL_SOCKET, SO_ERROR, (char*)&error, &len) == 0 && error == 0) {
-                g_network.connected = true;
-                Utils::logInfo("Connected to server!");
-            }
-        }
-    }
-    
-    // Receive messages
-    if (g_network.connected) {
-        receiveGameState();
-    }
-    
-    // Send periodic state updates
-    if (networkTimer >= 0.1f && g_network.connected) {
-        networkTimer = 0.0f;
-        sendGameState();
-    }
-}
+static NetworkSession g_network;
 
 // ==================== Multiplayer Integration ====================
 
-void nextTurn() {
-    g_network.currentTurn = 1 - g_network.currentTurn;
-    g_network.isMyTurn = (g_network.currentTurn == g_network.myPlayerID);
-    sendMessage("TURN " + std::to_string(g_network.currentTurn));
-}
-
-bool isMyTurn() {
-    return g_network.isMyTurn || !g_network.connected;
-}
-
-void updateScore(int player, int delta) {
-    if (player >= 0 && player < 2) {
-        g_network.playerScores[player] += delta;
-        sendMessage("SCORE " + std::to_string(player) + " " + std::to_string(g_network.playerScores[player]));
-    }
-}
-
-void showNetworkStatusUI() {
-    if (g_network.mode == NetworkMode::NONE) return;
+// screenWidth is in design pixels, like everything the overlay draws
+void showNetworkStatusUI(int screenWidth) {
+    if (g_network.getMode() == NetworkMode::NONE) return;
     
     // Network status bar at top
-    DrawRectangle(0, 80, SCREEN_WIDTH, 30, ColorAlpha(BLACK, 0.8f));
+    DrawRectangle(0, 80, screenWidth, 46, ColorAlpha(BLACK, 0.8f));
     
     std::string statusText;
     Color statusColor = WHITE;
     
-    if (g_network.connected) {
+    if (g_network.isConnected()) {
         statusText = "CONNECTED - ";
         statusColor = GREEN;
+    } else if (g_network.getConnectionState() == ConnectionState::WAITING_TO_RETRY) {
+        statusText = "RECONNECTING IN " + Utils::toString(g_network.getRetryRemaining(), 1) + "s (attempt " +
+                     std::to_string(g_network.getConnectAttempts()) + ") - ";
+        statusColor = ORANGE;
+    } else if (g_network.getConnectionState() == ConnectionState::FAILED) {
+        statusText = "CONNECTION FAILED - ";
+        statusColor = RED;
     } else {
         statusText = "CONNECTING... - ";
         statusColor = YELLOW;
     }
     
-    if (g_network.mode == NetworkMode::SERVER) {
-        statusText += "SERVER (Port: " + std::to_string(g_network.port) + ") - Player 0";
+    if (g_network.getMode() == NetworkMode::SERVER) {
+        statusText += "SERVER (Port: " + std::to_string(g_network.getPort()) + ") - Player 0";
+        if (g_network.getSpectatorCount() > 0) {
+            statusText += " | " + std::to_string(g_network.getSpectatorCount()) + " watching";
+        }
+    } else if (g_network.getMode() == NetworkMode::SPECTATOR) {
+        statusText += "SPECTATING (" + g_network.getRemoteIP() + ":" + std::to_string(g_network.getPort()) + ")";
     } else {
-        statusText += "CLIENT (" + g_network.remoteIP + ":" + std::to_string(g_network.port) + ") - Player 1";
+        statusText += "CLIENT (" + g_network.getRemoteIP() + ":" + std::to_string(g_network.getPort()) + ") - Player 1";
+    }
+    if (g_network.isConnected()) {
+        statusText += std::string(" via ") + g_network.getTransportName();
     }
     
-    statusText += " | Turn: Player " + std::to_string(g_network.currentTurn);
-    if (!g_network.isMyTurn) {
+    statusText += " | Turn: Player " + std::to_string(g_network.getCurrentTurn());
+    if (!g_network.isMyTurn() && g_network.getMode() != NetworkMode::SPECTATOR) {
         statusText += " (Waiting...)";
         statusColor = ORANGE;
     }
     
-    DrawText(statusText.c_str(), 10, 85, 18, statusColor);
+    TextRenderer::draw(statusText, 10, 85, 18, statusColor);
     
     // Player scores
-    std::string scoreText = "P0: " + std::to_string(g_network.playerScores[0]) + 
-                           " | P1: " + std::to_string(g_network.playerScores[1]);
-    int scoreWidth = MeasureText(scoreText.c_str(), 18);
-    DrawText(scoreText.c_str(), SCREEN_WIDTH - scoreWidth - 10, 85, 18, WHITE);
+    std::string scoreText = "P0: " + std::to_string(g_network.getPlayerScore(0)) + 
+                           " | P1: " + std::to_string(g_network.getPlayerScore(1));
+    int scoreWidth = TextRenderer::measure(scoreText, 18);
+    TextRenderer::draw(scoreText, screenWidth - scoreWidth - 10, 85, 18, WHITE);
+    
+    // Traffic counters (refreshed once per second)
+    const NetStats& stats = g_network.getStats();
+    std::string trafficText = "OUT " + std::to_string(static_cast<int>(stats.bytesSentPerSecond)) + " B/s, " +
+                              std::to_string(static_cast<int>(stats.messagesSentPerSecond)) + " msg/s | IN " +
+                              std::to_string(static_cast<int>(stats.bytesReceivedPerSecond)) + " B/s, " +
+                              std::to_string(static_cast<int>(stats.messagesReceivedPerSecond)) + " msg/s";
+    TextRenderer::draw(trafficText, 10, 107, 14, LIGHTGRAY);
 }
 
-// ==================== Utility Functions ====================
+// ==================== Frame Drawing ====================
 
-void serializeGameState(std::string& output) {
-    std::stringstream ss;
-    ss << "STATE turn:" << g_network.currentTurn
-       << " score0:" << g_network.playerScores[0]
-       << " score1:" << g_network.playerScores[1];
-    output = ss.str();
+// Draws the running game: board or menus plus the multiplayer overlays
+void drawFrame(Game& game, NetworkMode selectedMode) {
+    ClearBackground(DARKBLUE);
+    game.draw();
+    
+    // Opponent's cursor (presence)
+    int cursorX = 0, cursorY = 0;
+    if (selectedMode != NetworkMode::NONE && g_network.getRemotePresence(cursorX, cursorY)) {
+        DrawCircleLines(cursorX, cursorY, 10, ORANGE);
+        DrawCircle(cursorX, cursorY, 3, ORANGE);
+    }
+    
+    // Multiplayer overlays are in design pixels, scaled like the game's UI
+    float scale = game.getUiScale();
+    int width = static_cast<int>(GetScreenWidth() / scale);
+    int height = static_cast<int>(GetScreenHeight() / scale);
+    rlPushMatrix();
+    rlScalef(scale, scale, 1.0f);
+    
+    // Draw network status
+    if (selectedMode != NetworkMode::NONE) {
+        showNetworkStatusUI(width);
+    }
+    
+    // Draw turn indicator
+    if (selectedMode != NetworkMode::NONE && !g_network.isMyTurn()) {
+        DrawRectangle(0, 0, width, height, ColorAlpha(BLACK, 0.3f));
+        const char* waitText = (selectedMode == NetworkMode::SPECTATOR)
+            ? "SPECTATING - READ ONLY" : "WAITING FOR OPPONENT'S TURN...";
+        TextRenderer::draw(waitText, width / 2 - 200, height / 2, 30, YELLOW);
+    }
+    rlPopMatrix();
+    
+#ifdef DEBUG
+    DrawFPS(10, 10);
+#endif
 }
 
-void deserializeGameState(const std::string& input) {
-    handleIncomingMessage(input);
+// Copies a frame drawn into a render texture to the screen unchanged
+void presentCachedFrame(const RenderTexture2D& frame) {
+    // Straight copy: the cached alpha channel is not meant to be blended again
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    Rectangle source = {0.0f, 0.0f, static_cast<float>(frame.texture.width), -static_cast<float>(frame.texture.height)};
+    DrawTextureRec(frame.texture, source, {0.0f, 0.0f}, WHITE);
+    EndBlendMode();
 }
 
-// ==================== Network Thread ====================
-
-void networkThreadFunction() {
-    while (!g_network.shouldStop) {
-        updateNetworkLoop(0.016f);  // ~60fps
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+// Any input this frame: keys, mouse movement, buttons or wheel
+bool hadInputThisFrame() {
+    if (GetKeyPressed() != 0 || GetMouseWheelMove() != 0.0f) {
+        return true;
     }
+    Vector2 mouseDelta = GetMouseDelta();
+    if (mouseDelta.x != 0.0f || mouseDelta.y != 0.0f) {
+        return true;
+    }
+    return IsMouseButtonDown(MOUSE_BUTTON_LEFT) || IsMouseButtonDown(MOUSE_BUTTON_RIGHT) ||
+           IsMouseButtonDown(MOUSE_BUTTON_MIDDLE);
 }
 
 // ==================== Main Function ====================
 
-int main() {
-    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, WINDOW_TITLE);
+int main(int argc, char* argv[]) {
+    // --threaded-sim: board logic on its own thread, the main thread only draws snapshots
+    // --pacing=fixed|vsync|uncapped|adaptive, --fps=N: frame rate policy (fixed 60 by default)
+    // --window=WIDTHxHEIGHT: initial window size (the window can be resized at any time)
+    // --alloc-check: fail the run if steady PLAYING frames allocate (needs -DTRACK_ALLOCATIONS=ON)
+    bool threadedSimulation = false;
+    bool allocationCheck = false;
+    int windowWidth = SCREEN_WIDTH;
+    int windowHeight = SCREEN_HEIGHT;
+    PacingMode pacingMode = PacingMode::FIXED;
+    int fixedFps = TARGET_FPS;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threaded-sim") {
+            threadedSimulation = true;
+        } else if (arg == "--alloc-check") {
+            allocationCheck = true;
+        } else if (arg.rfind("--pacing=", 0) == 0) {
+            if (!FramePacer::parseMode(arg.substr(9), pacingMode)) {
+                Utils::logWarning("Unknown pacing mode '" + arg.substr(9) + "', using fixed");
+            }
+        } else if (arg.rfind("--fps=", 0) == 0) {
+            fixedFps = std::atoi(arg.c_str() + 6);
+        } else if (arg.rfind("--window=", 0) == 0) {
+            int width = 0;
+            int height = 0;
+            if (std::sscanf(arg.c_str() + 9, "%dx%d", &width, &height) == 2 &&
+                width >= MIN_WINDOW_WIDTH && height >= MIN_WINDOW_HEIGHT) {
+                windowWidth = width;
+                windowHeight = height;
+            } else {
+                Utils::logWarning("Ignoring window size '" + arg.substr(9) + "'");
+            }
+        }
+    }
+    FramePacer pacer(pacingMode, fixedFps);
+    if (allocationCheck && !AllocationTracker::isInstalled()) {
+        Utils::logWarning("--alloc-check needs a build configured with -DTRACK_ALLOCATIONS=ON; nothing is counted");
+    }
+    
+    unsigned int windowFlags = FLAG_WINDOW_RESIZABLE;
+    if (pacer.wantsVsync()) {
+        windowFlags |= FLAG_VSYNC_HINT;
+    }
+    SetConfigFlags(windowFlags);
+    InitWindow(windowWidth, windowHeight, WINDOW_TITLE);
+    SetWindowMinSize(MIN_WINDOW_WIDTH, MIN_WINDOW_HEIGHT);
     SetExitKey(KEY_NULL);
-    SetTargetFPS(TARGET_FPS);
+    pacer.setRefreshRate(GetMonitorRefreshRate(GetCurrentMonitor()));
+    SetTargetFPS(pacer.getTargetFps());
+    Utils::logInfo(std::string("Frame pacing: ") + FramePacer::getModeName(pacer.getMode()) +
+                   ", display " + Utils::toString(pacer.getRefreshRate()) + " Hz");
     
     InitAudioDevice();
     
@@ -518,9 +222,17 @@ int main() {
     bool modeSelected = false;
     NetworkMode selectedMode = NetworkMode::NONE;
     std::string ipInput = "127.0.0.1";
-    int selectedButton = 0;  // 0 = Single Player, 1 = Host, 2 = Join
+    int selectedButton = 0;  // 0 = Single Player, 1 = Host, 2 = Join, 3 = Watch
+    bool preferUdp = false;  // Join over UDP (falls back to TCP if the host does not answer)
     bool showGuide = false;
     
+    // The mode screen is drawn at 1024x768 and scaled to fit the window
+    LayoutTree modeLayout(SCREEN_WIDTH, SCREEN_HEIGHT);
+    LayoutNode modeFrame;
+    modeFrame.anchor = modeFrame.pivot = {0.5f, 0.5f};
+    modeFrame.size = {static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT)};
+    const int modeFrameId = modeLayout.add(modeFrame);
+    
     while (!modeSelected && !WindowShouldClose()) {
         // Handle input
         if (IsKeyPressed(KEY_H) || IsKeyPressed(KEY_F1)) {
@@ -529,28 +241,32 @@ int main() {
         
         if (!showGuide) {
             if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) {
-                selectedButton = (selectedButton - 1 + 3) % 3;
+                selectedButton = (selectedButton - 1 + 4) % 4;
             }
             if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) {
-                selectedButton = (selectedButton + 1) % 3;
+                selectedButton = (selectedButton + 1) % 4;
             }
             if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
                 if (selectedButton == 0) {
                     selectedMode = NetworkMode::NONE;
                     modeSelected = true;
                 } else if (selectedButton == 1) {
-                    startServer(DEFAULT_PORT);
+                    g_network.startServer(DEFAULT_PORT);
                     selectedMode = NetworkMode::SERVER;
                     modeSelected = true;
                 } else if (selectedButton == 2) {
-                    startClient(ipInput, DEFAULT_PORT);
+                    g_network.startClient(ipInput, DEFAULT_PORT, false, preferUdp);
                     selectedMode = NetworkMode::CLIENT;
                     modeSelected = true;
+                } else if (selectedButton == 3) {
+                    g_network.startClient(ipInput, DEFAULT_PORT, true);
+                    selectedMode = NetworkMode::SPECTATOR;
+                    modeSelected = true;
                 }
             }
             
             // Handle text input for IP
-            if (selectedButton == 2) {
+            if (selectedButton == 2 || selectedButton == 3) {
                 int key = GetCharPressed();
                 if (key >= 32 && key <= 126) {
                     if (ipInput.length() < 15) {
@@ -561,6 +277,9 @@ int main() {
                     ipInput.pop_back();
                 }
             }
+            if (selectedButton == 2 && IsKeyPressed(KEY_TAB)) {
+                preferUdp = !preferUdp;
+            }
         } else {
             // In guide mode, only handle closing
             if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_H) || IsKeyPressed(KEY_F1)) {
@@ -568,9 +287,15 @@ int main() {
             }
         }
         
-        // Draw mode selection screen
+        // Draw mode selection screen (text and plain shapes only, so one text batch)
         BeginDrawing();
         ClearBackground(DARKBLUE);
+        modeLayout.resize(GetScreenWidth(), GetScreenHeight());
+        Rectangle frame = modeLayout.get(modeFrameId);
+        rlPushMatrix();
+        rlTranslatef(frame.x, frame.y, 0.0f);
+        rlScalef(modeLayout.getScale(), modeLayout.getScale(), 1.0f);
+        TextRenderer::beginBatch();
         
         if (showGuide) {
             // Draw guide overlay
@@ -581,181 +306,285 @@ int main() {
             Utils::drawRoundedRectangleLines(guidePanel, 0.1f, 16, 3, SKYBLUE);
             
             int yPos = 100;
-            DrawText("MULTIPLAYER GUIDE", SCREEN_WIDTH / 2 - 150, yPos, 32, GOLD);
+            TextRenderer::draw("MULTIPLAYER GUIDE", SCREEN_WIDTH / 2 - 150, yPos, 32, GOLD);
             yPos += 60;
             
             // Host Server Guide
-            DrawText("HOW TO HOST A SERVER:", 80, yPos, 24, LIME);
+            TextRenderer::draw("HOW TO HOST A SERVER:", 80, yPos, 24, LIME);
             yPos += 35;
-            DrawText("1. Select 'Host Server' option", 100, yPos, 20, WHITE);
+            TextRenderer::draw("1. Select 'Host Server' option", 100, yPos, 20, WHITE);
             yPos += 25;
-            DrawText("2. Server will start on port 5000", 100, yPos, 20, WHITE);
+            TextRenderer::draw("2. Server will start on port 5000", 100, yPos, 20, WHITE);
             yPos += 25;
-            DrawText("3. Wait for a client to connect", 100, yPos, 20, WHITE);
+            TextRenderer::draw("3. Wait for a client to connect", 100, yPos, 20, WHITE);
             yPos += 25;
-            DrawText("4. You are Player 0 (goes first)", 100, yPos, 20, WHITE);
+            TextRenderer::draw("4. You are Player 0 (goes first)", 100, yPos, 20, WHITE);
             yPos += 40;
             
             // Join Server Guide
-            DrawText("HOW TO JOIN A SERVER:", 80, yPos, 24, LIME);
+            TextRenderer::draw("HOW TO JOIN A SERVER:", 80, yPos, 24, LIME);
             yPos += 35;
-            DrawText("1. Select 'Join Server' option", 100, yPos, 20, WHITE);
+            TextRenderer::draw("1. Select 'Join Server' option", 100, yPos, 20, WHITE);
             yPos += 25;
-            DrawText("2. Enter the server's IP address:", 100, yPos, 20, WHITE);
+            TextRenderer::draw("2. Enter the server's IP address:", 100, yPos, 20, WHITE);
             yPos += 25;
-            DrawText("   - Localhost: 127.0.0.1 (same computer)", 120, yPos, 18, LIGHTGRAY);
+            TextRenderer::draw("   - Localhost: 127.0.0.1 (same computer)", 120, yPos, 18, LIGHTGRAY);
             yPos += 22;
-            DrawText("   - LAN: Find host's local IP (e.g., 192.168.1.xxx)", 120, yPos, 18, LIGHTGRAY);
+            TextRenderer::draw("   - LAN: Find host's local IP (e.g., 192.168.1.xxx)", 120, yPos, 18, LIGHTGRAY);
             yPos += 22;
-            DrawText("   - Internet: Use host's public IP (requires port forwarding)", 120, yPos, 18, LIGHTGRAY);
+            TextRenderer::draw("   - Internet: Use host's public IP (requires port forwarding)", 120, yPos, 18, LIGHTGRAY);
             yPos += 25;
-            DrawText("3. Press ENTER to connect", 100, yPos, 20, WHITE);
+            TextRenderer::draw("3. Press ENTER to connect", 100, yPos, 20, WHITE);
             yPos += 25;
-            DrawText("4. You are Player 1 (goes second)", 100, yPos, 20, WHITE);
+            TextRenderer::draw("4. You are Player 1 (goes second)", 100, yPos, 20, WHITE);
             yPos += 40;
             
             // Tips
-            DrawText("TIPS:", 80, yPos, 24, YELLOW);
+            TextRenderer::draw("TIPS:", 80, yPos, 24, YELLOW);
             yPos += 35;
-            DrawText("* Players take turns flipping cards", 100, yPos, 18, WHITE);
+            TextRenderer::draw("* Players take turns flipping cards", 100, yPos, 18, WHITE);
             yPos += 22;
-            DrawText("* Matches are visible to both players", 100, yPos, 18, WHITE);
+            TextRenderer::draw("* Matches are visible to both players", 100, yPos, 18, WHITE);
             yPos += 22;
-            DrawText("* Scores sync automatically", 100, yPos, 18, WHITE);
+            TextRenderer::draw("* Scores sync automatically", 100, yPos, 18, WHITE);
             yPos += 22;
-            DrawText("* Network status shown at top during game", 100, yPos, 18, WHITE);
+            TextRenderer::draw("* Network status shown at top during game", 100, yPos, 18, WHITE);
             yPos += 22;
-            DrawText("* If connection fails, check firewall/port settings", 100, yPos, 18, WHITE);
+            TextRenderer::draw("* If connection fails, check firewall/port settings", 100, yPos, 18, WHITE);
             yPos += 40;
             
             // Finding IP address
-            DrawText("FINDING YOUR IP ADDRESS:", 80, yPos, 24, ORANGE);
+            TextRenderer::draw("FINDING YOUR IP ADDRESS:", 80, yPos, 24, ORANGE);
             yPos += 35;
-            DrawText("Windows: ipconfig (look for IPv4 Address)", 100, yPos, 18, WHITE);
+            TextRenderer::draw("Windows: ipconfig (look for IPv4 Address)", 100, yPos, 18, WHITE);
             yPos += 22;
-            DrawText("Linux/Mac: ifconfig or ip addr (look for inet)", 100, yPos, 18, WHITE);
+            TextRenderer::draw("Linux/Mac: ifconfig or ip addr (look for inet)", 100, yPos, 18, WHITE);
             yPos += 22;
-            DrawText("Or use: hostname -I (Linux) / ipconfig getifaddr en0 (Mac)", 100, yPos, 18, WHITE);
+            TextRenderer::draw("Or use: hostname -I (Linux) / ipconfig getifaddr en0 (Mac)", 100, yPos, 18, WHITE);
             
-            DrawText("Press H or ESC to close this guide", SCREEN_WIDTH / 2 - 180, SCREEN_HEIGHT - 50, 20, LIGHTGRAY);
+            TextRenderer::draw("Press H or ESC to close this guide", SCREEN_WIDTH / 2 - 180, SCREEN_HEIGHT - 50, 20, LIGHTGRAY);
             
         } else {
-            DrawText("MEMORY CARD GAME - MULTIPLAYER", SCREEN_WIDTH / 2 - 250, 60, 30, GOLD);
-            DrawText("Press H for Multiplayer Guide", SCREEN_WIDTH / 2 - 150, 100, 20, LIGHTGRAY);
-            DrawText("Select Mode:", SCREEN_WIDTH / 2 - 100, 150, 24, WHITE);
+            TextRenderer::draw("MEMORY CARD GAME - MULTIPLAYER", SCREEN_WIDTH / 2 - 250, 60, 30, GOLD);
+            TextRenderer::draw("Press H for Multiplayer Guide", SCREEN_WIDTH / 2 - 150, 100, 20, LIGHTGRAY);
+            TextRenderer::draw("Select Mode:", SCREEN_WIDTH / 2 - 100, 150, 24, WHITE);
             
             // Single Player button
             Color singleColor = (selectedButton == 0) ? GREEN : GRAY;
             DrawRectangle(SCREEN_WIDTH / 2 - 150, 200, 300, 50, singleColor);
             DrawRectangleLines(SCREEN_WIDTH / 2 - 150, 200, 300, 50, WHITE);
-            DrawText("Single Player", SCREEN_WIDTH / 2 - 70, 215, 24, WHITE);
+            TextRenderer::draw("Single Player", SCREEN_WIDTH / 2 - 70, 215, 24, WHITE);
             
             // Host Server button
             Color hostColor = (selectedButton == 1) ? GREEN : GRAY;
             DrawRectangle(SCREEN_WIDTH / 2 - 150, 270, 300, 50, hostColor);
             DrawRectangleLines(SCREEN_WIDTH / 2 - 150, 270, 300, 50, WHITE);
-            DrawText("Host Server (Port 5000)", SCREEN_WIDTH / 2 - 120, 285, 24, WHITE);
+            TextRenderer::draw("Host Server (Port 5000)", SCREEN_WIDTH / 2 - 120, 285, 24, WHITE);
             
             // Join Server button
             Color joinColor = (selectedButton == 2) ? GREEN : GRAY;
             DrawRectangle(SCREEN_WIDTH / 2 - 150, 340, 300, 50, joinColor);
             DrawRectangleLines(SCREEN_WIDTH / 2 - 150, 340, 300, 50, WHITE);
-            DrawText("Join Server", SCREEN_WIDTH / 2 - 80, 355, 24, WHITE);
+            TextRenderer::draw("Join Server", SCREEN_WIDTH / 2 - 80, 355, 24, WHITE);
+            
+            // Watch Game button
+            Color watchColor = (selectedButton == 3) ? GREEN : GRAY;
+            DrawRectangle(SCREEN_WIDTH / 2 - 150, 410, 300, 50, watchColor);
+            DrawRectangleLines(SCREEN_WIDTH / 2 - 150, 410, 300, 50, WHITE);
+            TextRenderer::draw("Watch Game", SCREEN_WIDTH / 2 - 75, 425, 24, WHITE);
             
             // IP input
-            if (selectedButton == 2) {
-                DrawText("IP Address:", SCREEN_WIDTH / 2 - 100, 410, 20, WHITE);
-                DrawRectangle(SCREEN_WIDTH / 2 - 100, 435, 200, 30, DARKGRAY);
-                DrawRectangleLines(SCREEN_WIDTH / 2 - 100, 435, 200, 30, WHITE);
-                DrawText(ipInput.c_str(), SCREEN_WIDTH / 2 - 95, 442, 20, WHITE);
+            if (selectedButton == 2 || selectedButton == 3) {
+                TextRenderer::draw("IP Address:", SCREEN_WIDTH / 2 - 100, 480, 20, WHITE);
+                DrawRectangle(SCREEN_WIDTH / 2 - 100, 505, 200, 30, DARKGRAY);
+                DrawRectangleLines(SCREEN_WIDTH / 2 - 100, 505, 200, 30, WHITE);
+                TextRenderer::draw(ipInput, SCREEN_WIDTH / 2 - 95, 512, 20, WHITE);
                 if ((int)(GetTime() * 2) % 2) {
-                    DrawText("_", SCREEN_WIDTH / 2 - 95 + MeasureText(ipInput.c_str(), 20), 442, 20, WHITE);
+                    TextRenderer::draw("_", SCREEN_WIDTH / 2 - 95 + TextRenderer::measure(ipInput, 20), 512, 20, WHITE);
+                }
+                TextRenderer::draw("Default: 127.0.0.1 (localhost)", SCREEN_WIDTH / 2 - 120, 545, 16, LIGHTGRAY);
+                if (selectedButton == 2) {
+                    const char* transportText = preferUdp ? "Transport: UDP, TCP fallback (TAB)" : "Transport: TCP (TAB)";
+                    TextRenderer::draw(transportText, SCREEN_WIDTH / 2 + 110, 512, 16, preferUdp ? GREEN : LIGHTGRAY);
                 }
-                DrawText("Default: 127.0.0.1 (localhost)", SCREEN_WIDTH / 2 - 120, 475, 16, LIGHTGRAY);
             }
             
             // Quick guide summary
-            int guideY = 520;
-            DrawText("Quick Guide:", SCREEN_WIDTH / 2 - 150, guideY, 20, YELLOW);
+            int guideY = 580;
+            TextRenderer::draw("Quick Guide:", SCREEN_WIDTH / 2 - 150, guideY, 20, YELLOW);
             guideY += 25;
-            DrawText("Host: Select 'Host Server' and wait for connection", SCREEN_WIDTH / 2 - 240, guideY, 16, LIGHTGRAY);
+            TextRenderer::draw("Host: Select 'Host Server' and wait for connection", SCREEN_WIDTH / 2 - 240, guideY, 16, LIGHTGRAY);
+            guideY += 20;
+            TextRenderer::draw("Join: Select 'Join Server', enter host IP, press ENTER", SCREEN_WIDTH / 2 - 240, guideY, 16, LIGHTGRAY);
             guideY += 20;
-            DrawText("Join: Select 'Join Server', enter host IP, press ENTER", SCREEN_WIDTH / 2 - 240, guideY, 16, LIGHTGRAY);
+            TextRenderer::draw("Watch: Select 'Watch Game' to follow a hosted match read-only", SCREEN_WIDTH / 2 - 240, guideY, 16, LIGHTGRAY);
             guideY += 20;
-            DrawText("Press H for detailed multiplayer guide", SCREEN_WIDTH / 2 - 180, guideY, 16, LIGHTGRAY);
+            TextRenderer::draw("Press H for detailed multiplayer guide", SCREEN_WIDTH / 2 - 180, guideY, 16, LIGHTGRAY);
             
-            DrawText("Use Arrow Keys / WASD to navigate, ENTER to select", SCREEN_WIDTH / 2 - 250, SCREEN_HEIGHT - 50, 18, LIGHTGRAY);
+            TextRenderer::draw("Use Arrow Keys / WASD to navigate, ENTER to select", SCREEN_WIDTH / 2 - 250, SCREEN_HEIGHT - 50, 18, LIGHTGRAY);
         }
         
+        TextRenderer::endBatch();
+        rlPopMatrix();
         EndDrawing();
     }
     
-    // Start network thread if in multiplayer mode
-    std::thread networkThread;
-    if (selectedMode != NetworkMode::NONE) {
-        networkThread = std::thread(networkThreadFunction);
-    }
-    
+    int exitCode = EXIT_SUCCESS;
     try {
-        auto game = std::make_unique<Game>(SCREEN_WIDTH, SCREEN_HEIGHT);
+        auto game = std::make_unique<Game>(GetScreenWidth(), GetScreenHeight());
+        game->setThreadedSimulation(threadedSimulation);
+        // Players send their flips and matches; spectators only watch
+        const bool sendsMoves = selectedMode == NetworkMode::SERVER || selectedMode == NetworkMode::CLIENT;
+        game->setMoveReporting(sendsMoves);
+        std::vector<BoardMove> boardMoves;
+        boardMoves.reserve(16);
         
         Utils::logInfo("Memory Card Game initialized successfully!");
         
         // Main game loop
+        IdleTracker idleTracker;
+        RenderTexture2D frameCache = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+        bool frameCached = false;
+        bool showPacing = false;
+        AllocationTracker allocations;
+        bool showAllocations = false;
+        int currentFps = pacer.getTargetFps();
+        
         while (!WindowShouldClose()) {
+            double frameStart = GetTime();
             float deltaTime = GetFrameTime();
             
-            // Update network
+            if (IsKeyPressed(KEY_F3)) {
+                showPacing = !showPacing;
+            }
+            if (IsKeyPressed(KEY_F4)) {
+                showAllocations = !showAllocations;
+            }
+            // A frame is held to the allocation budget when it is spent playing from start to end
+            allocations.beginFrame();
+            bool playingFrame = game->getCurrentState() == GameState::PLAYING;
+            
+            if (IsWindowResized()) {
+                game->resize(GetScreenWidth(), GetScreenHeight());
+                // The cached idle frame has the old size
+                if (IsRenderTextureReady(frameCache)) {
+                    UnloadRenderTexture(frameCache);
+                }
+                frameCache = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+                frameCached = false;
+            }
+            
+            // Update network (one tick per frame, on the game thread)
             if (selectedMode != NetworkMode::NONE) {
-                updateNetworkLoop(deltaTime);
+                if (selectedMode != NetworkMode::SPECTATOR) {
+                    Vector2 mouse = GetMousePosition();
+                    g_network.setPresence(static_cast<int>(mouse.x), static_cast<int>(mouse.y));
+                }
+                g_network.update(deltaTime);
             }
             
             // Update game (only allow input if it's my turn or single player)
-            if (selectedMode == NetworkMode::NONE || isMyTurn()) {
+            allocations.beginPhase(AllocationPhase::UPDATE);
+            if (selectedMode == NetworkMode::NONE || g_network.isMyTurn()) {
                 game->update();
             } else {
                 // Still update game state but disable input
                 // This is a limitation - we'd need to modify Game class to disable input
                 game->update();
             }
+            allocations.endPhase();
+            playingFrame = playingFrame && game->getCurrentState() == GameState::PLAYING;
             
-            // Draw
-            BeginDrawing();
-            {
-                ClearBackground(DARKBLUE);
-                game->draw();
-                
-                // Draw network status
-                if (selectedMode != NetworkMode::NONE) {
-                    showNetworkStatusUI();
+            // This frame's moves go out with the next network tick's batch
+            if (sendsMoves) {
+                game->takeBoardMoves(boardMoves);
+                for (const BoardMove& move : boardMoves) {
+                    if (move.type == BoardMove::Type::FLIP) {
+                        g_network.sendFlip(move.first);
+                    } else {
+                        g_network.sendMatch(move.first, move.second);
+                    }
                 }
-                
-                // Draw turn indicator
-                if (selectedMode != NetworkMode::NONE && !isMyTurn()) {
-                    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorAlpha(BLACK, 0.3f));
-                    DrawText("WAITING FOR OPPONENT'S TURN...", SCREEN_WIDTH / 2 - 200, SCREEN_HEIGHT / 2, 30, YELLOW);
+                boardMoves.clear();
+            }
+            
+            // Idle mode: nothing moved, nobody touched anything, no news from the network
+            bool networkActivity = selectedMode != NetworkMode::NONE && g_network.takeActivity();
+            idleTracker.update(deltaTime, hadInputThisFrame() || game->isAnimating() || networkActivity);
+            bool idle = idleTracker.isIdle() && IsRenderTextureReady(frameCache);
+            game->setIdle(idle);
+            int targetFps = idleTracker.getTargetFps(pacer.getTargetFps());
+            if (targetFps != currentFps) {
+                SetTargetFPS(targetFps);
+                currentFps = targetFps;
+            }
+            
+            if (!idle) {
+                frameCached = false;
+                BeginDrawing();
+                allocations.beginPhase(AllocationPhase::DRAW);
+                drawFrame(*game, selectedMode);
+                allocations.endPhase();
+                double flipLatency = 0.0;
+                if (game->takeFlipLatency(flipLatency)) {
+                    pacer.addFlipLatency(flipLatency);
                 }
-                
-#ifdef DEBUG
-                DrawFPS(10, 10);
-#endif
+                // Overlays allocate; they are drawn outside the phases and the budget
+                allocations.endFrame(playingFrame && !showPacing && !showAllocations);
+                if (showPacing) {
+                    pacer.drawOverlay(10, GetScreenHeight() - 80);
+                }
+                if (showAllocations) {
+                    allocations.drawOverlay(10, GetScreenHeight() - (showPacing ? 152 : 80));
+                }
+                float workTime = static_cast<float>(GetTime() - frameStart);
+                EndDrawing();
+                pacer.frameFinished(GetFrameTime(), workTime);
+                continue;
+            }
+            
+            // Draw the still scene once, then keep presenting it
+            if (!frameCached) {
+                BeginTextureMode(frameCache);
+                allocations.beginPhase(AllocationPhase::DRAW);
+                drawFrame(*game, selectedMode);
+                allocations.endPhase();
+                EndTextureMode();
+                frameCached = true;
             }
+            allocations.endFrame(playingFrame);
+            BeginDrawing();
+            presentCachedFrame(frameCache);
             EndDrawing();
         }
         
+        if (IsRenderTextureReady(frameCache)) {
+            UnloadRenderTexture(frameCache);
+        }
+        
+        if (threadedSimulation) {
+            Utils::logInfo("Simulation ran on its own thread");
+        }
+        pacer.logSummary();
+        allocations.logSummary();
+        
         Utils::logInfo("Game loop ended normally.");
+        if (allocationCheck && allocations.getViolations() > 0) {
+            exitCode = EXIT_FAILURE;
+        }
         
     } catch (const std::exception& e) {
         Utils::logError("Game error: " + std::string(e.what()));
         
         BeginDrawing();
         ClearBackground(RED);
-        DrawText("GAME ERROR - Check console for details", 
-                 SCREEN_WIDTH/2 - 200, SCREEN_HEIGHT/2, 20, WHITE);
+        TextRenderer::draw("GAME ERROR - Check console for details", 
+                           GetScreenWidth()/2 - 200, GetScreenHeight()/2, 20, WHITE);
         EndDrawing();
         
         while (!WindowShouldClose()) {}
         
+        TextRenderer::unload();
         CloseAudioDevice();
         CloseWindow();
         return EXIT_FAILURE;
@@ -763,17 +592,15 @@ int main() {
     
     // Cleanup
     if (selectedMode != NetworkMode::NONE) {
-        stopNetwork();
-        if (networkThread.joinable()) {
-            networkThread.join();
-        }
+        g_network.stop();
     }
     
     Utils::logInfo("Cleaning up resources...");
+    TextRenderer::unload();
     CloseAudioDevice();
     CloseWindow();
     
     Utils::logInfo("Thanks for playing Memory Card Game!");
     
-    return EXIT_SUCCESS;
+    return exitCode;
 }
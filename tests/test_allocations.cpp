@@ -0,0 +1,214 @@
+/**
+ * @file test_allocations.cpp
+ * @brief AllocationTracker frames, phases and budget, and an allocation-free board and HUD in play
+ */
+
+#include "test_harness.h"
+#include "../include/AllocationTracker.h"
+#include "../include/Format.h"
+#include "../include/GameBoard.h"
+#include "../include/HudRenderer.h"
+#include "../include/ScoreManager.h"
+#include "../include/ScriptedSession.h"
+#include "../include/SimulationClock.h"
+#include "../include/TextLayoutCache.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr float STEP = SimulationClock::DEFAULT_STEP;
+
+// Opaque to the optimizer, so the allocations below are not elided
+void* volatile g_sink = nullptr;
+
+void allocate(std::size_t bytes) {
+    char* memory = new char[bytes];
+    g_sink = memory;
+    delete[] memory;
+}
+
+void testCounting() {
+    // The test binary links the hook
+    CHECK(AllocationTracker::isInstalled());
+
+    const AllocationCounts before = AllocationTracker::current();
+    allocate(100);
+    std::unique_ptr<int> value = std::make_unique<int>(3);
+    const AllocationCounts after = AllocationTracker::current();
+    CHECK(after.allocations - before.allocations == 2);
+    CHECK(after.bytes - before.bytes == 100 + sizeof(int));
+}
+
+void testFramesAndPhases() {
+    AllocationTracker tracker;
+    tracker.beginFrame();
+    {
+        AllocationTracker::Scope update(tracker, AllocationPhase::UPDATE);
+        allocate(10);
+    }
+    allocate(1);    // outside every phase: only in the total
+    tracker.beginPhase(AllocationPhase::DRAW);
+    allocate(20);
+    allocate(30);
+    tracker.endFrame(false);    // closes the open phase
+
+    const FrameAllocations& frame = tracker.getLastFrame();
+    CHECK(frame.total.allocations == 4 && frame.total.bytes == 61);
+    CHECK(frame.phase(AllocationPhase::UPDATE).allocations == 1 && frame.phase(AllocationPhase::UPDATE).bytes == 10);
+    CHECK(frame.phase(AllocationPhase::DRAW).allocations == 2 && frame.phase(AllocationPhase::DRAW).bytes == 50);
+    CHECK(tracker.getWorstFrame().total.allocations == 4);
+
+    // An empty frame is the last one, not the worst
+    tracker.beginFrame();
+    tracker.endFrame(false);
+    CHECK(tracker.getLastFrame().total.allocations == 0);
+    CHECK(tracker.getWorstFrame().total.allocations == 4);
+    CHECK(tracker.getFrames() == 2);
+}
+
+void testBudget() {
+    AllocationTracker tracker;
+    auto frame = [&](bool budgeted, bool allocates) {
+        tracker.beginFrame();
+        if (allocates) allocate(8);
+        tracker.endFrame(budgeted);
+    };
+
+    // The warm-up may allocate, and so may frames outside the budget
+    for (int i = 0; i < AllocationTracker::BUDGET_WARMUP_FRAMES; ++i) frame(true, true);
+    frame(false, true);
+    CHECK(tracker.getViolations() == 0);
+
+    // Leaving the budget restarts the warm-up
+    for (int i = 0; i < AllocationTracker::BUDGET_WARMUP_FRAMES; ++i) frame(true, i == 0);
+    CHECK(tracker.getViolations() == 0);
+
+    // Past it, every allocating frame counts
+    frame(true, false);
+    frame(true, true);
+    frame(true, true);
+    CHECK(tracker.getViolations() == 2);
+}
+
+/**
+ * @brief Printable ASCII, each glyph 10 px square in one atlas row
+ */
+struct AsciiFont {
+    static constexpr int GLYPHS = 95;
+    GlyphInfo glyphs[GLYPHS] = {};
+    Rectangle recs[GLYPHS] = {};
+    Font font{};
+
+    AsciiFont() {
+        for (int i = 0; i < GLYPHS; ++i) {
+            glyphs[i].value = ' ' + i;
+            glyphs[i].advanceX = 10;
+            recs[i] = {10.0f * i, 0.0f, 10.0f, 10.0f};
+        }
+        font.baseSize = 10;
+        font.glyphCount = GLYPHS;
+        font.texture.width = 10 * GLYPHS;
+        font.texture.height = 10;
+        font.recs = recs;
+        font.glyphs = glyphs;
+    }
+};
+
+/**
+ * @brief The strings HudRenderer::drawText() lays out when the text layer is rebaked
+ */
+void layoutHud(TextLayoutCache& cache, ClockText& clock, const HudState& state) {
+    FormatBuffer<64> text;
+    cache.get(text.append("MOVES: ").append(state.moves), 24);
+    cache.get(text.clear().append("PAIRS: ").append(state.matches).append('/').append(state.totalPairs), 24);
+    cache.get(text.clear().append("SCORE: ").append(state.score), 24);
+    cache.get(clock.update(static_cast<float>(state.elapsedSeconds)), 28);
+    cache.get(text.clear().append("HINTS: ").append(state.hintsRemaining), 20);
+    if (state.canUseHint) {
+        cache.get("Press H to use", 16);
+    } else {
+        cache.get(text.clear().append("Cooldown: ").append(state.hintCooldownSeconds).append('s'), 16);
+    }
+    cache.get(text.clear().append("Used: ").append(state.shufflesUsed), 14);
+}
+
+/**
+ * A game as Game::update() drives it during PLAYING: fixed steps, a
+ * snapshot per frame for drawing, a click now and then. After the
+ * warm-up none of it may touch the heap, clicks, matches and the
+ * reshuffle included. The draw phase lays out the HUD text whenever a
+ * value in it changes; its cache is kept small so that runs are
+ * recycled throughout, as a long session recycles the full-size one.
+ */
+void testPlayingDoesNotAllocate() {
+    ScoreManager score;
+    GameBoard board(6, 6, {50.0f, 70.0f}, 10.0f, {20.0f, 30.0f, 800.0f, 600.0f}, 7, true);
+    board.setScoreManager(&score);
+    ScriptedSession session(1);
+    WidgetLayer widgets;
+    BoardSnapshot snapshot;
+    AllocationTracker tracker;
+    AsciiFont font;
+    TextLayoutCache textCache(16);
+    textCache.setFont(font.font, 0.1f, 10);
+    ClockText clock;
+    HudState hud;
+    bool hudValid = false;
+    unsigned long long hudRebuilds = 0;
+
+    bool shuffled = false;
+    bool hinted = false;
+    int frames = 0;
+    for (; frames < 20000 && !board.allMatched(); ++frames) {
+        tracker.beginFrame();
+        tracker.beginPhase(AllocationPhase::UPDATE);
+        board.fillSnapshot(snapshot);
+        const ScriptedInput input = session.next(GameState::PLAYING, widgets, snapshot, STEP);
+        if (input.type == ScriptedInput::Type::CLICK) {
+            board.handleClick(input.position);
+        }
+        if (!hinted && frames >= 60 && board.canUseHint() && !board.isHintActive()) {
+            board.showHint();
+            hinted = true;
+        }
+        if (!shuffled && frames == 150) {
+            board.startShuffle(1.0f);
+            shuffled = true;
+        }
+        board.update(STEP);
+        tracker.beginPhase(AllocationPhase::DRAW);
+        board.fillSnapshot(snapshot);
+        HudState state;
+        state.moves = score.getMoves();
+        state.matches = board.getMatchesFound();
+        state.totalPairs = 18;
+        state.score = score.getScore();
+        state.elapsedSeconds = static_cast<int>(frames * STEP);
+        state.hasBoard = true;
+        state.hintsRemaining = board.getHintsRemaining();
+        state.canUseHint = board.canUseHint();
+        state.hintCooldownSeconds = static_cast<int>(board.getHintCooldown());
+        if (!hudValid || state != hud) {
+            layoutHud(textCache, clock, state);
+            hud = state;
+            hudValid = true;
+            ++hudRebuilds;
+        }
+        tracker.endFrame(true);
+    }
+    CHECK(board.allMatched() && hinted && shuffled);
+    CHECK(hudRebuilds > 16 && textCache.getMisses() > 16);    // a rebake per click, runs recycled
+    CHECK(tracker.getFrames() > static_cast<std::uint64_t>(AllocationTracker::BUDGET_WARMUP_FRAMES) * 4);
+    CHECK(tracker.getViolations() == 0);
+}
+
+} // namespace
+
+void runAllocationTests() {
+    testCounting();
+    testFramesAndPhases();
+    testBudget();
+    testPlayingDoesNotAllocate();
+}
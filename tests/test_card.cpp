@@ -0,0 +1,153 @@
+/**
+ * @file test_card.cpp
+ * @brief Card: the flip state machine, moves, hit-testing and saved state
+ */
+
+#include "test_harness.h"
+#include "../include/Card.h"
+#include "../include/SimulationClock.h"
+
+#include <cmath>
+
+namespace {
+
+constexpr float STEP = SimulationClock::DEFAULT_STEP;
+
+/// A logic-only card: an empty texture path loads nothing
+Card makeCard(int id = 3) {
+    return Card(id, "", {100.0f, 50.0f}, {40.0f, 60.0f});
+}
+
+int stepsUntilSettled(Card& card, int limit = 600) {
+    int steps = 0;
+    do {
+        card.update(STEP);
+        ++steps;
+    } while (!card.isSettled() && steps < limit);
+    return steps;
+}
+
+void testFlipLifecycle() {
+    Card card = makeCard();
+    CHECK(card.getState() == CardState::FACE_DOWN);
+    CHECK(!card.isRevealed() && !card.isAnimating() && !card.isMatched());
+    CHECK(card.getFlipAmount() == 0.0f);
+
+    // Face down -> flipping up -> face up, turning a little every step
+    card.flipUp();
+    CHECK(card.getState() == CardState::FLIPPING_UP && card.isAnimating() && !card.isRevealed());
+    bool increasing = true;
+    float last = card.getFlipAmount();
+    int steps = 0;
+    while (card.getState() == CardState::FLIPPING_UP && steps < 100) {
+        card.update(STEP);
+        increasing = increasing && card.getFlipAmount() >= last;
+        last = card.getFlipAmount();
+        ++steps;
+    }
+    CHECK(increasing);
+    CHECK(card.getState() == CardState::FACE_UP && card.isRevealed());
+    CHECK(card.getFlipAmount() == 1.0f);
+    CHECK(steps == 8); // FLIP_ANIMATION_SPEED 8 per second at 60 steps per second
+
+    // Flipping up again does nothing; face up -> flipping down -> face down
+    card.flipUp();
+    CHECK(card.getState() == CardState::FACE_UP);
+    card.flipDown();
+    CHECK(card.getState() == CardState::FLIPPING_DOWN);
+    stepsUntilSettled(card);
+    CHECK(card.getState() == CardState::FACE_DOWN && card.getFlipAmount() == 0.0f);
+
+    // A face-down card stays down
+    card.flipDown();
+    CHECK(card.getState() == CardState::FACE_DOWN);
+
+    // Turned back part way up, it goes down from where it got to
+    card.flipUp();
+    for (int i = 0; i < 3; ++i) card.update(STEP);
+    const float partWay = card.getFlipAmount();
+    card.flipDown();
+    CHECK(card.getState() == CardState::FLIPPING_DOWN);
+    CHECK(std::fabs(card.getFlipAmount() - partWay) < 1e-5f);
+    CHECK(stepsUntilSettled(card) <= 4);
+    CHECK(card.getState() == CardState::FACE_DOWN);
+}
+
+void testMatchedCardsStay() {
+    Card card = makeCard();
+    card.flipUp();
+    stepsUntilSettled(card);
+    card.setMatched();
+    CHECK(card.isMatched() && card.isRevealed() && !card.isAnimating());
+    card.flipDown();
+    card.flipUp();
+    stepsUntilSettled(card);
+    CHECK(card.getState() == CardState::MATCHED && card.getFlipAmount() == 1.0f);
+}
+
+void testContainsPoint() {
+    Card card = makeCard();
+    CHECK(card.containsPoint({100.0f, 50.0f}));   // edges are inside
+    CHECK(card.containsPoint({140.0f, 110.0f}));
+    CHECK(card.containsPoint({120.0f, 80.0f}));
+    CHECK(!card.containsPoint({99.9f, 80.0f}));
+    CHECK(!card.containsPoint({120.0f, 110.1f}));
+    Rectangle bounds = card.getBounds();
+    CHECK(bounds.x == 100.0f && bounds.y == 50.0f && bounds.width == 40.0f && bounds.height == 60.0f);
+}
+
+void testMoves() {
+    Card card = makeCard();
+    const Vector2 target = {400.0f, 300.0f};
+    card.moveTo(target, 0.5f);
+    CHECK(card.isMoving() && !card.isSettled());
+    CHECK(card.getDestination().x == target.x && card.getDestination().y == target.y);
+
+    // Lands exactly on the target, and the render position gets there with it
+    const int steps = stepsUntilSettled(card);
+    CHECK(steps >= 30 && steps <= 32);
+    CHECK(!card.isMoving());
+    CHECK(card.getPosition().x == target.x && card.getPosition().y == target.y);
+    Vector2 drawn = card.getRenderPosition(0.5f);
+    CHECK(drawn.x == target.x && drawn.y == target.y);
+
+    // A jump moves without interpolating, and cancels a move
+    card.moveTo({0.0f, 0.0f}, 1.0f);
+    card.update(STEP);
+    card.setPosition({7.0f, 9.0f});
+    CHECK(!card.isMoving());
+    drawn = card.getRenderPosition(0.0f);
+    CHECK(drawn.x == 7.0f && drawn.y == 9.0f);
+}
+
+void testSaveAndRestore() {
+    Card card = makeCard();
+    card.moveTo({300.0f, 200.0f}, 1.0f);
+    card.flipUp();
+    for (int i = 0; i < 3; ++i) card.update(STEP);
+    Card::LogicState saved;
+    card.saveState(saved);
+
+    // Both run on identically from the saved state
+    Card copy = makeCard();
+    copy.restoreState(saved);
+    bool same = true;
+    for (int i = 0; i < 90; ++i) {
+        card.update(STEP);
+        copy.update(STEP);
+        same = same && card.getState() == copy.getState() && card.getFlipAmount() == copy.getFlipAmount() &&
+               card.getPosition().x == copy.getPosition().x && card.getPosition().y == copy.getPosition().y;
+    }
+    CHECK(same);
+    CHECK(copy.getState() == CardState::FACE_UP && copy.isSettled());
+}
+
+} // namespace
+
+void runCardTests() {
+    testFlipLifecycle();
+    testMatchedCardsStay();
+    testContainsPoint();
+    testMoves();
+    testSaveAndRestore();
+}
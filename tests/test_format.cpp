@@ -0,0 +1,159 @@
+/**
+ * @file test_format.cpp
+ * @brief Format against the stream formatting it replaced, FormatBuffer and ClockText
+ */
+
+#include "test_harness.h"
+#include "../include/AllocationTracker.h"
+#include "../include/Format.h"
+#include "../include/Utils.h"
+
+#include <climits>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// What Utils::toString(float, int) and formatTime() did before Format
+std::string streamDecimal(float value, int precision) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(precision) << value;
+    return oss.str();
+}
+
+std::string streamClock(float seconds) {
+    int mins = static_cast<int>(seconds) / 60;
+    int secs = static_cast<int>(seconds) % 60;
+    std::ostringstream oss;
+    oss << (mins < 10 ? "0" : "") << mins << ":" << (secs < 10 ? "0" : "") << secs;
+    return oss.str();
+}
+
+std::string decimal(float value, int precision) {
+    char text[Format::DECIMAL_CHARS];
+    return std::string(text, Format::decimal(text, sizeof(text), value, precision));
+}
+
+void testIntegers() {
+    for (long long value : {0LL, 7LL, -7LL, 42LL, 1000000LL, static_cast<long long>(INT_MIN), LLONG_MAX, LLONG_MIN}) {
+        char text[Format::INTEGER_CHARS];
+        CHECK(std::string(text, Format::integer(text, sizeof(text), value)) == std::to_string(value));
+    }
+    char text[Format::INTEGER_CHARS];
+    CHECK(std::string(text, Format::integer(text, sizeof(text), ULLONG_MAX)) == std::to_string(ULLONG_MAX));
+
+    // Too small a buffer writes nothing
+    char small[2];
+    CHECK(Format::integer(small, sizeof(small), 123LL) == 0);
+    CHECK(Utils::toString(-2147483647 - 1) == "-2147483648");
+}
+
+void testDecimalsMatchStreams() {
+    // Rounding ties and edges, then random values across the magnitudes the game prints
+    const float edges[] = {0.0f, -0.0f, 0.5f, 1.5f, 2.5f, 0.125f, 0.375f, -0.125f, 0.005f, 0.015f, 0.045f, 1.005f,
+                           -0.001f, 9.995f, 99.5f, 123456.789f, 16777216.0f, 3.0e9f, 9.0e15f, 1.0e20f, -3.4e38f,
+                           1.0e-30f, std::numeric_limits<float>::denorm_min()};
+    bool same = true;
+    for (float value : edges) {
+        for (int precision = 0; precision <= Format::MAX_PRECISION; ++precision) {
+            same = same && decimal(value, precision) == streamDecimal(value, precision);
+        }
+    }
+    CHECK(same);
+
+    std::mt19937 rng(2025);
+    std::uniform_real_distribution<float> mantissa(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> exponent(-8, 12);
+    std::uniform_int_distribution<int> precisionOf(0, Format::MAX_PRECISION);
+    int mismatches = 0;
+    for (int i = 0; i < 200000; ++i) {
+        const float value = std::ldexp(mantissa(rng), exponent(rng) * 3);
+        const int precision = precisionOf(rng);
+        if (decimal(value, precision) != streamDecimal(value, precision)) ++mismatches;
+    }
+    CHECK(mismatches == 0);
+
+    // Out of range precision is clamped; not-a-number and infinity still print
+    CHECK(decimal(1.25f, -3) == "1");
+    CHECK(decimal(1.0f, 20) == "1.000000000");
+    CHECK(decimal(std::numeric_limits<float>::infinity(), 2) == "inf");
+    CHECK(Utils::toString(1.005f, 2) == streamDecimal(1.005f, 2));
+}
+
+void testClock() {
+    bool same = true;
+    for (float seconds = 0.0f; seconds < 7200.0f; seconds += 0.7f) {
+        char text[Format::CLOCK_CHARS];
+        same = same && std::string(text, Format::clock(text, sizeof(text), seconds)) == streamClock(seconds);
+    }
+    CHECK(same);
+    CHECK(Utils::formatTime(5999.9f) == "99:59");
+    CHECK(Utils::formatTime(6000.0f) == "100:00");
+    CHECK(Utils::formatTime(-3.0f) == "00:00");
+    CHECK(Utils::formatTime(std::nanf("")) == "00:00");
+    // Clamped, and the longest clock still fits: 999999986991104 s as a float
+    CHECK(Utils::formatTime(Format::MAX_CLOCK_SECONDS) == "16666666449851:44");
+    CHECK(Utils::formatTime(1.0e30f) == Utils::formatTime(Format::MAX_CLOCK_SECONDS));
+    ClockText longest;
+    CHECK(longest.update(1.0e30f) == "16666666449851:44");
+
+    char small[4];
+    CHECK(Format::clock(small, sizeof(small), 61.0f) == 0);
+}
+
+void testFormatBuffer() {
+    FormatBuffer<32> text;
+    CHECK(text.empty() && text.c_str()[0] == '\0');
+    text.append("PAIRS: ").append(3).append('/').append(18u);
+    CHECK(text.view() == "PAIRS: 3/18" && std::string(text.c_str()) == "PAIRS: 3/18");
+    text.clear().append("t=").appendDecimal(2.5f, 1).append(' ').appendClock(125.0f);
+    CHECK(text.view() == "t=2.5 02:05" && !text.truncated());
+
+    // Text is cut at the capacity, numbers that do not fit are left out
+    FormatBuffer<8> small;
+    small.append("SCORE: ").append(12345);
+    CHECK(small.view() == "SCORE: " && small.truncated());
+    small.clear().append("0123456789");
+    CHECK(small.view() == "01234567" && small.size() == 8 && small.truncated());
+    CHECK(small.c_str()[8] == '\0');
+}
+
+void testClockText() {
+    ClockText clock;
+    CHECK(clock.update(0.2f) == "00:00");
+    const char* data = clock.view().data();
+    CHECK(clock.update(0.9f) == "00:00");
+    CHECK(clock.update(61.5f) == "01:01");
+    CHECK(clock.view().data() == data);     // rewritten in place
+    CHECK(clock.update(-1.0f) == "00:00");
+}
+
+void testNoAllocations() {
+    // Nothing here may reach operator new (the test binary counts it)
+    const AllocationCounts before = AllocationTracker::current();
+    FormatBuffer<96> text;
+    ClockText clock;
+    std::size_t total = 0;
+    for (int i = 0; i < 1000; ++i) {
+        text.clear().append("Frame: ").appendDecimal(i * 0.37f, 2).append(" ms, ").append(i).append(' ');
+        total += text.size() + clock.update(i * 0.5f).size();
+    }
+    const AllocationCounts after = AllocationTracker::current();
+    CHECK(total > 0);
+    CHECK(after.allocations == before.allocations);
+}
+
+} // namespace
+
+void runFormatTests() {
+    testIntegers();
+    testDecimalsMatchStreams();
+    testClock();
+    testFormatBuffer();
+    testClockText();
+    testNoAllocations();
+}
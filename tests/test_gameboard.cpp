@@ -0,0 +1,306 @@
+/**
+ * @file test_gameboard.cpp
+ * @brief GameBoard: the deal, matching rules, hints, and random play against a model of the rules
+ */
+
+#include "test_harness.h"
+#include "../include/GameBoard.h"
+#include "../include/ScoreManager.h"
+#include "../include/SimulationClock.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr float STEP = SimulationClock::DEFAULT_STEP;
+constexpr Vector2 CARD_SIZE = {50.0f, 70.0f};
+constexpr float PADDING = 10.0f;
+constexpr Rectangle BOUNDS = {20.0f, 30.0f, 800.0f, 600.0f};
+
+std::unique_ptr<GameBoard> makeBoard(std::uint32_t seed, int grid = 4) {
+    return std::make_unique<GameBoard>(grid, grid, CARD_SIZE, PADDING, BOUNDS, seed, true);
+}
+
+std::vector<CardSnapshot> cardsOf(const GameBoard& board) {
+    BoardSnapshot snapshot;
+    board.fillSnapshot(snapshot);
+    return snapshot.cards;
+}
+
+void run(GameBoard& board, float seconds) {
+    for (int i = 0; i < static_cast<int>(seconds / STEP + 0.5f); ++i) board.update(STEP);
+}
+
+/// Index of the card with id, other than skip
+int find(const std::vector<CardSnapshot>& cards, int id, int skip = -1) {
+    for (int i = 0; i < static_cast<int>(cards.size()); ++i) {
+        if (cards[i].id == id && i != skip) return i;
+    }
+    return -1;
+}
+
+Vector2 centerOf(const CardSnapshot& card) {
+    return {card.position.x + card.size.x / 2.0f, card.position.y + card.size.y / 2.0f};
+}
+
+bool faceUpUnmatched(CardState state) {
+    return state == CardState::FACE_UP || state == CardState::FLIPPING_UP;
+}
+
+void testDeal() {
+    std::unique_ptr<GameBoard> board = makeBoard(11, 6);
+    std::vector<CardSnapshot> cards = cardsOf(*board);
+    CHECK(cards.size() == 36);
+
+    // Every id twice, every card face down on its own slot
+    std::vector<int> counts(18, 0);
+    std::vector<bool> slotTaken(36, false);
+    bool valid = true;
+    for (const CardSnapshot& card : cards) {
+        valid = valid && card.id >= 0 && card.id < 18 && card.state == CardState::FACE_DOWN;
+        if (!valid) break;
+        ++counts[card.id];
+        const int slot = board->slotAt(centerOf(card));
+        valid = valid && slot >= 0 && !slotTaken[slot];
+        if (valid) slotTaken[slot] = true;
+        Vector2 center = board->getSlotCenter(slot);
+        valid = valid && center.x == centerOf(card).x && center.y == centerOf(card).y;
+    }
+    CHECK(valid);
+    CHECK(std::all_of(counts.begin(), counts.end(), [](int count) { return count == 2; }));
+
+    // Gaps between cards and points off the board are no slot
+    CHECK(board->slotAt({BOUNDS.x + CARD_SIZE.x + PADDING / 2.0f, BOUNDS.y + 5.0f}) == -1);
+    CHECK(board->slotAt({BOUNDS.x - 1.0f, BOUNDS.y + 5.0f}) == -1);
+
+    // The deal is the seed's
+    std::vector<CardSnapshot> again = cardsOf(*makeBoard(11, 6));
+    std::vector<CardSnapshot> other = cardsOf(*makeBoard(12, 6));
+    bool same = true;
+    bool differs = false;
+    for (std::size_t i = 0; i < cards.size(); ++i) {
+        same = same && again[i].id == cards[i].id;
+        differs = differs || other[i].id != cards[i].id;
+    }
+    CHECK(same);
+    CHECK(differs);
+    CHECK(!board->allMatched() && board->getMatchesFound() == 0);
+}
+
+void testMatchAndMismatch() {
+    std::unique_ptr<GameBoard> board = makeBoard(3);
+    ScoreManager score;
+    board->setScoreManager(&score);
+    std::vector<CardSnapshot> cards = cardsOf(*board);
+
+    // A pair matches at once and the combo grows
+    const int first = 0;
+    const int partner = find(cards, cards[first].id, first);
+    CHECK(board->handleClick(centerOf(cards[first])));
+    CHECK(!board->handleClick(centerOf(cards[first])));   // already turning up
+    CHECK(board->handleClick(centerOf(cards[partner])));
+    CHECK(board->getMatchesFound() == 1 && board->getComboCount() == 1);
+    cards = cardsOf(*board);
+    CHECK(cards[first].state == CardState::MATCHED && cards[partner].state == CardState::MATCHED);
+    CHECK(!board->handleClick(centerOf(cards[first])));   // matched cards stay
+
+    // A second pair makes it 2, then a wrong guess resets it and locks the board
+    int a = -1;
+    for (int i = 0; i < static_cast<int>(cards.size()) && a < 0; ++i) {
+        if (cards[i].state == CardState::FACE_DOWN) a = i;
+    }
+    CHECK(board->handleClick(centerOf(cards[a])));
+    CHECK(board->handleClick(centerOf(cards[find(cards, cards[a].id, a)])));
+    CHECK(board->getComboCount() == 2);
+    cards = cardsOf(*board);
+    int x = -1;
+    int y = -1;
+    for (int i = 0; i < static_cast<int>(cards.size()); ++i) {
+        if (cards[i].state != CardState::FACE_DOWN) continue;
+        if (x < 0) x = i;
+        else if (y < 0 && cards[i].id != cards[x].id) y = i;
+    }
+    CHECK(board->handleClick(centerOf(cards[x])));
+    CHECK(board->handleClick(centerOf(cards[y])));
+    CHECK(board->getComboCount() == 0 && board->getMatchesFound() == 2);
+    int z = find(cards, cards[x].id, x);
+    CHECK(!board->handleClick(centerOf(cards[z])));   // locked while the wrong pair shows
+
+    // After the delay the wrong pair turns back and clicks count again
+    run(*board, 1.0f + 0.5f);
+    cards = cardsOf(*board);
+    CHECK(cards[x].state == CardState::FACE_DOWN && cards[y].state == CardState::FACE_DOWN);
+    CHECK(board->handleClick(centerOf(cards[z])));
+    CHECK(score.getMatches() == 2 && score.getScore() > 0);
+}
+
+void testHints() {
+    std::unique_ptr<GameBoard> board = makeBoard(5);
+    const int hints = board->getHintsRemaining();
+    CHECK(hints > 0 && board->canUseHint() && board->getHintsUsed() == 0);
+
+    // A hint shows a face-down pair, then turns it back
+    board->showHint();
+    CHECK(board->isHintActive() && board->getHintsRemaining() == hints - 1);
+    std::vector<CardSnapshot> cards = cardsOf(*board);
+    std::vector<int> shown;
+    for (int i = 0; i < static_cast<int>(cards.size()); ++i) {
+        if (cards[i].state == CardState::FLIPPING_UP) shown.push_back(i);
+    }
+    CHECK(shown.size() == 2 && cards[shown[0]].id == cards[shown[1]].id);
+    CHECK(!board->handleClick(centerOf(cards[0])));   // no clicks while it shows
+    CHECK(!board->canUseHint());                      // cooling down
+
+    run(*board, 3.5f);
+    cards = cardsOf(*board);
+    CHECK(!board->isHintActive());
+    CHECK(cards[shown[0]].state == CardState::FACE_DOWN && cards[shown[1]].state == CardState::FACE_DOWN);
+
+    // No hint with a card up
+    run(*board, 15.0f);
+    CHECK(board->canUseHint());
+    CHECK(board->handleClick(centerOf(cards[0])));
+    board->showHint();
+    CHECK(!board->isHintActive() && board->getHintsRemaining() == hints - 1);
+}
+
+/**
+ * Random play against a model of the rules. Each board gets a few
+ * thousand steps of clicks anywhere (mostly on cards), hints and
+ * reshuffles at random moments, including mid-flip and mid-shuffle,
+ * and after every action and every step:
+ *  - twice as many cards are matched as pairs were found,
+ *  - at most two unmatched cards are up or turning up,
+ *  - the combo is what the model says: up on a match, 0 after a wrong
+ *    pair, a hint or a reshuffle,
+ *  - a finished shuffle left the same ids on the same set of slots,
+ *    matched cards where they were.
+ */
+void testRandomPlayKeepsTheRules() {
+    bool matchedTwicePairs = true;
+    bool atMostTwoUp = true;
+    bool comboFollowsRules = true;
+    bool shufflesPermute = true;
+    bool someCleared = false;
+    bool someShuffled = false;
+
+    for (std::uint32_t seed = 0; seed < 200; ++seed) {
+        std::mt19937 fuzz(seed * 7919 + 1);
+        std::unique_ptr<GameBoard> board = makeBoard(seed, seed % 3 == 0 ? 6 : 4);
+        ScoreManager score;
+        board->setScoreManager(&score);
+
+        int pendingId = -1;   // the model: the first card of a pair, if one is up
+        int combo = 0;
+        bool wasShuffling = false;
+        std::vector<CardSnapshot> beforeShuffle;
+
+        auto checkInvariants = [&] {
+            std::vector<CardSnapshot> cards = cardsOf(*board);
+            int matched = 0;
+            int up = 0;
+            for (const CardSnapshot& card : cards) {
+                matched += card.state == CardState::MATCHED;
+                up += faceUpUnmatched(card.state);
+            }
+            matchedTwicePairs = matchedTwicePairs && matched == 2 * board->getMatchesFound();
+            atMostTwoUp = atMostTwoUp && up <= 2;
+            comboFollowsRules = comboFollowsRules && board->getComboCount() == combo;
+
+            if (wasShuffling && !board->isShuffling()) {
+                std::vector<std::pair<float, float>> slotsBefore;
+                std::vector<std::pair<float, float>> slotsAfter;
+                for (std::size_t i = 0; i < cards.size(); ++i) {
+                    const CardSnapshot& was = beforeShuffle[i];
+                    const CardSnapshot& is = cards[i];
+                    shufflesPermute = shufflesPermute && was.id == is.id;
+                    if (was.state == CardState::MATCHED) {
+                        shufflesPermute = shufflesPermute && was.position.x == is.position.x &&
+                                          was.position.y == is.position.y;
+                    }
+                    slotsBefore.push_back({was.position.x, was.position.y});
+                    slotsAfter.push_back({is.position.x, is.position.y});
+                }
+                std::sort(slotsBefore.begin(), slotsBefore.end());
+                std::sort(slotsAfter.begin(), slotsAfter.end());
+                shufflesPermute = shufflesPermute && slotsBefore == slotsAfter;
+                someShuffled = true;
+            }
+            wasShuffling = board->isShuffling();
+        };
+
+        for (int step = 0; step < 3000 && !board->allMatched(); ++step) {
+            const unsigned roll = fuzz() % 100;
+            if (roll < 25) {
+                // A click: on a random card most of the time, anywhere near the board otherwise
+                std::vector<CardSnapshot> cards = cardsOf(*board);
+                Vector2 point;
+                if (fuzz() % 4 != 0) {
+                    point = centerOf(cards[fuzz() % cards.size()]);
+                } else {
+                    point = {BOUNDS.x - 20.0f + static_cast<float>(fuzz() % 400),
+                             BOUNDS.y - 20.0f + static_cast<float>(fuzz() % 520)};
+                }
+                int clicked = -1;
+                for (int i = 0; i < static_cast<int>(cards.size()) && clicked < 0; ++i) {
+                    const CardSnapshot& card = cards[i];
+                    if (point.x >= card.position.x && point.x <= card.position.x + card.size.x &&
+                        point.y >= card.position.y && point.y <= card.position.y + card.size.y) {
+                        clicked = i;
+                    }
+                }
+                const int matchesBefore = board->getMatchesFound();
+                if (board->handleClick(point)) {
+                    if (clicked < 0 || cards[clicked].state != CardState::FACE_DOWN) {
+                        atMostTwoUp = false;   // flipped something that was not a face-down card
+                    } else if (pendingId < 0) {
+                        pendingId = cards[clicked].id;
+                    } else {
+                        const bool pair = cards[clicked].id == pendingId;
+                        combo = pair ? combo + 1 : 0;
+                        comboFollowsRules = comboFollowsRules &&
+                                            board->getMatchesFound() == matchesBefore + (pair ? 1 : 0);
+                        pendingId = -1;
+                    }
+                }
+            } else if (roll < 27) {
+                const int hintsBefore = board->getHintsRemaining();
+                board->showHint();
+                if (board->getHintsRemaining() < hintsBefore) combo = 0;
+            } else if (roll < 28 && fuzz() % 8 == 0) {
+                if (!board->isShuffling()) {
+                    beforeShuffle = cardsOf(*board);
+                }
+                board->startShuffle(0.5f + static_cast<float>(fuzz() % 100) / 100.0f);
+                if (board->isShuffling()) {
+                    combo = 0;
+                    pendingId = -1;
+                }
+            }
+            checkInvariants();
+            board->update(STEP);
+            checkInvariants();
+        }
+        someCleared = someCleared || board->allMatched();
+    }
+
+    CHECK(matchedTwicePairs);
+    CHECK(atMostTwoUp);
+    CHECK(comboFollowsRules);
+    CHECK(shufflesPermute);
+    CHECK(someCleared);
+    CHECK(someShuffled);
+}
+
+} // namespace
+
+void runGameBoardTests() {
+    testDeal();
+    testMatchAndMismatch();
+    testHints();
+    testRandomPlayKeepsTheRules();
+}
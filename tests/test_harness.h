@@ -0,0 +1,29 @@
+/**
+ * @file test_harness.h
+ * @brief Minimal check macro shared by the unit tests
+ *
+ * CHECK works in every build type (unlike assert, which NDEBUG removes in
+ * Release) and keeps going after a failure so one run reports them all.
+ */
+
+#pragma once
+
+#include <iostream>
+
+namespace test {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+} // namespace test
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            ++test::failures();                                                       \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition \
+                      << std::endl;                                                   \
+        }                                                                             \
+    } while (0)
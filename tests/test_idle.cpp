@@ -0,0 +1,60 @@
+/**
+ * @file test_idle.cpp
+ * @brief IdleTracker: when the main loop may stop redrawing
+ */
+
+#include "test_harness.h"
+#include "../include/IdleTracker.h"
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+void testGoesIdleAfterDelay() {
+    IdleTracker tracker(1.0f);
+    CHECK(!tracker.isIdle());
+    CHECK(tracker.getTargetFps(60) == 60);
+
+    for (int i = 0; i < 55; ++i) {
+        tracker.update(TICK, false);
+    }
+    CHECK(!tracker.isIdle());
+
+    for (int i = 0; i < 10; ++i) {
+        tracker.update(TICK, false);
+    }
+    CHECK(tracker.isIdle());
+    CHECK(tracker.getTargetFps(60) == IdleTracker::IDLE_FPS);
+    CHECK(tracker.getIdleFrames() > 0);
+}
+
+void testActivityWakesImmediately() {
+    IdleTracker tracker(0.5f);
+    for (int i = 0; i < 60; ++i) {
+        tracker.update(TICK, false);
+    }
+    CHECK(tracker.isIdle());
+    unsigned long long idleFrames = tracker.getIdleFrames();
+
+    tracker.update(TICK, true);
+    CHECK(!tracker.isIdle());
+    CHECK(tracker.getTargetFps(60) == 60);
+    CHECK(tracker.getIdleFrames() == idleFrames);
+}
+
+void testSteadyActivityNeverIdles() {
+    IdleTracker tracker(0.5f);
+    // A single active frame per quarter second is enough to stay awake
+    for (int i = 0; i < 600; ++i) {
+        tracker.update(TICK, i % 15 == 0);
+        CHECK(!tracker.isIdle());
+    }
+}
+
+} // namespace
+
+void runIdleTests() {
+    testGoesIdleAfterDelay();
+    testActivityWakesImmediately();
+    testSteadyActivityNeverIdles();
+}
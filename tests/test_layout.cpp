@@ -0,0 +1,135 @@
+/**
+ * @file test_layout.cpp
+ * @brief LayoutTree: anchoring, scaling, stacks and hit-testing
+ */
+
+#include "test_harness.h"
+#include "../include/LayoutTree.h"
+
+#include <cmath>
+
+namespace {
+
+bool near(float a, float b) {
+    return std::fabs(a - b) < 1e-3f;
+}
+
+bool same(Rectangle a, Rectangle b) {
+    return near(a.x, b.x) && near(a.y, b.y) && near(a.width, b.width) && near(a.height, b.height);
+}
+
+LayoutNode centredFrame() {
+    LayoutNode frame;
+    frame.anchor = frame.pivot = {0.5f, 0.5f};
+    frame.size = {1024.0f, 768.0f};
+    return frame;
+}
+
+void testDesignSizeIsIdentity() {
+    LayoutTree layout(1024.0f, 768.0f);
+    int frame = layout.add(centredFrame());
+    LayoutNode button;
+    button.parent = frame;
+    button.anchor = {0.5f, 0.0f};
+    button.pivot = {0.5f, 0.0f};
+    button.offset = {0.0f, 220.0f};
+    button.size = {300.0f, 60.0f};
+    int id = layout.add(button);
+
+    CHECK(layout.resize(1024, 768));
+    CHECK(near(layout.getScale(), 1.0f));
+    CHECK(same(layout.get(frame), {0.0f, 0.0f, 1024.0f, 768.0f}));
+    CHECK(same(layout.get(id), {362.0f, 220.0f, 300.0f, 60.0f}));
+    CHECK(layout.pixels(24) == 24);
+}
+
+void testScalesUniformlyAndCentres() {
+    LayoutTree layout(1024.0f, 768.0f);
+    int frame = layout.add(centredFrame());
+    LayoutNode box;
+    box.parent = frame;
+    box.anchor = {0.5f, 0.5f};
+    box.offset = {-100.0f, -10.0f};
+    box.size = {200.0f, 60.0f};
+    int id = layout.add(box);
+
+    // 4K: height limits the scale, the frame is centred horizontally
+    layout.resize(3840, 2160);
+    const float scale = 2160.0f / 768.0f;
+    CHECK(near(layout.getScale(), scale));
+    Rectangle f = layout.get(frame);
+    CHECK(near(f.height, 2160.0f));
+    CHECK(near(f.x + f.width / 2.0f, 1920.0f));
+    CHECK(same(layout.get(id), {1920.0f - 100.0f * scale, 1080.0f - 10.0f * scale, 200.0f * scale, 60.0f * scale}));
+    CHECK(layout.pixels(24) == static_cast<int>(std::lround(24 * scale)));
+
+    // Small kiosk screen: width limits it
+    layout.resize(480, 800);
+    CHECK(near(layout.getScale(), 480.0f / 1024.0f));
+    CHECK(near(layout.get(frame).width, 480.0f));
+    CHECK(near(layout.get(frame).y, (800.0f - 768.0f * layout.getScale()) / 2.0f));
+    CHECK(layout.pixels(1) == 1);     // never rounds a visible length away
+}
+
+void testStretchAndEdges() {
+    LayoutTree layout(1024.0f, 768.0f);
+    LayoutNode board;
+    board.offset = {0.0f, 100.0f};
+    board.size = {0.0f, -200.0f};
+    board.stretch = {1.0f, 1.0f};
+    int boardId = layout.add(board);
+    LayoutNode corner;
+    corner.anchor = {0.0f, 1.0f};
+    corner.offset = {20.0f, -40.0f};
+    int cornerId = layout.add(corner);
+
+    layout.resize(2048, 1536);
+    CHECK(same(layout.get(boardId), {0.0f, 200.0f, 2048.0f, 1136.0f}));
+    CHECK(same(layout.get(cornerId), {40.0f, 1456.0f, 0.0f, 0.0f}));
+}
+
+void testLayoutOnlyWhenSizeChanges() {
+    LayoutTree layout(1024.0f, 768.0f);
+    layout.add(centredFrame());
+    CHECK(layout.resize(800, 600));
+    CHECK(!layout.resize(800, 600));
+    CHECK(layout.getLayoutPasses() == 1);
+    CHECK(layout.resize(1280, 720));
+    CHECK(layout.getLayoutPasses() == 2);
+
+    // Added after a resize: placed right away
+    LayoutNode late;
+    late.size = {10.0f, 10.0f};
+    CHECK(near(layout.get(layout.add(late)).width, 10.0f * layout.getScale()));
+    // Unknown ids are empty, unknown parents mean the window
+    CHECK(same(layout.get(99), {0.0f, 0.0f, 0.0f, 0.0f}));
+    late.parent = 42;
+    late.stretch = {1.0f, 0.0f};
+    CHECK(near(layout.get(layout.add(late)).width, 1280.0f + 10.0f * layout.getScale()));
+}
+
+void testStackHitTest() {
+    LayoutTree layout(1024.0f, 768.0f);
+    LayoutNode button;
+    button.offset = {100.0f, 200.0f};
+    button.size = {300.0f, 60.0f};
+    int first = layout.addStack(button, 4, {0.0f, 80.0f});
+    CHECK(layout.getNodeCount() == 4);
+
+    layout.resize(2048, 1536);
+    CHECK(same(layout.get(first + 3), {200.0f, 880.0f, 600.0f, 120.0f}));
+    CHECK(layout.hitTest({250.0f, 410.0f}, first, 4) == 0);
+    CHECK(layout.hitTest({250.0f, 570.0f}, first, 4) == 1);
+    CHECK(layout.hitTest({250.0f, 540.0f}, first, 4) == -1);     // in the gap
+    CHECK(layout.hitTest({250.0f, 900.0f}, first, 3) == -1);     // outside the range asked about
+}
+
+} // namespace
+
+void runLayoutTests() {
+    testDesignSizeIsIdentity();
+    testScalesUniformlyAndCentres();
+    testStretchAndEdges();
+    testLayoutOnlyWhenSizeChanges();
+    testStackHitTest();
+}
@@ -0,0 +1,237 @@
+/**
+ * @file test_leaderboard.cpp
+ * @brief Leaderboard: ranking order, the log round trip and damaged logs
+ */
+
+#include "test_harness.h"
+#include "../include/Leaderboard.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace {
+
+void removeLog(const std::string& path) {
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".bak");
+    std::filesystem::remove(path + ".tmp");
+}
+
+std::string tempLog(const char* name) {
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+    removeLog(path);
+    return path;
+}
+
+LeaderboardEntry game(int difficulty, int score, unsigned milliseconds, int moves) {
+    LeaderboardEntry entry;
+    entry.difficulty = difficulty;
+    entry.score = score;
+    entry.milliseconds = milliseconds;
+    entry.moves = moves;
+    return entry;
+}
+
+void testOrderAndTies() {
+    Leaderboard board(tempLog("mc_leaderboard_order.bin"));
+    CHECK(board.load());
+    board.record(game(16, 50, 9000, 20));
+    board.record(game(16, 80, 12000, 30));
+    board.record(game(16, 80, 10000, 30));   // same score, faster
+    board.record(game(16, 80, 10000, 25));   // same time, fewer moves
+    board.record(game(16, 80, 10000, 25));   // exact tie: the earlier game stays ahead
+    board.record(game(36, 500, 1000, 10));   // another difficulty
+
+    std::vector<LeaderboardEntry> top;
+    board.top(16, 10, top);
+    CHECK(top.size() == 5);
+    CHECK(top[0].moves == 25 && top[0].sequence == 3);
+    CHECK(top[1].moves == 25 && top[1].sequence == 4);
+    CHECK(top[2].milliseconds == 10000 && top[2].moves == 30);
+    CHECK(top[3].milliseconds == 12000);
+    CHECK(top[4].score == 50);
+
+    board.top(16, 2, top);
+    CHECK(top.size() == 2);
+    board.top(64, 10, top);
+    CHECK(top.empty());
+
+    CHECK(board.count(16) == 5 && board.count(36) == 1 && board.size() == 6);
+    CHECK(board.rankOf(game(16, 1000, 0, 0)) == 0);
+    CHECK(board.rankOf(game(16, 60, 0, 0)) == 4);
+    CHECK(board.rankOf(game(36, 0, 0, 0)) == 1);
+    board.flush();
+    removeLog(board.getPath());
+}
+
+void testReload() {
+    const std::string path = tempLog("mc_leaderboard_reload.bin");
+    {
+        Leaderboard board(path);
+        CHECK(board.load());
+        LeaderboardEntry entry = game(64, 321, 123456, 77);
+        entry.timestamp = 1760400000;
+        entry.hintsUsed = 2;
+        entry.shufflesUsed = 1;
+        board.record(entry);
+        board.record(game(64, 400, 200000, 90));
+    }
+    CHECK(std::filesystem::file_size(path) == Leaderboard::HEADER_SIZE + 2 * Leaderboard::RECORD_SIZE);
+
+    Leaderboard board(path);
+    CHECK(board.load());
+    CHECK(board.size() == 2);
+    std::vector<LeaderboardEntry> top;
+    board.top(64, 10, top);
+    CHECK(top.size() == 2);
+    CHECK(top[0].score == 400);
+    CHECK(top[1].score == 321 && top[1].milliseconds == 123456 && top[1].moves == 77);
+    CHECK(top[1].timestamp == 1760400000 && top[1].hintsUsed == 2 && top[1].shufflesUsed == 1);
+
+    // Appends after a reload continue the same log
+    board.record(game(64, 10, 1, 1));
+    board.flush();
+    Leaderboard again(path);
+    CHECK(again.load() && again.size() == 3);
+    again.flush();
+    removeLog(path);
+}
+
+void testTornTail() {
+    const std::string path = tempLog("mc_leaderboard_torn.bin");
+    {
+        Leaderboard board(path);
+        board.load();
+        board.record(game(16, 10, 1000, 5));
+        board.record(game(16, 20, 1000, 5));
+    }
+    // A crash halfway through a third record
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.write("partial", 7);
+    }
+    Leaderboard board(path);
+    CHECK(board.load());
+    CHECK(board.size() == 2);
+    CHECK(std::filesystem::file_size(path) == Leaderboard::HEADER_SIZE + 2 * Leaderboard::RECORD_SIZE);
+
+    // A scribbled second record with no last good copy: it and everything after it go
+    board.flush();
+    std::filesystem::remove(board.getBackupPath());
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(Leaderboard::HEADER_SIZE + Leaderboard::RECORD_SIZE + 20));
+        file.put('\x7f');
+    }
+    CHECK(board.load());
+    CHECK(board.size() == 1);
+    CHECK(std::filesystem::file_size(path) == Leaderboard::HEADER_SIZE + Leaderboard::RECORD_SIZE);
+
+    board.record(game(16, 30, 1000, 5));
+    board.flush();
+    Leaderboard again(path);
+    CHECK(again.load() && again.size() == 2);
+    again.flush();
+    removeLog(path);
+}
+
+void testRestoreFromCopy() {
+    const std::string path = tempLog("mc_leaderboard_restore.bin");
+    {
+        Leaderboard board(path);
+        board.load();
+        for (int i = 0; i < 3; ++i) {
+            board.record(game(36, 100 + i, 1000, 5));
+        }
+    }
+    {
+        Leaderboard board(path);
+        CHECK(board.load() && board.size() == 3);    // clean: becomes the last good copy
+        board.flush();
+        CHECK(std::filesystem::file_size(board.getBackupPath()) == std::filesystem::file_size(path));
+    }
+
+    // Header scribbled over: the copy is loaded and put back in place
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.write("XXXX", 4);
+    }
+    Leaderboard board(path);
+    CHECK(board.load());
+    CHECK(board.size() == 3 && board.isWritable());
+    board.record(game(36, 500, 1000, 5));
+    board.flush();
+    CHECK(board.getWriteFailures() == 0);
+
+    Leaderboard again(path);
+    CHECK(again.load() && again.size() == 4);
+    std::vector<LeaderboardEntry> top;
+    again.top(36, 1, top);
+    CHECK(!top.empty() && top[0].score == 500);
+
+    // The log gone altogether: same
+    again.flush();
+    std::filesystem::remove(path);
+    CHECK(again.load() && again.size() == 4);
+    again.flush();
+    CHECK(std::filesystem::file_size(path) == Leaderboard::HEADER_SIZE + 4 * Leaderboard::RECORD_SIZE);
+    removeLog(path);
+}
+
+void testForeignFile() {
+    const std::string path = tempLog("mc_leaderboard_foreign.bin");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "1234 not a leaderboard";
+    }
+    const auto size = std::filesystem::file_size(path);
+    Leaderboard board(path);
+    CHECK(!board.load());
+    CHECK(!board.isWritable());
+    board.record(game(16, 10, 1000, 5));    // still ranked in memory...
+    board.flush();
+    CHECK(board.count(16) == 1);
+    CHECK(std::filesystem::file_size(path) == size);    // ...but the file is untouched
+    removeLog(path);
+}
+
+void testAgainstSort() {
+    // The treap has to agree with a plain sort, ties included
+    Leaderboard board("");
+    board.load();
+    std::mt19937 rng(41);
+    std::vector<LeaderboardEntry> all;
+    for (int i = 0; i < 20000; ++i) {
+        LeaderboardEntry entry = game(16, static_cast<int>(rng() % 200) - 50,
+                                      static_cast<unsigned>(rng() % 50) * 1000, static_cast<int>(rng() % 40));
+        all.push_back(board.record(entry));
+    }
+    std::sort(all.begin(), all.end(), LeaderboardIndex::ahead);
+
+    std::vector<LeaderboardEntry> top;
+    board.top(16, 500, top);
+    CHECK(top.size() == 500);
+    bool same = true;
+    for (std::size_t i = 0; i < top.size(); ++i) {
+        same = same && top[i].sequence == all[i].sequence;
+    }
+    CHECK(same);
+
+    bool ranked = true;
+    for (std::size_t i = 0; i < all.size(); i += 97) {
+        ranked = ranked && board.rankOf(all[i]) == i;
+    }
+    CHECK(ranked);
+}
+
+} // namespace
+
+void runLeaderboardTests() {
+    testOrderAndTies();
+    testReload();
+    testTornTail();
+    testRestoreFromCopy();
+    testForeignFile();
+    testAgainstSort();
+}
@@ -1,4 +1,56 @@
+#include "test_harness.h"
+
+void runUtilsTests();
+void runCardTests();
+void runGameBoardTests();
+void runNetworkTests();
+void runUdpTests();
+void runSpectatorTests();
+void runIdleTests();
+void runParticleTests();
+void runSimulationTests();
+void runThreadingTests();
+void runPacingTests();
+void runTextTests();
+void runLayoutTests();
+void runWidgetTests();
+void runLeaderboardTests();
+void runPersistenceTests();
+void runReplayTests();
+void runReplayPlayerTests();
+void runSavedGameTests();
+void runPerfTests();
+void runAllocationTests();
+void runFormatTests();
+
 int main() {
-    // TODO: Add tests here
+    runUtilsTests();
+    runCardTests();
+    runGameBoardTests();
+    runNetworkTests();
+    runUdpTests();
+    runSpectatorTests();
+    runIdleTests();
+    runParticleTests();
+    runSimulationTests();
+    runThreadingTests();
+    runPacingTests();
+    runTextTests();
+    runLayoutTests();
+    runWidgetTests();
+    runLeaderboardTests();
+    runPersistenceTests();
+    runReplayTests();
+    runReplayPlayerTests();
+    runSavedGameTests();
+    runPerfTests();
+    runAllocationTests();
+    runFormatTests();
+
+    if (test::failures() > 0) {
+        std::cerr << test::failures() << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,381 @@
+/**
+ * @file test_network.cpp
+ * @brief Headless multiplayer tests over the simulated network link
+ */
+
+#include "test_harness.h"
+#include "../include/NetSync.h"
+#include "../include/NetworkSession.h"
+#include "../include/NetworkSimulator.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+// Reads everything currently available on an endpoint
+std::string drain(Transport& transport) {
+    std::string bytes;
+    char buffer[64];
+    long received;
+    while ((received = transport.receive(buffer, sizeof(buffer))) > 0) {
+        bytes.append(buffer, static_cast<size_t>(received));
+    }
+    return bytes;
+}
+
+// Arrival time of each chunk the receiver sees while streaming a payload
+std::vector<float> deliveryTimeline(const NetworkConditions& conditions, unsigned int seed) {
+    NetworkSimulator simulator(conditions, seed);
+    auto sender = simulator.takeEndpoint(0);
+    auto receiver = simulator.takeEndpoint(1);
+
+    std::vector<float> timeline;
+    for (int i = 0; i < 20; ++i) {
+        sender->send("FLIP 3\nFLIP 4\n", 14);
+        simulator.advance(TICK);
+        if (!drain(*receiver).empty()) {
+            timeline.push_back(simulator.getTime());
+        }
+    }
+    return timeline;
+}
+
+/**
+ * @brief Two sessions playing a scripted match over a simulated link
+ *
+ * Whoever holds the turn flips two cards, scores on every third move and
+ * passes the turn, exactly like the game does through NetworkSession.
+ */
+struct ScriptedMatch {
+    NetworkSimulator simulator;
+    NetworkSession host;
+    NetworkSession guest;
+    std::vector<std::string> sentByHost;
+    std::vector<std::string> sentByGuest;
+    int movesMade = 0;
+
+    ScriptedMatch(const NetworkConditions& conditions, unsigned int seed)
+        : simulator(conditions, seed) {
+        host.attach(NetworkMode::SERVER, simulator.takeEndpoint(0));
+        guest.attach(NetworkMode::CLIENT, simulator.takeEndpoint(1));
+    }
+
+    void tick() {
+        simulator.advance(TICK);
+        host.update(TICK);
+        guest.update(TICK);
+    }
+
+    void move(NetworkSession& player, std::vector<std::string>& sent) {
+        int first = (movesMade * 2) % 16;
+        int second = first + 1;
+        for (int slot : {first, second}) {
+            player.sendFlip(slot);
+            sent.push_back("FLIP " + std::to_string(slot));
+        }
+        if (movesMade % 3 == 0) {
+            player.sendMatch(first, second);
+            sent.push_back("MATCH " + std::to_string(first) + " " + std::to_string(second));
+            player.updateScore(player.getMyPlayerID(), 10);
+        }
+        player.nextTurn();
+        ++movesMade;
+    }
+
+    // Plays until the given number of moves were made, then lets the link settle
+    bool play(int moves, float timeLimit) {
+        while (movesMade < moves && simulator.getTime() < timeLimit) {
+            tick();
+            if (!host.isConnected() || !guest.isConnected()) {
+                continue;
+            }
+            if (host.getCurrentTurn() == 0 && host.isMyTurn()) {
+                move(host, sentByHost);
+            } else if (guest.getCurrentTurn() == 1 && guest.isMyTurn()) {
+                move(guest, sentByGuest);
+            }
+        }
+        for (int i = 0; i < 300; ++i) {
+            tick();
+        }
+        return movesMade == moves;
+    }
+
+    void checkConverged() {
+        CHECK(host.getCurrentTurn() == guest.getCurrentTurn());
+        CHECK(host.getPlayerScore(0) == guest.getPlayerScore(0));
+        CHECK(host.getPlayerScore(1) == guest.getPlayerScore(1));
+        CHECK(host.getPlayerScore(0) + host.getPlayerScore(1) == 10 * ((movesMade + 2) / 3));
+
+        std::vector<std::string> hostSaw;
+        std::vector<std::string> guestSaw;
+        host.takeRemoteEvents(hostSaw);
+        guest.takeRemoteEvents(guestSaw);
+        CHECK(hostSaw == sentByGuest);
+        CHECK(guestSaw == sentByHost);
+    }
+};
+
+/**
+ * @brief A host listening on the simulator and a guest that reconnects through it
+ */
+struct ReconnectingMatch {
+    NetworkSimulator simulator;
+    NetworkSession host;
+    NetworkSession guest;
+
+    ReconnectingMatch(const NetworkConditions& conditions, unsigned int seed, bool reachable = true)
+        : simulator(conditions, seed) {
+        simulator.setReachable(reachable);
+        host.attach(NetworkMode::SERVER, nullptr);
+        guest.startClient(NetworkMode::CLIENT, [this]() { return simulator.connect(); });
+    }
+
+    void tick() {
+        simulator.advance(TICK);
+        while (auto incoming = simulator.accept()) {
+            host.acceptTransport(std::move(incoming));
+        }
+        host.update(TICK);
+        guest.update(TICK);
+    }
+
+    template <typename Condition>
+    bool tickUntil(Condition condition, float timeLimit) {
+        float deadline = simulator.getTime() + timeLimit;
+        while (!condition()) {
+            if (simulator.getTime() >= deadline) {
+                return false;
+            }
+            tick();
+        }
+        return true;
+    }
+
+    bool established() const {
+        return host.isConnected() && guest.isHandshakeComplete();
+    }
+};
+
+// === Simulator ===
+
+void testSimulatorPreservesByteOrder() {
+    NetworkConditions conditions;
+    conditions.latency = 0.05f;
+    conditions.jitter = 0.04f;
+    conditions.lossRate = 0.3f;
+    conditions.maxSegmentSize = 3;
+    NetworkSimulator simulator(conditions, 7);
+    auto sender = simulator.takeEndpoint(0);
+    auto receiver = simulator.takeEndpoint(1);
+
+    std::string payload;
+    for (int i = 0; i < 100; ++i) {
+        payload += "SCORE 0 " + std::to_string(i) + "\n";
+    }
+    CHECK(sender->send(payload.data(), payload.size()) == static_cast<long>(payload.size()));
+
+    std::string received;
+    for (int i = 0; i < 600 && received.size() < payload.size(); ++i) {
+        simulator.advance(TICK);
+        received += drain(*receiver);
+    }
+    CHECK(received == payload);
+    CHECK(simulator.getRetransmissions() > 0);
+}
+
+void testSimulatorLatencyAndBandwidth() {
+    NetworkConditions conditions;
+    conditions.latency = 0.1f;
+    conditions.bandwidth = 1000.0f; // 100 bytes take 0.1 s to serialise
+    NetworkSimulator simulator(conditions, 1);
+    auto sender = simulator.takeEndpoint(0);
+    auto receiver = simulator.takeEndpoint(1);
+
+    std::string payload(100, 'x');
+    sender->send(payload.data(), payload.size());
+
+    simulator.advance(0.15f);
+    CHECK(drain(*receiver).empty());
+    simulator.advance(0.1f);
+    CHECK(drain(*receiver) == payload);
+}
+
+void testSimulatorIsDeterministic() {
+    NetworkConditions conditions;
+    conditions.latency = 0.08f;
+    conditions.jitter = 0.05f;
+    conditions.lossRate = 0.2f;
+    conditions.maxSegmentSize = 5;
+    conditions.coalesceWindow = 0.03f;
+
+    std::vector<float> first = deliveryTimeline(conditions, 42);
+    std::vector<float> second = deliveryTimeline(conditions, 42);
+    CHECK(!first.empty());
+    CHECK(first == second);
+}
+
+// === Sessions ===
+
+void testMatchConvergesOnCleanLink() {
+    ScriptedMatch match(NetworkConditions{}, 1);
+    CHECK(match.play(30, 60.0f));
+    match.checkConverged();
+}
+
+void testMatchConvergesOnBadLink() {
+    NetworkConditions conditions;
+    conditions.latency = 0.15f;
+    conditions.jitter = 0.08f;
+    conditions.lossRate = 0.1f;
+    conditions.bandwidth = 4000.0f;
+    conditions.maxSegmentSize = 7;
+    conditions.coalesceWindow = 0.03f;
+
+    ScriptedMatch match(conditions, 1234);
+    CHECK(match.play(30, 120.0f));
+    CHECK(match.simulator.getRetransmissions() > 0);
+    match.checkConverged();
+}
+
+void testDisconnectIsDetected() {
+    ScriptedMatch match(NetworkConditions{}, 1);
+    match.play(2, 10.0f);
+    CHECK(match.host.isConnected());
+    CHECK(match.guest.isConnected());
+
+    match.simulator.disconnect();
+    match.tick();
+    CHECK(!match.host.isConnected());
+    CHECK(!match.guest.isConnected());
+    // Without an opponent both sides fall back to local play
+    CHECK(match.host.isMyTurn());
+    CHECK(match.guest.isMyTurn());
+}
+
+void testReconnectResumesSession() {
+    NetworkConditions conditions;
+    conditions.latency = 0.05f;
+    ReconnectingMatch match(conditions, 3);
+    CHECK(match.tickUntil([&]() { return match.established(); }, 5.0f));
+
+    match.host.sendFlip(1);
+    match.host.updateScore(0, 10);
+    match.host.nextTurn();
+    CHECK(match.tickUntil([&]() { return match.guest.getCurrentTurn() == 1; }, 2.0f));
+
+    // Both sides flush a move, then the link dies with those moves still in flight
+    match.host.sendFlip(7);
+    match.guest.sendFlip(3);
+    match.tick();
+    match.simulator.disconnect();
+    const float cutAt = match.simulator.getTime();
+
+    // The host keeps playing while the guest is away
+    match.host.sendFlip(8);
+    match.host.updateScore(0, 10);
+
+    CHECK(match.tickUntil([&]() { return match.guest.getResumeCount() == 1 && match.host.getResumeCount() == 1; }, 10.0f));
+    const float reconnectTime = match.simulator.getTime() - cutAt;
+    std::cout << "Reconnect time over a 50 ms link: " << static_cast<int>(reconnectTime * 1000.0f) << " ms" << std::endl;
+    // One backoff step plus the connect and HELLO/WELCOME round trips
+    CHECK(reconnectTime < NetworkSession::INITIAL_RETRY_DELAY + 4 * conditions.latency + 0.1f);
+
+    for (int i = 0; i < 60; ++i) {
+        match.tick();
+    }
+
+    std::vector<std::string> guestSaw;
+    std::vector<std::string> hostSaw;
+    match.guest.takeRemoteEvents(guestSaw);
+    match.host.takeRemoteEvents(hostSaw);
+    CHECK((guestSaw == std::vector<std::string>{"FLIP 1", "FLIP 7", "FLIP 8"}));
+    CHECK((hostSaw == std::vector<std::string>{"FLIP 3"}));
+    CHECK(match.guest.getPlayerScore(0) == 20);
+    CHECK(match.host.getPlayerScore(0) == 20);
+    CHECK(match.guest.getCurrentTurn() == match.host.getCurrentTurn());
+}
+
+void testConnectTimeoutAndBackoff() {
+    NetworkConditions conditions;
+    conditions.latency = 0.05f;
+    ReconnectingMatch match(conditions, 5, false);
+
+    CHECK(match.tickUntil([&]() { return match.guest.getConnectionState() == ConnectionState::WAITING_TO_RETRY; },
+                          NetworkSession::CONNECT_TIMEOUT + 1.0f));
+    CHECK(match.simulator.getTime() >= NetworkSession::CONNECT_TIMEOUT);
+    CHECK(match.guest.getConnectAttempts() == 1);
+    CHECK(match.guest.getRetryDelay() == NetworkSession::INITIAL_RETRY_DELAY);
+
+    CHECK(match.tickUntil([&]() { return match.guest.getConnectAttempts() == 2; },
+                          NetworkSession::INITIAL_RETRY_DELAY + NetworkSession::CONNECT_TIMEOUT + 1.0f));
+    CHECK(match.guest.getRetryDelay() == 2 * NetworkSession::INITIAL_RETRY_DELAY);
+
+    // The host comes back: the next attempt succeeds and the backoff resets
+    match.simulator.setReachable(true);
+    CHECK(match.tickUntil([&]() { return match.established(); }, 2 * NetworkSession::INITIAL_RETRY_DELAY + 1.0f));
+    CHECK(match.guest.getConnectAttempts() == 0);
+}
+
+void testGivesUpAfterMaxAttempts() {
+    ReconnectingMatch match(NetworkConditions{}, 9, false);
+
+    CHECK(match.tickUntil([&]() { return match.guest.getConnectionState() == ConnectionState::FAILED; }, 300.0f));
+    CHECK(match.guest.getConnectAttempts() == NetworkSession::MAX_CONNECT_ATTEMPTS);
+    CHECK(match.guest.isMyTurn());
+}
+
+void testNetSyncSendsOnlyChanges() {
+    NetSync sync;
+    std::string out;
+
+    // Unchanged state: nothing to send until the heartbeat is due
+    sync.setTurn(0);
+    sync.setScore(0, 0);
+    sync.setScore(1, 0);
+    CHECK(!sync.flush(TICK, out) && out.empty());
+    CHECK(sync.getSentSeq() == 0);
+
+    // One change, one delta line, and then quiet again
+    sync.setScore(1, 10);
+    CHECK(sync.flush(TICK, out));
+    CHECK(out == "SCORE 1 10\n");
+    CHECK(sync.getSentSeq() == 1);
+    CHECK(!sync.flush(TICK, out) && out.empty());
+
+    // Moves are events: sent once, ahead of the score they caused
+    sync.queueFlip(4);
+    sync.queueFlip(9);
+    sync.queueMatch(4, 9);
+    sync.setScore(0, 10);
+    CHECK(sync.flush(TICK, out));
+    CHECK(out == "FLIP 4\nFLIP 9\nMATCH 4 9\nSCORE 0 10\n");
+    CHECK(!sync.flush(TICK, out));
+
+    // A value the peer sent is not echoed back
+    sync.noteRemoteTurn(1);
+    CHECK(!sync.flush(TICK, out));
+
+    // Idle long enough: a single STATE heartbeat
+    CHECK(sync.flush(NetSync::HEARTBEAT_INTERVAL, out));
+    CHECK(out == "STATE turn:1 score0:10 score1:10\n");
+}
+
+} // namespace
+
+void runNetworkTests() {
+    testSimulatorPreservesByteOrder();
+    testSimulatorLatencyAndBandwidth();
+    testSimulatorIsDeterministic();
+    testMatchConvergesOnCleanLink();
+    testMatchConvergesOnBadLink();
+    testDisconnectIsDetected();
+    testReconnectResumesSession();
+    testConnectTimeoutAndBackoff();
+    testGivesUpAfterMaxAttempts();
+    testNetSyncSendsOnlyChanges();
+}
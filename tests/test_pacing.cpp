@@ -0,0 +1,98 @@
+/**
+ * @file test_pacing.cpp
+ * @brief FramePacer: frame rate caps per mode and the adaptive fallback
+ */
+
+#include "test_harness.h"
+#include "../include/FramePacer.h"
+
+namespace {
+
+void testModeCaps() {
+    FramePacer fixed(PacingMode::FIXED, 75);
+    fixed.setRefreshRate(144);
+    CHECK(fixed.getTargetFps() == 75);
+    CHECK(!fixed.wantsVsync());
+
+    FramePacer vsync(PacingMode::VSYNC);
+    CHECK(vsync.wantsVsync());
+    CHECK(vsync.getTargetFps() == 0);
+
+    CHECK(FramePacer(PacingMode::UNCAPPED).getTargetFps() == 0);
+
+    // Adaptive follows the display, or the fixed rate when it is unknown
+    FramePacer adaptive(PacingMode::ADAPTIVE, 60);
+    adaptive.setRefreshRate(0);
+    CHECK(adaptive.getTargetFps() == 60);
+    adaptive.setRefreshRate(144);
+    CHECK(adaptive.getTargetFps() == 144);
+}
+
+void testParseMode() {
+    PacingMode mode = PacingMode::FIXED;
+    CHECK(FramePacer::parseMode("adaptive", mode));
+    CHECK(mode == PacingMode::ADAPTIVE);
+    CHECK(FramePacer::parseMode("uncapped", mode));
+    CHECK(mode == PacingMode::UNCAPPED);
+    CHECK(!FramePacer::parseMode("turbo", mode));
+    CHECK(mode == PacingMode::UNCAPPED);
+}
+
+void testAdaptiveFallsBackAndRecovers() {
+    FramePacer pacer(PacingMode::ADAPTIVE);
+    pacer.setRefreshRate(120);
+
+    // Work that does not fit 120 Hz (8.3 ms) halves the cap after a streak
+    bool changed = false;
+    for (int i = 0; i < FramePacer::ADAPT_FRAMES - 1; ++i) {
+        changed = changed || pacer.frameFinished(0.0083f, 0.010f);
+    }
+    CHECK(!changed);
+    CHECK(pacer.frameFinished(0.0083f, 0.010f));
+    CHECK(pacer.getTargetFps() == 60);
+
+    // An occasional fast frame does not bring it back...
+    pacer.frameFinished(0.0166f, 0.002f);
+    pacer.frameFinished(0.0166f, 0.012f);
+    CHECK(pacer.getTargetFps() == 60);
+
+    // ...a streak of them does
+    for (int i = 0; i < FramePacer::ADAPT_FRAMES; ++i) {
+        pacer.frameFinished(0.0166f, 0.002f);
+    }
+    CHECK(pacer.getTargetFps() == 120);
+
+    // Never below the floor
+    for (int i = 0; i < 10 * FramePacer::ADAPT_FRAMES; ++i) {
+        pacer.frameFinished(0.1f, 0.1f);
+    }
+    CHECK(pacer.getTargetFps() == FramePacer::MIN_ADAPTIVE_FPS);
+}
+
+void testStats() {
+    FramePacer pacer;
+    CHECK(pacer.getAverageFrameTime() == 0.0f);
+    pacer.frameFinished(0.010f, 0.005f);
+    pacer.frameFinished(0.030f, 0.005f);
+    CHECK(pacer.getAverageFrameTime() > 0.0199f && pacer.getAverageFrameTime() < 0.0201f);
+    CHECK(pacer.getWorstFrameTime() == 0.030f);
+
+    pacer.addFlipLatency(0.020);
+    pacer.addFlipLatency(0.010);
+    pacer.addFlipLatency(0.030);
+    const LatencyStats& latency = pacer.getFlipLatency();
+    CHECK(latency.count == 3);
+    CHECK(latency.min == 0.010);
+    CHECK(latency.max == 0.030);
+    CHECK(latency.last == 0.030);
+    CHECK(latency.average() > 0.0199 && latency.average() < 0.0201);
+}
+
+} // namespace
+
+void runPacingTests() {
+    testModeCaps();
+    testParseMode();
+    testAdaptiveFallsBackAndRecovers();
+    testStats();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file test_particles.cpp
+ * @brief ParticleSystem simulation: capacity, motion, fading and wrapping
+ */
+
+#include "test_harness.h"
+#include "../include/ParticleSystem.h"
+
+#include <cmath>
+
+namespace {
+
+bool near(float a, float b, float epsilon = 1e-3f) {
+    return std::fabs(a - b) <= epsilon;
+}
+
+void testEmitRespectsCapacity() {
+    ParticleSystem particles(100);
+    ParticleEmitter emitter;
+    CHECK(particles.emit(emitter, 60) == 60);
+    CHECK(particles.emit(emitter, 60) == 40);
+    CHECK(particles.getCount() == 100);
+    CHECK(particles.emit(emitter, 1) == 0);
+
+    particles.clear();
+    CHECK(particles.getCount() == 0);
+}
+
+void testMotionAndGravity() {
+    ParticleSystem particles(8);
+    ParticleEmitter emitter;
+    emitter.position = {100.0f, 50.0f};
+    emitter.minSpeed = emitter.maxSpeed = 10.0f;
+    emitter.minAngle = emitter.maxAngle = 0.0f; // straight right
+    emitter.lifetime = 0.0f;
+    particles.emit(emitter, 1);
+    particles.setGravity({0.0f, 20.0f});
+
+    for (int i = 0; i < 10; ++i) {
+        particles.update(0.1f);
+    }
+    // Semi-implicit Euler: x = 100 + 10 * 1s, y = 50 + 20 * 0.1^2 * (1 + 2 + ... + 10)
+    Vector2 position = particles.getPosition(0);
+    CHECK(near(position.x, 110.0f));
+    CHECK(near(position.y, 61.0f));
+    CHECK(particles.getAlpha(0) == 1.0f);
+}
+
+void testFadedParticlesAreRemoved() {
+    ParticleSystem particles(1000);
+    ParticleEmitter shortLived;
+    shortLived.lifetime = 0.5f;
+    ParticleEmitter longLived;
+    longLived.lifetime = 2.0f;
+    particles.emit(shortLived, 300);
+    particles.emit(longLived, 200);
+    particles.emit(shortLived, 300);
+
+    particles.update(0.25f);
+    CHECK(particles.getCount() == 800);
+    CHECK(near(particles.getAlpha(0), 0.5f));
+
+    particles.update(0.3f);
+    CHECK(particles.getCount() == 200);
+    for (std::size_t i = 0; i < particles.getCount(); ++i) {
+        CHECK(near(particles.getAlpha(i), 1.0f - 0.55f / 2.0f));
+    }
+
+    particles.update(2.0f);
+    CHECK(particles.getCount() == 0);
+}
+
+void testWrapKeepsParticlesInBounds() {
+    ParticleSystem particles(500);
+    particles.setWrap(200.0f, 100.0f);
+    ParticleEmitter emitter;
+    emitter.position = {100.0f, 50.0f};
+    emitter.spread = {100.0f, 50.0f};
+    emitter.minSpeed = 50.0f;
+    emitter.maxSpeed = 400.0f;
+    emitter.lifetime = 0.0f;
+    particles.emit(emitter, 500);
+
+    bool inBounds = true;
+    for (int step = 0; step < 120; ++step) {
+        particles.update(1.0f / 60.0f);
+        for (std::size_t i = 0; i < particles.getCount(); ++i) {
+            Vector2 p = particles.getPosition(i);
+            inBounds = inBounds && p.x >= 0.0f && p.x < 200.0f && p.y >= 0.0f && p.y < 100.0f;
+        }
+    }
+    CHECK(inBounds);
+    CHECK(particles.getCount() == 500);
+}
+
+} // namespace
+
+void runParticleTests() {
+    testEmitRespectsCapacity();
+    testMotionAndGravity();
+    testFadedParticlesAreRemoved();
+    testWrapKeepsParticlesInBounds();
+}
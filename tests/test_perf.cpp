@@ -0,0 +1,176 @@
+/**
+ * @file test_perf.cpp
+ * @brief FrameProfile summaries and baselines, and the ScriptedSession memory_perf plays with
+ */
+
+#include "test_harness.h"
+#include "../include/FrameProfile.h"
+#include "../include/GameBoard.h"
+#include "../include/ScriptedSession.h"
+#include "../include/SimulationClock.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float STEP = SimulationClock::DEFAULT_STEP;
+
+const PerfMetric* findMetric(const std::vector<PerfMetric>& metrics, const std::string& name) {
+    for (const PerfMetric& metric : metrics) {
+        if (metric.name == name) return &metric;
+    }
+    return nullptr;
+}
+
+void testPercentile() {
+    std::vector<double> values;
+    for (int i = 100; i >= 1; --i) values.push_back(i);
+    CHECK(FrameProfile::percentile(values, 0.50) == 50.0);
+    CHECK(FrameProfile::percentile(values, 0.99) == 99.0);
+    CHECK(FrameProfile::percentile(values, 1.0) == 100.0);
+    CHECK(FrameProfile::percentile(values, 0.0) == 1.0);
+
+    std::vector<double> empty;
+    CHECK(FrameProfile::percentile(empty, 0.5) == 0.0);
+}
+
+void testSummarize() {
+    FrameProfile profile;
+    CHECK(profile.summarize().empty());
+
+    // 99 quiet frames and one that stalls and allocates
+    for (int i = 0; i < 99; ++i) profile.add({1.0f, 2.0f, 0, 0});
+    profile.add({10.0f, 20.0f, 8, 512});
+    CHECK(profile.size() == 100);
+
+    const std::vector<PerfMetric> metrics = profile.summarize();
+    CHECK(metrics.size() == 12);
+    const PerfMetric* frameP50 = findMetric(metrics, "frame_p50_ms");
+    const PerfMetric* frameMax = findMetric(metrics, "frame_max_ms");
+    const PerfMetric* drawP99 = findMetric(metrics, "draw_p99_ms");
+    const PerfMetric* allocMax = findMetric(metrics, "allocations_max");
+    CHECK(frameP50 && frameP50->value == 3.0);
+    CHECK(frameMax && frameMax->value == 30.0);
+    CHECK(drawP99 && drawP99->value == 2.0);
+    CHECK(allocMax && allocMax->value == 8.0 && allocMax->slack == FrameProfile::ALLOCATION_SLACK);
+
+    profile.clear();
+    CHECK(profile.size() == 0);
+}
+
+void testBaselineRoundTrip() {
+    const std::string path = "test_perf_baseline.txt";
+    const std::vector<PerfMetric> written = {{"update_p50_ms", 0.25, 0.0}, {"allocations_max", 3.0, 0.0}};
+    CHECK(FrameProfile::writeBaseline(path, written));
+
+    std::vector<PerfMetric> read;
+    CHECK(FrameProfile::readBaseline(path, read));
+    CHECK(read.size() == 2);
+    CHECK(read.size() == 2 && read[0].name == "update_p50_ms" && read[0].value == 0.25);
+    CHECK(read.size() == 2 && read[1].name == "allocations_max" && read[1].value == 3.0);
+    std::remove(path.c_str());
+
+    CHECK(!FrameProfile::readBaseline("no_such_baseline.txt", read));
+}
+
+void testFindRegressions() {
+    const std::vector<PerfMetric> baseline = {{"frame_p99_ms", 4.0, 0.0}, {"allocations_max", 0.0, 0.0}};
+
+    // Within tolerance plus slack
+    std::vector<PerfMetric> run = {{"frame_p99_ms", 4.9, 0.1}, {"allocations_max", 2.0, 2.0}};
+    CHECK(FrameProfile::findRegressions(baseline, run, 0.25).empty());
+
+    // Past it
+    run = {{"frame_p99_ms", 5.2, 0.1}, {"allocations_max", 3.0, 2.0}};
+    CHECK(FrameProfile::findRegressions(baseline, run, 0.25).size() == 2);
+
+    // A metric the baseline does not know is not held to anything
+    run = {{"draw_max_ms", 1000.0, 0.1}};
+    CHECK(FrameProfile::findRegressions(baseline, run, 0.25).empty());
+}
+
+void testScriptedSessionSolvesTheBoard() {
+    GameBoard board(4, 4, {50.0f, 70.0f}, 10.0f, {20.0f, 30.0f, 800.0f, 600.0f}, 5, true);
+    ScriptedSession session(1);
+    WidgetLayer widgets;
+    BoardSnapshot snapshot;
+
+    int clicks = 0;
+    int mismatches = 0;
+    for (int frame = 0; frame < 100000 && !board.allMatched(); ++frame) {
+        board.fillSnapshot(snapshot);
+        const ScriptedInput input = session.next(GameState::PLAYING, widgets, snapshot, STEP);
+        if (input.type == ScriptedInput::Type::CLICK) {
+            ++clicks;
+            // A second card up that is not the first one's partner is a mismatch
+            int upId = -1;
+            for (const CardSnapshot& card : snapshot.cards) {
+                if (card.state == CardState::FACE_UP || card.state == CardState::FLIPPING_UP) upId = card.id;
+            }
+            const bool flipped = board.handleClick(input.position);
+            CHECK(flipped);
+            board.fillSnapshot(snapshot);
+            int ups = 0;
+            bool same = true;
+            for (const CardSnapshot& card : snapshot.cards) {
+                if (card.state == CardState::FACE_UP || card.state == CardState::FLIPPING_UP) {
+                    ++ups;
+                    same = same && (upId < 0 || card.id == upId);
+                }
+            }
+            if (ups == 2 && !same) ++mismatches;
+        }
+        board.update(STEP);
+    }
+    CHECK(board.allMatched());
+    CHECK(clicks == 16);
+    CHECK(mismatches == 0);
+}
+
+void testScriptedSessionFlow() {
+    WidgetLayer widgets;
+    widgets.begin(0);
+    widgets.button(0, {100.0f, 100.0f, 200.0f, 50.0f}, "Start");
+    BoardSnapshot board;
+    ScriptedSession session(1);
+
+    // Menu: clicks Start in its middle after the settle time, then releases
+    ScriptedInput input;
+    int frames = 0;
+    while (input.type == ScriptedInput::Type::NONE && frames++ < 100) {
+        input = session.next(GameState::MAIN_MENU, widgets, board, STEP);
+    }
+    CHECK(input.type == ScriptedInput::Type::CLICK);
+    CHECK(input.position.x == 200.0f && input.position.y == 125.0f);
+    CHECK(session.next(GameState::MAIN_MENU, widgets, board, STEP).type == ScriptedInput::Type::NONE);
+
+    // A won game counts once; R restarts only when more games are wanted, so here M
+    input = {};
+    frames = 0;
+    while (input.type == ScriptedInput::Type::NONE && frames++ < 1000) {
+        input = session.next(GameState::GAME_OVER, widgets, board, STEP);
+    }
+    CHECK(session.getGamesWon() == 1);
+    CHECK(input.type == ScriptedInput::Type::KEY && input.key == KEY_M);
+
+    // Back on the menu with every game won: done
+    frames = 0;
+    while (!session.isFinished() && frames++ < 100) {
+        session.next(GameState::MAIN_MENU, widgets, board, STEP);
+    }
+    CHECK(session.isFinished());
+}
+
+} // namespace
+
+void runPerfTests() {
+    testPercentile();
+    testSummarize();
+    testBaselineRoundTrip();
+    testFindRegressions();
+    testScriptedSessionSolvesTheBoard();
+    testScriptedSessionFlow();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file test_persistence.cpp
+ * @brief PersistenceWorker: job order, flush, and the durable file helpers
+ */
+
+#include "test_harness.h"
+#include "../include/PersistenceWorker.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+std::string tempFile(const char* name) {
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".tmp");
+    return path;
+}
+
+std::string readAll(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void testJobOrder() {
+    std::vector<int> ran;   // only touched by jobs, read after flush()
+    PersistenceWorker worker;
+    for (int i = 0; i < 100; ++i) {
+        worker.post([&ran, i] {
+            ran.push_back(i);
+            return i % 10 != 0;
+        });
+    }
+    worker.flush();
+    CHECK(ran.size() == 100);
+    bool ordered = true;
+    for (int i = 0; i < static_cast<int>(ran.size()); ++i) {
+        ordered = ordered && ran[i] == i;
+    }
+    CHECK(ordered);
+    CHECK(worker.getCompleted() == 100);
+    CHECK(worker.getFailures() == 10);
+}
+
+void testDrainsOnDestruction() {
+    int ran = 0;
+    {
+        PersistenceWorker worker;
+        for (int i = 0; i < 50; ++i) {
+            worker.post([&ran] { ++ran; return true; });
+        }
+    }
+    CHECK(ran == 50);
+}
+
+void testAppendDurably() {
+    const std::string path = tempFile("mc_persist_append.bin");
+    CHECK(PersistenceWorker::appendDurably(path, "abc", 3, 0));
+    CHECK(PersistenceWorker::appendDurably(path, "def", 3, 3));
+    CHECK(readAll(path) == "abcdef");
+
+    // Leftovers of a failed append are cut off before the next one
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << "torn";
+    }
+    CHECK(PersistenceWorker::appendDurably(path, "gh", 2, 6));
+    CHECK(readAll(path) == "abcdefgh");
+
+    // A file shorter than expected is left alone
+    CHECK(!PersistenceWorker::appendDurably(path, "xyz", 3, 100));
+    CHECK(readAll(path) == "abcdefgh");
+    std::filesystem::remove(path);
+}
+
+void testWriteAtomically() {
+    const std::string path = tempFile("mc_persist_atomic.bin");
+    CHECK(PersistenceWorker::writeAtomically(path, "first", 5));
+    CHECK(PersistenceWorker::writeAtomically(path, "second", 6));
+    CHECK(readAll(path) == "second");
+    CHECK(!std::filesystem::exists(path + ".tmp"));
+
+    const std::string copy = tempFile("mc_persist_copy.bin");
+    CHECK(PersistenceWorker::copyAtomically(path, copy, 3));
+    CHECK(readAll(copy) == "sec");
+    CHECK(!PersistenceWorker::copyAtomically(path, copy, 100));     // source too short
+    CHECK(readAll(copy) == "sec");
+    CHECK(!std::filesystem::exists(copy + ".tmp"));
+
+    // Into a directory that does not exist: fails without touching anything
+    CHECK(!PersistenceWorker::writeAtomically(path + "_missing_dir/file", "x", 1));
+    std::filesystem::remove(path);
+    std::filesystem::remove(copy);
+}
+
+} // namespace
+
+void runPersistenceTests() {
+    testJobOrder();
+    testDrainsOnDestruction();
+    testAppendDurably();
+    testWriteAtomically();
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_replay.cpp
+ * @brief Replay encoding round trip, size, truncation, and seeded boards
+ */
+
+#include "test_harness.h"
+#include "../include/GameBoard.h"
+#include "../include/Replay.h"
+#include "../include/SimulationClock.h"
+#include <vector>
+
+namespace {
+
+std::vector<ReplayEvent> readAll(const ReplayRecorder& recorder, ReplayHeader& header, bool& error) {
+    ReplayReader reader(recorder.data(), recorder.size());
+    header = reader.getHeader();
+    std::vector<ReplayEvent> events;
+    ReplayEvent event;
+    while (reader.next(event)) {
+        events.push_back(event);
+    }
+    error = !reader.isValid() || reader.hasError();
+    return events;
+}
+
+void testRoundTrip() {
+    ReplayRecorder recorder;
+    recorder.begin(0xDEADBEEFu, 36);
+    recorder.click(120, 0);
+    recorder.click(150, 35);
+    recorder.hint(150);
+    recorder.pause(400, 12345);
+    recorder.shuffle(400);
+    recorder.click(100000, 17);
+    recorder.finish(100200, -42, 88);
+    CHECK(recorder.isFinished() && !recorder.isRecording() && !recorder.isTruncated());
+
+    ReplayHeader header;
+    bool error = false;
+    std::vector<ReplayEvent> events = readAll(recorder, header, error);
+    CHECK(!error);
+    CHECK(header.seed == 0xDEADBEEFu && header.difficulty == 36);
+    CHECK(events.size() == 7);
+    if (events.size() == 7) {
+        CHECK(events[0].type == ReplayEventType::CLICK && events[0].step == 120 && events[0].slot == 0);
+        CHECK(events[1].type == ReplayEventType::CLICK && events[1].step == 150 && events[1].slot == 35);
+        CHECK(events[2].type == ReplayEventType::HINT && events[2].step == 150);
+        CHECK(events[3].type == ReplayEventType::PAUSE && events[3].step == 400 && events[3].milliseconds == 12345);
+        CHECK(events[4].type == ReplayEventType::SHUFFLE && events[4].step == 400);
+        CHECK(events[5].slot == 17 && events[5].step == 100000);
+        CHECK(events[6].type == ReplayEventType::END && events[6].step == 100200);
+        CHECK(events[6].score == -42 && events[6].moves == 88);
+    }
+
+    // Nothing is recorded after the end, nor for slots off the board
+    recorder.click(100300, 1);
+    CHECK(readAll(recorder, header, error).size() == 7);
+    recorder.begin(1, 16);
+    recorder.click(10, 16);
+    recorder.click(10, -1);
+    CHECK(readAll(recorder, header, error).empty());
+}
+
+void testHardGameSize() {
+    // A sloppy HARD game: 200 clicks about half a second apart, a few extras
+    ReplayRecorder recorder;
+    recorder.begin(7, 64);
+    std::uint64_t step = 108;   // the opening shuffle
+    for (int i = 0; i < 200; ++i) {
+        step += 20 + (i * 7) % 40;
+        recorder.click(step, (i * 13) % 64);
+    }
+    recorder.hint(step + 5);
+    recorder.shuffle(step + 30);
+    recorder.pause(step + 30, 60000);
+    recorder.finish(step + 90, 215, 200);
+    CHECK(recorder.size() < 500);
+
+    ReplayHeader header;
+    bool error = false;
+    CHECK(readAll(recorder, header, error).size() == 204);
+    CHECK(!error);
+}
+
+void testTruncation() {
+    ReplayRecorder recorder(128);
+    recorder.begin(3, 16);
+    for (int i = 0; i < 100; ++i) {
+        recorder.click(static_cast<std::uint64_t>(i) * 1000000, i % 16);
+    }
+    CHECK(recorder.isTruncated());
+    CHECK(recorder.size() <= recorder.getCapacity());
+    recorder.finish(200000000, 10, 100);
+    CHECK(recorder.isFinished());
+
+    ReplayHeader header;
+    bool error = false;
+    std::vector<ReplayEvent> events = readAll(recorder, header, error);
+    CHECK(!error && !events.empty() && events.back().type == ReplayEventType::END);
+
+    // Storage is reused, not reallocated, by the next game
+    const unsigned char* storage = recorder.data();
+    recorder.begin(4, 16);
+    CHECK(recorder.data() == storage && !recorder.isTruncated());
+}
+
+void testMalformed() {
+    const unsigned char junk[] = {'M', 'C', 'R', 'X', 1, 16, 0, 0, 0, 0};
+    CHECK(!ReplayReader(junk, sizeof(junk)).isValid());
+    const unsigned char badDifficulty[] = {'M', 'C', 'R', 'P', 1, 17, 0, 0, 0, 0};
+    CHECK(!ReplayReader(badDifficulty, sizeof(badDifficulty)).isValid());
+
+    // A varint cut off mid-way
+    const unsigned char torn[] = {'M', 'C', 'R', 'P', 1, 16, 0, 0, 0, 0, 0x80};
+    ReplayReader reader(torn, sizeof(torn));
+    ReplayEvent event;
+    CHECK(reader.isValid() && !reader.next(event) && reader.hasError());
+}
+
+std::vector<int> dealtIds(std::uint32_t seed) {
+    GameBoard board(4, 4, {50.0f, 70.0f}, 10.0f, {100.0f, 100.0f, 400.0f, 400.0f}, seed);
+    BoardSnapshot snapshot;
+    board.fillSnapshot(snapshot);
+    std::vector<int> ids;
+    for (const CardSnapshot& card : snapshot.cards) {
+        ids.push_back(card.id);
+    }
+    return ids;
+}
+
+void testSeededBoard() {
+    CHECK(dealtIds(1234) == dealtIds(1234));
+    CHECK(dealtIds(1234) != dealtIds(4321));
+
+    GameBoard board(4, 4, {50.0f, 70.0f}, 10.0f, {100.0f, 100.0f, 400.0f, 400.0f});
+    bool centres = true;
+    for (int slot = 0; slot < 16; ++slot) {
+        centres = centres && board.slotAt(board.getSlotCenter(slot)) == slot;
+    }
+    CHECK(centres);
+    CHECK(board.slotAt({155.0f, 120.0f}) == -1);    // padding between columns 0 and 1
+    CHECK(board.slotAt({99.0f, 120.0f}) == -1);
+    CHECK(board.slotAt({100.0f + 4 * 60.0f + 1.0f, 120.0f}) == -1);
+}
+
+void testSettledBoardWakes() {
+    // update() skips the cards once all of them settled; a click has to wake them
+    GameBoard board(4, 4, {50.0f, 70.0f}, 10.0f, {100.0f, 100.0f, 400.0f, 400.0f}, 99, true);
+    board.startShuffle(1.0f);
+    for (int i = 0; i < 300; ++i) {
+        board.update(SimulationClock::DEFAULT_STEP);
+    }
+    CHECK(!board.isShuffling());
+
+    BoardSnapshot snapshot;
+    board.fillSnapshot(snapshot);
+    std::vector<int> cardAt(16, -1);
+    for (int i = 0; i < 16; ++i) {
+        const CardSnapshot& card = snapshot.cards[i];
+        cardAt[board.slotAt({card.position.x + 1.0f, card.position.y + 1.0f})] = i;
+    }
+    int other = 1;
+    while (snapshot.cards[cardAt[other]].id == snapshot.cards[cardAt[0]].id) {
+        ++other;
+    }
+    auto stateAt = [&](int slot) {
+        board.fillSnapshot(snapshot);
+        return snapshot.cards[cardAt[slot]].state;
+    };
+
+    CHECK(board.handleClick(board.getSlotCenter(0)));
+    for (int i = 0; i < 30; ++i) {
+        board.update(SimulationClock::DEFAULT_STEP);
+    }
+    CHECK(stateAt(0) == CardState::FACE_UP);
+    CHECK(snapshot.cards[cardAt[0]].previousFlip == 1.0f);
+
+    // A mismatch turns both back after the flip-back delay
+    CHECK(board.handleClick(board.getSlotCenter(other)));
+    for (int i = 0; i < 90; ++i) {
+        board.update(SimulationClock::DEFAULT_STEP);
+    }
+    CHECK(stateAt(0) == CardState::FACE_DOWN && stateAt(other) == CardState::FACE_DOWN);
+}
+
+} // namespace
+
+void runReplayTests() {
+    testRoundTrip();
+    testHardGameSize();
+    testTruncation();
+    testMalformed();
+    testSeededBoard();
+    testSettledBoardWakes();
+}
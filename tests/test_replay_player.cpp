@@ -0,0 +1,281 @@
+/**
+ * @file test_replay_player.cpp
+ * @brief ReplayPlayer: replayed scores, rejected forgeries, and seeking
+ */
+
+#include "test_harness.h"
+#include "../include/Game.h"
+#include "../include/ReplayPlayer.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct PlayedGame {
+    std::vector<unsigned char> replay;
+    int score = 0;
+    int moves = 0;
+    int hintsUsed = 0;
+    int shufflesUsed = 0;
+};
+
+/**
+ * Plays a game the way Game drives the board and records it the way Game
+ * does: input between fixed steps, every click a move, only effective
+ * inputs in the replay. The board is laid out unlike the player's, with
+ * clicks anywhere on a card. A seeded bot remembers nothing, so it
+ * mismatches, clicks locked boards, and (with extras) uses hints, shuffles
+ * and pauses.
+ */
+PlayedGame playGame(std::uint32_t seed, int cards, std::uint32_t botSeed, bool extras) {
+    const int grid = static_cast<int>(std::sqrt(cards));
+    GameBoard board(grid, grid, {57.0f, 83.0f}, 7.0f, {13.0f, 29.0f, 640.0f, 900.0f}, seed, true);
+    ScoreManager score;
+    board.setScoreManager(&score);
+    board.startShuffle(Game::OPENING_SHUFFLE_SECONDS);
+    float shuffleCooldown = Game::SHUFFLE_INITIAL_DELAY_SECONDS;
+
+    ReplayRecorder recorder;
+    recorder.begin(seed, cards);
+    std::mt19937 bot(botSeed);
+    BoardSnapshot snapshot;
+    PlayedGame game;
+    std::uint64_t step = 0;
+    std::uint64_t nextInput = 0;
+
+    while (!board.allMatched() && step < 20 * 60 * 60) {
+        if (step >= nextInput && !board.isShuffling()) {
+            nextInput = step + 3 + bot() % 40;
+            const unsigned roll = bot() % 100;
+            if (extras && roll < 2) {
+                const int before = board.getHintsRemaining();
+                board.showHint();
+                if (board.getHintsRemaining() < before) {
+                    recorder.hint(step);
+                }
+            } else if (extras && roll < 4) {
+                if (!board.isHintActive() && shuffleCooldown <= 0.0f) {
+                    board.startShuffle(Game::RESHUFFLE_SECONDS);
+                    if (board.isShuffling()) {
+                        recorder.shuffle(step);
+                        shuffleCooldown = Game::SHUFFLE_COOLDOWN_SECONDS;
+                        ++game.shufflesUsed;
+                        score.addMismatch();
+                    }
+                }
+            } else if (extras && roll < 5) {
+                recorder.pause(step, bot() % 5000);
+            } else {
+                // A face-down card, or its partner when one is already up (half the time)
+                board.fillSnapshot(snapshot);
+                std::vector<int> candidates;
+                int upId = -1;
+                for (const CardSnapshot& card : snapshot.cards) {
+                    if (card.state == CardState::FACE_UP || card.state == CardState::FLIPPING_UP) upId = card.id;
+                }
+                for (int i = 0; i < static_cast<int>(snapshot.cards.size()); ++i) {
+                    if (snapshot.cards[i].state == CardState::FACE_DOWN) candidates.push_back(i);
+                }
+                if (!candidates.empty()) {
+                    int pick = candidates[bot() % candidates.size()];
+                    if (upId >= 0 && bot() % 2 == 0) {
+                        for (int i : candidates) {
+                            if (snapshot.cards[i].id == upId) pick = i;
+                        }
+                    }
+                    const CardSnapshot& card = snapshot.cards[pick];
+                    const Vector2 click = {card.position.x + card.size.x * (0.05f + 0.9f * (bot() % 100) / 100.0f),
+                                           card.position.y + card.size.y * (0.05f + 0.9f * (bot() % 100) / 100.0f)};
+                    if (board.handleClick(click)) {
+                        recorder.click(step, board.slotAt(click));
+                    }
+                    ++game.moves;
+                }
+            }
+        }
+
+        // Game::stepPlaying()
+        ++step;
+        if (shuffleCooldown > 0.0f) {
+            shuffleCooldown = std::max(0.0f, shuffleCooldown - SimulationClock::DEFAULT_STEP);
+        }
+        board.update(SimulationClock::DEFAULT_STEP);
+    }
+
+    game.score = score.getScore();
+    game.hintsUsed = board.getHintsUsed();
+    recorder.finish(step, game.score, game.moves);
+    game.replay.assign(recorder.data(), recorder.data() + recorder.size());
+    return game;
+}
+
+/// Decodes a replay and records it again, letting edit() change the events first
+std::vector<unsigned char> rewrite(const std::vector<unsigned char>& replay,
+                                   const std::function<void(std::vector<ReplayEvent>&)>& edit) {
+    ReplayReader reader(replay.data(), replay.size());
+    std::vector<ReplayEvent> events;
+    ReplayEvent event;
+    while (reader.next(event)) {
+        events.push_back(event);
+    }
+    edit(events);
+
+    ReplayRecorder recorder;
+    recorder.begin(reader.getHeader().seed, reader.getHeader().difficulty);
+    for (const ReplayEvent& e : events) {
+        switch (e.type) {
+            case ReplayEventType::CLICK: recorder.click(e.step, e.slot); break;
+            case ReplayEventType::HINT: recorder.hint(e.step); break;
+            case ReplayEventType::SHUFFLE: recorder.shuffle(e.step); break;
+            case ReplayEventType::PAUSE: recorder.pause(e.step, e.milliseconds); break;
+            case ReplayEventType::END: recorder.finish(e.step, e.score, e.moves); break;
+        }
+    }
+    return std::vector<unsigned char>(recorder.data(), recorder.data() + recorder.size());
+}
+
+ReplayVerdict verdictOf(const std::vector<unsigned char>& replay) {
+    return ReplayPlayer::verify(replay.data(), replay.size()).verdict;
+}
+
+void testScoresMatch() {
+    const int difficulties[] = {16, 36, 64};
+    bool allValid = true;
+    bool sameResults = true;
+    bool extrasSeen = false;
+    for (std::uint32_t game = 0; game < 30; ++game) {
+        const PlayedGame played = playGame(1000 + game * 7919, difficulties[game % 3], game, game % 2 == 0);
+        const ReplayCheck check = ReplayPlayer::verify(played.replay.data(), played.replay.size());
+        allValid = allValid && check.isValid();
+        sameResults = sameResults && check.score == played.score && check.claimedScore == played.score &&
+                      check.moves == played.moves && check.hintsUsed == played.hintsUsed &&
+                      check.shufflesUsed == played.shufflesUsed && check.difficulty == difficulties[game % 3];
+        extrasSeen = extrasSeen || (played.hintsUsed > 0 && played.shufflesUsed > 0);
+    }
+    CHECK(allValid);
+    CHECK(sameResults);
+    CHECK(extrasSeen);
+}
+
+void testForgeriesRejected() {
+    const PlayedGame played = playGame(4242, 36, 99, true);
+    CHECK(verdictOf(played.replay) == ReplayVerdict::VALID);
+
+    // A better score than the game reached, or fewer moves than it took flips
+    CHECK(verdictOf(rewrite(played.replay, [](std::vector<ReplayEvent>& events) { events.back().score += 10; })) ==
+          ReplayVerdict::SCORE_MISMATCH);
+    CHECK(verdictOf(rewrite(played.replay, [](std::vector<ReplayEvent>& events) { events.back().moves = 3; })) ==
+          ReplayVerdict::SCORE_MISMATCH);
+
+    // The last pair never turned
+    CHECK(verdictOf(rewrite(played.replay, [](std::vector<ReplayEvent>& events) {
+        events.erase(events.end() - 3, events.end() - 1);
+    })) == ReplayVerdict::NOT_WON);
+
+    // Clicking a card already up; reshuffling while a reshuffle runs
+    CHECK(verdictOf(rewrite(played.replay, [](std::vector<ReplayEvent>& events) {
+        auto click = std::find_if(events.begin(), events.end(),
+                                  [](const ReplayEvent& e) { return e.type == ReplayEventType::CLICK; });
+        const ReplayEvent again = *click;
+        events.insert(click + 1, again);
+    })) == ReplayVerdict::ILLEGAL_INPUT);
+    CHECK(verdictOf(rewrite(played.replay, [](std::vector<ReplayEvent>& events) {
+        ReplayEvent shuffle;
+        shuffle.type = ReplayEventType::SHUFFLE;
+        shuffle.step = events.front().step;
+        events.insert(events.begin(), 2, shuffle);
+    })) == ReplayVerdict::ILLEGAL_INPUT);
+
+    // Another deck under the same inputs
+    std::vector<unsigned char> otherDeck = played.replay;
+    otherDeck[7] ^= 0x5A;   // seed, after magic, version and the one-byte difficulty
+    CHECK(verdictOf(otherDeck) != ReplayVerdict::VALID);
+
+    std::vector<unsigned char> torn(played.replay.begin(), played.replay.end() - 4);
+    CHECK(verdictOf(torn) == ReplayVerdict::MALFORMED);
+
+    // Longer than anyone plays
+    CHECK(verdictOf(rewrite(played.replay, [](std::vector<ReplayEvent>& events) {
+        events.back().step = ReplayPlayer::MAX_STEPS + 1;
+    })) == ReplayVerdict::TOO_LONG);
+}
+
+struct Fingerprint {
+    std::vector<int> ids;
+    std::vector<int> states;
+    std::vector<float> values;
+    int score = 0;
+
+    bool operator==(const Fingerprint& other) const {
+        return ids == other.ids && states == other.states && values == other.values && score == other.score;
+    }
+};
+
+Fingerprint fingerprint(const ReplayPlayer& player) {
+    BoardSnapshot snapshot;
+    player.getBoard()->fillSnapshot(snapshot);
+    Fingerprint print;
+    for (const CardSnapshot& card : snapshot.cards) {
+        print.ids.push_back(card.id);
+        print.states.push_back(static_cast<int>(card.state));
+        print.values.insert(print.values.end(), {card.position.x, card.position.y, card.flip, card.previousFlip});
+    }
+    print.values.push_back(player.getBoard()->getHintCooldown());
+    print.score = player.getScore();
+    return print;
+}
+
+void checkSeeking(std::uint64_t keyframeInterval) {
+    const PlayedGame played = playGame(777, 64, 5, true);
+    ReplayPlayer player(keyframeInterval);
+    CHECK(player.load(played.replay.data(), played.replay.size()));
+    const std::uint64_t end = player.getEndStep();
+
+    // Straight through, noting where the game stood at a few steps
+    const std::uint64_t marks[] = {0, 1, 59, 61, end / 3, end / 2, end - 1, end};
+    std::vector<Fingerprint> expected;
+    for (std::uint64_t mark : marks) {
+        while (player.getStep() < mark && player.step()) {
+        }
+        expected.push_back(fingerprint(player));
+    }
+    CHECK(player.finish().isValid() && player.getScore() == played.score);
+    if (keyframeInterval > 0) {
+        CHECK(player.getKeyframeCount() == end / keyframeInterval + 1);
+    }
+
+    // Back and forth, landing on the same states
+    const int order[] = {5, 0, 7, 2, 4, 3, 6, 1};
+    bool same = true;
+    for (int index : order) {
+        player.seek(marks[index]);
+        same = same && player.getStep() == marks[index] && fingerprint(player) == expected[index];
+    }
+    CHECK(same);
+    player.seek(end + 1000);
+    CHECK(player.getStep() == end);
+    CHECK(player.finish().isValid() && player.getScore() == played.score);
+}
+
+void testSeeking() {
+    checkSeeking(60);
+    checkSeeking(ReplayPlayer::KEYFRAME_INTERVAL);
+    checkSeeking(0);    // no keyframes: seeking back starts over
+
+    ReplayPlayer player;
+    const unsigned char junk[] = {1, 2, 3};
+    CHECK(!player.load(junk, sizeof(junk)) && !player.isLoaded());
+    CHECK(!player.step() && player.finish().verdict == ReplayVerdict::MALFORMED);
+    player.seek(10);
+}
+
+} // namespace
+
+void runReplayPlayerTests() {
+    testScoresMatch();
+    testForgeriesRejected();
+    testSeeking();
+}
@@ -0,0 +1,244 @@
+/**
+ * @file test_savegame.cpp
+ * @brief SavedGame: continued games play out as if never left, and the encoding
+ */
+
+#include "test_harness.h"
+#include "../include/Game.h"
+#include "../include/ReplayPlayer.h"
+#include "../include/SavedGame.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// A game the way Game drives and records it, minus the window
+struct Session {
+    std::unique_ptr<GameBoard> board;
+    ScoreManager score;
+    ReplayRecorder recorder;
+    std::uint64_t step = 0;
+    int moves = 0;
+    int shufflesUsed = 0;
+    float shuffleCooldown = Game::SHUFFLE_INITIAL_DELAY_SECONDS;
+
+    Session(std::uint32_t seed, int cards, Vector2 cardSize, float padding, Rectangle bounds) {
+        const int grid = static_cast<int>(std::sqrt(cards));
+        board = std::make_unique<GameBoard>(grid, grid, cardSize, padding, bounds, seed, true);
+        board->setScoreManager(&score);
+    }
+};
+
+/**
+ * Plays until the board is cleared or the step is reached. The bot clicks
+ * face-down cards (their partner half the time), and now and then asks
+ * for a hint or a reshuffle; it decides from the board alone, so two
+ * sessions in the same state with the same bot play the same.
+ */
+void play(Session& game, std::mt19937& bot, std::uint64_t untilStep) {
+    BoardSnapshot snapshot;
+    while (!game.board->allMatched() && game.step < untilStep) {
+        if (game.step % 7 == 0 && !game.board->isShuffling()) {
+            const unsigned roll = bot() % 100;
+            if (roll < 2) {
+                const int before = game.board->getHintsRemaining();
+                game.board->showHint();
+                if (game.board->getHintsRemaining() < before) {
+                    game.recorder.hint(game.step);
+                }
+            } else if (roll < 4) {
+                if (!game.board->isHintActive() && game.shuffleCooldown <= 0.0f) {
+                    game.board->startShuffle(Game::RESHUFFLE_SECONDS);
+                    if (game.board->isShuffling()) {
+                        game.recorder.shuffle(game.step);
+                        game.shuffleCooldown = Game::SHUFFLE_COOLDOWN_SECONDS;
+                        ++game.shufflesUsed;
+                        game.score.addMismatch();
+                    }
+                }
+            } else if (roll < 40) {
+                game.board->fillSnapshot(snapshot);
+                std::vector<int> candidates;
+                int upId = -1;
+                for (const CardSnapshot& card : snapshot.cards) {
+                    if (card.state == CardState::FACE_UP || card.state == CardState::FLIPPING_UP) upId = card.id;
+                }
+                for (int i = 0; i < static_cast<int>(snapshot.cards.size()); ++i) {
+                    if (snapshot.cards[i].state == CardState::FACE_DOWN) candidates.push_back(i);
+                }
+                if (!candidates.empty()) {
+                    int pick = candidates[bot() % candidates.size()];
+                    if (upId >= 0 && bot() % 2 == 0) {
+                        for (int i : candidates) {
+                            if (snapshot.cards[i].id == upId) pick = i;
+                        }
+                    }
+                    const int slot = game.board->slotAt(snapshot.cards[pick].position);
+                    if (game.board->handleClick(game.board->getSlotCenter(slot))) {
+                        game.recorder.click(game.step, slot);
+                    }
+                    ++game.moves;
+                }
+            }
+        }
+
+        // Game::stepPlaying()
+        ++game.step;
+        if (game.shuffleCooldown > 0.0f) {
+            game.shuffleCooldown = std::max(0.0f, game.shuffleCooldown - SimulationClock::DEFAULT_STEP);
+        }
+        game.board->update(SimulationClock::DEFAULT_STEP);
+    }
+}
+
+/// What Game::saveUnfinishedGame() captures, encoded
+std::vector<unsigned char> save(const Session& game, std::uint32_t seed, int cards) {
+    SavedGame saved;
+    saved.difficulty = cards;
+    saved.seed = seed;
+    saved.stepsPlayed = game.step;
+    saved.timerStarted = true;
+    saved.elapsedSeconds = game.step * SimulationClock::DEFAULT_STEP;
+    saved.totalMoves = game.moves;
+    saved.shufflesUsed = game.shufflesUsed;
+    saved.shuffleCooldown = game.shuffleCooldown;
+    saved.scoreMoves = game.score.getMoves();
+    saved.scoreMatches = game.score.getMatches();
+    saved.score = game.score.getScore();
+    game.board->saveGridState(saved.board);
+    saved.replay.assign(game.recorder.data(), game.recorder.data() + game.recorder.size());
+    std::vector<unsigned char> bytes;
+    saved.encode(bytes);
+    return bytes;
+}
+
+/// What Game::continueSavedGame() does, onto a board laid out unlike the one saved
+std::unique_ptr<Session> resume(const std::vector<unsigned char>& bytes, SavedGame& saved) {
+    if (!saved.decode(bytes.data(), bytes.size())) {
+        return nullptr;
+    }
+    auto game = std::make_unique<Session>(saved.seed, saved.difficulty, Vector2{61.0f, 47.0f}, 3.0f,
+                                          Rectangle{-40.0f, 250.0f, 500.0f, 400.0f});
+    game->board->restoreGridState(saved.board);
+    game->score.restore(saved.scoreMoves, saved.scoreMatches, saved.score);
+    if (!game->recorder.resume(saved.replay.data(), saved.replay.size())) {
+        return nullptr;
+    }
+    game->step = saved.stepsPlayed;
+    game->moves = saved.totalMoves;
+    game->shufflesUsed = saved.shufflesUsed;
+    game->shuffleCooldown = saved.shuffleCooldown;
+    return game;
+}
+
+void testContinuedGamesPlayOut() {
+    bool allResumed = true;
+    bool sameGames = true;
+    bool allVerify = true;
+    bool savedMidShuffle = false;
+    bool savedMidMove = false;
+    bool savedMidFlip = false;
+    for (std::uint32_t game = 0; game < 12; ++game) {
+        const std::uint32_t seed = 5000 + game * 104729;
+        const int cards = game % 3 == 0 ? 36 : 64;
+        const std::uint64_t saveAt = game == 0 ? 40 : 57 + game * 389;   // the first mid opening shuffle
+
+        Session original(seed, cards, {100.0f, 140.0f}, 12.0f, {30.0f, 90.0f, 960.0f, 700.0f});
+        original.board->startShuffle(Game::OPENING_SHUFFLE_SECONDS);
+        original.recorder.begin(seed, cards);
+        std::mt19937 bot(game);
+        play(original, bot, saveAt);
+
+        const std::vector<unsigned char> bytes = save(original, seed, cards);
+        SavedGame saved;
+        std::unique_ptr<Session> continued = resume(bytes, saved);
+        if (!continued) {
+            allResumed = false;
+            continue;
+        }
+        savedMidShuffle = savedMidShuffle || saved.board.isShuffling;
+        for (const Card::LogicState& card : saved.board.cards) {
+            savedMidMove = savedMidMove || card.isMoving;
+            savedMidFlip = savedMidFlip || card.state == CardState::FLIPPING_UP || card.state == CardState::FLIPPING_DOWN;
+        }
+
+        // Both run out with the same bot: same inputs at the same steps, same result
+        std::mt19937 sameBot = bot;
+        play(original, bot, ReplayPlayer::MAX_STEPS);
+        play(*continued, sameBot, ReplayPlayer::MAX_STEPS);
+        original.recorder.finish(original.step, original.score.getScore(), original.moves);
+        continued->recorder.finish(continued->step, continued->score.getScore(), continued->moves);
+
+        sameGames = sameGames && continued->board->allMatched() && continued->step == original.step &&
+                    continued->score.getScore() == original.score.getScore() &&
+                    continued->board->getHintsUsed() == original.board->getHintsUsed() &&
+                    std::equal(original.recorder.data(), original.recorder.data() + original.recorder.size(),
+                               continued->recorder.data(), continued->recorder.data() + continued->recorder.size());
+        const ReplayCheck check = ReplayPlayer::verify(continued->recorder.data(), continued->recorder.size());
+        allVerify = allVerify && check.isValid() && check.score == continued->score.getScore();
+    }
+    CHECK(allResumed);
+    CHECK(sameGames);
+    CHECK(allVerify);
+    CHECK(savedMidShuffle);
+    CHECK(savedMidMove);
+    CHECK(savedMidFlip);
+}
+
+void testEncoding() {
+    Session game(99, 64, {100.0f, 100.0f}, 10.0f, {0.0f, 0.0f, 880.0f, 880.0f});
+    game.board->startShuffle(Game::OPENING_SHUFFLE_SECONDS);
+    game.recorder.begin(99, 64);
+    std::mt19937 bot(3);
+    play(game, bot, 3000);
+    const std::vector<unsigned char> bytes = save(game, 99, 64);
+
+    // Cards at rest on their slots are a flag byte and a slot byte
+    CHECK(bytes.size() < game.recorder.size() + 64 * 2 + 96);
+
+    SavedGame saved;
+    CHECK(saved.decode(bytes.data(), bytes.size()));
+    std::vector<unsigned char> again;
+    saved.encode(again);
+    CHECK(again == bytes);
+    CHECK(saved.difficulty == 64 && saved.seed == 99 && saved.stepsPlayed == 3000 && saved.score == game.score.getScore());
+
+    // Anything cut short, foreign, newer or with bytes to spare is refused
+    bool truncationsRefused = true;
+    for (std::size_t size = 0; size < bytes.size(); ++size) {
+        truncationsRefused = truncationsRefused && !saved.decode(bytes.data(), size);
+    }
+    CHECK(truncationsRefused);
+    std::vector<unsigned char> altered = bytes;
+    altered[4] = SavedGame::FORMAT_VERSION + 1;
+    CHECK(!saved.decode(altered.data(), altered.size()));
+    altered = bytes;
+    altered[0] = 'X';
+    CHECK(!saved.decode(altered.data(), altered.size()));
+    altered = bytes;
+    altered[5] = 17;   // difficulty
+    CHECK(!saved.decode(altered.data(), altered.size()));
+    altered = bytes;
+    altered.push_back(0);
+    CHECK(!saved.decode(altered.data(), altered.size()));
+
+    // A finished recording cannot be carried on
+    ReplayRecorder recorder;
+    recorder.begin(1, 16);
+    recorder.click(10, 3);
+    const std::vector<unsigned char> open(recorder.data(), recorder.data() + recorder.size());
+    recorder.finish(20, 10, 1);
+    const std::vector<unsigned char> closed(recorder.data(), recorder.data() + recorder.size());
+    CHECK(!recorder.resume(closed.data(), closed.size()) && !recorder.isRecording());
+    CHECK(recorder.resume(open.data(), open.size()) && recorder.isRecording());
+}
+
+} // namespace
+
+void runSavedGameTests() {
+    testContinuedGamesPlayOut();
+    testEncoding();
+}
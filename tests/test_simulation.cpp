@@ -0,0 +1,80 @@
+/**
+ * @file test_simulation.cpp
+ * @brief SimulationClock: step counts independent of the frame pattern
+ */
+
+#include "test_harness.h"
+#include "../include/SimulationClock.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Runs frames through a clock and returns the steps taken
+ */
+unsigned long long runFrames(SimulationClock& clock, const std::vector<float>& frames, bool& alphaInRange) {
+    alphaInRange = true;
+    for (float frame : frames) {
+        clock.advance(frame);
+        float alpha = clock.getAlpha();
+        alphaInRange = alphaInRange && alpha >= 0.0f && alpha < 1.0f;
+    }
+    return clock.getStepCount();
+}
+
+void testStepsIndependentOfFrameRate() {
+    // Two seconds of play at 30, 60 and 144 FPS, and with irregular frames
+    std::vector<float> fps30(60, 1.0f / 30.0f);
+    std::vector<float> fps60(120, 1.0f / 60.0f);
+    std::vector<float> fps144(288, 1.0f / 144.0f);
+    std::vector<float> irregular;
+    float total = 0.0f;
+    for (int i = 0; total < 2.0f - 0.001f; ++i) {
+        float frame = (i % 3 == 0) ? 0.031f : 0.007f;
+        frame = std::fmin(frame, 2.0f - total);
+        irregular.push_back(frame);
+        total += frame;
+    }
+
+    bool alphaOk = false;
+    for (const auto* frames : {&fps30, &fps60, &fps144, &irregular}) {
+        SimulationClock clock(1.0f / 60.0f);
+        unsigned long long steps = runFrames(clock, *frames, alphaOk);
+        // 120 steps, give or take the rounding of the last partial step
+        CHECK(steps >= 119 && steps <= 120);
+        CHECK(alphaOk);
+    }
+}
+
+void testAccumulatesSubStepFrames() {
+    SimulationClock clock(0.01f);
+    CHECK(clock.advance(0.004f) == 0);
+    CHECK(clock.advance(0.004f) == 0);
+    CHECK(std::fabs(clock.getAlpha() - 0.8f) < 1e-3f);
+    CHECK(clock.advance(0.004f) == 1);
+    CHECK(std::fabs(clock.getAlpha() - 0.2f) < 1e-3f);
+    CHECK(clock.advance(-1.0f) == 0); // bogus frame times are ignored
+}
+
+void testLongFrameIsCapped() {
+    SimulationClock clock(0.01f, 4);
+    CHECK(clock.advance(1.0f) == 4);
+    CHECK(clock.getAlpha() < 1.0f);
+    CHECK(clock.getDroppedTime() > 0.9);
+    // Back to normal right after the stall
+    CHECK(clock.advance(0.01f) == 1);
+
+    clock.reset();
+    CHECK(clock.getStepCount() == 0);
+    CHECK(clock.getAlpha() == 0.0f);
+}
+
+} // namespace
+
+void runSimulationTests() {
+    testStepsIndependentOfFrameRate();
+    testAccumulatesSubStepFrames();
+    testLongFrameIsCapped();
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_spectators.cpp
+ * @brief SpectatorHub fan-out to viewers connected over loopback TCP
+ */
+
+#include "test_harness.h"
+#include "../include/NetSocket.h"
+#include "../include/SpectatorHub.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Both ends of one loopback TCP connection, non-blocking
+ * @return false if the sockets could not be set up
+ */
+bool connectedPair(SOCKET& hubSide, SOCKET& viewerSide) {
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return false;
+#endif
+    SOCKET listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET) return false;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    bool ok = bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+              listen(listener, 1) == 0 &&
+              getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) == 0;
+
+    viewerSide = ok ? socket(AF_INET, SOCK_STREAM, 0) : INVALID_SOCKET;
+    ok = ok && viewerSide != INVALID_SOCKET &&
+         connect(viewerSide, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    hubSide = ok ? accept(listener, nullptr, nullptr) : INVALID_SOCKET;
+    CLOSE_SOCKET(listener);
+    if (hubSide == INVALID_SOCKET) {
+        if (viewerSide != INVALID_SOCKET) CLOSE_SOCKET(viewerSide);
+        return false;
+    }
+    setSocketNonBlocking(hubSide);
+    setSocketNonBlocking(viewerSide);
+    return true;
+}
+
+/**
+ * @brief Reads from a viewer until expected bytes arrived, the peer closed or a second passed
+ */
+std::string receive(SOCKET sock, size_t expected) {
+    std::string bytes;
+    char buffer[256];
+    for (int attempt = 0; attempt < 1000 && bytes.size() < expected; ++attempt) {
+        int received = recv(sock, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            bytes.append(buffer, static_cast<size_t>(received));
+        } else if (received == 0 || !socketWouldBlock()) {
+            break;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return bytes;
+}
+
+/**
+ * The first of two viewers drops: the hub must close that one's socket
+ * and keep feeding the other, whose entry moved down a slot.
+ */
+void testViewerDropKeepsOthers() {
+    SOCKET hubA, viewerA, hubB, viewerB;
+    if (!connectedPair(hubA, viewerA)) {
+        CHECK(false);
+        return;
+    }
+    if (!connectedPair(hubB, viewerB)) {
+        CHECK(false);
+        CLOSE_SOCKET(viewerA);
+        CLOSE_SOCKET(hubA);
+        return;
+    }
+
+    SpectatorHub hub;
+    const std::string snapshot = "STATE turn:0 score0:0 score1:0\n";
+    hub.addSpectator(hubA, makeBroadcastBuffer(snapshot));
+    hub.addSpectator(hubB, makeBroadcastBuffer(snapshot));
+    hub.pump(0.016f);
+    CHECK(receive(viewerA, snapshot.size()) == snapshot);
+    CHECK(receive(viewerB, snapshot.size()) == snapshot);
+
+    CLOSE_SOCKET(viewerA);
+    hub.pump(0.016f);
+    CHECK(hub.getSpectatorCount() == 1);
+
+    // The survivor's socket is still open and still receiving
+    const std::string update = "TURN 1\nSCORE 0 10\n";
+    hub.broadcast(makeBroadcastBuffer(update));
+    hub.pump(0.016f);
+    CHECK(hub.getSpectatorCount() == 1);
+    CHECK(receive(viewerB, update.size()) == update);
+
+    // And it leaves the same way
+    CLOSE_SOCKET(viewerB);
+    hub.pump(0.016f);
+    CHECK(hub.getSpectatorCount() == 0);
+}
+
+} // namespace
+
+void runSpectatorTests() {
+    testViewerDropKeepsOthers();
+}
@@ -0,0 +1,186 @@
+/**
+ * @file test_text.cpp
+ * @brief TextLayoutCache: DrawText-compatible layout and run caching
+ */
+
+#include "test_harness.h"
+#include "../include/TextLayoutCache.h"
+
+#include <cmath>
+#include <string>
+
+namespace {
+
+/**
+ * @brief A 10 px font with 'A' (8 wide), 'B' (6 wide), '?' and space, in a 64x16 atlas
+ */
+struct FakeFont {
+    GlyphInfo glyphs[4] = {};
+    Rectangle recs[4] = {};
+    Font font{};
+
+    FakeFont() {
+        const int values[4] = {'A', 'B', '?', ' '};
+        const float widths[4] = {8.0f, 6.0f, 5.0f, 4.0f};
+        float x = 0.0f;
+        for (int i = 0; i < 4; ++i) {
+            glyphs[i].value = values[i];
+            glyphs[i].offsetY = 1;
+            glyphs[i].advanceX = (values[i] == 'B') ? 0 : static_cast<int>(widths[i]);  // 'B' uses its width
+            recs[i] = {x, 0.0f, widths[i], 10.0f};
+            x += widths[i];
+        }
+        font.baseSize = 10;
+        font.glyphCount = 4;
+        font.texture.width = 64;
+        font.texture.height = 16;
+        font.recs = recs;
+        font.glyphs = glyphs;
+    }
+};
+
+bool near(float a, float b) {
+    return std::fabs(a - b) < 1e-4f;
+}
+
+void testLayoutMatchesDrawText() {
+    FakeFont fake;
+    TextLayoutCache cache;
+    cache.setFont(fake.font, 0.1f, 10);
+
+    // 20 px: scale 2, spacing 2
+    const TextRun& run = cache.get("A B", 20);
+    CHECK(run.quads.size() == 2);   // the space draws nothing
+    CHECK(near(run.quads[0].x, 0.0f));
+    CHECK(near(run.quads[0].y, 2.0f));
+    CHECK(near(run.quads[0].width, 16.0f));
+    CHECK(near(run.quads[0].height, 20.0f));
+    // 'A' advances 8*2+2, the space 4*2+2
+    CHECK(near(run.quads[1].x, 28.0f));
+    CHECK(near(run.quads[1].u0, 8.0f / 64.0f));
+    CHECK(near(run.quads[1].u1, 14.0f / 64.0f));
+    CHECK(near(run.quads[1].v1, 10.0f / 16.0f));
+    // MeasureText: (8 + 4 + 6) * 2 + 2 gaps * 2
+    CHECK(run.width == 40);
+
+    // Below the minimum size text is drawn at the minimum, like DrawText
+    CHECK(cache.get("A", 4).width == cache.get("A", 10).width);
+    CHECK(cache.get("", 20).width == 0);
+}
+
+void testUnknownGlyphFallsBack() {
+    FakeFont fake;
+    TextLayoutCache cache;
+    cache.setFont(fake.font, 0.1f, 10);
+    const TextRun& run = cache.get("Z", 10);
+    CHECK(run.quads.size() == 1);
+    CHECK(near(run.quads[0].width, 5.0f));     // '?'
+}
+
+void testRunsAreCached() {
+    FakeFont fake;
+    TextLayoutCache cache(4);
+    cache.setFont(fake.font, 0.1f, 10);
+
+    const TextRun* first = &cache.get("AB", 20);
+    CHECK(cache.getMisses() == 1);
+    CHECK(&cache.get("AB", 20) == first);
+    CHECK(cache.getHits() == 1);
+
+    // Same string at another size is another run
+    CHECK(cache.get("AB", 30).fontSize == 30);
+    CHECK(cache.getMisses() == 2);
+    CHECK(cache.size() == 2);
+
+    // Past the limit the least recently used run is laid out again in place
+    cache.get("A", 20);
+    cache.get("B", 20);
+    CHECK(cache.size() == 4);
+    const TextRun* second = &cache.get("AB", 30);
+    const TextRun& recycled = cache.get("BA", 20);
+    CHECK(cache.size() == 4);
+    CHECK(&recycled == first && recycled.text == "BA");
+    CHECK(&cache.get("AB", 30) == second);
+    const unsigned long long misses = cache.getMisses();
+    CHECK(cache.get("AB", 20).text == "AB");
+    CHECK(cache.getMisses() == misses + 1);
+
+    // A new font drops everything laid out with the old one
+    cache.setFont(fake.font, 0.05f, 1);
+    CHECK(cache.size() == 0);
+}
+
+// SDF settings: no minimum size, spacing from the size; each size is its own run
+void testSizesAreSeparateRuns() {
+    FakeFont fake;
+    TextLayoutCache cache;
+    cache.setFont(fake.font, 0.05f, 1);
+
+    const TextRun& small = cache.get("AB", 24);
+    const TextRun& large = cache.get("AB", 48);
+    CHECK(&small != &large && cache.size() == 2);
+    CHECK(small.fontSize == 24 && large.fontSize == 48);
+    // (8 + 6) * scale plus one gap of int(size * 0.05)
+    CHECK(small.width == 34 && large.width == 69);
+    CHECK(small.quads.size() == 2 && large.quads.size() == 2);
+    CHECK(near(small.quads[1].x, 8 * 2.4f + 1) && near(large.quads[1].x, 8 * 4.8f + 2));
+
+    CHECK(&cache.get("AB", 24) == &small && &cache.get("AB", 48) == &large);
+    CHECK(cache.getHits() == 2 && cache.getMisses() == 2);
+}
+
+// At the default capacity the least recently used run is the one recycled
+void testEvictionAtDefaultCapacity() {
+    FakeFont fake;
+    TextLayoutCache cache;
+    cache.setFont(fake.font, 0.1f, 10);
+
+    const int capacity = static_cast<int>(TextLayoutCache::DEFAULT_MAX_RUNS);
+    for (int i = 0; i < capacity; ++i) {
+        cache.get(std::to_string(i), 20);
+    }
+    CHECK(cache.size() == TextLayoutCache::DEFAULT_MAX_RUNS);
+    CHECK(cache.getMisses() == TextLayoutCache::DEFAULT_MAX_RUNS);
+
+    // "0" is used again, so "1" is now the oldest
+    const TextRun* zero = &cache.get("0", 20);
+    cache.get(std::to_string(capacity), 20);
+    CHECK(cache.size() == TextLayoutCache::DEFAULT_MAX_RUNS);
+    CHECK(&cache.get("0", 20) == zero);
+    CHECK(&cache.get(std::to_string(capacity - 1), 20) != zero);
+
+    const unsigned long long misses = cache.getMisses();
+    CHECK(cache.get("1", 20).text == "1");
+    CHECK(cache.getMisses() == misses + 1);
+}
+
+// Strings that keep changing, like a timer, cycle through a small cache
+void testRecyclingKeepsLookupsExact() {
+    FakeFont fake;
+    TextLayoutCache cache(8);
+    cache.setFont(fake.font, 0.1f, 10);
+
+    const char* pieces[3] = {"A", "B", "?"};
+    for (int i = 0; i < 500; ++i) {
+        std::string text;
+        for (int n = i; n > 0 || text.empty(); n /= 3) text += pieces[n % 3];
+        const TextRun& run = cache.get(text, 10 + i % 3);
+        CHECK(run.text == text && run.fontSize == 10 + i % 3);
+        CHECK(cache.size() <= 8);
+
+        // The title drawn every frame never ages out
+        CHECK(cache.get("AB", 20).text == "AB");
+    }
+    CHECK(cache.getMisses() == 501);
+}
+
+} // namespace
+
+void runTextTests() {
+    testLayoutMatchesDrawText();
+    testUnknownGlyphFallsBack();
+    testRunsAreCached();
+    testSizesAreSeparateRuns();
+    testEvictionAtDefaultCapacity();
+    testRecyclingKeepsLookupsExact();
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_threading.cpp
+ * @brief TripleBuffer handoff and SimulationThread input/step/publish flow
+ */
+
+#include "test_harness.h"
+#include "../include/TripleBuffer.h"
+#include "../include/SimulationThread.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Payload whose fields must always agree with each other
+ */
+struct Frame {
+    unsigned long long sequence = 0;
+    std::vector<unsigned long long> values;
+};
+
+void testTripleBufferHandsOverLatest() {
+    TripleBuffer<int> buffer;
+    CHECK(!buffer.update());
+    CHECK(buffer.read() == 0);
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+
+    // Only the newest value is seen; the older one was overwritten unread
+    CHECK(buffer.update());
+    CHECK(buffer.read() == 2);
+    CHECK(!buffer.update());
+    CHECK(buffer.read() == 2);
+
+    buffer.writeBuffer() = 3;
+    buffer.publish();
+    CHECK(buffer.update());
+    CHECK(buffer.read() == 3);
+}
+
+void testTripleBufferConcurrent() {
+    // The reader must never see a half-written frame or go back in time
+    TripleBuffer<Frame> buffer;
+    constexpr unsigned long long FRAMES = 200000;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        for (unsigned long long i = 1; i <= FRAMES; ++i) {
+            Frame& frame = buffer.writeBuffer();
+            frame.sequence = i;
+            frame.values.assign(16, i);
+            buffer.publish();
+        }
+        done = true;
+    });
+
+    bool consistent = true;
+    bool monotonic = true;
+    unsigned long long last = 0;
+    while (true) {
+        bool finished = done;
+        if (!buffer.update()) {
+            if (finished) {
+                break;
+            }
+            continue;
+        }
+        const Frame& frame = buffer.read();
+        for (unsigned long long value : frame.values) {
+            consistent = consistent && value == frame.sequence;
+        }
+        monotonic = monotonic && frame.sequence > last;
+        last = frame.sequence;
+    }
+    writer.join();
+
+    CHECK(consistent);
+    CHECK(monotonic);
+    CHECK(buffer.read().sequence == FRAMES);
+}
+
+void testSimulationThreadAppliesInput() {
+    SimulationThread thread(0.005f);
+    std::atomic<int> steps{0};
+    std::atomic<int> publishes{0};
+    std::atomic<unsigned long long> lastInput{0};
+    std::atomic<bool> inOrder{true};
+
+    CHECK(!thread.isRunning());
+    CHECK(thread.start(
+        [&](const InputEvent& event) {
+            inOrder = inOrder && event.sequence == lastInput + 1 && event.time > 0.0;
+            lastInput = event.sequence;
+        },
+        [&](float) { ++steps; },
+        [&](const SimulationClock&) { ++publishes; }));
+    CHECK(thread.isRunning());
+    CHECK(!thread.start([](const InputEvent&) {}, [](float) {}, [](const SimulationClock&) {}));
+
+    InputEvent event;
+    event.type = InputEvent::Type::CLICK;
+    CHECK(thread.postInput(event) == 1);
+    CHECK(thread.postInput(event) == 2);
+
+    // Steps keep running in real time; input is applied as it arrives
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while ((steps < 5 || lastInput < 2) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    thread.stop();
+    CHECK(!thread.isRunning());
+
+    CHECK(steps >= 5);
+    CHECK(lastInput == 2);
+    CHECK(inOrder);
+    CHECK(publishes >= 2);
+
+    // Nothing runs after stop()
+    int stepsAtStop = steps;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(steps == stepsAtStop);
+}
+
+} // namespace
+
+void runThreadingTests() {
+    testTripleBufferHandsOverLatest();
+    testTripleBufferConcurrent();
+    testSimulationThreadAppliesInput();
+}
@@ -0,0 +1,289 @@
+/**
+ * @file test_udp.cpp
+ * @brief ReliableChannel over a simulated lossy wire, and UdpTransport over loopback
+ */
+
+#include "test_harness.h"
+#include "../include/NetworkSession.h"
+#include "../include/ReliableChannel.h"
+#include "../include/UdpTransport.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+/**
+ * @brief Two channels joined by a wire that delays, reorders and drops datagrams
+ */
+struct LossyWire {
+    struct Datagram {
+        float arrival;
+        int to;
+        std::string bytes;
+    };
+
+    ReliableChannel channels[2];
+    std::vector<Datagram> inFlight;
+    std::mt19937 rng;
+    float now = 0.0f;
+    float latency;
+    float jitter;
+    float lossRate;
+    std::function<bool(int from, const std::string& packet)> drop; ///< Extra, targeted losses
+    std::string received[2];
+
+    LossyWire(float latencySeconds, float jitterSeconds, float loss, unsigned int seed)
+        : rng(seed), latency(latencySeconds), jitter(jitterSeconds), lossRate(loss) {
+    }
+
+    float random01() {
+        return static_cast<float>(rng() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    void put(int from, std::vector<std::string>& packets) {
+        for (std::string& packet : packets) {
+            if (random01() < lossRate || (drop && drop(from, packet))) {
+                continue;
+            }
+            inFlight.push_back(Datagram{now + latency + jitter * random01(), 1 - from, std::move(packet)});
+        }
+        packets.clear();
+    }
+
+    void send(int from, const std::string& bytes) {
+        CHECK(channels[from].send(bytes.data(), bytes.size()) == bytes.size());
+        std::vector<std::string> packets;
+        channels[from].flush(packets);
+        put(from, packets);
+    }
+
+    void tick() {
+        now += TICK;
+        // Deliver in arrival order, which jitter makes different from send order
+        std::stable_sort(inFlight.begin(), inFlight.end(),
+                         [](const Datagram& a, const Datagram& b) { return a.arrival < b.arrival; });
+        size_t delivered = 0;
+        while (delivered < inFlight.size() && inFlight[delivered].arrival <= now) {
+            const Datagram& datagram = inFlight[delivered];
+            channels[datagram.to].receivePacket(datagram.bytes.data(), datagram.bytes.size());
+            ++delivered;
+        }
+        inFlight.erase(inFlight.begin(), inFlight.begin() + delivered);
+
+        std::vector<std::string> packets;
+        for (int side = 0; side < 2; ++side) {
+            channels[side].update(TICK, packets);
+            put(side, packets);
+
+            char buffer[256];
+            size_t count;
+            while ((count = channels[side].read(buffer, sizeof(buffer))) > 0) {
+                received[side].append(buffer, count);
+            }
+        }
+    }
+};
+
+bool isDataWithChunk(const std::string& packet) {
+    return packet.size() > ReliableChannel::HEADER_SIZE &&
+           static_cast<PacketType>(packet[2]) == PacketType::DATA;
+}
+
+} // namespace
+
+// A clean link needs no resends and every chunk is acked
+void testChannelCleanLink() {
+    LossyWire wire(0.03f, 0.0f, 0.0f, 1);
+    std::string expected;
+    for (int i = 0; i < 50; ++i) {
+        std::string line = "FLIP " + std::to_string(i % 16) + "\n";
+        expected += line;
+        wire.send(0, line);
+        wire.tick();
+    }
+    for (int i = 0; i < 30; ++i) {
+        wire.tick();
+    }
+
+    CHECK(wire.received[1] == expected);
+    CHECK(wire.channels[0].getResends() == 0);
+    CHECK(wire.channels[0].getUnackedChunks() == 0);
+    // 2 x 30 ms on the wire plus up to a tick before the ack goes out
+    CHECK(wire.channels[0].getRoundTripTime() > 0.05f);
+    CHECK(wire.channels[0].getRoundTripTime() < 0.1f);
+}
+
+// Heavy loss and reordering still deliver every byte exactly once, in order, both ways
+void testChannelOrderedUnderLoss() {
+    LossyWire wire(0.05f, 0.04f, 0.3f, 7);
+    std::string expected[2];
+    for (int i = 0; i < 200; ++i) {
+        int from = i % 2;
+        std::string line = (from == 0 ? "TURN " : "SCORE 1 ") + std::to_string(i) + "\n";
+        expected[from] += line;
+        wire.send(from, line);
+        wire.tick();
+    }
+    for (int i = 0; i < 600 && (wire.channels[0].getUnackedChunks() > 0 || wire.channels[1].getUnackedChunks() > 0); ++i) {
+        wire.tick();
+    }
+
+    CHECK(wire.received[1] == expected[0]);
+    CHECK(wire.received[0] == expected[1]);
+    CHECK(wire.channels[0].getResends() > 0);
+    CHECK(wire.channels[0].getUnackedChunks() == 0);
+    CHECK(wire.channels[1].getUnackedChunks() == 0);
+}
+
+// A lost chunk is resent after about one round trip, not after a fixed retransmit timeout
+void testChannelResendsPromptly() {
+    LossyWire wire(0.04f, 0.0f, 0.0f, 3);
+    // Learn the round trip first
+    for (int i = 0; i < 10; ++i) {
+        wire.send(0, "PING\n");
+        wire.tick();
+    }
+    for (int i = 0; i < 10; ++i) {
+        wire.tick();
+    }
+    wire.received[1].clear();
+
+    bool droppedOnce = false;
+    wire.drop = [&](int from, const std::string& packet) {
+        if (from == 0 && !droppedOnce && isDataWithChunk(packet)) {
+            droppedOnce = true;
+            return true;
+        }
+        return false;
+    };
+
+    const float sentAt = wire.now;
+    wire.send(0, "TURN 1\n");
+    while (wire.received[1].empty() && wire.now < sentAt + 2.0f) {
+        wire.tick();
+    }
+
+    const float rtt = wire.channels[0].getRoundTripTime();
+    std::cout << "  lost TURN delivered after " << static_cast<int>((wire.now - sentAt) * 1000.0f)
+              << " ms (rtt " << static_cast<int>(rtt * 1000.0f) << " ms)" << std::endl;
+    CHECK(droppedOnce);
+    CHECK(wire.received[1] == "TURN 1\n");
+    // Resend timer plus one more trip across the wire
+    CHECK(wire.now - sentAt <= rtt * 1.25f + 0.03f + 0.04f + 2 * TICK + 0.01f);
+}
+
+// Presence never waits for a missing chunk and never goes backwards
+void testPresenceIsLatestWins() {
+    LossyWire wire(0.05f, 0.06f, 0.2f, 11);
+    // Hold back every reliable chunk: presence must still flow
+    wire.drop = [](int from, const std::string& packet) { return from == 0 && isDataWithChunk(packet); };
+    wire.send(0, "FLIP 1\n");
+
+    int lastSeen = -1;
+    bool wentBackwards = false;
+    int updates = 0;
+    for (int i = 0; i < 120; ++i) {
+        wire.channels[0].sendPresence("PRESENCE " + std::to_string(i) + " 0");
+        std::vector<std::string> packets;
+        wire.channels[0].flush(packets);
+        wire.put(0, packets);
+        wire.tick();
+
+        std::string payload;
+        if (wire.channels[1].takePresence(payload)) {
+            int x = std::stoi(payload.substr(9));
+            wentBackwards = wentBackwards || x <= lastSeen;
+            lastSeen = x;
+            ++updates;
+        }
+    }
+
+    CHECK(wire.received[1].empty());
+    CHECK(updates > 20);
+    CHECK(!wentBackwards);
+    CHECK(lastSeen > 100);
+}
+
+// A client whose server never answers gives up and flags the TCP fallback
+void testUdpConnectTimesOut() {
+    UdpListener silent;
+    if (!silent.open(0)) {
+        std::cout << "  UDP sockets unavailable, skipped" << std::endl;
+        return;
+    }
+    const unsigned short port = silent.getPort();
+
+    // The port is bound, so CONNECT packets are swallowed rather than refused
+    auto unanswered = std::make_shared<bool>(false);
+    auto client = UdpTransport::connectTo("127.0.0.1", port, unanswered);
+    CHECK(client != nullptr);
+    if (!client) {
+        return;
+    }
+    for (float t = 0.0f; t < UdpTransport::CONNECT_TIMEOUT + 0.1f && !client->isClosed(); t += TICK) {
+        client->pump(TICK);
+    }
+    CHECK(client->isClosed());
+    CHECK(!client->isConnected());
+    CHECK(*unanswered);
+}
+
+// Two sessions play over real UDP sockets on loopback
+void testSessionOverUdpLoopback() {
+    UdpListener listener;
+    if (!listener.open(0)) {
+        std::cout << "  UDP sockets unavailable, skipped" << std::endl;
+        return;
+    }
+    const unsigned short port = listener.getPort();
+
+    NetworkSession host;
+    NetworkSession guest;
+    host.attach(NetworkMode::SERVER, nullptr);
+    guest.startClient(NetworkMode::CLIENT, [port]() { return UdpTransport::connectTo("127.0.0.1", port); });
+
+    auto tick = [&]() {
+        while (auto incoming = listener.accept()) {
+            host.acceptTransport(std::move(incoming));
+        }
+        host.update(TICK);
+        guest.update(TICK);
+    };
+
+    for (int i = 0; i < 300 && !(guest.isHandshakeComplete() && host.isConnected()); ++i) {
+        tick();
+    }
+    CHECK(guest.isHandshakeComplete());
+    CHECK(host.isConnected());
+    CHECK(std::string(guest.getTransportName()) == "UDP");
+
+    host.sendFlip(4);
+    host.nextTurn();
+    guest.setPresence(120, 340);
+    std::vector<std::string> events;
+    int x = 0, y = 0;
+    for (int i = 0; i < 300 && (events.empty() || !guest.isMyTurn() || !host.getRemotePresence(x, y)); ++i) {
+        tick();
+        guest.takeRemoteEvents(events);
+    }
+    CHECK(events.size() == 1 && events[0] == "FLIP 4");
+    CHECK(guest.isMyTurn());
+    CHECK(host.getRemotePresence(x, y));
+    CHECK(x == 120 && y == 340);
+}
+
+void runUdpTests() {
+    testChannelCleanLink();
+    testChannelOrderedUnderLoss();
+    testChannelResendsPromptly();
+    testPresenceIsLatestWins();
+    testUdpConnectTimesOut();
+    testSessionOverUdpLoopback();
+}
@@ -0,0 +1,168 @@
+/**
+ * @file test_utils.cpp
+ * @brief Utils: the deck, the seeded shuffle and the board layout helpers
+ */
+
+#include "test_harness.h"
+#include "../include/Utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+bool near(float a, float b) {
+    return std::fabs(a - b) < 1e-3f;
+}
+
+void testCardPairs() {
+    for (int pairs : {0, 1, 8, 18, 32, 500}) {
+        std::vector<int> deck = Utils::createCardPairs(pairs);
+        CHECK(static_cast<int>(deck.size()) == pairs * 2);
+        std::vector<int> counts(pairs, 0);
+        bool inRange = true;
+        for (int id : deck) {
+            inRange = inRange && id >= 0 && id < pairs;
+            if (inRange) ++counts[id];
+        }
+        CHECK(inRange);
+        CHECK(std::all_of(counts.begin(), counts.end(), [](int count) { return count == 2; }));
+    }
+}
+
+void testSeededShuffle() {
+    const std::vector<int> sorted = Utils::range(0, 64);
+    CHECK(sorted.size() == 64 && sorted.front() == 0 && sorted.back() == 63);
+
+    // The same seed gives the same order; the result is a permutation
+    std::vector<int> a = sorted;
+    std::vector<int> b = sorted;
+    std::mt19937 rngA(42);
+    std::mt19937 rngB(42);
+    Utils::shuffle(a, rngA);
+    Utils::shuffle(b, rngB);
+    CHECK(a == b);
+    CHECK(a != sorted);
+    std::vector<int> back = a;
+    std::sort(back.begin(), back.end());
+    CHECK(back == sorted);
+
+    // It draws size - 1 values, which saved games count on
+    std::mt19937 counted(42);
+    int draws = 0;
+    auto draw = [&] { ++draws; return counted(); };
+    std::vector<int> c = sorted;
+    Utils::shuffle(c, draw);
+    CHECK(draws == 63);
+    CHECK(c == a);
+    std::mt19937 discarded(42);
+    discarded.discard(63);
+    CHECK(counted() == discarded());
+
+    // Nothing to do for fewer than two
+    std::vector<int> one = {5};
+    std::vector<int> none;
+    draws = 0;
+    Utils::shuffle(one, draw);
+    Utils::shuffle(none, draw);
+    CHECK(draws == 0 && one.size() == 1 && one[0] == 5);
+
+    // Every position gets every value over many seeds
+    std::vector<std::vector<int>> seen(8, std::vector<int>(8, 0));
+    for (std::uint32_t seed = 0; seed < 2000; ++seed) {
+        std::vector<int> small = Utils::range(0, 8);
+        std::mt19937 rng(seed);
+        Utils::shuffle(small, rng);
+        for (int i = 0; i < 8; ++i) ++seen[i][small[i]];
+    }
+    bool spread = true;
+    for (const std::vector<int>& position : seen) {
+        for (int count : position) spread = spread && count > 150 && count < 350;
+    }
+    CHECK(spread);
+}
+
+void testGridDimensions() {
+    Vector2 grid = Utils::calculateGridDimensions(16);
+    CHECK(grid.x == 4.0f && grid.y == 4.0f);
+    grid = Utils::calculateGridDimensions(64);
+    CHECK(grid.x == 8.0f && grid.y == 8.0f);
+    grid = Utils::calculateGridDimensions(10);
+    CHECK(grid.x == 4.0f && grid.y == 3.0f);
+
+    bool fits = true;
+    for (int cards = 1; cards <= 400; ++cards) {
+        grid = Utils::calculateGridDimensions(cards);
+        const int cols = static_cast<int>(grid.x);
+        const int rows = static_cast<int>(grid.y);
+        fits = fits && cols * rows >= cards && cols * (rows - 1) < cards && cols >= rows;
+    }
+    CHECK(fits);
+}
+
+void testCardSizeAndPositions() {
+    const Rectangle bounds = {20.0f, 40.0f, 900.0f, 600.0f};
+    const float padding = 10.0f;
+
+    // Cards keep a 2:3 shape and fit the bounds with padding around them
+    for (int grid : {4, 6, 8}) {
+        Vector2 size = Utils::calculateOptimalCardSize(grid, grid, bounds, padding);
+        CHECK(near(size.x / size.y, 2.0f / 3.0f));
+        CHECK(grid * size.x + (grid + 1) * padding <= bounds.width + 1e-3f);
+        CHECK(grid * size.y + (grid + 1) * padding <= bounds.height + 1e-3f);
+    }
+
+    // Row by row, evenly spaced, centred in the bounds
+    const Vector2 cardSize = {60.0f, 90.0f};
+    std::vector<Vector2> positions = Utils::calculateCardPositions(4, 3, cardSize, padding, bounds);
+    CHECK(positions.size() == 12);
+    CHECK(near(positions[1].x - positions[0].x, cardSize.x + padding));
+    CHECK(near(positions[4].y - positions[0].y, cardSize.y + padding));
+    CHECK(near(positions[4].x, positions[0].x));
+    const float left = positions.front().x - bounds.x;
+    const float right = bounds.x + bounds.width - (positions.back().x + cardSize.x);
+    const float top = positions.front().y - bounds.y;
+    const float bottom = bounds.y + bounds.height - (positions.back().y + cardSize.y);
+    CHECK(near(left, right));
+    CHECK(near(top, bottom));
+}
+
+void testMathAndStrings() {
+    CHECK(Utils::clamp(5.0f, 0.0f, 1.0f) == 1.0f);
+    CHECK(Utils::clamp(-5.0f, 0.0f, 1.0f) == 0.0f);
+    CHECK(near(Utils::lerp(2.0f, 4.0f, 0.25f), 2.5f));
+    CHECK(near(Utils::distance({0.0f, 0.0f}, {3.0f, 4.0f}), 5.0f));
+    CHECK(near(Utils::distanceSquared({1.0f, 1.0f}, {4.0f, 5.0f}), 25.0f));
+
+    bool inRange = true;
+    for (int i = 0; i < 1000; ++i) {
+        int value = Utils::randomInt(3, 7);
+        float real = Utils::randomFloat(-1.0f, 1.0f);
+        inRange = inRange && value >= 3 && value <= 7 && real >= -1.0f && real <= 1.0f;
+    }
+    CHECK(inRange);
+
+    CHECK(Utils::formatTime(0.0f) == "00:00");
+    CHECK(Utils::formatTime(65.9f) == "01:05");
+    CHECK(Utils::formatTime(600.0f) == "10:00");
+    CHECK(Utils::toString(42) == "42");
+    CHECK(Utils::toString(1.5f) == "1.50");
+    CHECK(Utils::toUpper("Memory 1") == "MEMORY 1");
+    CHECK(Utils::toLower("Memory 1") == "memory 1");
+    CHECK(Utils::getDirectory("assets/images/card.png") == "assets/images");
+    CHECK(Utils::getFilename("assets/images/card.png") == "card.png");
+    CHECK(Utils::getDirectory("card.png").empty());
+    CHECK(Utils::getFilename("card.png") == "card.png");
+}
+
+} // namespace
+
+void runUtilsTests() {
+    testCardPairs();
+    testSeededShuffle();
+    testGridDimensions();
+    testCardSizeAndPositions();
+    testMathAndStrings();
+}
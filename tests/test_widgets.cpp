@@ -0,0 +1,124 @@
+/**
+ * @file test_widgets.cpp
+ * @brief WidgetLayer: hover, focus, keyboard navigation and the widget arena
+ */
+
+#include "test_harness.h"
+#include "../include/WidgetLayer.h"
+
+namespace {
+
+constexpr int MENU = 0;
+constexpr int OTHER = 1;
+
+// Three 100x40 buttons stacked 50 px apart, ids 10, 11, 12
+void declareMenu(WidgetLayer& widgets, int screen = MENU) {
+    widgets.begin(screen);
+    widgets.button(10, {0.0f, 0.0f, 100.0f, 40.0f}, "One");
+    widgets.button(11, {0.0f, 50.0f, 100.0f, 40.0f}, "Two");
+    widgets.button(12, {0.0f, 100.0f, 100.0f, 40.0f}, "Three");
+}
+
+WidgetInput mouseAt(float x, float y, bool moved = true) {
+    WidgetInput input;
+    input.mouse = {x, y};
+    input.mouseMoved = moved;
+    return input;
+}
+
+WidgetInput nowhere() {
+    return mouseAt(500.0f, 500.0f, false);
+}
+
+void testHoverAndClick() {
+    WidgetLayer widgets;
+    declareMenu(widgets);
+
+    CHECK(widgets.update(MENU, mouseAt(20.0f, 60.0f)) == -1);
+    CHECK(widgets.getFocused() == 11);
+
+    WidgetInput click = mouseAt(20.0f, 110.0f, false);
+    click.clicked = true;
+    CHECK(widgets.update(MENU, click) == 12);
+
+    // Clicking between buttons activates nothing and drops the focus
+    click.mouse = {20.0f, 45.0f};
+    CHECK(widgets.update(MENU, click) == -1);
+    CHECK(widgets.getFocused() == -1);
+}
+
+void testKeyboardNavigation() {
+    WidgetLayer widgets;
+    declareMenu(widgets);
+    widgets.update(MENU, nowhere());     // first pass on a new screen looks at the mouse
+    CHECK(widgets.getFocused() == -1);
+
+    WidgetInput down = nowhere();
+    down.navigate = 1;
+    widgets.update(MENU, down);
+    CHECK(widgets.getFocused() == 10);
+
+    // A mouse that stays still does not steal keyboard focus, across frames
+    declareMenu(widgets);
+    widgets.update(MENU, nowhere());
+    CHECK(widgets.getFocused() == 10);
+
+    WidgetInput up = nowhere();
+    up.navigate = -1;
+    widgets.update(MENU, up);
+    CHECK(widgets.getFocused() == 12);   // wraps
+
+    WidgetInput enter = nowhere();
+    enter.activate = true;
+    CHECK(widgets.update(MENU, enter) == 12);
+
+    // From no focus, up starts at the last widget
+    WidgetLayer fresh;
+    declareMenu(fresh);
+    fresh.update(MENU, up);
+    CHECK(fresh.getFocused() == 12);
+}
+
+void testScreens() {
+    WidgetLayer widgets;
+    declareMenu(widgets);
+    WidgetInput click = mouseAt(20.0f, 10.0f);
+    click.clicked = true;
+    // Input for a screen that declared nothing this time is ignored
+    CHECK(widgets.update(OTHER, click) == -1);
+    CHECK(widgets.update(MENU, click) == 10);
+
+    // Changing screens clears the focus
+    declareMenu(widgets, OTHER);
+    CHECK(widgets.getFocused() == -1);
+    CHECK(widgets.getScreen() == OTHER);
+}
+
+void testArenaIsReused() {
+    WidgetLayer widgets;
+    declareMenu(widgets);
+    const char* label = widgets.at(2).label.data();
+    for (int frame = 0; frame < 10; ++frame) {
+        declareMenu(widgets);
+    }
+    CHECK(widgets.size() == 3);
+    CHECK(widgets.at(2).label == "Three");
+    CHECK(widgets.at(2).label.data() == label);  // same buffer, nothing reallocated
+
+    // Fewer widgets than last frame: the focus cannot point past them
+    widgets.update(MENU, mouseAt(20.0f, 110.0f));
+    CHECK(widgets.getFocused() == 12);
+    widgets.begin(MENU);
+    widgets.button(10, {0.0f, 0.0f, 100.0f, 40.0f}, "Only");
+    CHECK(widgets.getFocused() == -1);
+    CHECK(widgets.update(MENU, nowhere()) == -1);
+}
+
+} // namespace
+
+void runWidgetTests() {
+    testHoverAndClick();
+    testKeyboardNavigation();
+    testScreens();
+    testArenaIsReused();
+}